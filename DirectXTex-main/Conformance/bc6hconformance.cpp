@@ -0,0 +1,220 @@
+//-------------------------------------------------------------------------------------
+// bc6hconformance.cpp
+//
+// DirectX Texture Library - BC6H encoder conformance test
+//
+// Compresses a synthetic HDR corpus to BC6H_UF16 and BC6H_SF16 and checks that the
+// round-trip PSNR is at least that of the reference encoder (the BC6H encoder prior
+// to the vectorized palette search).
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+//-------------------------------------------------------------------------------------
+
+#include "DirectXTex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr size_t c_Size = 64;
+
+    // Round-trip PSNR (dB) of the reference encoder for each corpus image
+    struct Reference
+    {
+        const char* name;
+        DXGI_FORMAT format;
+        double      psnr;
+    };
+
+    const Reference g_Reference[] =
+    {
+        { "gradient",   DXGI_FORMAT_BC6H_UF16, 49.38 },
+        { "sky",        DXGI_FORMAT_BC6H_UF16, 51.47 },
+        { "highlights", DXGI_FORMAT_BC6H_UF16, 60.48 },
+        { "noise",      DXGI_FORMAT_BC6H_UF16, 14.65 },
+        { "dark",       DXGI_FORMAT_BC6H_UF16, 40.56 },
+        { "gradient",   DXGI_FORMAT_BC6H_SF16, 49.35 },
+        { "signed",     DXGI_FORMAT_BC6H_SF16, 34.48 },
+        { "noise",      DXGI_FORMAT_BC6H_SF16, 14.45 },
+    };
+
+    // Allowed PSNR loss against the reference; covers DirectXMath half conversion differences between platforms
+    constexpr double c_Tolerance = 0.05;
+
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed) noexcept : m_state(seed) {}
+
+        // Uniform in [0, 1)
+        float Next() noexcept
+        {
+            m_state = m_state * 1664525u + 1013904223u;
+            return float(m_state >> 8) * (1.f / 16777216.f);
+        }
+
+    private:
+        uint32_t m_state;
+    };
+
+    bool GenerateImage(const char* name, ScratchImage& image)
+    {
+        if (FAILED(image.Initialize2D(DXGI_FORMAT_R32G32B32A32_FLOAT, c_Size, c_Size, 1, 1)))
+            return false;
+
+        auto pixels = reinterpret_cast<float*>(image.GetPixels());
+        Random rng(0x1234567u);
+
+        for (size_t y = 0; y < c_Size; ++y)
+        {
+            for (size_t x = 0; x < c_Size; ++x)
+            {
+                const float u = float(x) / float(c_Size - 1);
+                const float v = float(y) / float(c_Size - 1);
+
+                float rgb[3] = {};
+                if (!strcmp(name, "gradient"))
+                {
+                    // Smooth ramps over several orders of magnitude
+                    const float e = std::exp2(u * 12.f - 4.f);
+                    rgb[0] = e;
+                    rgb[1] = e * (0.25f + 0.75f * v);
+                    rgb[2] = e * (1.f - 0.5f * v);
+                }
+                else if (!strcmp(name, "sky"))
+                {
+                    // Bright sky over a darker horizon with a soft sun
+                    const float dx = u - 0.7f;
+                    const float dy = v - 0.25f;
+                    const float sun = 400.f * std::exp(-(dx * dx + dy * dy) * 300.f);
+                    rgb[0] = 0.6f + 2.f * (1.f - v) + sun;
+                    rgb[1] = 0.9f + 3.f * (1.f - v) + sun * 0.9f;
+                    rgb[2] = 1.5f + 6.f * (1.f - v) + sun * 0.7f;
+                }
+                else if (!strcmp(name, "highlights"))
+                {
+                    // Mostly mid-range content with sharp, very bright specular spots
+                    const bool spot = ((x * 7 + y * 13) % 97) < 3;
+                    const float base = 0.2f + 0.6f * ((x / 8 + y / 8) & 1);
+                    rgb[0] = spot ? 5000.f : base;
+                    rgb[1] = spot ? 4000.f : base * 0.8f;
+                    rgb[2] = spot ? 2500.f : base * 0.6f;
+                }
+                else if (!strcmp(name, "noise"))
+                {
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        rgb[c] = std::exp2(rng.Next() * 10.f - 5.f);
+                    }
+                }
+                else if (!strcmp(name, "dark"))
+                {
+                    // Near-black content where half precision is densest
+                    rgb[0] = 0.001f + 0.01f * u;
+                    rgb[1] = 0.002f + 0.005f * v + 0.001f * rng.Next();
+                    rgb[2] = 0.0005f + 0.01f * u * v;
+                }
+                else if (!strcmp(name, "signed"))
+                {
+                    rgb[0] = 8.f * std::sin(u * 9.f + v * 2.f);
+                    rgb[1] = -4.f + 8.f * v;
+                    rgb[2] = (((x / 4) ^ (y / 4)) & 1) ? -20.f * u : 20.f * v;
+                }
+                else
+                {
+                    return false;
+                }
+
+                float* p = pixels + (y * c_Size + x) * 4;
+                p[0] = rgb[0];
+                p[1] = rgb[1];
+                p[2] = rgb[2];
+                p[3] = 1.f;
+            }
+        }
+
+        return true;
+    }
+
+    // PSNR over RGB relative to the peak magnitude of the source image
+    double ComputePSNR(const ScratchImage& source, const ScratchImage& result)
+    {
+        auto src = reinterpret_cast<const float*>(source.GetPixels());
+        auto dst = reinterpret_cast<const float*>(result.GetPixels());
+
+        double peak = 0.0;
+        double sum = 0.0;
+        for (size_t i = 0; i < c_Size * c_Size; ++i)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                const double a = src[i * 4 + c];
+                const double d = double(dst[i * 4 + c]) - a;
+                peak = std::max(peak, std::abs(a));
+                sum += d * d;
+            }
+        }
+
+        const double mse = sum / double(c_Size * c_Size * 3);
+        if (mse <= 0.0)
+            return 999.0;
+
+        return 10.0 * std::log10(peak * peak / mse);
+    }
+}
+
+int main()
+{
+    int failures = 0;
+
+    for (const auto& ref : g_Reference)
+    {
+        ScratchImage source;
+        if (!GenerateImage(ref.name, source))
+        {
+            printf("FAILED: %s could not be generated\n", ref.name);
+            ++failures;
+            continue;
+        }
+
+        ScratchImage compressed;
+        HRESULT hr = Compress(*source.GetImage(0, 0, 0), ref.format, TEX_COMPRESS_DEFAULT, TEX_THRESHOLD_DEFAULT, compressed);
+        if (FAILED(hr))
+        {
+            printf("FAILED: %s Compress (%08X)\n", ref.name, static_cast<unsigned int>(hr));
+            ++failures;
+            continue;
+        }
+
+        ScratchImage result;
+        hr = Decompress(*compressed.GetImage(0, 0, 0), DXGI_FORMAT_R32G32B32A32_FLOAT, result);
+        if (FAILED(hr))
+        {
+            printf("FAILED: %s Decompress (%08X)\n", ref.name, static_cast<unsigned int>(hr));
+            ++failures;
+            continue;
+        }
+
+        const double psnr = ComputePSNR(source, result);
+        const bool pass = (psnr + c_Tolerance >= ref.psnr);
+        printf("%s: %s %s %.2f dB (reference %.2f dB)\n",
+            pass ? "PASSED" : "FAILED",
+            ref.name,
+            (ref.format == DXGI_FORMAT_BC6H_SF16) ? "BC6H_SF16" : "BC6H_UF16",
+            psnr, ref.psnr);
+
+        if (!pass)
+            ++failures;
+    }
+
+    return (failures > 0) ? 1 : 0;
+}
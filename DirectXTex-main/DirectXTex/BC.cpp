@@ -194,8 +194,8 @@ namespace
         }
 
 
-        // Two color block.. no need to root-find
-        if (fAB < 1.0f / 4096.0f)
+        // Two color block, or the caller only wants a range fit.. no need to root-find
+        if ((fAB < 1.0f / 4096.0f) || (flags & BC_FLAGS_RANGE_FIT))
         {
             pX->r = X.r; pX->g = X.g; pX->b = X.b; pX->a = 1.0f;
             pY->r = Y.r; pY->g = Y.g; pY->b = Y.b; pY->a = 1.0f;
@@ -315,12 +315,272 @@ namespace
 
 
     //-------------------------------------------------------------------------------------
-    inline void DecodeBC1(
-        _Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pColor,
+    // Principal axis of a set of colors, found by power iteration on the covariance
+    // matrix. Returns false if the colors are all the same.
+    //-------------------------------------------------------------------------------------
+    bool ComputePrincipalAxis(
+        _Out_ HDRColorA *pAxis,
+        _In_reads_(cPoints) const HDRColorA *pPoints,
+        size_t cPoints) noexcept
+    {
+        HDRColorA Mean(0.0f, 0.0f, 0.0f, 0.0f);
+        for (size_t iPoint = 0; iPoint < cPoints; iPoint++)
+        {
+            Mean.r += pPoints[iPoint].r;
+            Mean.g += pPoints[iPoint].g;
+            Mean.b += pPoints[iPoint].b;
+        }
+
+        const float fInv = 1.0f / static_cast<float>(cPoints);
+        Mean.r *= fInv;
+        Mean.g *= fInv;
+        Mean.b *= fInv;
+
+        // rr, rg, rb, gg, gb, bb
+        float fCov[6] = {};
+        for (size_t iPoint = 0; iPoint < cPoints; iPoint++)
+        {
+            const float r = pPoints[iPoint].r - Mean.r;
+            const float g = pPoints[iPoint].g - Mean.g;
+            const float b = pPoints[iPoint].b - Mean.b;
+
+            fCov[0] += r * r;
+            fCov[1] += r * g;
+            fCov[2] += r * b;
+            fCov[3] += g * g;
+            fCov[4] += g * b;
+            fCov[5] += b * b;
+        }
+
+        if ((fCov[0] + fCov[3] + fCov[5]) < FLT_MIN)
+        {
+            pAxis->r = pAxis->g = pAxis->b = 1.0f;
+            pAxis->a = 0.0f;
+            return false;
+        }
+
+        // Start from the row with the largest variance, which is never orthogonal to the answer
+        float r, g, b;
+        if (fCov[0] >= fCov[3] && fCov[0] >= fCov[5])
+        {
+            r = fCov[0]; g = fCov[1]; b = fCov[2];
+        }
+        else if (fCov[3] >= fCov[5])
+        {
+            r = fCov[1]; g = fCov[3]; b = fCov[4];
+        }
+        else
+        {
+            r = fCov[2]; g = fCov[4]; b = fCov[5];
+        }
+
+        for (size_t iIteration = 0; iIteration < 8; iIteration++)
+        {
+            const float nr = fCov[0] * r + fCov[1] * g + fCov[2] * b;
+            const float ng = fCov[1] * r + fCov[3] * g + fCov[4] * b;
+            const float nb = fCov[2] * r + fCov[4] * g + fCov[5] * b;
+
+            const float fMax = std::max(std::max(fabsf(nr), fabsf(ng)), fabsf(nb));
+            if (fMax < FLT_MIN)
+                break;
+
+            const float fScale = 1.0f / fMax;
+            r = nr * fScale;
+            g = ng * fScale;
+            b = nb * fScale;
+        }
+
+        pAxis->r = r;
+        pAxis->g = g;
+        pAxis->b = b;
+        pAxis->a = 0.0f;
+        return true;
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    // Exhaustive endpoint selection (cluster fit)
+    //
+    // Colors are ordered along the principal axis, then every split of that ordering into
+    // cSteps contiguous clusters is tried. Each split has a least-squares pair of endpoints;
+    // those are snapped to the 5:6:5 grid and the split with the lowest error wins. The
+    // axis is then re-derived from the winning endpoints and the search repeated until the
+    // ordering stops changing.
+    //-------------------------------------------------------------------------------------
+    void ClusterFitRGB(
+        _Out_ HDRColorA *pX,
+        _Out_ HDRColorA *pY,
+        _In_reads_(cPoints) const HDRColorA *pPoints,
+        size_t cPoints,
+        uint32_t cSteps,
+        uint32_t flags) noexcept
+    {
+        *pX = *pY = pPoints[0];
+
+        HDRColorA Axis;
+        if (cPoints < 2 || !ComputePrincipalAxis(&Axis, pPoints, cPoints))
+            return;
+
+        const HDRColorA Weight = (flags & BC_FLAGS_UNIFORM) ? HDRColorA(1.f, 1.f, 1.f, 1.f) : g_Luminance;
+        const HDRColorA WeightInv = (flags & BC_FLAGS_UNIFORM) ? HDRColorA(1.f, 1.f, 1.f, 1.f) : g_LuminanceInv;
+
+        // Snapping to the 5:6:5 grid happens in weighted space
+        const float fToGrid[3] = { WeightInv.r * 31.0f, WeightInv.g * 63.0f, WeightInv.b * 31.0f };
+        const float fFromGrid[3] = { Weight.r * (1.0f / 31.0f), Weight.g * (1.0f / 63.0f), Weight.b * (1.0f / 31.0f) };
+        const float fGridMax[3] = { 31.0f, 63.0f, 31.0f };
+
+        float fBestError = FLT_MAX;
+        bool bImproved = false;
+
+        // Least-squares endpoints for one clustering, given
+        //   fAlpha2 = sum(a*a), fBeta2 = sum(b*b), fAlphaBeta = sum(a*b), AlphaX = sum(a*x)
+        // where a and b = 1 - a are the interpolation weights of X and Y for each color
+        auto TryClustering = [&](float fAlpha2, float fBeta2, float fAlphaBeta, const float *pAlphaX, const float *pTotal) noexcept
+        {
+            const float fDet = fAlpha2 * fBeta2 - fAlphaBeta * fAlphaBeta;
+            if (fDet < FLT_EPSILON)
+                return;
+
+            const float fDetInv = 1.0f / fDet;
+
+            float A[3], B[3];
+            float fError = 0.0f;
+            for (size_t iChannel = 0; iChannel < 3; ++iChannel)
+            {
+                const float fAlphaX = pAlphaX[iChannel];
+                const float fBetaX = pTotal[iChannel] - fAlphaX;
+
+                float fA = (fAlphaX * fBeta2 - fBetaX * fAlphaBeta) * fDetInv * fToGrid[iChannel];
+                float fB = (fBetaX * fAlpha2 - fAlphaX * fAlphaBeta) * fDetInv * fToGrid[iChannel];
+
+                fA = (fA < 0.0f) ? 0.0f : (fA > fGridMax[iChannel]) ? fGridMax[iChannel] : fA;
+                fB = (fB < 0.0f) ? 0.0f : (fB > fGridMax[iChannel]) ? fGridMax[iChannel] : fB;
+
+                A[iChannel] = static_cast<float>(static_cast<int32_t>(fA + 0.5f)) * fFromGrid[iChannel];
+                B[iChannel] = static_cast<float>(static_cast<int32_t>(fB + 0.5f)) * fFromGrid[iChannel];
+
+                // Squared error, less the constant sum of squared colors
+                fError += A[iChannel] * A[iChannel] * fAlpha2 + B[iChannel] * B[iChannel] * fBeta2
+                    + 2.0f * (A[iChannel] * B[iChannel] * fAlphaBeta - A[iChannel] * fAlphaX - B[iChannel] * fBetaX);
+            }
+
+            if (fError < fBestError)
+            {
+                fBestError = fError;
+                pX->r = A[0]; pX->g = A[1]; pX->b = A[2]; pX->a = 1.0f;
+                pY->r = B[0]; pY->g = B[1]; pY->b = B[2]; pY->a = 1.0f;
+                bImproved = true;
+            }
+        };
+
+        uint8_t pOrder[NUM_PIXELS_PER_BLOCK] = {};
+        uint8_t pPrevOrder[NUM_PIXELS_PER_BLOCK] = {};
+
+        for (size_t iIteration = 0; iIteration < 4; iIteration++)
+        {
+            // Sort by projection onto the axis
+            float fDot[NUM_PIXELS_PER_BLOCK];
+            for (size_t iPoint = 0; iPoint < cPoints; iPoint++)
+            {
+                const float f = pPoints[iPoint].r * Axis.r + pPoints[iPoint].g * Axis.g + pPoints[iPoint].b * Axis.b;
+
+                size_t j = iPoint;
+                for (; j > 0 && fDot[j - 1] > f; --j)
+                {
+                    fDot[j] = fDot[j - 1];
+                    pOrder[j] = pOrder[j - 1];
+                }
+
+                fDot[j] = f;
+                pOrder[j] = static_cast<uint8_t>(iPoint);
+            }
+
+            if (iIteration > 0 && !memcmp(pOrder, pPrevOrder, cPoints))
+                break;
+
+            memcpy(pPrevOrder, pOrder, cPoints);
+
+            // Prefix sums of the ordered colors
+            float fSum[NUM_PIXELS_PER_BLOCK + 1][3] = {};
+            for (size_t iPoint = 0; iPoint < cPoints; iPoint++)
+            {
+                const HDRColorA& P = pPoints[pOrder[iPoint]];
+                fSum[iPoint + 1][0] = fSum[iPoint][0] + P.r;
+                fSum[iPoint + 1][1] = fSum[iPoint][1] + P.g;
+                fSum[iPoint + 1][2] = fSum[iPoint][2] + P.b;
+            }
+
+            const float *pTotal = fSum[cPoints];
+
+            bImproved = false;
+
+            // Ordered colors [0, i0) map to X, [i2, cPoints) map to Y, and the ones in between
+            // to the interpolated steps
+            if (3 == cSteps)
+            {
+                for (size_t i0 = 0; i0 <= cPoints; i0++)
+                {
+                    for (size_t i1 = i0; i1 <= cPoints; i1++)
+                    {
+                        const auto n1 = static_cast<float>(i1 - i0);
+
+                        float fAlphaX[3];
+                        for (size_t iChannel = 0; iChannel < 3; ++iChannel)
+                            fAlphaX[iChannel] = (fSum[i0][iChannel] + fSum[i1][iChannel]) * 0.5f;
+
+                        TryClustering(
+                            static_cast<float>(i0) + n1 * 0.25f,
+                            static_cast<float>(cPoints - i1) + n1 * 0.25f,
+                            n1 * 0.25f,
+                            fAlphaX, pTotal);
+                    }
+                }
+            }
+            else
+            {
+                for (size_t i0 = 0; i0 <= cPoints; i0++)
+                {
+                    for (size_t i1 = i0; i1 <= cPoints; i1++)
+                    {
+                        for (size_t i2 = i1; i2 <= cPoints; i2++)
+                        {
+                            const auto n1 = static_cast<float>(i1 - i0);
+                            const auto n2 = static_cast<float>(i2 - i1);
+
+                            float fAlphaX[3];
+                            for (size_t iChannel = 0; iChannel < 3; ++iChannel)
+                                fAlphaX[iChannel] = (fSum[i0][iChannel] + fSum[i1][iChannel] + fSum[i2][iChannel]) * (1.0f / 3.0f);
+
+                            TryClustering(
+                                static_cast<float>(i0) + (n1 * 4.0f + n2) * (1.0f / 9.0f),
+                                static_cast<float>(cPoints - i2) + (n1 + n2 * 4.0f) * (1.0f / 9.0f),
+                                (n1 + n2) * (2.0f / 9.0f),
+                                fAlphaX, pTotal);
+                        }
+                    }
+                }
+            }
+
+            if (!bImproved)
+                break;
+
+            Axis.r = pY->r - pX->r;
+            Axis.g = pY->g - pX->g;
+            Axis.b = pY->b - pX->b;
+
+            if ((Axis.r * Axis.r + Axis.g * Axis.g + Axis.b * Axis.b) < FLT_MIN)
+                break;
+        }
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    inline void DecodeBC1Palette(
+        _Out_writes_(4) XMVECTOR *pPalette,
         _In_ const D3DX_BC1 *pBC,
         bool isbc1) noexcept
     {
-        assert(pColor && pBC);
+        assert(pPalette && pBC);
         static_assert(sizeof(D3DX_BC1) == 8, "D3DX_BC1 should be 8 bytes");
 
         static XMVECTORF32 s_Scale = { { { 1.f / 31.f, 1.f / 63.f, 1.f / 31.f, 1.f } } };
@@ -334,34 +594,48 @@ namespace
         clr0 = XMVectorSwizzle<2, 1, 0, 3>(clr0);
         clr1 = XMVectorSwizzle<2, 1, 0, 3>(clr1);
 
-        clr0 = XMVectorSelect(g_XMIdentityR3, clr0, g_XMSelect1110);
-        clr1 = XMVectorSelect(g_XMIdentityR3, clr1, g_XMSelect1110);
+        pPalette[0] = XMVectorSelect(g_XMIdentityR3, clr0, g_XMSelect1110);
+        pPalette[1] = XMVectorSelect(g_XMIdentityR3, clr1, g_XMSelect1110);
 
-        XMVECTOR clr2, clr3;
         if (isbc1 && (pBC->rgb[0] <= pBC->rgb[1]))
         {
-            clr2 = XMVectorLerp(clr0, clr1, 0.5f);
-            clr3 = XMVectorZero();  // Alpha of 0
+            pPalette[2] = XMVectorLerp(pPalette[0], pPalette[1], 0.5f);
+            pPalette[3] = XMVectorZero();  // Alpha of 0
         }
         else
         {
-            clr2 = XMVectorLerp(clr0, clr1, 1.f / 3.f);
-            clr3 = XMVectorLerp(clr0, clr1, 2.f / 3.f);
+            pPalette[2] = XMVectorLerp(pPalette[0], pPalette[1], 1.f / 3.f);
+            pPalette[3] = XMVectorLerp(pPalette[0], pPalette[1], 2.f / 3.f);
         }
+    }
+
+    inline void DecodeBC1(
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pColor,
+        _In_ const D3DX_BC1 *pBC,
+        bool isbc1) noexcept
+    {
+        assert(pColor && pBC);
+
+        XMVECTOR clr[4];
+        DecodeBC1Palette(clr, pBC, isbc1);
 
         uint32_t dw = pBC->bitmap;
 
         for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i, dw >>= 2)
         {
-            switch (dw & 3)
-            {
-            case 0: pColor[i] = clr0; break;
-            case 1: pColor[i] = clr1; break;
-            case 2: pColor[i] = clr2; break;
+            pColor[i] = clr[dw & 3];
+        }
+    }
 
-            case 3:
-            default: pColor[i] = clr3; break;
-            }
+    inline void DecodeBC1Indices(
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) uint8_t *pIndex,
+        _In_ const D3DX_BC1 *pBC) noexcept
+    {
+        uint32_t dw = pBC->bitmap;
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i, dw >>= 2)
+        {
+            pIndex[i] = static_cast<uint8_t>(dw & 3);
         }
     }
 
@@ -493,7 +767,24 @@ namespace
         // Then quantize and sort the endpoints depending on mode.
         HDRColorA ColorA, ColorB, ColorC, ColorD;
 
-        OptimizeRGB(&ColorA, &ColorB, Color, uSteps, flags);
+        if (flags & BC_FLAGS_CLUSTER_FIT)
+        {
+            // Color-keyed texels are encoded as transparent and do not affect the endpoints
+            HDRColorA Points[NUM_PIXELS_PER_BLOCK];
+            size_t cPoints = 0;
+
+            for (i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+            {
+                if ((4 == uSteps) || !(pColor[i].a < threshold))
+                    Points[cPoints++] = Color[i];
+            }
+
+            ClusterFitRGB(&ColorA, &ColorB, Points, cPoints, uSteps, flags);
+        }
+        else
+        {
+            OptimizeRGB(&ColorA, &ColorB, Color, uSteps, flags);
+        }
 
         if (flags & BC_FLAGS_UNIFORM)
         {
@@ -717,92 +1008,1460 @@ namespace
         pBC->bitmap = 0x00000000;
     }
 #endif // COLOR_WEIGHTS
-}
 
+    //-------------------------------------------------------------------------------------
+    void EncodeBC2Alpha(
+        _Inout_ D3DX_BC2 *pBC2,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const HDRColorA *pColor,
+        uint32_t flags) noexcept
+    {
+        // 4-bit alpha part.  Dithered using Floyd Stienberg error diffusion.
+        pBC2->bitmap[0] = 0;
+        pBC2->bitmap[1] = 0;
 
-//=====================================================================================
-// Entry points
-//=====================================================================================
+        float fError[NUM_PIXELS_PER_BLOCK] = {};
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            float fAlph = pColor[i].a;
+            if (flags & BC_FLAGS_DITHER_A)
+                fAlph += fError[i];
 
-//-------------------------------------------------------------------------------------
-// BC1 Compression
-//-------------------------------------------------------------------------------------
-_Use_decl_annotations_
-void DirectX::D3DXDecodeBC1(XMVECTOR *pColor, const uint8_t *pBC) noexcept
-{
-    auto pBC1 = reinterpret_cast<const D3DX_BC1 *>(pBC);
-    DecodeBC1(pColor, pBC1, true);
-}
+            const auto u = static_cast<uint32_t>(fAlph * 15.0f + 0.5f);
 
-_Use_decl_annotations_
-void DirectX::D3DXEncodeBC1(uint8_t *pBC, const XMVECTOR *pColor, float threshold, uint32_t flags) noexcept
-{
-    assert(pBC && pColor);
+            pBC2->bitmap[i >> 3] >>= 4;
+            pBC2->bitmap[i >> 3] |= (u << 28);
 
-    HDRColorA Color[NUM_PIXELS_PER_BLOCK];
+            if (flags & BC_FLAGS_DITHER_A)
+            {
+                const float fDiff = fAlph - float(u) * (1.0f / 15.0f);
 
-    if (flags & BC_FLAGS_DITHER_A)
+                if (3 != (i & 3))
+                {
+                    assert(i < 15);
+                    _Analysis_assume_(i < 15);
+                    fError[i + 1] += fDiff * (7.0f / 16.0f);
+                }
+
+                if (i < 12)
+                {
+                    if (i & 3)
+                        fError[i + 3] += fDiff * (3.0f / 16.0f);
+
+                    fError[i + 4] += fDiff * (5.0f / 16.0f);
+
+                    if (3 != (i & 3))
+                    {
+                        assert(i < 11);
+                        _Analysis_assume_(i < 11);
+                        fError[i + 5] += fDiff * (1.0f / 16.0f);
+                    }
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    void QuantizeBC3Alpha(
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const HDRColorA *pColor,
+        uint32_t flags,
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) float *fAlpha,
+        _Out_ float& fMinAlpha,
+        _Out_ float& fMaxAlpha) noexcept
     {
+        // Quantize block to A8, using Floyd Stienberg error diffusion.  This
+        // increases the chance that colors will map directly to the quantized
+        // axis endpoints.
         float fError[NUM_PIXELS_PER_BLOCK] = {};
 
+        fMinAlpha = pColor[0].a;
+        fMaxAlpha = pColor[0].a;
+
         for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
         {
-            HDRColorA clr;
-            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&clr), pColor[i]);
-
-            const float fAlph = clr.a + fError[i];
-
-            Color[i].r = clr.r;
-            Color[i].g = clr.g;
-            Color[i].b = clr.b;
-            Color[i].a = static_cast<float>(static_cast<int32_t>(clr.a + fError[i] + 0.5f));
+            float fAlph = pColor[i].a;
+            if (flags & BC_FLAGS_DITHER_A)
+                fAlph += fError[i];
 
-            const float fDiff = fAlph - Color[i].a;
+            fAlpha[i] = static_cast<float>(static_cast<int32_t>(fAlph * 255.0f + 0.5f)) * (1.0f / 255.0f);
 
-            if (3 != (i & 3))
-            {
-                assert(i < 15);
-                _Analysis_assume_(i < 15);
-                fError[i + 1] += fDiff * (7.0f / 16.0f);
-            }
+            if (fAlpha[i] < fMinAlpha)
+                fMinAlpha = fAlpha[i];
+            else if (fAlpha[i] > fMaxAlpha)
+                fMaxAlpha = fAlpha[i];
 
-            if (i < 12)
+            if (flags & BC_FLAGS_DITHER_A)
             {
-                if (i & 3)
-                    fError[i + 3] += fDiff * (3.0f / 16.0f);
-
-                fError[i + 4] += fDiff * (5.0f / 16.0f);
+                const float fDiff = fAlph - fAlpha[i];
 
                 if (3 != (i & 3))
                 {
-                    assert(i < 11);
-                    _Analysis_assume_(i < 11);
-                    fError[i + 5] += fDiff * (1.0f / 16.0f);
+                    assert(i < 15);
+                    _Analysis_assume_(i < 15);
+                    fError[i + 1] += fDiff * (7.0f / 16.0f);
+                }
+
+                if (i < 12)
+                {
+                    if (i & 3)
+                        fError[i + 3] += fDiff * (3.0f / 16.0f);
+
+                    fError[i + 4] += fDiff * (5.0f / 16.0f);
+
+                    if (3 != (i & 3))
+                    {
+                        assert(i < 11);
+                        _Analysis_assume_(i < 11);
+                        fError[i + 5] += fDiff * (1.0f / 16.0f);
+                    }
                 }
             }
         }
     }
-    else
+
+    //-------------------------------------------------------------------------------------
+    void EncodeBC3Alpha(
+        _Inout_ D3DX_BC3 *pBC3,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const HDRColorA *pColor,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const float *fAlpha,
+        float fMinAlpha,
+        float fMaxAlpha,
+        uint32_t flags) noexcept
     {
-        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        if (1.0f == fMinAlpha)
         {
-            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&Color[i]), pColor[i]);
+            pBC3->alpha[0] = 0xff;
+            pBC3->alpha[1] = 0xff;
+            memset(pBC3->bitmap, 0x00, 6);
+            return;
         }
-    }
 
-    auto pBC1 = reinterpret_cast<D3DX_BC1 *>(pBC);
-    EncodeBC1(pBC1, Color, true, threshold, flags);
-}
+        // Optimize and Quantize Min and Max values
+        const uint32_t uSteps = ((0.0f == fMinAlpha) || (1.0f == fMaxAlpha)) ? 6u : 8u;
 
+        float fAlphaA, fAlphaB;
+        OptimizeAlpha<false>(&fAlphaA, &fAlphaB, fAlpha, uSteps);
 
-//-------------------------------------------------------------------------------------
-// BC2 Compression
-//-------------------------------------------------------------------------------------
-_Use_decl_annotations_
-void DirectX::D3DXDecodeBC2(XMVECTOR *pColor, const uint8_t *pBC) noexcept
-{
-    assert(pColor && pBC);
-    static_assert(sizeof(D3DX_BC2) == 16, "D3DX_BC2 should be 16 bytes");
+        const auto bAlphaA = static_cast<uint8_t>(static_cast<int32_t>(fAlphaA * 255.0f + 0.5f));
+        const auto bAlphaB = static_cast<uint8_t>(static_cast<int32_t>(fAlphaB * 255.0f + 0.5f));
+
+        fAlphaA = static_cast<float>(bAlphaA) * (1.0f / 255.0f);
+        fAlphaB = static_cast<float>(bAlphaB) * (1.0f / 255.0f);
+
+        // Setup block
+        if ((8 == uSteps) && (bAlphaA == bAlphaB))
+        {
+            pBC3->alpha[0] = bAlphaA;
+            pBC3->alpha[1] = bAlphaB;
+            memset(pBC3->bitmap, 0x00, 6);
+            return;
+        }
+
+        static const size_t pSteps6[] = { 0, 2, 3, 4, 5, 1 };
+        static const size_t pSteps8[] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+
+        const size_t *pSteps;
+        float fStep[8] = {};
+
+        if (6 == uSteps)
+        {
+            pBC3->alpha[0] = bAlphaA;
+            pBC3->alpha[1] = bAlphaB;
+
+            fStep[0] = fAlphaA;
+            fStep[1] = fAlphaB;
+
+            for (size_t i = 1; i < 5; ++i)
+                fStep[i + 1] = (fStep[0] * float(5u - i) + fStep[1] * float(i)) * (1.0f / 5.0f);
+
+            fStep[6] = 0.0f;
+            fStep[7] = 1.0f;
+
+            pSteps = pSteps6;
+        }
+        else
+        {
+            pBC3->alpha[0] = bAlphaB;
+            pBC3->alpha[1] = bAlphaA;
+
+            fStep[0] = fAlphaB;
+            fStep[1] = fAlphaA;
+
+            for (size_t i = 1; i < 7; ++i)
+                fStep[i + 1] = (fStep[0] * float(7u - i) + fStep[1] * float(i)) * (1.0f / 7.0f);
+
+            pSteps = pSteps8;
+        }
+
+        // Encode alpha bitmap
+        const auto fSteps = static_cast<float>(uSteps - 1);
+        const float fScale = (fStep[0] != fStep[1]) ? (fSteps / (fStep[1] - fStep[0])) : 0.0f;
+
+        float fError[NUM_PIXELS_PER_BLOCK] = {};
+
+        for (size_t iSet = 0; iSet < 2; iSet++)
+        {
+            uint32_t dw = 0;
+
+            const size_t iMin = iSet * 8;
+            const size_t iLim = iMin + 8;
+
+            for (size_t i = iMin; i < iLim; ++i)
+            {
+                float fAlph = pColor[i].a;
+                if (flags & BC_FLAGS_DITHER_A)
+                    fAlph += fError[i];
+                const float fDot = (fAlph - fStep[0]) * fScale;
+
+                uint32_t iStep;
+                if (fDot <= 0.0f)
+                    iStep = ((6 == uSteps) && (fAlph <= fStep[0] * 0.5f)) ? 6u : 0u;
+                else if (fDot >= fSteps)
+                    iStep = ((6 == uSteps) && (fAlph >= (fStep[1] + 1.0f) * 0.5f)) ? 7u : 1u;
+                else
+                    iStep = uint32_t(pSteps[uint32_t(fDot + 0.5f)]);
+
+                dw = (iStep << 21) | (dw >> 3);
+
+                if (flags & BC_FLAGS_DITHER_A)
+                {
+                    const float fDiff = (fAlph - fStep[iStep]);
+
+                    if (3 != (i & 3))
+                        fError[i + 1] += fDiff * (7.0f / 16.0f);
+
+                    if (i < 12)
+                    {
+                        if (i & 3)
+                            fError[i + 3] += fDiff * (3.0f / 16.0f);
+
+                        fError[i + 4] += fDiff * (5.0f / 16.0f);
+
+                        if (3 != (i & 3))
+                            fError[i + 5] += fDiff * (1.0f / 16.0f);
+                    }
+                }
+            }
+
+            pBC3->bitmap[0 + iSet * 3] = reinterpret_cast<uint8_t *>(&dw)[0];
+            pBC3->bitmap[1 + iSet * 3] = reinterpret_cast<uint8_t *>(&dw)[1];
+            pBC3->bitmap[2 + iSet * 3] = reinterpret_cast<uint8_t *>(&dw)[2];
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Batched BC1 color encoder
+    //
+    // Blocks are transposed into structure-of-arrays form so that each XMVECTOR lane
+    // holds the same pixel/channel of a different block. The math below performs the
+    // same IEEE operations in the same order as OptimizeRGB and EncodeBC1 (no fused
+    // multiply-add, no reciprocal estimates), so the output is bit-identical to the
+    // scalar path. Per-lane early-outs become lane masks.
+    //-------------------------------------------------------------------------------------
+    constexpr size_t BC_BATCH_LANES = 4;
+
+    struct BlockSoA
+    {
+        XMVECTOR r[NUM_PIXELS_PER_BLOCK];
+        XMVECTOR g[NUM_PIXELS_PER_BLOCK];
+        XMVECTOR b[NUM_PIXELS_PER_BLOCK];
+        XMVECTOR a[NUM_PIXELS_PER_BLOCK];
+    };
+
+    // Transposes up to four AoS blocks into SoA; missing lanes replicate the last block
+    void LoadBlocksSoA(
+        _Out_ BlockSoA& soa,
+        _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor,
+        size_t count) noexcept
+    {
+        assert(count > 0 && count <= BC_BATCH_LANES);
+
+        const XMVECTOR *pBlock0 = pColor;
+        const XMVECTOR *pBlock1 = pColor + NUM_PIXELS_PER_BLOCK * std::min<size_t>(1, count - 1);
+        const XMVECTOR *pBlock2 = pColor + NUM_PIXELS_PER_BLOCK * std::min<size_t>(2, count - 1);
+        const XMVECTOR *pBlock3 = pColor + NUM_PIXELS_PER_BLOCK * std::min<size_t>(3, count - 1);
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const XMVECTOR t0 = XMVectorMergeXY(pBlock0[i], pBlock2[i]);
+            const XMVECTOR t1 = XMVectorMergeXY(pBlock1[i], pBlock3[i]);
+            const XMVECTOR t2 = XMVectorMergeZW(pBlock0[i], pBlock2[i]);
+            const XMVECTOR t3 = XMVectorMergeZW(pBlock1[i], pBlock3[i]);
+
+            soa.r[i] = XMVectorMergeXY(t0, t1);
+            soa.g[i] = XMVectorMergeZW(t0, t1);
+            soa.b[i] = XMVectorMergeXY(t2, t3);
+            soa.a[i] = XMVectorMergeZW(t2, t3);
+        }
+    }
+
+    inline XMVECTOR XM_CALLCONV SelectStepSoA(
+        FXMVECTOR iStep,
+        _In_reads_(4) const XMVECTOR *pValues) noexcept
+    {
+        XMVECTOR v = XMVectorSelect(pValues[3], pValues[2], XMVectorEqual(iStep, g_XMTwo));
+        v = XMVectorSelect(v, pValues[1], XMVectorEqual(iStep, g_XMOne));
+        return XMVectorSelect(v, pValues[0], XMVectorEqual(iStep, g_XMZero));
+    }
+
+    //-------------------------------------------------------------------------------------
+    void OptimizeRGBSoA(
+        _Out_writes_(3) XMVECTOR *pX,
+        _Out_writes_(3) XMVECTOR *pY,
+        const BlockSoA& points,
+        FXMVECTOR steps3,
+        uint32_t flags) noexcept
+    {
+        static const XMVECTORF32 s_Epsilon = { { { (0.25f / 64.0f) * (0.25f / 64.0f), (0.25f / 64.0f) * (0.25f / 64.0f), (0.25f / 64.0f) * (0.25f / 64.0f), (0.25f / 64.0f) * (0.25f / 64.0f) } } };
+        static const XMVECTORF32 s_TwoColor = { { { 1.0f / 4096.0f, 1.0f / 4096.0f, 1.0f / 4096.0f, 1.0f / 4096.0f } } };
+        static const XMVECTORF32 s_OneEighth = { { { 1.0f / 8.0f, 1.0f / 8.0f, 1.0f / 8.0f, 1.0f / 8.0f } } };
+
+        // Lanes using 3 steps interpolate with pC3/pD3, others with pC4/pD4; 3-step lanes never select index 3
+        XMVECTOR pC[4], pD[4];
+        pC[0] = g_XMOne;
+        pC[1] = XMVectorSelect(XMVectorReplicate(2.0f / 3.0f), g_XMOneHalf, steps3);
+        pC[2] = XMVectorSelect(XMVectorReplicate(1.0f / 3.0f), g_XMZero, steps3);
+        pC[3] = g_XMZero;
+        pD[0] = g_XMZero;
+        pD[1] = XMVectorSelect(XMVectorReplicate(1.0f / 3.0f), g_XMOneHalf, steps3);
+        pD[2] = XMVectorSelect(XMVectorReplicate(2.0f / 3.0f), g_XMOne, steps3);
+        pD[3] = g_XMOne;
+
+        const XMVECTOR fSteps = XMVectorSelect(XMVectorReplicate(3.0f), g_XMTwo, steps3);
+
+        // Find Min and Max points, as starting point
+        XMVECTOR Xr, Xg, Xb;
+        if (flags & BC_FLAGS_UNIFORM)
+        {
+            Xr = Xg = Xb = g_XMOne;
+        }
+        else
+        {
+            Xr = XMVectorReplicate(g_Luminance.r);
+            Xg = XMVectorReplicate(g_Luminance.g);
+            Xb = XMVectorReplicate(g_Luminance.b);
+        }
+
+        XMVECTOR Yr = g_XMZero;
+        XMVECTOR Yg = g_XMZero;
+        XMVECTOR Yb = g_XMZero;
+
+        for (size_t iPoint = 0; iPoint < NUM_PIXELS_PER_BLOCK; iPoint++)
+        {
+            Xr = XMVectorMin(points.r[iPoint], Xr);
+            Xg = XMVectorMin(points.g[iPoint], Xg);
+            Xb = XMVectorMin(points.b[iPoint], Xb);
+
+            Yr = XMVectorMax(points.r[iPoint], Yr);
+            Yg = XMVectorMax(points.g[iPoint], Yg);
+            Yb = XMVectorMax(points.b[iPoint], Yb);
+        }
+
+        // Diagonal axis
+        const XMVECTOR ABr = XMVectorSubtract(Yr, Xr);
+        const XMVECTOR ABg = XMVectorSubtract(Yg, Xg);
+        const XMVECTOR ABb = XMVectorSubtract(Yb, Xb);
+
+        const XMVECTOR fAB = XMVectorAdd(XMVectorAdd(XMVectorMultiply(ABr, ABr), XMVectorMultiply(ABg, ABg)), XMVectorMultiply(ABb, ABb));
+
+        // Single color block.. no need to root-find
+        XMVECTOR done = XMVectorLess(fAB, g_XMFltMin);
+
+        // Try all four axis directions, to determine which diagonal best fits data
+        const XMVECTOR fABInv = XMVectorDivide(g_XMOne, fAB);
+
+        XMVECTOR Dr = XMVectorMultiply(ABr, fABInv);
+        XMVECTOR Dg = XMVectorMultiply(ABg, fABInv);
+        XMVECTOR Db = XMVectorMultiply(ABb, fABInv);
+
+        const XMVECTOR Midr = XMVectorMultiply(XMVectorAdd(Xr, Yr), g_XMOneHalf);
+        const XMVECTOR Midg = XMVectorMultiply(XMVectorAdd(Xg, Yg), g_XMOneHalf);
+        const XMVECTOR Midb = XMVectorMultiply(XMVectorAdd(Xb, Yb), g_XMOneHalf);
+
+        XMVECTOR fDir[4] = { g_XMZero, g_XMZero, g_XMZero, g_XMZero };
+
+        for (size_t iPoint = 0; iPoint < NUM_PIXELS_PER_BLOCK; iPoint++)
+        {
+            const XMVECTOR Ptr = XMVectorMultiply(XMVectorSubtract(points.r[iPoint], Midr), Dr);
+            const XMVECTOR Ptg = XMVectorMultiply(XMVectorSubtract(points.g[iPoint], Midg), Dg);
+            const XMVECTOR Ptb = XMVectorMultiply(XMVectorSubtract(points.b[iPoint], Midb), Db);
+
+            XMVECTOR f = XMVectorAdd(XMVectorAdd(Ptr, Ptg), Ptb);
+            fDir[0] = XMVectorAdd(fDir[0], XMVectorMultiply(f, f));
+
+            f = XMVectorSubtract(XMVectorAdd(Ptr, Ptg), Ptb);
+            fDir[1] = XMVectorAdd(fDir[1], XMVectorMultiply(f, f));
+
+            f = XMVectorAdd(XMVectorSubtract(Ptr, Ptg), Ptb);
+            fDir[2] = XMVectorAdd(fDir[2], XMVectorMultiply(f, f));
+
+            f = XMVectorSubtract(XMVectorSubtract(Ptr, Ptg), Ptb);
+            fDir[3] = XMVectorAdd(fDir[3], XMVectorMultiply(f, f));
+        }
+
+        // Track the two bits of iDirMax as lane masks
+        XMVECTOR fDirMax = fDir[0];
+        XMVECTOR iDirBit0 = XMVectorFalseInt();
+        XMVECTOR iDirBit1 = XMVectorFalseInt();
+
+        for (size_t iDir = 1; iDir < 4; iDir++)
+        {
+            const XMVECTOR greater = XMVectorGreater(fDir[iDir], fDirMax);
+            fDirMax = XMVectorSelect(fDirMax, fDir[iDir], greater);
+            iDirBit0 = XMVectorSelect(iDirBit0, (iDir & 1) ? XMVectorTrueInt() : XMVectorFalseInt(), greater);
+            iDirBit1 = XMVectorSelect(iDirBit1, (iDir & 2) ? XMVectorTrueInt() : XMVectorFalseInt(), greater);
+        }
+
+        iDirBit0 = XMVectorAndCInt(iDirBit0, done);
+        iDirBit1 = XMVectorAndCInt(iDirBit1, done);
+
+        {
+            const XMVECTOR f = Xg;
+            Xg = XMVectorSelect(Xg, Yg, iDirBit1);
+            Yg = XMVectorSelect(Yg, f, iDirBit1);
+        }
+
+        {
+            const XMVECTOR f = Xb;
+            Xb = XMVectorSelect(Xb, Yb, iDirBit0);
+            Yb = XMVectorSelect(Yb, f, iDirBit0);
+        }
+
+        // Two color block, or the caller only wants a range fit.. no need to root-find
+        done = XMVectorOrInt(done, XMVectorLess(fAB, s_TwoColor));
+
+        if (flags & BC_FLAGS_RANGE_FIT)
+            done = XMVectorTrueInt();
+
+        // Use Newton's Method to find local minima of sum-of-squares error.
+        for (size_t iIteration = 0; iIteration < 8; iIteration++)
+        {
+            if (XMComparisonAllTrue(XMVector4EqualIntR(done, XMVectorTrueInt())))
+                break;
+
+            // Calculate new steps
+            XMVECTOR pStepsR[4], pStepsG[4], pStepsB[4];
+
+            for (size_t iStep = 0; iStep < 4; iStep++)
+            {
+                pStepsR[iStep] = XMVectorAdd(XMVectorMultiply(Xr, pC[iStep]), XMVectorMultiply(Yr, pD[iStep]));
+                pStepsG[iStep] = XMVectorAdd(XMVectorMultiply(Xg, pC[iStep]), XMVectorMultiply(Yg, pD[iStep]));
+                pStepsB[iStep] = XMVectorAdd(XMVectorMultiply(Xb, pC[iStep]), XMVectorMultiply(Yb, pD[iStep]));
+            }
+
+            // Calculate color direction
+            Dr = XMVectorSubtract(Yr, Xr);
+            Dg = XMVectorSubtract(Yg, Xg);
+            Db = XMVectorSubtract(Yb, Xb);
+
+            const XMVECTOR fLen = XMVectorAdd(XMVectorAdd(XMVectorMultiply(Dr, Dr), XMVectorMultiply(Dg, Dg)), XMVectorMultiply(Db, Db));
+
+            done = XMVectorOrInt(done, XMVectorLess(fLen, s_TwoColor));
+
+            const XMVECTOR fScale = XMVectorDivide(fSteps, fLen);
+
+            Dr = XMVectorMultiply(Dr, fScale);
+            Dg = XMVectorMultiply(Dg, fScale);
+            Db = XMVectorMultiply(Db, fScale);
+
+            // Evaluate function, and derivatives
+            XMVECTOR d2X = g_XMZero;
+            XMVECTOR d2Y = g_XMZero;
+            XMVECTOR dXr = g_XMZero, dXg = g_XMZero, dXb = g_XMZero;
+            XMVECTOR dYr = g_XMZero, dYg = g_XMZero, dYb = g_XMZero;
+
+            for (size_t iPoint = 0; iPoint < NUM_PIXELS_PER_BLOCK; iPoint++)
+            {
+                const XMVECTOR fDot = XMVectorAdd(XMVectorAdd(
+                    XMVectorMultiply(XMVectorSubtract(points.r[iPoint], Xr), Dr),
+                    XMVectorMultiply(XMVectorSubtract(points.g[iPoint], Xg), Dg)),
+                    XMVectorMultiply(XMVectorSubtract(points.b[iPoint], Xb), Db));
+
+                XMVECTOR iStep = XMVectorTruncate(XMVectorAdd(fDot, g_XMOneHalf));
+                iStep = XMVectorSelect(iStep, fSteps, XMVectorGreaterOrEqual(fDot, fSteps));
+                iStep = XMVectorSelect(iStep, g_XMZero, XMVectorLessOrEqual(fDot, g_XMZero));
+
+                const XMVECTOR fStepC = SelectStepSoA(iStep, pC);
+                const XMVECTOR fStepD = SelectStepSoA(iStep, pD);
+
+                const XMVECTOR Diffr = XMVectorSubtract(SelectStepSoA(iStep, pStepsR), points.r[iPoint]);
+                const XMVECTOR Diffg = XMVectorSubtract(SelectStepSoA(iStep, pStepsG), points.g[iPoint]);
+                const XMVECTOR Diffb = XMVectorSubtract(SelectStepSoA(iStep, pStepsB), points.b[iPoint]);
+
+                const XMVECTOR fC = XMVectorMultiply(fStepC, s_OneEighth);
+                const XMVECTOR fD = XMVectorMultiply(fStepD, s_OneEighth);
+
+                d2X = XMVectorAdd(d2X, XMVectorMultiply(fC, fStepC));
+                dXr = XMVectorAdd(dXr, XMVectorMultiply(fC, Diffr));
+                dXg = XMVectorAdd(dXg, XMVectorMultiply(fC, Diffg));
+                dXb = XMVectorAdd(dXb, XMVectorMultiply(fC, Diffb));
+
+                d2Y = XMVectorAdd(d2Y, XMVectorMultiply(fD, fStepD));
+                dYr = XMVectorAdd(dYr, XMVectorMultiply(fD, Diffr));
+                dYg = XMVectorAdd(dYg, XMVectorMultiply(fD, Diffg));
+                dYb = XMVectorAdd(dYb, XMVectorMultiply(fD, Diffb));
+            }
+
+            // Move endpoints
+            {
+                const XMVECTOR move = XMVectorAndCInt(XMVectorGreater(d2X, g_XMZero), done);
+                const XMVECTOR f = XMVectorDivide(g_XMNegativeOne, d2X);
+
+                Xr = XMVectorSelect(Xr, XMVectorAdd(Xr, XMVectorMultiply(dXr, f)), move);
+                Xg = XMVectorSelect(Xg, XMVectorAdd(Xg, XMVectorMultiply(dXg, f)), move);
+                Xb = XMVectorSelect(Xb, XMVectorAdd(Xb, XMVectorMultiply(dXb, f)), move);
+            }
+
+            {
+                const XMVECTOR move = XMVectorAndCInt(XMVectorGreater(d2Y, g_XMZero), done);
+                const XMVECTOR f = XMVectorDivide(g_XMNegativeOne, d2Y);
+
+                Yr = XMVectorSelect(Yr, XMVectorAdd(Yr, XMVectorMultiply(dYr, f)), move);
+                Yg = XMVectorSelect(Yg, XMVectorAdd(Yg, XMVectorMultiply(dYg, f)), move);
+                Yb = XMVectorSelect(Yb, XMVectorAdd(Yb, XMVectorMultiply(dYb, f)), move);
+            }
+
+            XMVECTOR converged = XMVectorLess(XMVectorMultiply(dXr, dXr), s_Epsilon);
+            converged = XMVectorAndInt(converged, XMVectorLess(XMVectorMultiply(dXg, dXg), s_Epsilon));
+            converged = XMVectorAndInt(converged, XMVectorLess(XMVectorMultiply(dXb, dXb), s_Epsilon));
+            converged = XMVectorAndInt(converged, XMVectorLess(XMVectorMultiply(dYr, dYr), s_Epsilon));
+            converged = XMVectorAndInt(converged, XMVectorLess(XMVectorMultiply(dYg, dYg), s_Epsilon));
+            converged = XMVectorAndInt(converged, XMVectorLess(XMVectorMultiply(dYb, dYb), s_Epsilon));
+
+            done = XMVectorOrInt(done, converged);
+        }
+
+        pX[0] = Xr; pX[1] = Xg; pX[2] = Xb;
+        pY[0] = Yr; pY[1] = Yg; pY[2] = Yb;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Encodes the RGB part of up to four blocks; ppBC entries past count are ignored
+    void EncodeBC1SoA(
+        _Out_writes_(count) D3DX_BC1 **ppBC,
+        size_t count,
+        const BlockSoA& color,
+        bool bColorKey,
+        float threshold,
+        uint32_t flags) noexcept
+    {
+        assert(ppBC && count > 0 && count <= BC_BATCH_LANES);
+        assert(!(flags & BC_FLAGS_DITHER_RGB));
+
+        static const XMVECTORF32 s_Scale565 = { { { 31.0f, 63.0f, 31.0f, 0.0f } } };
+
+        const bool uniform = (flags & BC_FLAGS_UNIFORM) != 0;
+
+        // Determine which blocks need to colorkey
+        XMVECTOR anyKey = XMVectorFalseInt();
+        XMVECTOR allKey = XMVectorTrueInt();
+
+        if (bColorKey)
+        {
+            const XMVECTOR vThreshold = XMVectorReplicate(threshold);
+            for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+            {
+                const XMVECTOR key = XMVectorLess(color.a[i], vThreshold);
+                anyKey = XMVectorOrInt(anyKey, key);
+                allKey = XMVectorAndInt(allKey, key);
+            }
+        }
+        else
+        {
+            allKey = XMVectorFalseInt();
+        }
+
+        const XMVECTOR steps3 = anyKey;
+
+        // Quantize block to R5G6B5
+        BlockSoA quant;
+        {
+            const XMVECTOR scaleR = XMVectorSplatX(s_Scale565);
+            const XMVECTOR scaleG = XMVectorSplatY(s_Scale565);
+            const XMVECTOR invScaleR = XMVectorReplicate(1.0f / 31.0f);
+            const XMVECTOR invScaleG = XMVectorReplicate(1.0f / 63.0f);
+
+            for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+            {
+                quant.r[i] = XMVectorMultiply(XMVectorTruncate(XMVectorAdd(XMVectorMultiply(color.r[i], scaleR), g_XMOneHalf)), invScaleR);
+                quant.g[i] = XMVectorMultiply(XMVectorTruncate(XMVectorAdd(XMVectorMultiply(color.g[i], scaleG), g_XMOneHalf)), invScaleG);
+                quant.b[i] = XMVectorMultiply(XMVectorTruncate(XMVectorAdd(XMVectorMultiply(color.b[i], scaleR), g_XMOneHalf)), invScaleR);
+                quant.a[i] = g_XMOne;
+
+                if (!uniform)
+                {
+                    quant.r[i] = XMVectorMultiply(quant.r[i], XMVectorReplicate(g_Luminance.r));
+                    quant.g[i] = XMVectorMultiply(quant.g[i], XMVectorReplicate(g_Luminance.g));
+                    quant.b[i] = XMVectorMultiply(quant.b[i], XMVectorReplicate(g_Luminance.b));
+                }
+            }
+        }
+
+        // Perform 6D root finding function to find two endpoints of color axis.
+        XMVECTOR vA[3], vB[3];
+        OptimizeRGBSoA(vA, vB, quant, steps3, flags);
+
+        XM_ALIGNED_DATA(16) float fA[3][BC_BATCH_LANES];
+        XM_ALIGNED_DATA(16) float fB[3][BC_BATCH_LANES];
+        XM_ALIGNED_DATA(16) uint32_t uSteps3[BC_BATCH_LANES];
+        XM_ALIGNED_DATA(16) uint32_t uAllKey[BC_BATCH_LANES];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(fA[j]), vA[j]);
+            XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(fB[j]), vB[j]);
+        }
+        XMStoreInt4(uSteps3, steps3);
+        XMStoreInt4(uAllKey, allKey);
+
+        // Quantize and sort the endpoints depending on mode, one lane at a time
+        XM_ALIGNED_DATA(16) float fStep[4][3][BC_BATCH_LANES] = {};
+        XM_ALIGNED_DATA(16) float fDir[3][BC_BATCH_LANES] = {};
+        bool encodeIndices[BC_BATCH_LANES] = {};
+
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            D3DX_BC1 *pBC = ppBC[lane];
+
+            if (uAllKey[lane])
+            {
+                pBC->rgb[0] = 0x0000;
+                pBC->rgb[1] = 0xffff;
+                pBC->bitmap = 0xffffffff;
+                continue;
+            }
+
+            const uint32_t uSteps = (uSteps3[lane]) ? 3u : 4u;
+
+            HDRColorA ColorA(fA[0][lane], fA[1][lane], fA[2][lane], 1.0f);
+            HDRColorA ColorB(fB[0][lane], fB[1][lane], fB[2][lane], 1.0f);
+            HDRColorA ColorC, ColorD;
+
+            if (uniform)
+            {
+                ColorC = ColorA;
+                ColorD = ColorB;
+            }
+            else
+            {
+                ColorC.r = ColorA.r * g_LuminanceInv.r;
+                ColorC.g = ColorA.g * g_LuminanceInv.g;
+                ColorC.b = ColorA.b * g_LuminanceInv.b;
+                ColorC.a = ColorA.a;
+
+                ColorD.r = ColorB.r * g_LuminanceInv.r;
+                ColorD.g = ColorB.g * g_LuminanceInv.g;
+                ColorD.b = ColorB.b * g_LuminanceInv.b;
+                ColorD.a = ColorB.a;
+            }
+
+            const uint16_t wColorA = Encode565(&ColorC);
+            const uint16_t wColorB = Encode565(&ColorD);
+
+            if ((uSteps == 4) && (wColorA == wColorB))
+            {
+                pBC->rgb[0] = wColorA;
+                pBC->rgb[1] = wColorB;
+                pBC->bitmap = 0x00000000;
+                continue;
+            }
+
+            Decode565(&ColorC, wColorA);
+            Decode565(&ColorD, wColorB);
+
+            if (uniform)
+            {
+                ColorA = ColorC;
+                ColorB = ColorD;
+            }
+            else
+            {
+                ColorA.r = ColorC.r * g_Luminance.r;
+                ColorA.g = ColorC.g * g_Luminance.g;
+                ColorA.b = ColorC.b * g_Luminance.b;
+
+                ColorB.r = ColorD.r * g_Luminance.r;
+                ColorB.g = ColorD.g * g_Luminance.g;
+                ColorB.b = ColorD.b * g_Luminance.b;
+            }
+
+            // Calculate color steps
+            HDRColorA Step[4];
+
+            if ((3 == uSteps) == (wColorA <= wColorB))
+            {
+                pBC->rgb[0] = wColorA;
+                pBC->rgb[1] = wColorB;
+
+                Step[0] = ColorA;
+                Step[1] = ColorB;
+            }
+            else
+            {
+                pBC->rgb[0] = wColorB;
+                pBC->rgb[1] = wColorA;
+
+                Step[0] = ColorB;
+                Step[1] = ColorA;
+            }
+
+            if (3 == uSteps)
+            {
+                HDRColorALerp(&Step[2], &Step[0], &Step[1], 0.5f);
+                Step[3] = Step[2];
+            }
+            else
+            {
+                HDRColorALerp(&Step[2], &Step[0], &Step[1], 1.0f / 3.0f);
+                HDRColorALerp(&Step[3], &Step[0], &Step[1], 2.0f / 3.0f);
+            }
+
+            // Calculate color direction
+            HDRColorA Dir;
+            Dir.r = Step[1].r - Step[0].r;
+            Dir.g = Step[1].g - Step[0].g;
+            Dir.b = Step[1].b - Step[0].b;
+
+            const auto fSteps = static_cast<float>(uSteps - 1);
+            const float fScale = (wColorA != wColorB) ? (fSteps / (Dir.r * Dir.r + Dir.g * Dir.g + Dir.b * Dir.b)) : 0.0f;
+
+            fDir[0][lane] = Dir.r * fScale;
+            fDir[1][lane] = Dir.g * fScale;
+            fDir[2][lane] = Dir.b * fScale;
+
+            for (size_t iStep = 0; iStep < 4; ++iStep)
+            {
+                fStep[iStep][0][lane] = Step[iStep].r;
+                fStep[iStep][1][lane] = Step[iStep].g;
+                fStep[iStep][2][lane] = Step[iStep].b;
+            }
+
+            encodeIndices[lane] = true;
+        }
+
+        // Encode colors
+        const XMVECTOR Step0r = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fStep[0][0]));
+        const XMVECTOR Step0g = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fStep[0][1]));
+        const XMVECTOR Step0b = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fStep[0][2]));
+        const XMVECTOR Dirr = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fDir[0]));
+        const XMVECTOR Dirg = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fDir[1]));
+        const XMVECTOR Dirb = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fDir[2]));
+        const XMVECTOR fSteps = XMVectorSelect(XMVectorReplicate(3.0f), g_XMTwo, steps3);
+        const XMVECTOR vThreshold = XMVectorReplicate(threshold);
+
+        // Index codes are accumulated as exact float sums of code * 4^i, eight pixels per half
+        XMVECTOR bitmapLo = g_XMZero;
+        XMVECTOR bitmapHi = g_XMZero;
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            XMVECTOR Clrr = color.r[i];
+            XMVECTOR Clrg = color.g[i];
+            XMVECTOR Clrb = color.b[i];
+            if (!uniform)
+            {
+                Clrr = XMVectorMultiply(Clrr, XMVectorReplicate(g_Luminance.r));
+                Clrg = XMVectorMultiply(Clrg, XMVectorReplicate(g_Luminance.g));
+                Clrb = XMVectorMultiply(Clrb, XMVectorReplicate(g_Luminance.b));
+            }
+
+            const XMVECTOR fDot = XMVectorAdd(XMVectorAdd(
+                XMVectorMultiply(XMVectorSubtract(Clrr, Step0r), Dirr),
+                XMVectorMultiply(XMVectorSubtract(Clrg, Step0g), Dirg)),
+                XMVectorMultiply(XMVectorSubtract(Clrb, Step0b), Dirb));
+
+            // Map the rounded step along the axis to the BC1 index order (pSteps3/pSteps4)
+            const XMVECTOR iRound = XMVectorTruncate(XMVectorAdd(fDot, g_XMOneHalf));
+            XMVECTOR iStep = XMVectorAdd(iRound, g_XMOne);
+            iStep = XMVectorSelect(iStep, g_XMOne, XMVectorEqual(iRound, fSteps));
+            iStep = XMVectorSelect(iStep, g_XMZero, XMVectorEqual(iRound, g_XMZero));
+            iStep = XMVectorSelect(iStep, g_XMOne, XMVectorGreaterOrEqual(fDot, fSteps));
+            iStep = XMVectorSelect(iStep, g_XMZero, XMVectorLessOrEqual(fDot, g_XMZero));
+            iStep = XMVectorSelect(iStep, XMVectorReplicate(3.0f), XMVectorAndInt(steps3, XMVectorLess(color.a[i], vThreshold)));
+
+            const XMVECTOR weight = XMVectorReplicate(static_cast<float>(1u << (2 * (i & 7))));
+            if (i < 8)
+                bitmapLo = XMVectorAdd(bitmapLo, XMVectorMultiply(iStep, weight));
+            else
+                bitmapHi = XMVectorAdd(bitmapHi, XMVectorMultiply(iStep, weight));
+        }
+
+        XM_ALIGNED_DATA(16) uint32_t dwLo[BC_BATCH_LANES];
+        XM_ALIGNED_DATA(16) uint32_t dwHi[BC_BATCH_LANES];
+        XMStoreInt4(dwLo, XMConvertVectorFloatToUInt(bitmapLo, 0));
+        XMStoreInt4(dwHi, XMConvertVectorFloatToUInt(bitmapHi, 0));
+
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            if (encodeIndices[lane])
+            {
+                ppBC[lane]->bitmap = dwLo[lane] | (dwHi[lane] << 16);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    // 8-bit integer BC1/BC3 encoder
+    //
+    // Used with BC_FLAGS_INTEGER_FIT for 8-bit UNORM sources, where expanding every pixel to
+    // float and running the Newton solver in OptimizeRGB is not worth the cost. Endpoints come from a range fit
+    // along the (perceptually weighted) principal axis, followed by a least-squares
+    // refinement of the endpoints for the chosen indices.
+    //-------------------------------------------------------------------------------------
+
+    // Perceptual weightings for squared error in 1/1024ths. The float encoder scales colors by
+    // g_Luminance before measuring, so its effective weights are the squares of g_Luminance.
+    const int32_t g_Luminance8[3] = {
+        static_cast<int32_t>(g_Luminance.r * g_Luminance.r * 1024.f + 0.5f),
+        static_cast<int32_t>(g_Luminance.g * g_Luminance.g * 1024.f + 0.5f),
+        static_cast<int32_t>(g_Luminance.b * g_Luminance.b * 1024.f + 0.5f) };
+    const int32_t g_Uniform8[3] = { 1, 1, 1 };
+
+    struct RGBA8Block
+    {
+        int32_t c[NUM_PIXELS_PER_BLOCK][3];
+        int32_t a[NUM_PIXELS_PER_BLOCK];
+    };
+
+    void UnpackRGBA8(
+        _Out_ RGBA8Block& block,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const uint32_t *pColor) noexcept
+    {
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const uint32_t t = pColor[i];
+            block.c[i][0] = static_cast<int32_t>(t & 0xff);
+            block.c[i][1] = static_cast<int32_t>((t >> 8) & 0xff);
+            block.c[i][2] = static_cast<int32_t>((t >> 16) & 0xff);
+            block.a[i] = static_cast<int32_t>(t >> 24);
+        }
+    }
+
+    inline uint16_t Encode565(_In_reads_(3) const int32_t *pColor) noexcept
+    {
+        const int32_t r = std::min<int32_t>(255, std::max<int32_t>(0, pColor[0]));
+        const int32_t g = std::min<int32_t>(255, std::max<int32_t>(0, pColor[1]));
+        const int32_t b = std::min<int32_t>(255, std::max<int32_t>(0, pColor[2]));
+
+        return static_cast<uint16_t>(
+            (((r * 31 + 127) / 255) << 11)
+            | (((g * 63 + 127) / 255) << 5)
+            | ((b * 31 + 127) / 255));
+    }
+
+    inline void Decode565(_Out_writes_(3) int32_t *pColor, uint16_t w565) noexcept
+    {
+        const int32_t r = (w565 >> 11) & 31;
+        const int32_t g = (w565 >> 5) & 63;
+        const int32_t b = w565 & 31;
+
+        pColor[0] = (r << 3) | (r >> 2);
+        pColor[1] = (g << 2) | (g >> 4);
+        pColor[2] = (b << 3) | (b >> 2);
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Picks the two pixels at the extremes of the principal axis
+    void RangeFitRGB8(
+        _Out_writes_(3) int32_t *pMax,
+        _Out_writes_(3) int32_t *pMin,
+        const RGBA8Block& block,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const bool *pUse,
+        _In_reads_(3) const int32_t *pWeights) noexcept
+    {
+        int32_t sum[3] = {};
+        int32_t n = 0;
+        size_t first = 0;
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            if (!pUse[i])
+                continue;
+
+            if (!n)
+                first = i;
+
+            sum[0] += block.c[i][0];
+            sum[1] += block.c[i][1];
+            sum[2] += block.c[i][2];
+            ++n;
+        }
+
+        memcpy(pMax, block.c[first], sizeof(int32_t) * 3);
+        memcpy(pMin, block.c[first], sizeof(int32_t) * 3);
+
+        if (n < 2)
+            return;
+
+        // Covariance of (n * c - sum), which keeps everything in integers
+        int32_t cov[6] = {};
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            if (!pUse[i])
+                continue;
+
+            const int32_t r = block.c[i][0] * n - sum[0];
+            const int32_t g = block.c[i][1] * n - sum[1];
+            const int32_t b = block.c[i][2] * n - sum[2];
+
+            cov[0] += r * r;
+            cov[1] += r * g;
+            cov[2] += r * b;
+            cov[3] += g * g;
+            cov[4] += g * b;
+            cov[5] += b * b;
+        }
+
+        // Power iteration in the weighted space for the principal axis
+        const float w[3] = {
+            sqrtf(static_cast<float>(pWeights[0])),
+            sqrtf(static_cast<float>(pWeights[1])),
+            sqrtf(static_cast<float>(pWeights[2])) };
+
+        const float m00 = float(cov[0]) * w[0] * w[0];
+        const float m01 = float(cov[1]) * w[0] * w[1];
+        const float m02 = float(cov[2]) * w[0] * w[2];
+        const float m11 = float(cov[3]) * w[1] * w[1];
+        const float m12 = float(cov[4]) * w[1] * w[2];
+        const float m22 = float(cov[5]) * w[2] * w[2];
+
+        // Start from the row of the channel with the largest variance
+        float vr, vg, vb;
+        if (m00 >= m11 && m00 >= m22)
+        {
+            vr = m00; vg = m01; vb = m02;
+        }
+        else if (m11 >= m22)
+        {
+            vr = m01; vg = m11; vb = m12;
+        }
+        else
+        {
+            vr = m02; vg = m12; vb = m22;
+        }
+
+        for (size_t iter = 0; iter < 3; ++iter)
+        {
+            const float r = vr * m00 + vg * m01 + vb * m02;
+            const float g = vr * m01 + vg * m11 + vb * m12;
+            const float b = vr * m02 + vg * m12 + vb * m22;
+
+            const float fMax = std::max(fabsf(r), std::max(fabsf(g), fabsf(b)));
+            if (fMax < FLT_MIN)
+                break;
+
+            const float fInv = 1.f / fMax;
+            vr = r * fInv;
+            vg = g * fInv;
+            vb = b * fInv;
+        }
+
+        // Project back into color space as an integer axis
+        const auto ar = static_cast<int32_t>(vr * w[0] * 256.f);
+        const auto ag = static_cast<int32_t>(vg * w[1] * 256.f);
+        const auto ab = static_cast<int32_t>(vb * w[2] * 256.f);
+
+        int32_t dotMin = INT32_MAX;
+        int32_t dotMax = INT32_MIN;
+        size_t iMin = first;
+        size_t iMax = first;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            if (!pUse[i])
+                continue;
+
+            const int32_t dot = block.c[i][0] * ar + block.c[i][1] * ag + block.c[i][2] * ab;
+
+            const bool less = (dot < dotMin);
+            dotMin = less ? dot : dotMin;
+            iMin = less ? i : iMin;
+
+            const bool greater = (dot > dotMax);
+            dotMax = greater ? dot : dotMax;
+            iMax = greater ? i : iMax;
+        }
+
+        memcpy(pMin, block.c[iMin], sizeof(int32_t) * 3);
+        memcpy(pMax, block.c[iMax], sizeof(int32_t) * 3);
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Assigns indices for the given endpoints, returning the weighted squared error
+    uint32_t FitIndicesRGB8(
+        _Out_ uint32_t& bitmap,
+        uint16_t w0,
+        uint16_t w1,
+        const RGBA8Block& block,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const bool *pUse,
+        _In_reads_(3) const int32_t *pWeights) noexcept
+    {
+        int32_t pal[4][3];
+        Decode565(pal[0], w0);
+        Decode565(pal[1], w1);
+
+        size_t nColors;
+        if (w0 > w1)
+        {
+            nColors = 4;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                pal[2][j] = (2 * pal[0][j] + pal[1][j] + 1) / 3;
+                pal[3][j] = (pal[0][j] + 2 * pal[1][j] + 1) / 3;
+            }
+        }
+        else
+        {
+            nColors = 3;
+            for (size_t j = 0; j < 3; ++j)
+            {
+                pal[2][j] = (pal[0][j] + pal[1][j] + 1) >> 1;
+                pal[3][j] = 0;
+            }
+        }
+
+        // Palette entries in order along the line from color0 to color1
+        static const uint32_t s_Order4[4] = { 0, 2, 3, 1 };
+        static const uint32_t s_Order3[4] = { 0, 2, 1, 1 };
+        const uint32_t *pOrder = (nColors == 4) ? s_Order4 : s_Order3;
+
+        // Pick indices by projecting onto the (weighted) endpoint axis and comparing against
+        // the midpoints between successive palette entries
+        const int32_t dir[3] = {
+            (pal[1][0] - pal[0][0]) * pWeights[0],
+            (pal[1][1] - pal[0][1]) * pWeights[1],
+            (pal[1][2] - pal[0][2]) * pWeights[2] };
+
+        int32_t dots[4];
+        for (size_t k = 0; k < nColors; ++k)
+        {
+            const uint32_t j = pOrder[k];
+            dots[k] = pal[j][0] * dir[0] + pal[j][1] * dir[1] + pal[j][2] * dir[2];
+        }
+
+        const int32_t mid0 = dots[0] + dots[1];
+        const int32_t mid1 = dots[1] + dots[2];
+        const int32_t mid2 = (nColors == 4) ? (dots[2] + dots[3]) : INT32_MAX;
+
+        uint32_t error = 0;
+        uint32_t dw = 0;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            uint32_t index = 3;
+            if (pUse[i])
+            {
+                const int32_t dot = 2 * (block.c[i][0] * dir[0] + block.c[i][1] * dir[1] + block.c[i][2] * dir[2]);
+                const uint32_t step = uint32_t(dot >= mid0) + uint32_t(dot >= mid1) + uint32_t(dot >= mid2);
+                index = pOrder[step];
+
+                const int32_t dr = block.c[i][0] - pal[index][0];
+                const int32_t dg = block.c[i][1] - pal[index][1];
+                const int32_t db = block.c[i][2] - pal[index][2];
+                error += static_cast<uint32_t>(dr * dr * pWeights[0] + dg * dg * pWeights[1] + db * db * pWeights[2]);
+            }
+
+            dw |= index << (2 * i);
+        }
+
+        bitmap = dw;
+        return error;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Least-squares endpoints for the given indices; returns false if the system is singular
+    bool RefineEndpointsRGB8(
+        _Out_writes_(3) int32_t *pColor0,
+        _Out_writes_(3) int32_t *pColor1,
+        uint32_t bitmap,
+        bool fourColor,
+        const RGBA8Block& block,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const bool *pUse) noexcept
+    {
+        // Interpolation weights (in thirds or halves) of color0/color1 for each index
+        static const int32_t s_Weights4[4][2] = { { 3, 0 }, { 0, 3 }, { 2, 1 }, { 1, 2 } };
+        static const int32_t s_Weights3[4][2] = { { 2, 0 }, { 0, 2 }, { 1, 1 }, { 0, 0 } };
+
+        const int32_t (*pW)[2] = fourColor ? s_Weights4 : s_Weights3;
+        const int32_t scale = fourColor ? 3 : 2;
+
+        int32_t aa = 0, bb = 0, ab = 0;
+        int32_t ax[3] = {}, bx[3] = {};
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i, bitmap >>= 2)
+        {
+            if (!pUse[i])
+                continue;
+
+            const int32_t alpha = pW[bitmap & 3][0];
+            const int32_t beta = pW[bitmap & 3][1];
+
+            aa += alpha * alpha;
+            bb += beta * beta;
+            ab += alpha * beta;
+
+            for (size_t j = 0; j < 3; ++j)
+            {
+                ax[j] += alpha * block.c[i][j];
+                bx[j] += beta * block.c[i][j];
+            }
+        }
+
+        const int32_t det = aa * bb - ab * ab;
+        if (!det)
+            return false;
+
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const int32_t c0 = scale * (ax[j] * bb - bx[j] * ab);
+            const int32_t c1 = scale * (bx[j] * aa - ax[j] * ab);
+
+            // Round to nearest; det is always positive
+            pColor0[j] = (c0 >= 0) ? (c0 + det / 2) / det : -((-c0 + det / 2) / det);
+            pColor1[j] = (c1 >= 0) ? (c1 + det / 2) / det : -((-c1 + det / 2) / det);
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    void EncodeBC1RGB8(
+        _Out_ D3DX_BC1 *pBC,
+        const RGBA8Block& block,
+        bool bColorKey,
+        float threshold,
+        uint32_t flags) noexcept
+    {
+        assert(pBC);
+
+        const int32_t *pWeights = (flags & BC_FLAGS_UNIFORM) ? g_Uniform8 : g_Luminance8;
+
+        // Determine if we need to colorkey this block
+        bool use[NUM_PIXELS_PER_BLOCK];
+        size_t uColorKey = 0;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            use[i] = !bColorKey || (static_cast<float>(block.a[i]) * (1.0f / 255.0f) >= threshold);
+            if (!use[i])
+                ++uColorKey;
+        }
+
+        if (NUM_PIXELS_PER_BLOCK == uColorKey)
+        {
+            pBC->rgb[0] = 0x0000;
+            pBC->rgb[1] = 0xffff;
+            pBC->bitmap = 0xffffffff;
+            return;
+        }
+
+        const bool fourColor = (uColorKey == 0);
+
+        int32_t cMax[3], cMin[3];
+        RangeFitRGB8(cMax, cMin, block, use, pWeights);
+
+        uint16_t w0 = Encode565(cMax);
+        uint16_t w1 = Encode565(cMin);
+
+        if (fourColor && (w0 == w1))
+        {
+            pBC->rgb[0] = w0;
+            pBC->rgb[1] = w1;
+            pBC->bitmap = 0x00000000;
+            return;
+        }
+
+        // 4 color blocks need color0 > color1, 3 color blocks need color0 <= color1
+        if (fourColor == (w0 < w1))
+            std::swap(w0, w1);
+
+        uint32_t bitmap;
+        uint32_t error = FitIndicesRGB8(bitmap, w0, w1, block, use, pWeights);
+
+        if ((error > 0) && !(flags & BC_FLAGS_RANGE_FIT))
+        {
+            int32_t c0[3], c1[3];
+            if (RefineEndpointsRGB8(c0, c1, bitmap, fourColor, block, use))
+            {
+                uint16_t r0 = Encode565(c0);
+                uint16_t r1 = Encode565(c1);
+
+                if (fourColor == (r0 < r1))
+                    std::swap(r0, r1);
+
+                if (!fourColor || (r0 != r1))
+                {
+                    uint32_t rbitmap;
+                    const uint32_t rerror = FitIndicesRGB8(rbitmap, r0, r1, block, use, pWeights);
+                    if (rerror < error)
+                    {
+                        w0 = r0;
+                        w1 = r1;
+                        bitmap = rbitmap;
+                    }
+                }
+            }
+        }
+
+        pBC->rgb[0] = w0;
+        pBC->rgb[1] = w1;
+        pBC->bitmap = bitmap;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Assigns BC3 alpha indices for the given endpoints, returning the squared error (in 1/35ths)
+    uint32_t FitIndicesAlpha8(
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) uint8_t *pIndices,
+        int32_t a0,
+        int32_t a1,
+        const RGBA8Block& block) noexcept
+    {
+        // Interpolated values are kept scaled by the denominator (7 or 5) to stay exact, and
+        // walked in order from the smaller to the larger endpoint
+        static const uint8_t s_Order8[8] = { 1, 7, 6, 5, 4, 3, 2, 0 };
+        static const uint8_t s_Order6[6] = { 0, 2, 3, 4, 5, 1 };
+
+        const bool eightAlpha = (a0 > a1);
+        const int32_t denom = eightAlpha ? 7 : 5;
+        const int32_t scale = eightAlpha ? 5 : 7;
+        const int32_t lo = eightAlpha ? a1 : a0;
+        const int32_t hi = eightAlpha ? a0 : a1;
+        const uint8_t *pOrder = eightAlpha ? s_Order8 : s_Order6;
+
+        // Midpoints (doubled) between successive interpolated values
+        int32_t mids[7];
+        for (int32_t k = 0; k < denom; ++k)
+        {
+            mids[k] = lo * (2 * denom - 2 * k - 1) + hi * (2 * k + 1);
+        }
+
+        uint32_t error = 0;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const int32_t a = block.a[i] * denom;
+
+            int32_t pos = 0;
+            for (int32_t k = 0; k < denom; ++k)
+                pos += (2 * a >= mids[k]) ? 1 : 0;
+
+            uint8_t index = pOrder[pos];
+            int32_t best = abs(a - (lo * (denom - pos) + hi * pos));
+
+            if (!eightAlpha)
+            {
+                // 6 alpha mode also has explicit 0 and 255
+                const int32_t d0 = a;
+                const int32_t d1 = 255 * 5 - a;
+                if (d0 < best)
+                {
+                    best = d0;
+                    index = 6;
+                }
+                if (d1 < best)
+                {
+                    best = d1;
+                    index = 7;
+                }
+            }
+
+            pIndices[i] = index;
+            best *= scale;
+            error += static_cast<uint32_t>(best * best);
+        }
+
+        return error;
+    }
+
+    void EncodeBC3Alpha8(
+        _Out_ D3DX_BC3 *pBC3,
+        const RGBA8Block& block) noexcept
+    {
+        int32_t aMin = 255, aMax = 0;
+        int32_t aInnerMin = 255, aInnerMax = 0;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const int32_t a = block.a[i];
+            aMin = std::min(aMin, a);
+            aMax = std::max(aMax, a);
+
+            if (a != 0 && a != 255)
+            {
+                aInnerMin = std::min(aInnerMin, a);
+                aInnerMax = std::max(aInnerMax, a);
+            }
+        }
+
+        if (aMin == aMax)
+        {
+            pBC3->alpha[0] = static_cast<uint8_t>(aMin);
+            pBC3->alpha[1] = static_cast<uint8_t>(aMin);
+            memset(pBC3->bitmap, 0x00, 6);
+            return;
+        }
+
+        // 8 interpolated values between the extremes
+        uint8_t indices[NUM_PIXELS_PER_BLOCK];
+        int32_t a0 = aMax;
+        int32_t a1 = aMin;
+        const uint32_t error = FitIndicesAlpha8(indices, a0, a1, block);
+
+        // 6 interpolated values between the inner extremes, plus explicit 0 and 255
+        if ((aMin == 0 || aMax == 255) && error > 0)
+        {
+            if (aInnerMin > aInnerMax)
+            {
+                aInnerMin = aInnerMax = 0;
+            }
+
+            uint8_t indices6[NUM_PIXELS_PER_BLOCK];
+            const uint32_t error6 = FitIndicesAlpha8(indices6, aInnerMin, aInnerMax, block);
+            if (error6 < error)
+            {
+                a0 = aInnerMin;
+                a1 = aInnerMax;
+                memcpy(indices, indices6, sizeof(indices));
+            }
+        }
+
+        pBC3->alpha[0] = static_cast<uint8_t>(a0);
+        pBC3->alpha[1] = static_cast<uint8_t>(a1);
+
+        for (size_t iSet = 0; iSet < 2; ++iSet)
+        {
+            uint32_t dw = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                dw |= uint32_t(indices[iSet * 8 + i]) << (3 * i);
+            }
+
+            pBC3->bitmap[0 + iSet * 3] = static_cast<uint8_t>(dw);
+            pBC3->bitmap[1 + iSet * 3] = static_cast<uint8_t>(dw >> 8);
+            pBC3->bitmap[2 + iSet * 3] = static_cast<uint8_t>(dw >> 16);
+        }
+    }
+}
+
+
+//=====================================================================================
+// Entry points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// BC1 Compression
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC1(XMVECTOR *pColor, const uint8_t *pBC) noexcept
+{
+    auto pBC1 = reinterpret_cast<const D3DX_BC1 *>(pBC);
+    DecodeBC1(pColor, pBC1, true);
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC1Palette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+
+    auto pBC1 = reinterpret_cast<const D3DX_BC1 *>(pBC);
+    DecodeBC1Palette(pBlock->color, pBC1, true);
+    DecodeBC1Indices(pBlock->colorIndex, pBC1);
+    pBlock->colorCount = 4;
+    pBlock->channelCount = 0;
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC1(uint8_t *pBC, const XMVECTOR *pColor, float threshold, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+
+    HDRColorA Color[NUM_PIXELS_PER_BLOCK];
+
+    if (flags & BC_FLAGS_DITHER_A)
+    {
+        float fError[NUM_PIXELS_PER_BLOCK] = {};
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            HDRColorA clr;
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&clr), pColor[i]);
+
+            const float fAlph = clr.a + fError[i];
+
+            Color[i].r = clr.r;
+            Color[i].g = clr.g;
+            Color[i].b = clr.b;
+            Color[i].a = static_cast<float>(static_cast<int32_t>(clr.a + fError[i] + 0.5f));
+
+            const float fDiff = fAlph - Color[i].a;
+
+            if (3 != (i & 3))
+            {
+                assert(i < 15);
+                _Analysis_assume_(i < 15);
+                fError[i + 1] += fDiff * (7.0f / 16.0f);
+            }
+
+            if (i < 12)
+            {
+                if (i & 3)
+                    fError[i + 3] += fDiff * (3.0f / 16.0f);
+
+                fError[i + 4] += fDiff * (5.0f / 16.0f);
+
+                if (3 != (i & 3))
+                {
+                    assert(i < 11);
+                    _Analysis_assume_(i < 11);
+                    fError[i + 5] += fDiff * (1.0f / 16.0f);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&Color[i]), pColor[i]);
+        }
+    }
+
+    auto pBC1 = reinterpret_cast<D3DX_BC1 *>(pBC);
+    EncodeBC1(pBC1, Color, true, threshold, flags);
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC1Batch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, float threshold, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+
+#ifndef COLOR_WEIGHTS
+    if (!(flags & (BC_FLAGS_DITHER_RGB | BC_FLAGS_DITHER_A | BC_FLAGS_CLUSTER_FIT)))
+    {
+        for (size_t n = 0; n < count; n += BC_BATCH_LANES)
+        {
+            const size_t lanes = std::min<size_t>(BC_BATCH_LANES, count - n);
+
+            BlockSoA soa;
+            LoadBlocksSoA(soa, pColor + n * NUM_PIXELS_PER_BLOCK, lanes);
+
+            D3DX_BC1 *pBlocks[BC_BATCH_LANES] = {};
+            for (size_t lane = 0; lane < lanes; ++lane)
+                pBlocks[lane] = reinterpret_cast<D3DX_BC1 *>(pBC + (n + lane) * sizeof(D3DX_BC1));
+
+            EncodeBC1SoA(pBlocks, lanes, soa, true, threshold, flags);
+        }
+        return;
+    }
+#endif // !COLOR_WEIGHTS
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        D3DXEncodeBC1(pBC + n * sizeof(D3DX_BC1), pColor + n * NUM_PIXELS_PER_BLOCK, threshold, flags);
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// BC2 Compression
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC2(XMVECTOR *pColor, const uint8_t *pBC) noexcept
+{
+    assert(pColor && pBC);
+    static_assert(sizeof(D3DX_BC2) == 16, "D3DX_BC2 should be 16 bytes");
 
     auto pBC2 = reinterpret_cast<const D3DX_BC2 *>(pBC);
 
@@ -824,6 +2483,34 @@ void DirectX::D3DXDecodeBC2(XMVECTOR *pColor, const uint8_t *pBC) noexcept
         pColor[i] = XMVectorSetW(pColor[i], static_cast<float>(dw & 0xf) * (1.0f / 15.0f));
 }
 
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC2Palette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+    static_assert(sizeof(D3DX_BC2) == 16, "D3DX_BC2 should be 16 bytes");
+
+    auto pBC2 = reinterpret_cast<const D3DX_BC2 *>(pBC);
+
+    DecodeBC1Palette(pBlock->color, &pBC2->bc1, false);
+    DecodeBC1Indices(pBlock->colorIndex, &pBC2->bc1);
+    pBlock->colorCount = 4;
+
+    // 4-bit alpha part is explicit, so its palette is every representable value
+    for (size_t i = 0; i < 16; ++i)
+        pBlock->channel[i] = static_cast<float>(i) * (1.0f / 15.0f);
+    pBlock->channelCount = 16;
+
+    uint32_t dw = pBC2->bitmap[0];
+
+    for (size_t i = 0; i < 8; ++i, dw >>= 4)
+        pBlock->channelIndex[i] = static_cast<uint8_t>(dw & 0xf);
+
+    dw = pBC2->bitmap[1];
+
+    for (size_t i = 8; i < NUM_PIXELS_PER_BLOCK; ++i, dw >>= 4)
+        pBlock->channelIndex[i] = static_cast<uint8_t>(dw & 0xf);
+}
+
 _Use_decl_annotations_
 void DirectX::D3DXEncodeBC2(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flags) noexcept
 {
@@ -838,66 +2525,91 @@ void DirectX::D3DXEncodeBC2(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flags
 
     auto pBC2 = reinterpret_cast<D3DX_BC2 *>(pBC);
 
-    // 4-bit alpha part.  Dithered using Floyd Stienberg error diffusion.
-    pBC2->bitmap[0] = 0;
-    pBC2->bitmap[1] = 0;
+    // 4-bit alpha part
+    EncodeBC2Alpha(pBC2, Color, flags);
 
-    float fError[NUM_PIXELS_PER_BLOCK] = {};
-    for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+    // RGB part
+#ifdef COLOR_WEIGHTS
+    if (!pBC2->bitmap[0] && !pBC2->bitmap[1])
     {
-        float fAlph = Color[i].a;
-        if (flags & BC_FLAGS_DITHER_A)
-            fAlph += fError[i];
+        EncodeSolidBC1(pBC2->dxt1, Color);
+        return;
+    }
+#endif // COLOR_WEIGHTS
 
-        const auto u = static_cast<uint32_t>(fAlph * 15.0f + 0.5f);
+    EncodeBC1(&pBC2->bc1, Color, false, 0.f, flags);
+}
 
-        pBC2->bitmap[i >> 3] >>= 4;
-        pBC2->bitmap[i >> 3] |= (u << 28);
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC2Batch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
 
-        if (flags & BC_FLAGS_DITHER_A)
+#ifndef COLOR_WEIGHTS
+    if (!(flags & (BC_FLAGS_DITHER_RGB | BC_FLAGS_CLUSTER_FIT)))
+    {
+        for (size_t n = 0; n < count; n += BC_BATCH_LANES)
         {
-            const float fDiff = fAlph - float(u) * (1.0f / 15.0f);
-
-            if (3 != (i & 3))
-            {
-                assert(i < 15);
-                _Analysis_assume_(i < 15);
-                fError[i + 1] += fDiff * (7.0f / 16.0f);
-            }
+            const size_t lanes = std::min<size_t>(BC_BATCH_LANES, count - n);
 
-            if (i < 12)
+            D3DX_BC1 *pBlocks[BC_BATCH_LANES] = {};
+            for (size_t lane = 0; lane < lanes; ++lane)
             {
-                if (i & 3)
-                    fError[i + 3] += fDiff * (3.0f / 16.0f);
-
-                fError[i + 4] += fDiff * (5.0f / 16.0f);
+                auto pBC2 = reinterpret_cast<D3DX_BC2 *>(pBC + (n + lane) * sizeof(D3DX_BC2));
 
-                if (3 != (i & 3))
+                HDRColorA Color[NUM_PIXELS_PER_BLOCK];
+                for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
                 {
-                    assert(i < 11);
-                    _Analysis_assume_(i < 11);
-                    fError[i + 5] += fDiff * (1.0f / 16.0f);
+                    XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&Color[i]), pColor[(n + lane) * NUM_PIXELS_PER_BLOCK + i]);
                 }
+
+                EncodeBC2Alpha(pBC2, Color, flags);
+
+                pBlocks[lane] = &pBC2->bc1;
             }
+
+            BlockSoA soa;
+            LoadBlocksSoA(soa, pColor + n * NUM_PIXELS_PER_BLOCK, lanes);
+
+            EncodeBC1SoA(pBlocks, lanes, soa, false, 0.f, flags);
         }
+        return;
     }
+#endif // !COLOR_WEIGHTS
 
-    // RGB part
-#ifdef COLOR_WEIGHTS
-    if (!pBC2->bitmap[0] && !pBC2->bitmap[1])
+    for (size_t n = 0; n < count; ++n)
     {
-        EncodeSolidBC1(pBC2->dxt1, Color);
-        return;
+        D3DXEncodeBC2(pBC + n * sizeof(D3DX_BC2), pColor + n * NUM_PIXELS_PER_BLOCK, flags);
     }
-#endif // COLOR_WEIGHTS
-
-    EncodeBC1(&pBC2->bc1, Color, false, 0.f, flags);
 }
 
 
 //-------------------------------------------------------------------------------------
 // BC3 Compression
 //-------------------------------------------------------------------------------------
+namespace
+{
+    inline void DecodeBC3AlphaPalette(_Out_writes_(8) float *fAlpha, _In_ const D3DX_BC3 *pBC3) noexcept
+    {
+        fAlpha[0] = static_cast<float>(pBC3->alpha[0]) * (1.0f / 255.0f);
+        fAlpha[1] = static_cast<float>(pBC3->alpha[1]) * (1.0f / 255.0f);
+
+        if (pBC3->alpha[0] > pBC3->alpha[1])
+        {
+            for (size_t i = 1; i < 7; ++i)
+                fAlpha[i + 1] = (fAlpha[0] * float(7u - i) + fAlpha[1] * float(i)) * (1.0f / 7.0f);
+        }
+        else
+        {
+            for (size_t i = 1; i < 5; ++i)
+                fAlpha[i + 1] = (fAlpha[0] * float(5u - i) + fAlpha[1] * float(i)) * (1.0f / 5.0f);
+
+            fAlpha[6] = 0.0f;
+            fAlpha[7] = 1.0f;
+        }
+    }
+}
+
 _Use_decl_annotations_
 void DirectX::D3DXDecodeBC3(XMVECTOR *pColor, const uint8_t *pBC) noexcept
 {
@@ -911,33 +2623,43 @@ void DirectX::D3DXDecodeBC3(XMVECTOR *pColor, const uint8_t *pBC) noexcept
 
     // Adaptive 3-bit alpha part
     float fAlpha[8];
+    DecodeBC3AlphaPalette(fAlpha, pBC3);
 
-    fAlpha[0] = static_cast<float>(pBC3->alpha[0]) * (1.0f / 255.0f);
-    fAlpha[1] = static_cast<float>(pBC3->alpha[1]) * (1.0f / 255.0f);
+    uint32_t dw = uint32_t(pBC3->bitmap[0]) | uint32_t(pBC3->bitmap[1] << 8) | uint32_t(pBC3->bitmap[2] << 16);
 
-    if (pBC3->alpha[0] > pBC3->alpha[1])
-    {
-        for (size_t i = 1; i < 7; ++i)
-            fAlpha[i + 1] = (fAlpha[0] * float(7u - i) + fAlpha[1] * float(i)) * (1.0f / 7.0f);
-    }
-    else
-    {
-        for (size_t i = 1; i < 5; ++i)
-            fAlpha[i + 1] = (fAlpha[0] * float(5u - i) + fAlpha[1] * float(i)) * (1.0f / 5.0f);
+    for (size_t i = 0; i < 8; ++i, dw >>= 3)
+        pColor[i] = XMVectorSetW(pColor[i], fAlpha[dw & 0x7]);
 
-        fAlpha[6] = 0.0f;
-        fAlpha[7] = 1.0f;
-    }
+    dw = uint32_t(pBC3->bitmap[3]) | uint32_t(pBC3->bitmap[4] << 8) | uint32_t(pBC3->bitmap[5] << 16);
+
+    for (size_t i = 8; i < NUM_PIXELS_PER_BLOCK; ++i, dw >>= 3)
+        pColor[i] = XMVectorSetW(pColor[i], fAlpha[dw & 0x7]);
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC3Palette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+    static_assert(sizeof(D3DX_BC3) == 16, "D3DX_BC3 should be 16 bytes");
+
+    auto pBC3 = reinterpret_cast<const D3DX_BC3 *>(pBC);
+
+    DecodeBC1Palette(pBlock->color, &pBC3->bc1, false);
+    DecodeBC1Indices(pBlock->colorIndex, &pBC3->bc1);
+    pBlock->colorCount = 4;
+
+    DecodeBC3AlphaPalette(pBlock->channel, pBC3);
+    pBlock->channelCount = 8;
 
     uint32_t dw = uint32_t(pBC3->bitmap[0]) | uint32_t(pBC3->bitmap[1] << 8) | uint32_t(pBC3->bitmap[2] << 16);
 
     for (size_t i = 0; i < 8; ++i, dw >>= 3)
-        pColor[i] = XMVectorSetW(pColor[i], fAlpha[dw & 0x7]);
+        pBlock->channelIndex[i] = static_cast<uint8_t>(dw & 0x7);
 
     dw = uint32_t(pBC3->bitmap[3]) | uint32_t(pBC3->bitmap[4] << 8) | uint32_t(pBC3->bitmap[5] << 16);
 
     for (size_t i = 8; i < NUM_PIXELS_PER_BLOCK; ++i, dw >>= 3)
-        pColor[i] = XMVectorSetW(pColor[i], fAlpha[dw & 0x7]);
+        pBlock->channelIndex[i] = static_cast<uint8_t>(dw & 0x7);
 }
 
 _Use_decl_annotations_
@@ -954,60 +2676,14 @@ void DirectX::D3DXEncodeBC3(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flags
 
     auto pBC3 = reinterpret_cast<D3DX_BC3 *>(pBC);
 
-    // Quantize block to A8, using Floyd Stienberg error diffusion.  This
-    // increases the chance that colors will map directly to the quantized
-    // axis endpoints.
-    float fAlpha[NUM_PIXELS_PER_BLOCK] = {};
-    float fError[NUM_PIXELS_PER_BLOCK] = {};
-
-    float fMinAlpha = Color[0].a;
-    float fMaxAlpha = Color[0].a;
-
-    for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
-    {
-        float fAlph = Color[i].a;
-        if (flags & BC_FLAGS_DITHER_A)
-            fAlph += fError[i];
-
-        fAlpha[i] = static_cast<float>(static_cast<int32_t>(fAlph * 255.0f + 0.5f)) * (1.0f / 255.0f);
-
-        if (fAlpha[i] < fMinAlpha)
-            fMinAlpha = fAlpha[i];
-        else if (fAlpha[i] > fMaxAlpha)
-            fMaxAlpha = fAlpha[i];
-
-        if (flags & BC_FLAGS_DITHER_A)
-        {
-            const float fDiff = fAlph - fAlpha[i];
-
-            if (3 != (i & 3))
-            {
-                assert(i < 15);
-                _Analysis_assume_(i < 15);
-                fError[i + 1] += fDiff * (7.0f / 16.0f);
-            }
-
-            if (i < 12)
-            {
-                if (i & 3)
-                    fError[i + 3] += fDiff * (3.0f / 16.0f);
-
-                fError[i + 4] += fDiff * (5.0f / 16.0f);
-
-                if (3 != (i & 3))
-                {
-                    assert(i < 11);
-                    _Analysis_assume_(i < 11);
-                    fError[i + 5] += fDiff * (1.0f / 16.0f);
-                }
-            }
-        }
-    }
+    float fAlpha[NUM_PIXELS_PER_BLOCK];
+    float fMinAlpha, fMaxAlpha;
+    QuantizeBC3Alpha(Color, flags, fAlpha, fMinAlpha, fMaxAlpha);
 
 #ifdef COLOR_WEIGHTS
     if (0.0f == fMaxAlpha)
     {
-        EncodeSolidBC1(&pBC3->dxt1, Color);
+        EncodeSolidBC1(&pBC3->bc1, Color);
         pBC3->alpha[0] = 0x00;
         pBC3->alpha[1] = 0x00;
         memset(pBC3->bitmap, 0x00, 6);
@@ -1018,124 +2694,87 @@ void DirectX::D3DXEncodeBC3(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flags
     EncodeBC1(&pBC3->bc1, Color, false, 0.f, flags);
 
     // Alpha part
-    if (1.0f == fMinAlpha)
-    {
-        pBC3->alpha[0] = 0xff;
-        pBC3->alpha[1] = 0xff;
-        memset(pBC3->bitmap, 0x00, 6);
-        return;
-    }
-
-    // Optimize and Quantize Min and Max values
-    const uint32_t uSteps = ((0.0f == fMinAlpha) || (1.0f == fMaxAlpha)) ? 6u : 8u;
-
-    float fAlphaA, fAlphaB;
-    OptimizeAlpha<false>(&fAlphaA, &fAlphaB, fAlpha, uSteps);
-
-    const auto bAlphaA = static_cast<uint8_t>(static_cast<int32_t>(fAlphaA * 255.0f + 0.5f));
-    const auto bAlphaB = static_cast<uint8_t>(static_cast<int32_t>(fAlphaB * 255.0f + 0.5f));
-
-    fAlphaA = static_cast<float>(bAlphaA) * (1.0f / 255.0f);
-    fAlphaB = static_cast<float>(bAlphaB) * (1.0f / 255.0f);
-
-    // Setup block
-    if ((8 == uSteps) && (bAlphaA == bAlphaB))
-    {
-        pBC3->alpha[0] = bAlphaA;
-        pBC3->alpha[1] = bAlphaB;
-        memset(pBC3->bitmap, 0x00, 6);
-        return;
-    }
-
-    static const size_t pSteps6[] = { 0, 2, 3, 4, 5, 1 };
-    static const size_t pSteps8[] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+    EncodeBC3Alpha(pBC3, Color, fAlpha, fMinAlpha, fMaxAlpha, flags);
+}
 
-    const size_t *pSteps;
-    float fStep[8] = {};
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC3Batch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
 
-    if (6 == uSteps)
+#ifndef COLOR_WEIGHTS
+    if (!(flags & (BC_FLAGS_DITHER_RGB | BC_FLAGS_CLUSTER_FIT)))
     {
-        pBC3->alpha[0] = bAlphaA;
-        pBC3->alpha[1] = bAlphaB;
+        for (size_t n = 0; n < count; n += BC_BATCH_LANES)
+        {
+            const size_t lanes = std::min<size_t>(BC_BATCH_LANES, count - n);
 
-        fStep[0] = fAlphaA;
-        fStep[1] = fAlphaB;
+            D3DX_BC1 *pBlocks[BC_BATCH_LANES] = {};
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                auto pBC3 = reinterpret_cast<D3DX_BC3 *>(pBC + (n + lane) * sizeof(D3DX_BC3));
 
-        for (size_t i = 1; i < 5; ++i)
-            fStep[i + 1] = (fStep[0] * float(5u - i) + fStep[1] * float(i)) * (1.0f / 5.0f);
+                HDRColorA Color[NUM_PIXELS_PER_BLOCK];
+                for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+                {
+                    XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&Color[i]), pColor[(n + lane) * NUM_PIXELS_PER_BLOCK + i]);
+                }
 
-        fStep[6] = 0.0f;
-        fStep[7] = 1.0f;
+                float fAlpha[NUM_PIXELS_PER_BLOCK];
+                float fMinAlpha, fMaxAlpha;
+                QuantizeBC3Alpha(Color, flags, fAlpha, fMinAlpha, fMaxAlpha);
 
-        pSteps = pSteps6;
-    }
-    else
-    {
-        pBC3->alpha[0] = bAlphaB;
-        pBC3->alpha[1] = bAlphaA;
+                EncodeBC3Alpha(pBC3, Color, fAlpha, fMinAlpha, fMaxAlpha, flags);
 
-        fStep[0] = fAlphaB;
-        fStep[1] = fAlphaA;
+                pBlocks[lane] = &pBC3->bc1;
+            }
 
-        for (size_t i = 1; i < 7; ++i)
-            fStep[i + 1] = (fStep[0] * float(7u - i) + fStep[1] * float(i)) * (1.0f / 7.0f);
+            BlockSoA soa;
+            LoadBlocksSoA(soa, pColor + n * NUM_PIXELS_PER_BLOCK, lanes);
 
-        pSteps = pSteps8;
+            EncodeBC1SoA(pBlocks, lanes, soa, false, 0.f, flags);
+        }
+        return;
     }
+#endif // !COLOR_WEIGHTS
 
-    // Encode alpha bitmap
-    const auto fSteps = static_cast<float>(uSteps - 1);
-    const float fScale = (fStep[0] != fStep[1]) ? (fSteps / (fStep[1] - fStep[0])) : 0.0f;
-
-    if (flags & BC_FLAGS_DITHER_A)
-        memset(fError, 0x00, NUM_PIXELS_PER_BLOCK * sizeof(float));
-
-    for (size_t iSet = 0; iSet < 2; iSet++)
+    for (size_t n = 0; n < count; ++n)
     {
-        uint32_t dw = 0;
-
-        const size_t iMin = iSet * 8;
-        const size_t iLim = iMin + 8;
+        D3DXEncodeBC3(pBC + n * sizeof(D3DX_BC3), pColor + n * NUM_PIXELS_PER_BLOCK, flags);
+    }
+}
 
-        for (size_t i = iMin; i < iLim; ++i)
-        {
-            float fAlph = Color[i].a;
-            if (flags & BC_FLAGS_DITHER_A)
-                fAlph += fError[i];
-            const float fDot = (fAlph - fStep[0]) * fScale;
 
-            uint32_t iStep;
-            if (fDot <= 0.0f)
-                iStep = ((6 == uSteps) && (fAlph <= fStep[0] * 0.5f)) ? 6u : 0u;
-            else if (fDot >= fSteps)
-                iStep = ((6 == uSteps) && (fAlph >= (fStep[1] + 1.0f) * 0.5f)) ? 7u : 1u;
-            else
-                iStep = uint32_t(pSteps[uint32_t(fDot + 0.5f)]);
+//-------------------------------------------------------------------------------------
+// BC1/BC3 Compression from 8-bit UNORM sources
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC1RGBA8(uint8_t *pBC, const uint32_t *pColor, float threshold, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+    assert(!(flags & (BC_FLAGS_DITHER_RGB | BC_FLAGS_DITHER_A)));
 
-            dw = (iStep << 21) | (dw >> 3);
+    RGBA8Block block;
+    UnpackRGBA8(block, pColor);
 
-            if (flags & BC_FLAGS_DITHER_A)
-            {
-                const float fDiff = (fAlph - fStep[iStep]);
+    auto pBC1 = reinterpret_cast<D3DX_BC1 *>(pBC);
+    EncodeBC1RGB8(pBC1, block, true, threshold, flags);
+}
 
-                if (3 != (i & 3))
-                    fError[i + 1] += fDiff * (7.0f / 16.0f);
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC3RGBA8(uint8_t *pBC, const uint32_t *pColor, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+    assert(!(flags & (BC_FLAGS_DITHER_RGB | BC_FLAGS_DITHER_A)));
 
-                if (i < 12)
-                {
-                    if (i & 3)
-                        fError[i + 3] += fDiff * (3.0f / 16.0f);
+    RGBA8Block block;
+    UnpackRGBA8(block, pColor);
 
-                    fError[i + 4] += fDiff * (5.0f / 16.0f);
+    auto pBC3 = reinterpret_cast<D3DX_BC3 *>(pBC);
 
-                    if (3 != (i & 3))
-                        fError[i + 5] += fDiff * (1.0f / 16.0f);
-                }
-            }
-        }
+    // RGB part
+    EncodeBC1RGB8(&pBC3->bc1, block, false, 0.f, flags);
 
-        pBC3->bitmap[0 + iSet * 3] = reinterpret_cast<uint8_t *>(&dw)[0];
-        pBC3->bitmap[1 + iSet * 3] = reinterpret_cast<uint8_t *>(&dw)[1];
-        pBC3->bitmap[2 + iSet * 3] = reinterpret_cast<uint8_t *>(&dw)[2];
-    }
+    // Alpha part
+    EncodeBC3Alpha8(pBC3, block);
 }
@@ -45,6 +45,22 @@ namespace DirectX
 
         BC_FLAGS_FORCE_BC7_MODE6 = 0x100000,
         // BC7 should only use mode 6; skip other modes
+
+        BC_FLAGS_RANGE_FIT = 0x200000,
+        // BC1-3 color endpoints are the extremes along the principal axis; fastest, lowest quality
+        // BC4/BC5 use the batched range fit encoder
+
+        BC_FLAGS_CLUSTER_FIT = 0x400000,
+        // BC1-3 color endpoints use an exhaustive cluster fit; slowest, highest quality
+
+        BC_FLAGS_BC7_PRUNE = 0x800000,
+        // BC7 skips modes and partitions that block statistics show are unlikely to win
+
+        BC_FLAGS_INTEGER_FIT = 0x20000000,
+        // BC1/BC3 from 8-bit UNORM sources may use the integer encoders (D3DXEncodeBC1RGBA8/BC3RGBA8)
+
+        BC_FLAGS_BC7_PRUNE_MORE = 0x40000000,
+        // BC7 prunes as BC_FLAGS_BC7_PRUNE with looser thresholds, and refines fewer partitions
     };
 
     //-------------------------------------------------------------------------------------
@@ -317,6 +333,7 @@ namespace DirectX
 
     typedef void (*BC_DECODE)(XMVECTOR *pColor, const uint8_t *pBC);
     typedef void (*BC_ENCODE)(uint8_t *pDXT, const XMVECTOR *pColor, uint32_t flags);
+    typedef void (*BC_ENCODE_BATCH)(uint8_t *pDXT, const XMVECTOR *pColor, size_t count, uint32_t flags);
 
     void D3DXDecodeBC1(_Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pColor, _In_reads_(8) const uint8_t *pBC) noexcept;
     void D3DXDecodeBC2(_Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pColor, _In_reads_(16) const uint8_t *pBC) noexcept;
@@ -329,6 +346,29 @@ namespace DirectX
     void D3DXDecodeBC6HS(_Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pColor, _In_reads_(16) const uint8_t *pBC) noexcept;
     void D3DXDecodeBC7(_Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pColor, _In_reads_(16) const uint8_t *pBC) noexcept;
 
+    // Palette form of a decoded BC1-BC5 block, so callers converting to another format only need to convert the palette.
+    // Pixel i is color[colorIndex[i]] from the matching D3DXDecode* function, except that when channelCount is non-zero
+    // its alpha (BC2/BC3) or green (BC5) component is channel[channelIndex[i]] instead.
+    struct BC_PALETTE_BLOCK
+    {
+        XMVECTOR    color[8];
+        float       channel[16];
+        uint8_t     colorIndex[NUM_PIXELS_PER_BLOCK];
+        uint8_t     channelIndex[NUM_PIXELS_PER_BLOCK];
+        size_t      colorCount;
+        size_t      channelCount;
+    };
+
+    typedef void (*BC_DECODE_PALETTE)(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC);
+
+    void D3DXDecodeBC1Palette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(8) const uint8_t *pBC) noexcept;
+    void D3DXDecodeBC2Palette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(16) const uint8_t *pBC) noexcept;
+    void D3DXDecodeBC3Palette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(16) const uint8_t *pBC) noexcept;
+    void D3DXDecodeBC4UPalette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(8) const uint8_t *pBC) noexcept;
+    void D3DXDecodeBC4SPalette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(8) const uint8_t *pBC) noexcept;
+    void D3DXDecodeBC5UPalette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(16) const uint8_t *pBC) noexcept;
+    void D3DXDecodeBC5SPalette(_Out_ BC_PALETTE_BLOCK *pBlock, _In_reads_(16) const uint8_t *pBC) noexcept;
+
     void D3DXEncodeBC1(_Out_writes_(8) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pColor, _In_ float threshold, _In_ uint32_t flags) noexcept;
         // BC1 requires one additional parameter, so it doesn't match signature of BC_ENCODE above
 
@@ -342,4 +382,23 @@ namespace DirectX
     void D3DXEncodeBC6HS(_Out_writes_(16) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pColor, _In_ uint32_t flags) noexcept;
     void D3DXEncodeBC7(_Out_writes_(16) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pColor, _In_ uint32_t flags) noexcept;
 
+    // Multi-block encoders: 'count' consecutive blocks of NUM_PIXELS_PER_BLOCK colors in, 'count' consecutive blocks out.
+    // Output is bit-identical to calling the single-block encoder for each block.
+    void D3DXEncodeBC1Batch(_Out_writes_(8 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ float threshold, _In_ uint32_t flags) noexcept;
+    void D3DXEncodeBC2Batch(_Out_writes_(16 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ uint32_t flags) noexcept;
+    void D3DXEncodeBC3Batch(_Out_writes_(16 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ uint32_t flags) noexcept;
+
+    // Multi-block BC4/BC5 encoders. By default the output is bit-identical to the single-block encoders. With
+    // BC_FLAGS_RANGE_FIT, both interpolation modes are evaluated for several blocks at once, which is faster but
+    // not bit-identical to the single-block encoders.
+    void D3DXEncodeBC4UBatch(_Out_writes_(8 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ uint32_t flags) noexcept;
+    void D3DXEncodeBC4SBatch(_Out_writes_(8 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ uint32_t flags) noexcept;
+    void D3DXEncodeBC5UBatch(_Out_writes_(16 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ uint32_t flags) noexcept;
+    void D3DXEncodeBC5SBatch(_Out_writes_(16 * count) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor, _In_ size_t count, _In_ uint32_t flags) noexcept;
+
+    // Integer encoders for 8-bit UNORM sources: pColor is one block of DXGI_FORMAT_R8G8B8A8_UNORM pixels.
+    // Dithering and BC_FLAGS_CLUSTER_FIT are not supported. Output is not bit-identical to D3DXEncodeBC1/BC3.
+    void D3DXEncodeBC1RGBA8(_Out_writes_(8) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK) const uint32_t *pColor, _In_ float threshold, _In_ uint32_t flags) noexcept;
+    void D3DXEncodeBC3RGBA8(_Out_writes_(16) uint8_t *pBC, _In_reads_(NUM_PIXELS_PER_BLOCK) const uint32_t *pColor, _In_ uint32_t flags) noexcept;
+
 } // namespace
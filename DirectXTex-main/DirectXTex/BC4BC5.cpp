@@ -152,6 +152,44 @@ namespace
 
 #pragma warning(pop)
 
+    //-------------------------------------------------------------------------------------
+    // Palette form of a BC4 block (red) and optionally a second one for BC5 (green)
+    //-------------------------------------------------------------------------------------
+    template <class BC4>
+    void DecodeBC4Palette(
+        _Out_ BC_PALETTE_BLOCK *pBlock,
+        _In_ const BC4 *pBCR,
+        _In_opt_ const BC4 *pBCG) noexcept
+    {
+        for (size_t i = 0; i < 8; ++i)
+        {
+            pBlock->color[i] = XMVectorSet(pBCR->DecodeFromIndex(i), 0, 0, 1.0f);
+        }
+        pBlock->colorCount = 8;
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            pBlock->colorIndex[i] = static_cast<uint8_t>(pBCR->GetIndex(i));
+        }
+
+        if (!pBCG)
+        {
+            pBlock->channelCount = 0;
+            return;
+        }
+
+        for (size_t i = 0; i < 8; ++i)
+        {
+            pBlock->channel[i] = pBCG->DecodeFromIndex(i);
+        }
+        pBlock->channelCount = 8;
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            pBlock->channelIndex[i] = static_cast<uint8_t>(pBCG->GetIndex(i));
+        }
+    }
+
     //-------------------------------------------------------------------------------------
     // Convert a floating point value to an 8-bit SNORM
     //-------------------------------------------------------------------------------------
@@ -375,6 +413,314 @@ namespace
             pBC->SetIndex(i, uBestIndex);
         }
     }
+
+
+    //-------------------------------------------------------------------------------------
+    // Batched BC4 encoder
+    //
+    // Each XMVECTOR lane holds one channel of a different block (a BC5 block supplies two
+    // channels), so four single-channel blocks are encoded together. Endpoints start at the
+    // channel range and get one least-squares refinement. Both the 8 value and the 6 value
+    // (explicit 0/1 or -1/1) interpolation modes are evaluated for every lane and the one with
+    // the lower squared error is kept. Per-lane decisions are made with selects, not branches.
+    //-------------------------------------------------------------------------------------
+    constexpr size_t BC4_BATCH_LANES = 4;
+
+    template <bool bSigned>
+    struct BC4Traits
+    {
+        static constexpr float MIN_NORM = (bSigned) ? -1.f : 0.f;
+        static constexpr float MAX_NORM = 1.f;
+        static constexpr float SCALE = (bSigned) ? 127.f : 255.f;
+    };
+
+    // Snaps a value to the 8-bit endpoint grid, returning the integer code as a float
+    template <bool bSigned>
+    inline XMVECTOR XM_CALLCONV QuantizeEndpoint(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR scaled = XMVectorMultiply(v, XMVectorReplicate(BC4Traits<bSigned>::SCALE));
+        if (bSigned)
+        {
+            // Round half away from zero to match FloatToSNorm
+            const XMVECTOR half = XMVectorSelect(g_XMNegativeOneHalf, g_XMOneHalf, XMVectorGreaterOrEqual(scaled, g_XMZero));
+            return XMVectorTruncate(XMVectorAdd(scaled, half));
+        }
+        else
+        {
+            return XMVectorTruncate(XMVectorAdd(scaled, g_XMOneHalf));
+        }
+    }
+
+    // Index search for one set of endpoints (given as grid codes). pCode receives the BC4
+    // 3-bit index for each texel and the return value is the squared error per lane.
+    template <bool bSigned, bool bSixValues>
+    XMVECTOR XM_CALLCONV FitIndicesBC4Lanes(
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pCode,
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) XMVECTOR *pWeight,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pTexels,
+        FXMVECTOR qLow,
+        FXMVECTOR qHigh) noexcept
+    {
+        // Interpolants run from 'low' (weight 0) to 'high' (weight 1)
+        constexpr float fSteps = (bSixValues) ? 5.f : 7.f;
+
+        const XMVECTOR vSteps = XMVectorReplicate(fSteps);
+        const XMVECTOR vStepsInv = XMVectorReplicate(1.f / fSteps);
+        const XMVECTOR vScale = XMVectorReplicate(BC4Traits<bSigned>::SCALE);
+        const XMVECTOR fLow = XMVectorDivide(qLow, vScale);
+        const XMVECTOR fHigh = XMVectorDivide(qHigh, vScale);
+        const XMVECTOR fRange = XMVectorSubtract(fHigh, fLow);
+        const XMVECTOR fToStep = XMVectorSelect(
+            XMVectorDivide(vSteps, fRange), g_XMZero,
+            XMVectorLessOrEqual(fRange, g_XMZero));
+
+        const XMVECTOR vMin = XMVectorReplicate(BC4Traits<bSigned>::MIN_NORM);
+        const XMVECTOR vMax = XMVectorReplicate(BC4Traits<bSigned>::MAX_NORM);
+
+        XMVECTOR error = g_XMZero;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const XMVECTOR x = pTexels[i];
+
+            XMVECTOR step = XMVectorMultiply(XMVectorSubtract(x, fLow), fToStep);
+            step = XMVectorTruncate(XMVectorAdd(XMVectorClamp(step, g_XMZero, vSteps), g_XMOneHalf));
+
+            const XMVECTOR w = XMVectorMultiply(step, vStepsInv);
+            const XMVECTOR value = XMVectorAdd(fLow, XMVectorMultiply(fRange, w));
+            XMVECTOR diff = XMVectorSubtract(x, value);
+            XMVECTOR e = XMVectorMultiply(diff, diff);
+
+            const XMVECTOR atLow = XMVectorEqual(step, g_XMZero);
+            const XMVECTOR atHigh = XMVectorEqual(step, vSteps);
+
+            XMVECTOR code;
+            if (bSixValues)
+            {
+                // red_0 = low, red_1 = high; 0 -> 0, 5 -> 1, 1..4 -> 2..5
+                code = XMVectorSelect(XMVectorAdd(step, g_XMOne), g_XMZero, atLow);
+                code = XMVectorSelect(code, g_XMOne, atHigh);
+
+                // Explicit MIN_NORM (6) and MAX_NORM (7) codes
+                diff = XMVectorSubtract(x, vMin);
+                const XMVECTOR eMin = XMVectorMultiply(diff, diff);
+                diff = XMVectorSubtract(x, vMax);
+                const XMVECTOR eMax = XMVectorMultiply(diff, diff);
+
+                const XMVECTOR useMin = XMVectorLess(eMin, e);
+                code = XMVectorSelect(code, XMVectorReplicate(6.f), useMin);
+                e = XMVectorMin(e, eMin);
+
+                const XMVECTOR useMax = XMVectorLess(eMax, e);
+                code = XMVectorSelect(code, XMVectorReplicate(7.f), useMax);
+                e = XMVectorMin(e, eMax);
+
+                // Explicit codes do not take part in the endpoint refinement
+                pWeight[i] = XMVectorSelect(w, g_XMNegativeOne, XMVectorOrInt(useMin, useMax));
+            }
+            else
+            {
+                // red_0 = high, red_1 = low; 0 -> 1, 7 -> 0, 1..6 -> 7..2
+                code = XMVectorSelect(XMVectorSubtract(XMVectorReplicate(8.f), step), g_XMOne, atLow);
+                code = XMVectorSelect(code, g_XMZero, atHigh);
+
+                pWeight[i] = w;
+            }
+
+            pCode[i] = code;
+            error = XMVectorAdd(error, e);
+        }
+
+        return error;
+    }
+
+    // One least-squares pass over the texel weights from FitIndicesBC4Lanes; lanes that
+    // cannot be refined keep their endpoints
+    template <bool bSigned>
+    void XM_CALLCONV RefineEndpointsBC4Lanes(
+        _Inout_ XMVECTOR& qLow,
+        _Inout_ XMVECTOR& qHigh,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pTexels,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pWeight) noexcept
+    {
+        XMVECTOR a2 = g_XMZero;
+        XMVECTOR b2 = g_XMZero;
+        XMVECTOR ab = g_XMZero;
+        XMVECTOR ax = g_XMZero;
+        XMVECTOR bx = g_XMZero;
+
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const XMVECTOR used = XMVectorGreaterOrEqual(pWeight[i], g_XMZero);
+            const XMVECTOR b = XMVectorSelect(g_XMZero, pWeight[i], used);
+            const XMVECTOR a = XMVectorSelect(g_XMZero, XMVectorSubtract(g_XMOne, pWeight[i]), used);
+            const XMVECTOR x = XMVectorSelect(g_XMZero, pTexels[i], used);
+
+            a2 = XMVectorAdd(a2, XMVectorMultiply(a, a));
+            b2 = XMVectorAdd(b2, XMVectorMultiply(b, b));
+            ab = XMVectorAdd(ab, XMVectorMultiply(a, b));
+            ax = XMVectorAdd(ax, XMVectorMultiply(a, x));
+            bx = XMVectorAdd(bx, XMVectorMultiply(b, x));
+        }
+
+        const XMVECTOR det = XMVectorSubtract(XMVectorMultiply(a2, b2), XMVectorMultiply(ab, ab));
+        const XMVECTOR valid = XMVectorGreater(det, XMVectorReplicate(FLT_EPSILON));
+        const XMVECTOR detInv = XMVectorDivide(g_XMOne, XMVectorSelect(g_XMOne, det, valid));
+
+        const XMVECTOR vMin = XMVectorReplicate(BC4Traits<bSigned>::MIN_NORM);
+        const XMVECTOR vMax = XMVectorReplicate(BC4Traits<bSigned>::MAX_NORM);
+
+        XMVECTOR low = XMVectorMultiply(XMVectorSubtract(XMVectorMultiply(ax, b2), XMVectorMultiply(bx, ab)), detInv);
+        XMVECTOR high = XMVectorMultiply(XMVectorSubtract(XMVectorMultiply(bx, a2), XMVectorMultiply(ax, ab)), detInv);
+
+        low = QuantizeEndpoint<bSigned>(XMVectorClamp(low, vMin, vMax));
+        high = QuantizeEndpoint<bSigned>(XMVectorClamp(high, vMin, vMax));
+
+        qLow = XMVectorSelect(qLow, low, valid);
+        qHigh = XMVectorSelect(qHigh, high, valid);
+    }
+
+    template <bool bSigned>
+    void EncodeBC4Lanes(
+        _Out_writes_(BC4_BATCH_LANES) uint8_t **ppBC,
+        size_t lanes,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const XMVECTOR *pTexels) noexcept
+    {
+        const XMVECTOR vMin = XMVectorReplicate(BC4Traits<bSigned>::MIN_NORM);
+        const XMVECTOR vMax = XMVectorReplicate(BC4Traits<bSigned>::MAX_NORM);
+
+        // Block range, plus the range of texels not already covered by the explicit
+        // MIN_NORM/MAX_NORM codes of the 6 value mode
+        XMVECTOR fMin = vMax;
+        XMVECTOR fMax = vMin;
+        XMVECTOR fInnerMin = vMax;
+        XMVECTOR fInnerMax = vMin;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            const XMVECTOR x = pTexels[i];
+            fMin = XMVectorMin(fMin, x);
+            fMax = XMVectorMax(fMax, x);
+            fInnerMin = XMVectorSelect(fInnerMin, XMVectorMin(fInnerMin, x), XMVectorGreater(x, vMin));
+            fInnerMax = XMVectorSelect(fInnerMax, XMVectorMax(fInnerMax, x), XMVectorLess(x, vMax));
+        }
+
+        const XMVECTOR noInner = XMVectorGreater(fInnerMin, fInnerMax);
+        fInnerMin = XMVectorSelect(fInnerMin, vMin, noInner);
+        fInnerMax = XMVectorSelect(fInnerMax, vMin, noInner);
+
+        XMVECTOR code8[NUM_PIXELS_PER_BLOCK], code6[NUM_PIXELS_PER_BLOCK], codeTmp[NUM_PIXELS_PER_BLOCK];
+        XMVECTOR weight[NUM_PIXELS_PER_BLOCK];
+
+        // 8 value mode
+        XMVECTOR qLow8 = QuantizeEndpoint<bSigned>(fMin);
+        XMVECTOR qHigh8 = QuantizeEndpoint<bSigned>(fMax);
+        XMVECTOR error8 = FitIndicesBC4Lanes<bSigned, false>(code8, weight, pTexels, qLow8, qHigh8);
+        {
+            XMVECTOR qLow = qLow8;
+            XMVECTOR qHigh = qHigh8;
+            RefineEndpointsBC4Lanes<bSigned>(qLow, qHigh, pTexels, weight);
+
+            // red_0 > red_1 is what selects this mode
+            const XMVECTOR error = FitIndicesBC4Lanes<bSigned, false>(codeTmp, weight, pTexels, qLow, qHigh);
+            const XMVECTOR better = XMVectorAndInt(XMVectorLess(error, error8), XMVectorGreater(qHigh, qLow));
+
+            qLow8 = XMVectorSelect(qLow8, qLow, better);
+            qHigh8 = XMVectorSelect(qHigh8, qHigh, better);
+            error8 = XMVectorSelect(error8, error, better);
+            for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+                code8[i] = XMVectorSelect(code8[i], codeTmp[i], better);
+        }
+
+        // 6 value mode
+        XMVECTOR qLow6 = QuantizeEndpoint<bSigned>(fInnerMin);
+        XMVECTOR qHigh6 = QuantizeEndpoint<bSigned>(fInnerMax);
+        XMVECTOR error6 = FitIndicesBC4Lanes<bSigned, true>(code6, weight, pTexels, qLow6, qHigh6);
+        {
+            XMVECTOR qLow = qLow6;
+            XMVECTOR qHigh = qHigh6;
+            RefineEndpointsBC4Lanes<bSigned>(qLow, qHigh, pTexels, weight);
+
+            // red_0 <= red_1 is what selects this mode
+            const XMVECTOR error = FitIndicesBC4Lanes<bSigned, true>(codeTmp, weight, pTexels, qLow, qHigh);
+            const XMVECTOR better = XMVectorAndInt(XMVectorLess(error, error6), XMVectorLessOrEqual(qLow, qHigh));
+
+            qLow6 = XMVectorSelect(qLow6, qLow, better);
+            qHigh6 = XMVectorSelect(qHigh6, qHigh, better);
+            error6 = XMVectorSelect(error6, error, better);
+            for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+                code6[i] = XMVectorSelect(code6[i], codeTmp[i], better);
+        }
+
+        // Pick a mode per lane and write the blocks out
+        const XMVECTOR use6 = XMVectorLess(error6, error8);
+        const XMVECTOR red0 = XMVectorSelect(qHigh8, qLow6, use6);
+        const XMVECTOR red1 = XMVectorSelect(qLow8, qHigh6, use6);
+
+        XM_ALIGNED_DATA(16) int32_t iRed0[4];
+        XM_ALIGNED_DATA(16) int32_t iRed1[4];
+        XM_ALIGNED_DATA(16) int32_t iCode[NUM_PIXELS_PER_BLOCK][4];
+
+        XMStoreInt4(reinterpret_cast<uint32_t*>(iRed0), XMConvertVectorFloatToInt(red0, 0));
+        XMStoreInt4(reinterpret_cast<uint32_t*>(iRed1), XMConvertVectorFloatToInt(red1, 0));
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            XMStoreInt4(reinterpret_cast<uint32_t*>(iCode[i]), XMConvertVectorFloatToInt(XMVectorSelect(code8[i], code6[i], use6), 0));
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            uint64_t data = uint64_t(uint8_t(iRed0[lane])) | (uint64_t(uint8_t(iRed1[lane])) << 8);
+            for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+            {
+                data |= uint64_t(iCode[i][lane] & 0x07) << (3 * i + 16);
+            }
+
+            memcpy(ppBC[lane], &data, sizeof(data));
+        }
+    }
+
+    // Encodes 'count' blocks with 'channels' BC4 blocks each (1 for BC4, 2 for BC5)
+    template <bool bSigned>
+    void EncodeBC4Batch(
+        _Out_writes_(8 * channels * count) uint8_t *pBC,
+        _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR *pColor,
+        size_t count,
+        size_t channels) noexcept
+    {
+        const XMVECTOR vMin = XMVectorReplicate(BC4Traits<bSigned>::MIN_NORM);
+        const XMVECTOR vMax = XMVectorReplicate(BC4Traits<bSigned>::MAX_NORM);
+
+        const size_t total = count * channels;
+        for (size_t n = 0; n < total; n += BC4_BATCH_LANES)
+        {
+            const size_t lanes = std::min<size_t>(BC4_BATCH_LANES, total - n);
+
+            // Transpose into lanes, replicating the last channel into unused lanes
+            XM_ALIGNED_DATA(16) float fTexels[NUM_PIXELS_PER_BLOCK][4];
+            uint8_t *pBlocks[BC4_BATCH_LANES] = {};
+            for (size_t lane = 0; lane < BC4_BATCH_LANES; ++lane)
+            {
+                const size_t j = n + std::min(lane, lanes - 1);
+                const XMVECTOR *pBlock = pColor + (j / channels) * NUM_PIXELS_PER_BLOCK;
+                const size_t channel = j % channels;
+
+                for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+                    fTexels[i][lane] = XMVectorGetByIndex(pBlock[i], channel);
+
+                pBlocks[lane] = pBC + j * sizeof(uint64_t);
+            }
+
+            XMVECTOR texels[NUM_PIXELS_PER_BLOCK];
+            for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+            {
+                const XMVECTOR x = XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(fTexels[i]));
+
+                // NaN becomes 0, like FloatToSNorm
+                texels[i] = XMVectorClamp(XMVectorSelect(g_XMZero, x, XMVectorEqual(x, x)), vMin, vMax);
+            }
+
+            EncodeBC4Lanes<bSigned>(pBlocks, lanes, texels);
+        }
+    }
 }
 
 
@@ -415,6 +761,24 @@ void DirectX::D3DXDecodeBC4S(XMVECTOR *pColor, const uint8_t *pBC) noexcept
     }
 }
 
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC4UPalette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+    static_assert(sizeof(BC4_UNORM) == 8, "BC4_UNORM should be 8 bytes");
+
+    DecodeBC4Palette<BC4_UNORM>(pBlock, reinterpret_cast<const BC4_UNORM*>(pBC), nullptr);
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC4SPalette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+    static_assert(sizeof(BC4_SNORM) == 8, "BC4_SNORM should be 8 bytes");
+
+    DecodeBC4Palette<BC4_SNORM>(pBlock, reinterpret_cast<const BC4_SNORM*>(pBC), nullptr);
+}
+
 _Use_decl_annotations_
 void DirectX::D3DXEncodeBC4U(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flags) noexcept
 {
@@ -457,6 +821,42 @@ void DirectX::D3DXEncodeBC4S(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flag
     FindClosestSNORM(pBC4, theTexelsU);
 }
 
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC4UBatch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+    static_assert(sizeof(BC4_UNORM) == 8, "BC4_UNORM should be 8 bytes");
+
+    if (!(flags & BC_FLAGS_RANGE_FIT))
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            D3DXEncodeBC4U(pBC + n * sizeof(BC4_UNORM), pColor + n * NUM_PIXELS_PER_BLOCK, flags);
+        }
+        return;
+    }
+
+    EncodeBC4Batch<false>(pBC, pColor, count, 1);
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC4SBatch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+    static_assert(sizeof(BC4_SNORM) == 8, "BC4_SNORM should be 8 bytes");
+
+    if (!(flags & BC_FLAGS_RANGE_FIT))
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            D3DXEncodeBC4S(pBC + n * sizeof(BC4_SNORM), pColor + n * NUM_PIXELS_PER_BLOCK, flags);
+        }
+        return;
+    }
+
+    EncodeBC4Batch<true>(pBC, pColor, count, 1);
+}
+
 
 //-------------------------------------------------------------------------------------
 // BC5 Compression
@@ -493,6 +893,24 @@ void DirectX::D3DXDecodeBC5S(XMVECTOR *pColor, const uint8_t *pBC) noexcept
     }
 }
 
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC5UPalette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+    static_assert(sizeof(BC4_UNORM) == 8, "BC4_UNORM should be 8 bytes");
+
+    DecodeBC4Palette(pBlock, reinterpret_cast<const BC4_UNORM*>(pBC), reinterpret_cast<const BC4_UNORM*>(pBC + sizeof(BC4_UNORM)));
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXDecodeBC5SPalette(BC_PALETTE_BLOCK *pBlock, const uint8_t *pBC) noexcept
+{
+    assert(pBlock && pBC);
+    static_assert(sizeof(BC4_SNORM) == 8, "BC4_SNORM should be 8 bytes");
+
+    DecodeBC4Palette(pBlock, reinterpret_cast<const BC4_SNORM*>(pBC), reinterpret_cast<const BC4_SNORM*>(pBC + sizeof(BC4_SNORM)));
+}
+
 _Use_decl_annotations_
 void DirectX::D3DXEncodeBC5U(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flags) noexcept
 {
@@ -560,3 +978,39 @@ void DirectX::D3DXEncodeBC5S(uint8_t *pBC, const XMVECTOR *pColor, uint32_t flag
     FindClosestSNORM(pBCR, theTexelsU);
     FindClosestSNORM(pBCG, theTexelsV);
 }
+
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC5UBatch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+    static_assert(sizeof(BC4_UNORM) == 8, "BC4_UNORM should be 8 bytes");
+
+    if (!(flags & BC_FLAGS_RANGE_FIT))
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            D3DXEncodeBC5U(pBC + n * 2 * sizeof(BC4_UNORM), pColor + n * NUM_PIXELS_PER_BLOCK, flags);
+        }
+        return;
+    }
+
+    EncodeBC4Batch<false>(pBC, pColor, count, 2);
+}
+
+_Use_decl_annotations_
+void DirectX::D3DXEncodeBC5SBatch(uint8_t *pBC, const XMVECTOR *pColor, size_t count, uint32_t flags) noexcept
+{
+    assert(pBC && pColor);
+    static_assert(sizeof(BC4_SNORM) == 8, "BC4_SNORM should be 8 bytes");
+
+    if (!(flags & BC_FLAGS_RANGE_FIT))
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            D3DXEncodeBC5S(pBC + n * 2 * sizeof(BC4_SNORM), pColor + n * NUM_PIXELS_PER_BLOCK, flags);
+        }
+        return;
+    }
+
+    EncodeBC4Batch<true>(pBC, pColor, count, 2);
+}
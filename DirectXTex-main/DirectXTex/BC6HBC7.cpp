@@ -327,6 +327,15 @@ namespace
     const int g_aWeights2[] = { 0, 21, 43, 64 };
     const int g_aWeights3[] = { 0, 9, 18, 27, 37, 46, 55, 64 };
     const int g_aWeights4[] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    // The same weights four to a vector, for building palettes with SIMD
+    const XMVECTORF32 g_aWeightsV2[] = { { { { 0.f, 21.f, 43.f, 64.f } } } };
+    const XMVECTORF32 g_aWeightsV3[] = { { { { 0.f, 9.f, 18.f, 27.f } } }, { { { 37.f, 46.f, 55.f, 64.f } } } };
+    const XMVECTORF32 g_aWeightsV4[] =
+    {
+        { { { 0.f, 4.f, 9.f, 13.f } } }, { { { 17.f, 21.f, 26.f, 30.f } } },
+        { { { 34.f, 38.f, 43.f, 47.f } } }, { { { 51.f, 55.f, 60.f, 64.f } } }
+    };
 }
 
 namespace DirectX
@@ -662,6 +671,23 @@ namespace
         uint8_t m_uBits[SizeInBytes];
     };
 
+    // Pixels of one BC6H region in SoA form, four pixels per vector
+    struct INTPixelsSoA
+    {
+        XMVECTOR r[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR g[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR b[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR valid[NUM_PIXELS_PER_BLOCK / 4];
+        size_t np;
+    };
+
+    struct INTPaletteSoA
+    {
+        float r[BC6H_MAX_INDICES];
+        float g[BC6H_MAX_INDICES];
+        float b[BC6H_MAX_INDICES];
+    };
+
     // BC6H compression (16 bits per texel)
     class D3DX_BC6H : private CBits< 16 >
     {
@@ -737,11 +763,11 @@ namespace
         static bool EndPointsFit(_In_ const EncodeParams* pEP, _In_reads_(BC6H_MAX_REGIONS) const INTEndPntPair aEndPts[]) noexcept;
 
         void GeneratePaletteQuantized(_In_ const EncodeParams* pEP, _In_ const INTEndPntPair& endPts,
-            _Out_writes_(BC6H_MAX_INDICES) INTColor aPalette[]) const noexcept;
-        float MapColorsQuantized(_In_ const EncodeParams* pEP, _In_reads_(np) const INTColor aColors[], _In_ size_t np, _In_ const INTEndPntPair &endPts) const noexcept;
-        float PerturbOne(_In_ const EncodeParams* pEP, _In_reads_(np) const INTColor aColors[], _In_ size_t np, _In_ uint8_t ch,
+            _Out_ INTPaletteSoA& aPalette) const noexcept;
+        float MapColorsQuantized(_In_ const EncodeParams* pEP, _In_ const INTPixelsSoA& aColors, _In_ const INTEndPntPair &endPts) const noexcept;
+        float PerturbOne(_In_ const EncodeParams* pEP, _In_ const INTPixelsSoA& aColors, _In_ uint8_t ch,
             _In_ const INTEndPntPair& oldEndPts, _Out_ INTEndPntPair& newEndPts, _In_ float fOldErr, _In_ int do_b) const noexcept;
-        void OptimizeOne(_In_ const EncodeParams* pEP, _In_reads_(np) const INTColor aColors[], _In_ size_t np, _In_ float aOrgErr,
+        void OptimizeOne(_In_ const EncodeParams* pEP, _In_ const INTPixelsSoA& aColors, _In_ float aOrgErr,
             _In_ const INTEndPntPair &aOrgEndPts, _Out_ INTEndPntPair &aOptEndPts) const noexcept;
         void OptimizeEndPoints(_In_ const EncodeParams* pEP, _In_reads_(BC6H_MAX_REGIONS) const float aOrgErr[],
             _In_reads_(BC6H_MAX_REGIONS) const INTEndPntPair aOrgEndPts[],
@@ -756,7 +782,7 @@ namespace
             _In_reads_(NUM_PIXELS_PER_BLOCK) const size_t aIndices[]) noexcept;
         void Refine(_Inout_ EncodeParams* pEP) noexcept;
 
-        static void GeneratePaletteUnquantized(_In_ const EncodeParams* pEP, _In_ size_t uRegion, _Out_writes_(BC6H_MAX_INDICES) INTColor aPalette[]) noexcept;
+        static void GeneratePaletteUnquantized(_In_ const EncodeParams* pEP, _In_ size_t uRegion, _Out_ INTPaletteSoA& aPalette) noexcept;
         float MapColors(_In_ const EncodeParams* pEP, _In_ size_t uRegion, _In_ size_t np, _In_reads_(np) const size_t* auIndex) const noexcept;
         float RoughMSE(_Inout_ EncodeParams* pEP) const noexcept;
 
@@ -769,6 +795,17 @@ namespace
         static const int ms_aModeToInfo[c_NumModeInfo];
     };
 
+    // Pixels of one BC7 region in SoA form, four pixels per vector
+    struct LDRPixelsSoA
+    {
+        XMVECTOR r[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR g[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR b[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR a[NUM_PIXELS_PER_BLOCK / 4];
+        XMVECTOR valid[NUM_PIXELS_PER_BLOCK / 4];
+        size_t uGroups;
+    };
+
     // BC67 compression (16b bits per texel)
     class D3DX_BC7 : private CBits< 16 >
     {
@@ -842,12 +879,12 @@ namespace
 
         void GeneratePaletteQuantized(_In_ const EncodeParams* pEP, _In_ size_t uIndexMode, _In_ const LDREndPntPair& endpts,
             _Out_writes_(BC7_MAX_INDICES) LDRColorA aPalette[]) const noexcept;
-        float PerturbOne(_In_ const EncodeParams* pEP, _In_reads_(np) const LDRColorA colors[], _In_ size_t np, _In_ size_t uIndexMode,
+        float PerturbOne(_In_ const EncodeParams* pEP, _In_ const LDRPixelsSoA& colors, _In_ size_t uIndexMode,
             _In_ size_t ch, _In_ const LDREndPntPair &old_endpts,
             _Out_ LDREndPntPair &new_endpts, _In_ float old_err, _In_ uint8_t do_b) const noexcept;
-        void Exhaustive(_In_ const EncodeParams* pEP, _In_reads_(np) const LDRColorA aColors[], _In_ size_t np, _In_ size_t uIndexMode,
+        void Exhaustive(_In_ const EncodeParams* pEP, _In_ const LDRPixelsSoA& aColors, _In_ size_t uIndexMode,
             _In_ size_t ch, _Inout_ float& fOrgErr, _Inout_ LDREndPntPair& optEndPt) const noexcept;
-        void OptimizeOne(_In_ const EncodeParams* pEP, _In_reads_(np) const LDRColorA colors[], _In_ size_t np, _In_ size_t uIndexMode,
+        void OptimizeOne(_In_ const EncodeParams* pEP, _In_ const LDRPixelsSoA& colors, _In_ size_t uIndexMode,
             _In_ float orig_err, _In_ const LDREndPntPair &orig_endpts, _Out_ LDREndPntPair &opt_endpts) const noexcept;
         void OptimizeEndPoints(_In_ const EncodeParams* pEP, _In_ size_t uShape, _In_ size_t uIndexMode,
             _In_reads_(BC7_MAX_REGIONS) const float orig_err[],
@@ -864,7 +901,7 @@ namespace
         void FixEndpointPBits(_In_ const EncodeParams* pEP, _In_reads_(BC7_MAX_REGIONS) const LDREndPntPair *pOrigEndpoints, _Out_writes_(BC7_MAX_REGIONS) LDREndPntPair *pFixedEndpoints) noexcept;
         float Refine(_In_ const EncodeParams* pEP, _In_ size_t uShape, _In_ size_t uRotation, _In_ size_t uIndexMode) noexcept;
 
-        float MapColors(_In_ const EncodeParams* pEP, _In_reads_(np) const LDRColorA aColors[], _In_ size_t np, _In_ size_t uIndexMode,
+        float MapColors(_In_ const EncodeParams* pEP, _In_ const LDRPixelsSoA& aColors, _In_ size_t uIndexMode,
             _In_ const LDREndPntPair& endPts, _In_ float fMinErr) const noexcept;
         static float RoughMSE(_Inout_ EncodeParams* pEP, _In_ size_t uShape, _In_ size_t uIndexMode) noexcept;
 
@@ -1164,14 +1201,6 @@ namespace
         }
     }
 
-    inline float Norm(_In_ const INTColor& a, _In_ const INTColor& b) noexcept
-    {
-        const float dr = float(a.r) - float(b.r);
-        const float dg = float(a.g) - float(b.g);
-        const float db = float(a.b) - float(b.b);
-        return dr * dr + dg * dg + db * db;
-    }
-
     // return # of bits needed to store n. handle signed or unsigned cases properly
     inline int NBits(_In_ int n, _In_ bool bIsSigned) noexcept
     {
@@ -1635,6 +1664,378 @@ namespace
     }
 
 
+    //-------------------------------------------------------------------------------------
+    // SIMD error evaluation for the BC7 endpoint search
+    //
+    // Four pixels are tested against each palette entry at once. Every lane replays the
+    // ComputeError search (stopping at the first entry whose error increases), and all of
+    // the errors are small integers, so the float results match ComputeError exactly.
+    //-------------------------------------------------------------------------------------
+    struct LDRPaletteSoA
+    {
+        float r[BC7_MAX_INDICES];
+        float g[BC7_MAX_INDICES];
+        float b[BC7_MAX_INDICES];
+        float a[BC7_MAX_INDICES];
+    };
+
+    void LoadPixelsSoA(
+        _In_reads_(np) const LDRColorA aColors[],
+        size_t np,
+        _Out_ LDRPixelsSoA& out) noexcept
+    {
+        assert(np <= NUM_PIXELS_PER_BLOCK);
+        _Analysis_assume_(np <= NUM_PIXELS_PER_BLOCK);
+
+        static const XMVECTORF32 s_LaneIndex = { { { 0.f, 1.f, 2.f, 3.f } } };
+
+        out.uGroups = (np + 3) >> 2;
+        for (size_t g = 0; g < out.uGroups; ++g)
+        {
+            LDRColorA c[4] = {};
+            const size_t uCount = std::min<size_t>(4, np - g * 4);
+            for (size_t j = 0; j < uCount; ++j)
+                c[j] = aColors[g * 4 + j];
+
+            out.r[g] = XMVectorSet(float(c[0].r), float(c[1].r), float(c[2].r), float(c[3].r));
+            out.g[g] = XMVectorSet(float(c[0].g), float(c[1].g), float(c[2].g), float(c[3].g));
+            out.b[g] = XMVectorSet(float(c[0].b), float(c[1].b), float(c[2].b), float(c[3].b));
+            out.a[g] = XMVectorSet(float(c[0].a), float(c[1].a), float(c[2].a), float(c[3].a));
+            out.valid[g] = XMVectorLess(s_LaneIndex, XMVectorReplicate(float(uCount)));
+        }
+    }
+
+    const XMVECTORF32* GetWeightsV(uint8_t uPrec) noexcept
+    {
+        switch (uPrec)
+        {
+        case 2: return g_aWeightsV2;
+        case 3: return g_aWeightsV3;
+        default: assert(uPrec == 4); return g_aWeightsV4;
+        }
+    }
+
+    // (c0 * (64 - w) + c1 * w + 32) >> 6 for four palette entries at once; exact in float
+    // for endpoints of up to 16 bits, signed or unsigned
+    inline XMVECTOR XM_CALLCONV InterpolateV(int c0, int c1, FXMVECTOR w) noexcept
+    {
+        static const XMVECTORF32 s_WeightMax = { { { 64.f, 64.f, 64.f, 64.f } } };
+        static const XMVECTORF32 s_WeightRound = { { { 32.f, 32.f, 32.f, 32.f } } };
+        static const XMVECTORF32 s_WeightScale = { { { 1.f / 64.f, 1.f / 64.f, 1.f / 64.f, 1.f / 64.f } } };
+
+        XMVECTOR v = XMVectorMultiplyAdd(XMVectorReplicate(float(c1)), w, s_WeightRound);
+        v = XMVectorMultiplyAdd(XMVectorReplicate(float(c0)), XMVectorSubtract(s_WeightMax, w), v);
+        return XMVectorFloor(XMVectorMultiply(v, s_WeightScale));
+    }
+
+    // Palette of endpoints c0 and c1; RGB entries use uIndexPrec and, when uIndexPrec2 is
+    // non-zero, the alpha entries use uIndexPrec2 (as GeneratePaletteQuantized)
+    void GeneratePaletteSoA(
+        _In_ const LDRColorA& c0,
+        _In_ const LDRColorA& c1,
+        uint8_t uIndexPrec,
+        uint8_t uIndexPrec2,
+        _Out_ LDRPaletteSoA& out) noexcept
+    {
+        const uint8_t uAlphaPrec = uIndexPrec2 ? uIndexPrec2 : uIndexPrec;
+        const XMVECTORF32* aWeights = GetWeightsV(uIndexPrec);
+        const XMVECTORF32* aWeights2 = GetWeightsV(uAlphaPrec);
+
+        for (size_t i = 0; i < (size_t(1) << uIndexPrec); i += 4)
+        {
+            const XMVECTOR w = aWeights[i >> 2];
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.r[i]), InterpolateV(c0.r, c1.r, w));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.g[i]), InterpolateV(c0.g, c1.g, w));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.b[i]), InterpolateV(c0.b, c1.b, w));
+        }
+
+        for (size_t i = 0; i < (size_t(1) << uAlphaPrec); i += 4)
+        {
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.a[i]), InterpolateV(c0.a, c1.a, aWeights2[i >> 2]));
+        }
+    }
+
+    // Per-lane best error over palette entries [0, uNumIndices) for pixel group g
+    template <bool bRGB, bool bAlpha>
+    XMVECTOR BestErrorSoA(
+        _In_ const LDRPixelsSoA& px,
+        size_t g,
+        _In_ const LDRPaletteSoA& pal,
+        size_t uNumIndices) noexcept
+    {
+        XMVECTOR vBest = g_XMFltMax;
+        XMVECTOR vActive = px.valid[g];
+
+        for (size_t i = 0; i < uNumIndices; ++i)
+        {
+            XMVECTOR vErr = XMVectorZero();
+            if (bRGB)
+            {
+                const XMVECTOR dr = XMVectorSubtract(px.r[g], XMVectorReplicatePtr(&pal.r[i]));
+                const XMVECTOR dg = XMVectorSubtract(px.g[g], XMVectorReplicatePtr(&pal.g[i]));
+                const XMVECTOR db = XMVectorSubtract(px.b[g], XMVectorReplicatePtr(&pal.b[i]));
+                vErr = XMVectorMultiplyAdd(dr, dr, XMVectorMultiplyAdd(dg, dg, XMVectorMultiply(db, db)));
+            }
+            if (bAlpha)
+            {
+                const XMVECTOR da = XMVectorSubtract(px.a[g], XMVectorReplicatePtr(&pal.a[i]));
+                vErr = XMVectorMultiplyAdd(da, da, vErr);
+            }
+
+            // a lane whose error increased is done searching, as is one that hit zero
+            const XMVECTOR vWorse = XMVectorGreater(vErr, vBest);
+            vBest = XMVectorSelect(vBest, vErr, XMVectorAndInt(vActive, XMVectorLess(vErr, vBest)));
+            vActive = XMVectorAndCInt(vActive, XMVectorOrInt(vWorse, XMVectorEqual(vBest, XMVectorZero())));
+            if (XMVector4EqualInt(vActive, XMVectorZero()))
+                break;
+        }
+
+        return XMVectorAndInt(vBest, px.valid[g]);
+    }
+
+    // Total error of the pixels against the palette, or FLT_MAX once it exceeds fMinErr
+    float ComputeErrorSoA(
+        _In_ const LDRPixelsSoA& px,
+        _In_ const LDRPaletteSoA& pal,
+        uint8_t uIndexPrec,
+        uint8_t uIndexPrec2,
+        float fMinErr) noexcept
+    {
+        const size_t uNumIndices = size_t(1) << uIndexPrec;
+        const size_t uNumIndices2 = size_t(1) << uIndexPrec2;
+
+        XMVECTOR vTotalErr = XMVectorZero();
+        for (size_t g = 0; g < px.uGroups; ++g)
+        {
+            if (uIndexPrec2 == 0)
+            {
+                vTotalErr = XMVectorAdd(vTotalErr, BestErrorSoA<true, true>(px, g, pal, uNumIndices));
+            }
+            else
+            {
+                vTotalErr = XMVectorAdd(vTotalErr, BestErrorSoA<true, false>(px, g, pal, uNumIndices));
+                vTotalErr = XMVectorAdd(vTotalErr, BestErrorSoA<false, true>(px, g, pal, uNumIndices2));
+            }
+
+            const float fTotalErr = XMVectorGetX(XMVector4Dot(vTotalErr, g_XMOne));
+            if (fTotalErr > fMinErr)   // check for early exit
+                return FLT_MAX;
+        }
+
+        return XMVectorGetX(XMVector4Dot(vTotalErr, g_XMOne));
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    // SIMD error evaluation for the BC6H endpoint search
+    //
+    // As for BC7, four pixels are tested against each palette entry at once with the
+    // ComputeError search replayed per lane. BC6H errors are not exact in float, so each
+    // pixel error is formed as (dr * dr + dg * dg) + db * db and the totals are accumulated
+    // in pixel order, which keeps the results identical to the previous scalar loops.
+    //-------------------------------------------------------------------------------------
+    void LoadPixelsSoA(
+        _In_reads_(np) const INTColor aColors[],
+        size_t np,
+        _Out_ INTPixelsSoA& out) noexcept
+    {
+        assert(np <= NUM_PIXELS_PER_BLOCK);
+        _Analysis_assume_(np <= NUM_PIXELS_PER_BLOCK);
+
+        static const XMVECTORF32 s_LaneIndex = { { { 0.f, 1.f, 2.f, 3.f } } };
+
+        out.np = np;
+        for (size_t g = 0; g < ((np + 3) >> 2); ++g)
+        {
+            INTColor c[4] = {};
+            const size_t uCount = std::min<size_t>(4, np - g * 4);
+            for (size_t j = 0; j < uCount; ++j)
+                c[j] = aColors[g * 4 + j];
+
+            out.r[g] = XMVectorSet(float(c[0].r), float(c[1].r), float(c[2].r), float(c[3].r));
+            out.g[g] = XMVectorSet(float(c[0].g), float(c[1].g), float(c[2].g), float(c[3].g));
+            out.b[g] = XMVectorSet(float(c[0].b), float(c[1].b), float(c[2].b), float(c[3].b));
+            out.valid[g] = XMVectorLess(s_LaneIndex, XMVectorReplicate(float(uCount)));
+        }
+    }
+
+    // Palette of unquantized endpoints; with bFinish the entries are scaled as FinishUnquantize
+    void GeneratePaletteSoA(
+        _In_ const INTEndPntPair& endPts,
+        uint8_t uIndexPrec,
+        bool bSigned,
+        bool bFinish,
+        _Out_ INTPaletteSoA& out) noexcept
+    {
+        static const XMVECTORF32 s_FinishSigned = { { { 31.f / 32.f, 31.f / 32.f, 31.f / 32.f, 31.f / 32.f } } };
+        static const XMVECTORF32 s_FinishUnsigned = { { { 31.f / 64.f, 31.f / 64.f, 31.f / 64.f, 31.f / 64.f } } };
+
+        const XMVECTORF32* aWeights = GetWeightsV(uIndexPrec);
+
+        for (size_t i = 0; i < (size_t(1) << uIndexPrec); i += 4)
+        {
+            const XMVECTOR w = aWeights[i >> 2];
+            XMVECTOR vr = InterpolateV(endPts.A.r, endPts.B.r, w);
+            XMVECTOR vg = InterpolateV(endPts.A.g, endPts.B.g, w);
+            XMVECTOR vb = InterpolateV(endPts.A.b, endPts.B.b, w);
+
+            if (bFinish)
+            {
+                // magnitude * 31/32 (signed) or * 31/64 (unsigned), rounded toward zero
+                const XMVECTOR vScale = bSigned ? s_FinishSigned : s_FinishUnsigned;
+                vr = XMVectorTruncate(XMVectorMultiply(vr, vScale));
+                vg = XMVectorTruncate(XMVectorMultiply(vg, vScale));
+                vb = XMVectorTruncate(XMVectorMultiply(vb, vScale));
+            }
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.r[i]), vr);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.g[i]), vg);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&out.b[i]), vb);
+        }
+    }
+
+    // Total error of the pixels against the palette, optionally returning the chosen indices
+    float ComputeErrorSoA(
+        _In_ const INTPixelsSoA& px,
+        _In_ const INTPaletteSoA& pal,
+        size_t uNumIndices,
+        _Out_writes_opt_(px.np) size_t* pBestIndex = nullptr) noexcept
+    {
+        float fTotalErr = 0.0f;
+        for (size_t g = 0; g < ((px.np + 3) >> 2); ++g)
+        {
+            XMVECTOR vBest = g_XMFltMax;
+            XMVECTOR vIndex = XMVectorZero();
+            XMVECTOR vActive = px.valid[g];
+
+            for (size_t i = 0; i < uNumIndices; ++i)
+            {
+                const XMVECTOR dr = XMVectorSubtract(px.r[g], XMVectorReplicatePtr(&pal.r[i]));
+                const XMVECTOR dg = XMVectorSubtract(px.g[g], XMVectorReplicatePtr(&pal.g[i]));
+                const XMVECTOR db = XMVectorSubtract(px.b[g], XMVectorReplicatePtr(&pal.b[i]));
+
+                XMVECTOR vErr = XMVectorAdd(XMVectorMultiply(dr, dr), XMVectorMultiply(dg, dg));
+                vErr = XMVectorAdd(vErr, XMVectorMultiply(db, db));
+
+                const XMVECTOR vWorse = XMVectorGreater(vErr, vBest);
+                const XMVECTOR vImproved = XMVectorAndInt(vActive, XMVectorLess(vErr, vBest));
+                vBest = XMVectorSelect(vBest, vErr, vImproved);
+                if (pBestIndex)
+                    vIndex = XMVectorSelect(vIndex, XMVectorReplicate(float(i)), vImproved);
+                vActive = XMVectorAndCInt(vActive, XMVectorOrInt(vWorse, XMVectorEqual(vBest, XMVectorZero())));
+                if (XMVector4EqualInt(vActive, XMVectorZero()))
+                    break;
+            }
+
+            XM_ALIGNED_DATA(16) float fBest[4];
+            XM_ALIGNED_DATA(16) float fIndex[4];
+            XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(fBest), vBest);
+            XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(fIndex), vIndex);
+
+            const size_t uCount = std::min<size_t>(4, px.np - g * 4);
+            for (size_t j = 0; j < uCount; ++j)
+            {
+                fTotalErr += fBest[j];
+                if (pBestIndex)
+                    pBestIndex[g * 4 + j] = static_cast<size_t>(fIndex[j]);
+            }
+        }
+
+        return fTotalErr;
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    // Block statistics used to prune BC7 modes
+    //-------------------------------------------------------------------------------------
+    struct BlockStats
+    {
+        float fOffAxisMSE;  // per-pixel variance not explained by the principal axis
+        float fOpaqueMSE;   // error of forcing alpha to 255, as with modes 0-3
+    };
+
+    BlockStats ComputeBlockStats(_In_reads_(NUM_PIXELS_PER_BLOCK) const LDRColorA aPixels[]) noexcept
+    {
+        BlockStats stats = {};
+
+        float fMean[4] = {};
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            for (size_t ch = 0; ch < 4; ++ch)
+                fMean[ch] += float(aPixels[i][ch]);
+
+            const float ea = 255.f - float(aPixels[i].a);
+            stats.fOpaqueMSE += ea * ea;
+        }
+
+        for (size_t ch = 0; ch < 4; ++ch)
+            fMean[ch] *= 1.f / float(NUM_PIXELS_PER_BLOCK);
+
+        float fCov[4][4] = {};
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
+        {
+            float d[4];
+            for (size_t ch = 0; ch < 4; ++ch)
+                d[ch] = float(aPixels[i][ch]) - fMean[ch];
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                for (size_t k = j; k < 4; ++k)
+                    fCov[j][k] += d[j] * d[k];
+            }
+        }
+
+        for (size_t j = 0; j < 4; ++j)
+        {
+            for (size_t k = 0; k < j; ++k)
+                fCov[j][k] = fCov[k][j];
+        }
+
+        const float fTrace = fCov[0][0] + fCov[1][1] + fCov[2][2] + fCov[3][3];
+        if (fTrace <= 0.f)
+            return stats;
+
+        // Largest eigenvalue by power iteration, starting from the row with the largest variance
+        size_t iStart = 0;
+        for (size_t j = 1; j < 4; ++j)
+        {
+            if (fCov[j][j] > fCov[iStart][iStart])
+                iStart = j;
+        }
+
+        float v[4] = { fCov[iStart][0], fCov[iStart][1], fCov[iStart][2], fCov[iStart][3] };
+        float fLambda = 0.f;
+        for (size_t iter = 0; iter < 8; ++iter)
+        {
+            float w[4] = {};
+            for (size_t j = 0; j < 4; ++j)
+            {
+                for (size_t k = 0; k < 4; ++k)
+                    w[j] += fCov[j][k] * v[k];
+            }
+
+            const float fLen2 = w[0] * w[0] + w[1] * w[1] + w[2] * w[2] + w[3] * w[3];
+            if (fLen2 <= 0.f)
+                break;
+
+            const float fScale = 1.f / sqrtf(fLen2);
+            for (size_t j = 0; j < 4; ++j)
+                v[j] = w[j] * fScale;
+
+            // Rayleigh quotient of the normalized vector
+            fLambda = 0.f;
+            for (size_t j = 0; j < 4; ++j)
+            {
+                for (size_t k = 0; k < 4; ++k)
+                    fLambda += v[j] * fCov[j][k] * v[k];
+            }
+        }
+
+        stats.fOffAxisMSE = std::max(0.f, fTrace - fLambda) * (1.f / float(NUM_PIXELS_PER_BLOCK));
+        return stats;
+    }
+
+
     void FillWithErrorColors(_Out_writes_(NUM_PIXELS_PER_BLOCK) HDRColorA* pOut) noexcept
     {
         for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
@@ -1820,32 +2221,41 @@ void D3DX_BC6H::Encode(bool bSigned, const HDRColorA* const pIn) noexcept
 
     EncodeParams EP(pIn, bSigned);
 
+    // RoughMSE only depends on the partition count (which fixes the shapes and the index
+    // precision), so the shape ranking is shared by all modes with the same count
+    float afRoughMSE[BC6H_MAX_SHAPES];
+    uint8_t auShape[BC6H_MAX_SHAPES];
+    uint8_t uRankedPartitions = UINT8_MAX;
+
     for (EP.uMode = 0; EP.uMode < c_NumModes && EP.fBestErr > 0; ++EP.uMode)
     {
         const uint8_t uShapes = ms_aInfo[EP.uMode].uPartitions ? 32u : 1u;
         // Number of rough cases to look at. reasonable values of this are 1, uShapes/4, and uShapes
         // uShapes/4 gets nearly all the cases; you can increase that a bit (say by 3 or 4) if you really want to squeeze the last bit out
         const size_t uItems = std::max<size_t>(1u, size_t(uShapes >> 2));
-        float afRoughMSE[BC6H_MAX_SHAPES];
-        uint8_t auShape[BC6H_MAX_SHAPES];
 
-        // pick the best uItems shapes and refine these.
-        for (EP.uShape = 0; EP.uShape < uShapes; ++EP.uShape)
+        if (ms_aInfo[EP.uMode].uPartitions != uRankedPartitions)
         {
-            size_t uShape = EP.uShape;
-            afRoughMSE[uShape] = RoughMSE(&EP);
-            auShape[uShape] = static_cast<uint8_t>(uShape);
-        }
+            uRankedPartitions = ms_aInfo[EP.uMode].uPartitions;
 
-        // Bubble up the first uItems items
-        for (size_t i = 0; i < uItems; i++)
-        {
-            for (size_t j = i + 1; j < uShapes; j++)
+            // pick the best uItems shapes and refine these.
+            for (EP.uShape = 0; EP.uShape < uShapes; ++EP.uShape)
             {
-                if (afRoughMSE[i] > afRoughMSE[j])
+                size_t uShape = EP.uShape;
+                afRoughMSE[uShape] = RoughMSE(&EP);
+                auShape[uShape] = static_cast<uint8_t>(uShape);
+            }
+
+            // Bubble up the first uItems items
+            for (size_t i = 0; i < uItems; i++)
+            {
+                for (size_t j = i + 1; j < uShapes; j++)
                 {
-                    std::swap(afRoughMSE[i], afRoughMSE[j]);
-                    std::swap(auShape[i], auShape[j]);
+                    if (afRoughMSE[i] > afRoughMSE[j])
+                    {
+                        std::swap(afRoughMSE[i], afRoughMSE[j]);
+                        std::swap(auShape[i], auShape[j]);
+                    }
                 }
             }
         }
@@ -1987,16 +2397,14 @@ bool D3DX_BC6H::EndPointsFit(const EncodeParams* pEP, const INTEndPntPair aEndPt
 
 
 _Use_decl_annotations_
-void D3DX_BC6H::GeneratePaletteQuantized(const EncodeParams* pEP, const INTEndPntPair& endPts, INTColor aPalette[]) const noexcept
+void D3DX_BC6H::GeneratePaletteQuantized(const EncodeParams* pEP, const INTEndPntPair& endPts, INTPaletteSoA& aPalette) const noexcept
 {
     assert(pEP);
     assert(pEP->uMode < c_NumModes);
     _Analysis_assume_(pEP->uMode < c_NumModes);
 
-    const size_t uIndexPrec = ms_aInfo[pEP->uMode].uIndexPrec;
-    const size_t uNumIndices = size_t(1) << uIndexPrec;
-    assert(uNumIndices > 0);
-    _Analysis_assume_(uNumIndices > 0);
+    const uint8_t uIndexPrec = ms_aInfo[pEP->uMode].uIndexPrec;
+    assert(uIndexPrec == 3 || uIndexPrec == 4);
     const LDRColorA& Prec = ms_aInfo[pEP->uMode].RGBAPrec[0][0];
 
     // scale endpoints
@@ -2009,76 +2417,28 @@ void D3DX_BC6H::GeneratePaletteQuantized(const EncodeParams* pEP, const INTEndPn
     unqEndPts.B.b = Unquantize(endPts.B.b, Prec.b, pEP->bSigned);
 
     // interpolate
-    const int* aWeights = nullptr;
-    switch (uIndexPrec)
-    {
-    case 3: aWeights = g_aWeights3; assert(uNumIndices <= 8); _Analysis_assume_(uNumIndices <= 8); break;
-    case 4: aWeights = g_aWeights4; assert(uNumIndices <= 16); _Analysis_assume_(uNumIndices <= 16); break;
-    default:
-        assert(false);
-        for (size_t i = 0; i < uNumIndices; ++i)
-        {
-        #pragma prefast(suppress:22102 22103, "writing blocks in two halves confuses tool")
-            aPalette[i] = INTColor(0, 0, 0);
-        }
-        return;
-    }
-
-    for (size_t i = 0; i < uNumIndices; ++i)
-    {
-        aPalette[i].r = FinishUnquantize(
-            (unqEndPts.A.r * (BC67_WEIGHT_MAX - aWeights[i]) + unqEndPts.B.r * aWeights[i] + BC67_WEIGHT_ROUND) >> BC67_WEIGHT_SHIFT,
-            pEP->bSigned);
-        aPalette[i].g = FinishUnquantize(
-            (unqEndPts.A.g * (BC67_WEIGHT_MAX - aWeights[i]) + unqEndPts.B.g * aWeights[i] + BC67_WEIGHT_ROUND) >> BC67_WEIGHT_SHIFT,
-            pEP->bSigned);
-        aPalette[i].b = FinishUnquantize(
-            (unqEndPts.A.b * (BC67_WEIGHT_MAX - aWeights[i]) + unqEndPts.B.b * aWeights[i] + BC67_WEIGHT_ROUND) >> BC67_WEIGHT_SHIFT,
-            pEP->bSigned);
-    }
+    GeneratePaletteSoA(unqEndPts, uIndexPrec, pEP->bSigned, true, aPalette);
 }
 
 
 // given a collection of colors and quantized endpoints, generate a palette, choose best entries, and return a single toterr
 _Use_decl_annotations_
-float D3DX_BC6H::MapColorsQuantized(const EncodeParams* pEP, const INTColor aColors[], size_t np, const INTEndPntPair &endPts) const noexcept
+float D3DX_BC6H::MapColorsQuantized(const EncodeParams* pEP, const INTPixelsSoA& aColors, const INTEndPntPair &endPts) const noexcept
 {
     assert(pEP);
     assert(pEP->uMode < c_NumModes);
     _Analysis_assume_(pEP->uMode < c_NumModes);
 
     const uint8_t uIndexPrec = ms_aInfo[pEP->uMode].uIndexPrec;
-    const auto uNumIndices = static_cast<const uint8_t>(1u << uIndexPrec);
-    INTColor aPalette[BC6H_MAX_INDICES];
+    INTPaletteSoA aPalette;
     GeneratePaletteQuantized(pEP, endPts, aPalette);
 
-    float fTotErr = 0;
-    for (size_t i = 0; i < np; ++i)
-    {
-        const XMVECTOR vcolors = XMLoadSInt4(reinterpret_cast<const XMINT4*>(&aColors[i]));
-
-        // Compute ErrorMetricRGB
-        XMVECTOR tpal = XMLoadSInt4(reinterpret_cast<const XMINT4*>(&aPalette[0]));
-        tpal = XMVectorSubtract(vcolors, tpal);
-        float fBestErr = XMVectorGetX(XMVector3Dot(tpal, tpal));
-
-        for (int j = 1; j < uNumIndices && fBestErr > 0; ++j)
-        {
-            // Compute ErrorMetricRGB
-            tpal = XMLoadSInt4(reinterpret_cast<const XMINT4*>(&aPalette[j]));
-            tpal = XMVectorSubtract(vcolors, tpal);
-            const float fErr = XMVectorGetX(XMVector3Dot(tpal, tpal));
-            if (fErr > fBestErr) break;     // error increased, so we're done searching
-            if (fErr < fBestErr) fBestErr = fErr;
-        }
-        fTotErr += fBestErr;
-    }
-    return fTotErr;
+    return ComputeErrorSoA(aColors, aPalette, size_t(1) << uIndexPrec);
 }
 
 
 _Use_decl_annotations_
-float D3DX_BC6H::PerturbOne(const EncodeParams* pEP, const INTColor aColors[], size_t np, uint8_t ch,
+float D3DX_BC6H::PerturbOne(const EncodeParams* pEP, const INTPixelsSoA& aColors, uint8_t ch,
     const INTEndPntPair& oldEndPts, INTEndPntPair& newEndPts, float fOldErr, int do_b) const noexcept
 {
     assert(pEP);
@@ -2119,7 +2479,7 @@ float D3DX_BC6H::PerturbOne(const EncodeParams* pEP, const INTColor aColors[], s
                     continue;
             }
 
-            const float fErr = MapColorsQuantized(pEP, aColors, np, tmpEndPts);
+            const float fErr = MapColorsQuantized(pEP, aColors, tmpEndPts);
 
             if (fErr < fMinErr)
             {
@@ -2142,7 +2502,7 @@ float D3DX_BC6H::PerturbOne(const EncodeParams* pEP, const INTColor aColors[], s
 
 
 _Use_decl_annotations_
-void D3DX_BC6H::OptimizeOne(const EncodeParams* pEP, const INTColor aColors[], size_t np, float aOrgErr,
+void D3DX_BC6H::OptimizeOne(const EncodeParams* pEP, const INTPixelsSoA& aColors, float aOrgErr,
     const INTEndPntPair &aOrgEndPts, INTEndPntPair &aOptEndPts) const noexcept
 {
     assert(pEP);
@@ -2159,8 +2519,8 @@ void D3DX_BC6H::OptimizeOne(const EncodeParams* pEP, const INTColor aColors[], s
     {
         // figure out which endpoint when perturbed gives the most improvement and start there
         // if we just alternate, we can easily end up in a local minima
-        const float fErr0 = PerturbOne(pEP, aColors, np, ch, aOptEndPts, new_a, aOptErr, 0);	// perturb endpt A
-        const float fErr1 = PerturbOne(pEP, aColors, np, ch, aOptEndPts, new_b, aOptErr, 1);	// perturb endpt B
+        const float fErr0 = PerturbOne(pEP, aColors, ch, aOptEndPts, new_a, aOptErr, 0);	// perturb endpt A
+        const float fErr1 = PerturbOne(pEP, aColors, ch, aOptEndPts, new_b, aOptErr, 1);	// perturb endpt B
 
         if (fErr0 < fErr1)
         {
@@ -2180,7 +2540,7 @@ void D3DX_BC6H::OptimizeOne(const EncodeParams* pEP, const INTColor aColors[], s
         // now alternate endpoints and keep trying until there is no improvement
         for (;;)
         {
-            const float fErr = PerturbOne(pEP, aColors, np, ch, aOptEndPts, newEndPts, aOptErr, do_b);
+            const float fErr = PerturbOne(pEP, aColors, ch, aOptEndPts, newEndPts, aOptErr, do_b);
             if (fErr >= aOptErr)
                 break;
             if (do_b == 0)
@@ -2218,7 +2578,10 @@ void D3DX_BC6H::OptimizeEndPoints(const EncodeParams* pEP, const float aOrgErr[]
             }
         }
 
-        OptimizeOne(pEP, aPixels, np, aOrgErr[p], aOrgEndPts[p], aOptEndPts[p]);
+        INTPixelsSoA pixels;
+        LoadPixelsSoA(aPixels, np, pixels);
+
+        OptimizeOne(pEP, pixels, aOrgErr[p], aOrgEndPts[p], aOptEndPts[p]);
     }
 }
 
@@ -2269,34 +2632,32 @@ void D3DX_BC6H::AssignIndices(const EncodeParams* pEP, const INTEndPntPair aEndP
     assert(uPartitions < BC6H_MAX_REGIONS && pEP->uShape < BC6H_MAX_SHAPES);
     _Analysis_assume_(uPartitions < BC6H_MAX_REGIONS && pEP->uShape < BC6H_MAX_SHAPES);
 
-    // build list of possibles
-    INTColor aPalette[BC6H_MAX_REGIONS][BC6H_MAX_INDICES];
-
     for (size_t p = 0; p <= uPartitions; ++p)
     {
-        GeneratePaletteQuantized(pEP, aEndPts[p], aPalette[p]);
-        aTotErr[p] = 0;
-    }
-
-    for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
-    {
-        const uint8_t uRegion = g_aPartitionTable[uPartitions][pEP->uShape][i];
-        assert(uRegion < BC6H_MAX_REGIONS);
-        _Analysis_assume_(uRegion < BC6H_MAX_REGIONS);
-        float fBestErr = Norm(pEP->aIPixels[i], aPalette[uRegion][0]);
-        aIndices[i] = 0;
-
-        for (uint8_t j = 1; j < uNumIndices && fBestErr > 0; ++j)
+        // collect the pixels in the region
+        INTColor aPixels[NUM_PIXELS_PER_BLOCK];
+        size_t auPixIdx[NUM_PIXELS_PER_BLOCK];
+        size_t np = 0;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; ++i)
         {
-            const float fErr = Norm(pEP->aIPixels[i], aPalette[uRegion][j]);
-            if (fErr > fBestErr) break;	// error increased, so we're done searching
-            if (fErr < fBestErr)
+            if (g_aPartitionTable[uPartitions][pEP->uShape][i] == p)
             {
-                fBestErr = fErr;
-                aIndices[i] = j;
+                auPixIdx[np] = i;
+                aPixels[np++] = pEP->aIPixels[i];
             }
         }
-        aTotErr[uRegion] += fBestErr;
+
+        INTPixelsSoA pixels;
+        LoadPixelsSoA(aPixels, np, pixels);
+
+        INTPaletteSoA aPalette;
+        GeneratePaletteQuantized(pEP, aEndPts[p], aPalette);
+
+        size_t auRegionIdx[NUM_PIXELS_PER_BLOCK];
+        aTotErr[p] = ComputeErrorSoA(pixels, aPalette, uNumIndices, auRegionIdx);
+
+        for (size_t i = 0; i < np; ++i)
+            aIndices[auPixIdx[i]] = auRegionIdx[i];
     }
 }
 
@@ -2427,7 +2788,7 @@ void D3DX_BC6H::Refine(EncodeParams* pEP) noexcept
 
 
 _Use_decl_annotations_
-void D3DX_BC6H::GeneratePaletteUnquantized(const EncodeParams* pEP, size_t uRegion, INTColor aPalette[]) noexcept
+void D3DX_BC6H::GeneratePaletteUnquantized(const EncodeParams* pEP, size_t uRegion, INTPaletteSoA& aPalette) noexcept
 {
     assert(pEP);
     assert(uRegion < BC6H_MAX_REGIONS && pEP->uShape < BC6H_MAX_SHAPES);
@@ -2437,31 +2798,9 @@ void D3DX_BC6H::GeneratePaletteUnquantized(const EncodeParams* pEP, size_t uRegi
 
     const INTEndPntPair& endPts = pEP->aUnqEndPts[pEP->uShape][uRegion];
     const uint8_t uIndexPrec = ms_aInfo[pEP->uMode].uIndexPrec;
-    const auto uNumIndices = static_cast<const uint8_t>(1u << uIndexPrec);
-    assert(uNumIndices > 0);
-    _Analysis_assume_(uNumIndices > 0);
+    assert(uIndexPrec == 3 || uIndexPrec == 4);
 
-    const int* aWeights = nullptr;
-    switch (uIndexPrec)
-    {
-    case 3: aWeights = g_aWeights3; assert(uNumIndices <= 8); _Analysis_assume_(uNumIndices <= 8); break;
-    case 4: aWeights = g_aWeights4; assert(uNumIndices <= 16); _Analysis_assume_(uNumIndices <= 16); break;
-    default:
-        assert(false);
-        for (size_t i = 0; i < uNumIndices; ++i)
-        {
-        #pragma prefast(suppress:22102 22103, "writing blocks in two halves confuses tool")
-            aPalette[i] = INTColor(0, 0, 0);
-        }
-        return;
-    }
-
-    for (size_t i = 0; i < uNumIndices; ++i)
-    {
-        aPalette[i].r = (endPts.A.r * (BC67_WEIGHT_MAX - aWeights[i]) + endPts.B.r * aWeights[i] + BC67_WEIGHT_ROUND) >> BC67_WEIGHT_SHIFT;
-        aPalette[i].g = (endPts.A.g * (BC67_WEIGHT_MAX - aWeights[i]) + endPts.B.g * aWeights[i] + BC67_WEIGHT_ROUND) >> BC67_WEIGHT_SHIFT;
-        aPalette[i].b = (endPts.A.b * (BC67_WEIGHT_MAX - aWeights[i]) + endPts.B.b * aWeights[i] + BC67_WEIGHT_ROUND) >> BC67_WEIGHT_SHIFT;
-    }
+    GeneratePaletteSoA(endPts, uIndexPrec, pEP->bSigned, false, aPalette);
 }
 
 
@@ -2471,26 +2810,21 @@ float D3DX_BC6H::MapColors(const EncodeParams* pEP, size_t uRegion, size_t np, c
     assert(pEP);
     assert(pEP->uMode < c_NumModes);
     _Analysis_assume_(pEP->uMode < c_NumModes);
+    assert(np <= NUM_PIXELS_PER_BLOCK);
+    _Analysis_assume_(np <= NUM_PIXELS_PER_BLOCK);
 
     const uint8_t uIndexPrec = ms_aInfo[pEP->uMode].uIndexPrec;
-    const auto uNumIndices = static_cast<const uint8_t>(1u << uIndexPrec);
-    INTColor aPalette[BC6H_MAX_INDICES];
+    INTPaletteSoA aPalette;
     GeneratePaletteUnquantized(pEP, uRegion, aPalette);
 
-    float fTotalErr = 0.0f;
+    INTColor aPixels[NUM_PIXELS_PER_BLOCK];
     for (size_t i = 0; i < np; ++i)
-    {
-        float fBestErr = Norm(pEP->aIPixels[auIndex[i]], aPalette[0]);
-        for (uint8_t j = 1; j < uNumIndices && fBestErr > 0.0f; ++j)
-        {
-            const float fErr = Norm(pEP->aIPixels[auIndex[i]], aPalette[j]);
-            if (fErr > fBestErr) break;      // error increased, so we're done searching
-            if (fErr < fBestErr) fBestErr = fErr;
-        }
-        fTotalErr += fBestErr;
-    }
+        aPixels[i] = pEP->aIPixels[auIndex[i]];
 
-    return fTotalErr;
+    INTPixelsSoA pixels;
+    LoadPixelsSoA(aPixels, np, pixels);
+
+    return ComputeErrorSoA(pixels, aPalette, size_t(1) << uIndexPrec);
 }
 
 _Use_decl_annotations_
@@ -2800,8 +3134,33 @@ void D3DX_BC7::Encode(uint32_t flags, const HDRColorA* const pIn) noexcept
 
     const bool bHasAlpha = (alphaMask != 0xFF);
 
-    for (EP.uMode = 0; EP.uMode < 8 && fMSEBest > 0; ++EP.uMode)
+    // The pruning tiers visit the single subset modes first so that fMSEBest is meaningful
+    // by the time the partitioned modes are reached
+    static const uint8_t s_aModeOrder[c_NumModes] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    static const uint8_t s_aPrunedModeOrder[c_NumModes] = { 6, 5, 4, 1, 3, 7, 0, 2 };
+
+    const bool bPrune = (flags & (BC_FLAGS_BC7_PRUNE | BC_FLAGS_BC7_PRUNE_MORE)) != 0;
+
+    bool bSkipPartitions = false;
+    float fOpaqueMSE = 0.f;
+    if (bPrune)
+    {
+        const BlockStats stats = ComputeBlockStats(EP.aLDRPixels);
+
+        // Colors that are close to a line are already served by the single subset modes
+        const float fLinearThreshold = (flags & BC_FLAGS_BC7_PRUNE_MORE) ? 16.f : 4.f;
+        bSkipPartitions = (stats.fOffAxisMSE <= fLinearThreshold);
+
+        // Modes 0-3 have no alpha, so this much error is unavoidable with them
+        fOpaqueMSE = stats.fOpaqueMSE;
+    }
+
+    const uint8_t* pModeOrder = bPrune ? s_aPrunedModeOrder : s_aModeOrder;
+
+    for (size_t iMode = 0; iMode < c_NumModes && fMSEBest > 0; ++iMode)
     {
+        EP.uMode = pModeOrder[iMode];
+
         if (!(flags & BC_FLAGS_USE_3SUBSETS) && (EP.uMode == 0 || EP.uMode == 2))
         {
             // 3 subset modes tend to be used rarely and add significant compression time
@@ -2820,6 +3179,15 @@ void D3DX_BC7::Encode(uint32_t flags, const HDRColorA* const pIn) noexcept
             continue;
         }
 
+        if (bPrune)
+        {
+            if (bSkipPartitions && ms_aInfo[EP.uMode].uPartitions > 0)
+                continue;
+
+            if (EP.uMode < 4 && fOpaqueMSE >= fMSEBest)
+                continue;
+        }
+
         const size_t uShapes = size_t(1) << ms_aInfo[EP.uMode].uPartitionBits;
         assert(uShapes <= BC7_MAX_SHAPES);
         _Analysis_assume_(uShapes <= BC7_MAX_SHAPES);
@@ -2828,7 +3196,7 @@ void D3DX_BC7::Encode(uint32_t flags, const HDRColorA* const pIn) noexcept
         const size_t uNumIdxMode = size_t(1) << ms_aInfo[EP.uMode].uIndexModeBits;
         // Number of rough cases to look at. reasonable values of this are 1, uShapes/4, and uShapes
         // uShapes/4 gets nearly all the cases; you can increase that a bit (say by 3 or 4) if you really want to squeeze the last bit out
-        const size_t uItems = std::max<size_t>(1, uShapes >> 2);
+        const size_t uItems = std::max<size_t>(1, uShapes >> ((flags & BC_FLAGS_BC7_PRUNE_MORE) ? 4 : 2));
         float afRoughMSE[BC7_MAX_SHAPES];
         size_t auShape[BC7_MAX_SHAPES];
 
@@ -2866,6 +3234,11 @@ void D3DX_BC7::Encode(uint32_t flags, const HDRColorA* const pIn) noexcept
 
                 for (size_t i = 0; i < uItems && fMSEBest > 0; i++)
                 {
+                    // The unquantized fit is rarely beaten by refinement, so don't refine
+                    // shapes that already look worse than the best block so far
+                    if (bPrune && afRoughMSE[i] > fMSEBest)
+                        break;
+
                     const float fMSE = Refine(&EP, auShape[i], r, im);
                     if (fMSE < fMSEBest)
                     {
@@ -2923,7 +3296,7 @@ void D3DX_BC7::GeneratePaletteQuantized(const EncodeParams* pEP, size_t uIndexMo
 }
 
 _Use_decl_annotations_
-float D3DX_BC7::PerturbOne(const EncodeParams* pEP, const LDRColorA aColors[], size_t np, size_t uIndexMode, size_t ch,
+float D3DX_BC7::PerturbOne(const EncodeParams* pEP, const LDRPixelsSoA& aColors, size_t uIndexMode, size_t ch,
     const LDREndPntPair &oldEndPts, LDREndPntPair &newEndPts, float fOldErr, uint8_t do_b) const noexcept
 {
     assert(pEP);
@@ -2949,7 +3322,7 @@ float D3DX_BC7::PerturbOne(const EncodeParams* pEP, const LDRColorA aColors[], s
             else
                 *ptmp_c = static_cast<uint8_t>(tmp);
 
-            const float fTotalErr = MapColors(pEP, aColors, np, uIndexMode, tmp_endPts, fMinErr);
+            const float fTotalErr = MapColors(pEP, aColors, uIndexMode, tmp_endPts, fMinErr);
             if (fTotalErr < fMinErr)
             {
                 bImproved = true;
@@ -2968,7 +3341,7 @@ float D3DX_BC7::PerturbOne(const EncodeParams* pEP, const LDRColorA aColors[], s
 // perturb the endpoints at least -3 to 3.
 // always ensure endpoint ordering is preserved (no need to overlap the scan)
 _Use_decl_annotations_
-void D3DX_BC7::Exhaustive(const EncodeParams* pEP, const LDRColorA aColors[], size_t np, size_t uIndexMode, size_t ch,
+void D3DX_BC7::Exhaustive(const EncodeParams* pEP, const LDRPixelsSoA& aColors, size_t uIndexMode, size_t ch,
     float& fOrgErr, LDREndPntPair& optEndPt) const noexcept
 {
     assert(pEP);
@@ -3002,7 +3375,7 @@ void D3DX_BC7::Exhaustive(const EncodeParams* pEP, const LDRColorA aColors[], si
                 tmpEndPt.A[ch] = static_cast<uint8_t>(a);
                 tmpEndPt.B[ch] = static_cast<uint8_t>(b);
 
-                const float fErr = MapColors(pEP, aColors, np, uIndexMode, tmpEndPt, fBestErr);
+                const float fErr = MapColors(pEP, aColors, uIndexMode, tmpEndPt, fBestErr);
                 if (fErr < fBestErr)
                 {
                     amin = a;
@@ -3022,7 +3395,7 @@ void D3DX_BC7::Exhaustive(const EncodeParams* pEP, const LDRColorA aColors[], si
                 tmpEndPt.A[ch] = static_cast<uint8_t>(a);
                 tmpEndPt.B[ch] = static_cast<uint8_t>(b);
 
-                const float fErr = MapColors(pEP, aColors, np, uIndexMode, tmpEndPt, fBestErr);
+                const float fErr = MapColors(pEP, aColors, uIndexMode, tmpEndPt, fBestErr);
                 if (fErr < fBestErr)
                 {
                     amin = a;
@@ -3042,7 +3415,7 @@ void D3DX_BC7::Exhaustive(const EncodeParams* pEP, const LDRColorA aColors[], si
 }
 
 _Use_decl_annotations_
-void D3DX_BC7::OptimizeOne(const EncodeParams* pEP, const LDRColorA aColors[], size_t np, size_t uIndexMode,
+void D3DX_BC7::OptimizeOne(const EncodeParams* pEP, const LDRPixelsSoA& aColors, size_t uIndexMode,
     float fOrgErr, const LDREndPntPair& org, LDREndPntPair& opt) const noexcept
 {
     assert(pEP);
@@ -3064,8 +3437,8 @@ void D3DX_BC7::OptimizeOne(const EncodeParams* pEP, const LDRColorA aColors[], s
 
         // figure out which endpoint when perturbed gives the most improvement and start there
         // if we just alternate, we can easily end up in a local minima
-        const float fErr0 = PerturbOne(pEP, aColors, np, uIndexMode, ch, opt, new_a, fOptErr, 0);	// perturb endpt A
-        const float fErr1 = PerturbOne(pEP, aColors, np, uIndexMode, ch, opt, new_b, fOptErr, 1);	// perturb endpt B
+        const float fErr0 = PerturbOne(pEP, aColors, uIndexMode, ch, opt, new_a, fOptErr, 0);	// perturb endpt A
+        const float fErr1 = PerturbOne(pEP, aColors, uIndexMode, ch, opt, new_b, fOptErr, 1);	// perturb endpt B
 
         uint8_t& copt_a = opt.A[ch];
         uint8_t& copt_b = opt.B[ch];
@@ -3092,7 +3465,7 @@ void D3DX_BC7::OptimizeOne(const EncodeParams* pEP, const LDRColorA aColors[], s
         // now alternate endpoints and keep trying until there is no improvement
         for (; ; )
         {
-            const float fErr = PerturbOne(pEP, aColors, np, uIndexMode, ch, opt, newEndPts, fOptErr, do_b);
+            const float fErr = PerturbOne(pEP, aColors, uIndexMode, ch, opt, newEndPts, fOptErr, do_b);
             if (fErr >= fOptErr)
                 break;
             if (do_b == 0)
@@ -3106,7 +3479,7 @@ void D3DX_BC7::OptimizeOne(const EncodeParams* pEP, const LDRColorA aColors[], s
 
     // finally, do a small exhaustive search around what we think is the global minima to be sure
     for (size_t ch = 0; ch < BC7_NUM_CHANNELS; ch++)
-        Exhaustive(pEP, aColors, np, uIndexMode, ch, fOptErr, opt);
+        Exhaustive(pEP, aColors, uIndexMode, ch, fOptErr, opt);
 }
 
 _Use_decl_annotations_
@@ -3131,7 +3504,10 @@ void D3DX_BC7::OptimizeEndPoints(const EncodeParams* pEP, size_t uShape, size_t
             if (g_aPartitionTable[uPartitions][uShape][i] == p)
                 aPixels[np++] = pEP->aLDRPixels[i];
 
-        OptimizeOne(pEP, aPixels, np, uIndexMode, afOrgErr[p], aOrgEndPts[p], aOptEndPts[p]);
+        LDRPixelsSoA pixels;
+        LoadPixelsSoA(aPixels, np, pixels);
+
+        OptimizeOne(pEP, pixels, uIndexMode, afOrgErr[p], aOrgEndPts[p], aOptEndPts[p]);
     }
 }
 
@@ -3463,7 +3839,7 @@ float D3DX_BC7::Refine(const EncodeParams* pEP, size_t uShape, size_t uRotation,
 }
 
 _Use_decl_annotations_
-float D3DX_BC7::MapColors(const EncodeParams* pEP, const LDRColorA aColors[], size_t np, size_t uIndexMode, const LDREndPntPair& endPts, float fMinErr) const noexcept
+float D3DX_BC7::MapColors(const EncodeParams* pEP, const LDRPixelsSoA& aColors, size_t uIndexMode, const LDREndPntPair& endPts, float fMinErr) const noexcept
 {
     assert(pEP);
     assert(pEP->uMode < c_NumModes);
@@ -3471,21 +3847,14 @@ float D3DX_BC7::MapColors(const EncodeParams* pEP, const LDRColorA aColors[], si
 
     const uint8_t uIndexPrec = uIndexMode ? ms_aInfo[pEP->uMode].uIndexPrec2 : ms_aInfo[pEP->uMode].uIndexPrec;
     const uint8_t uIndexPrec2 = uIndexMode ? ms_aInfo[pEP->uMode].uIndexPrec : ms_aInfo[pEP->uMode].uIndexPrec2;
-    LDRColorA aPalette[BC7_MAX_INDICES];
-    float fTotalErr = 0;
 
-    GeneratePaletteQuantized(pEP, uIndexMode, endPts, aPalette);
-    for (size_t i = 0; i < np; ++i)
-    {
-        fTotalErr += ComputeError(aColors[i], aPalette, uIndexPrec, uIndexPrec2);
-        if (fTotalErr > fMinErr)   // check for early exit
-        {
-            fTotalErr = FLT_MAX;
-            break;
-        }
-    }
+    const LDRColorA a = Unquantize(endPts.A, ms_aInfo[pEP->uMode].RGBAPrecWithP);
+    const LDRColorA b = Unquantize(endPts.B, ms_aInfo[pEP->uMode].RGBAPrecWithP);
 
-    return fTotalErr;
+    LDRPaletteSoA aPalette;
+    GeneratePaletteSoA(a, b, uIndexPrec, uIndexPrec2, aPalette);
+
+    return ComputeErrorSoA(aColors, aPalette, uIndexPrec, uIndexPrec2, fMinErr);
 }
 
 _Use_decl_annotations_
@@ -3505,10 +3874,7 @@ float D3DX_BC7::RoughMSE(EncodeParams* pEP, size_t uShape, size_t uIndexMode) no
 
     const uint8_t uIndexPrec = uIndexMode ? ms_aInfo[pEP->uMode].uIndexPrec2 : ms_aInfo[pEP->uMode].uIndexPrec;
     const uint8_t uIndexPrec2 = uIndexMode ? ms_aInfo[pEP->uMode].uIndexPrec : ms_aInfo[pEP->uMode].uIndexPrec2;
-    const auto uNumIndices = static_cast<const uint8_t>(1u << uIndexPrec);
-    const auto uNumIndices2 = static_cast<const uint8_t>(1u << uIndexPrec2);
     size_t auPixIdx[NUM_PIXELS_PER_BLOCK];
-    LDRColorA aPalette[BC7_MAX_REGIONS][BC7_MAX_INDICES];
 
     for (size_t p = 0; p <= uPartitions; p++)
     {
@@ -3569,28 +3935,22 @@ float D3DX_BC7::RoughMSE(EncodeParams* pEP, size_t uShape, size_t uIndexMode) no
         }
     }
 
-    if (uIndexPrec2 == 0)
-    {
-        for (size_t p = 0; p <= uPartitions; p++)
-            for (size_t i = 0; i < uNumIndices; i++)
-                LDRColorA::Interpolate(aEndPts[p].A, aEndPts[p].B, i, i, uIndexPrec, uIndexPrec, aPalette[p][i]);
-    }
-    else
-    {
-        for (size_t p = 0; p <= uPartitions; p++)
-        {
-            for (size_t i = 0; i < uNumIndices; i++)
-                LDRColorA::InterpolateRGB(aEndPts[p].A, aEndPts[p].B, i, uIndexPrec, aPalette[p][i]);
-            for (size_t i = 0; i < uNumIndices2; i++)
-                LDRColorA::InterpolateA(aEndPts[p].A, aEndPts[p].B, i, uIndexPrec2, aPalette[p][i]);
-        }
-    }
-
     float fTotalErr = 0;
-    for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; i++)
+    for (size_t p = 0; p <= uPartitions; p++)
     {
-        const uint8_t uRegion = g_aPartitionTable[uPartitions][uShape][i];
-        fTotalErr += ComputeError(pEP->aLDRPixels[i], aPalette[uRegion], uIndexPrec, uIndexPrec2);
+        LDRColorA aPixels[NUM_PIXELS_PER_BLOCK];
+        size_t np = 0;
+        for (size_t i = 0; i < NUM_PIXELS_PER_BLOCK; i++)
+            if (g_aPartitionTable[uPartitions][uShape][i] == p)
+                aPixels[np++] = pEP->aLDRPixels[i];
+
+        LDRPixelsSoA pixels;
+        LoadPixelsSoA(aPixels, np, pixels);
+
+        LDRPaletteSoA aPalette;
+        GeneratePaletteSoA(aEndPts[p].A, aEndPts[p].B, uIndexPrec, uIndexPrec2, aPalette);
+
+        fTotalErr += ComputeErrorSoA(pixels, aPalette, uIndexPrec, uIndexPrec2, FLT_MAX);
     }
 
     return fTotalErr;
@@ -127,6 +127,15 @@ namespace DirectX
 
         CP_FLAGS_LIMIT_4GB = 0x10000000,
         // Don't allow pixel allocations in excess of 4GB (always true for 32-bit)
+
+        CP_FLAGS_NO_ZERO_FILL = 0x20000000,
+        // ScratchImage::Initialize* leaves pixel memory uninitialized (caller writes every byte)
+
+        CP_FLAGS_REUSE_MEMORY = 0x40000000,
+        // ScratchImage::Initialize* keeps the current pixel allocation if it is large enough, and no more than twice
+        // the size needed, otherwise it is freed and an exact-size block is allocated
+        // Convert, ConvertToSinglePlane, Resize, GenerateMipMaps/3D, PremultiplyAlpha, Compress, and Decompress always
+        // set up their output ScratchImage this way; call Release() on it first to force a fresh allocation
     };
 
     DIRECTX_TEX_API HRESULT __cdecl ComputePitch(
@@ -248,6 +257,10 @@ namespace DirectX
         DDS_FLAGS_IGNORE_MIPS = 0x100,
         // Allow some files to be read that have incorrect mipcount values in the header by only reading the top-level mip
 
+        DDS_FLAGS_NO_COPY = 0x200,
+        // LoadFromDDSMemory returns images that reference the source buffer when no conversion is required (the buffer must outlive the result)
+        // Only honored by the overloads taking a non-const uint8_t* buffer, since the returned pixels are writable; const sources are always copied
+
         DDS_FLAGS_FORCE_DX10_EXT = 0x10000,
         // Always use the 'DX10' header extension for DDS writer (i.e. don't try to write DX9 compatible DDS files)
 
@@ -429,13 +442,15 @@ namespace DirectX
         uint8_t*    pixels;
     };
 
+    class IMemoryAllocator;
+
     class DIRECTX_TEX_API ScratchImage
     {
     public:
         ScratchImage() noexcept
-            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr) {}
+            : m_nimages(0), m_size(0), m_capacity(0), m_metadata{}, m_image(nullptr), m_memory(nullptr), m_allocator(nullptr) {}
         ScratchImage(ScratchImage&& moveFrom) noexcept
-            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr) { *this = std::move(moveFrom); }
+            : m_nimages(0), m_size(0), m_capacity(0), m_metadata{}, m_image(nullptr), m_memory(nullptr), m_allocator(nullptr) { *this = std::move(moveFrom); }
         ~ScratchImage() { Release(); }
 
         ScratchImage& __cdecl operator= (ScratchImage&& moveFrom) noexcept;
@@ -455,6 +470,12 @@ namespace DirectX
         HRESULT __cdecl InitializeCubeFromImages(_In_reads_(nImages) const Image* images, _In_ size_t nImages, _In_ CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
         HRESULT __cdecl Initialize3DFromImages(_In_reads_(depth) const Image* images, _In_ size_t depth, _In_ CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
 
+        HRESULT __cdecl InitializeFromMemory(_In_ const TexMetadata& mdata, _In_reads_bytes_(size) uint8_t* pixels, _In_ size_t size,
+            _In_opt_ IMemoryAllocator* owner = nullptr, _In_ CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
+            // Lays out the image array directly over caller memory without copying. If owner is non-null the
+            // ScratchImage takes ownership and calls owner->Free(pixels, size) on Release, otherwise the memory
+            // must outlive the ScratchImage (or its next Initialize/Release)
+
         void __cdecl Release() noexcept;
 
         bool __cdecl OverrideFormat(_In_ DXGI_FORMAT f) noexcept;
@@ -473,9 +494,14 @@ namespace DirectX
     private:
         size_t      m_nimages;
         size_t      m_size;
+        size_t      m_capacity;
         TexMetadata m_metadata;
         Image*      m_image;
         uint8_t*    m_memory;
+        IMemoryAllocator* m_allocator;
+
+        void __cdecl ReleaseForInitialize(_In_ CP_FLAGS flags) noexcept;
+        HRESULT __cdecl AllocateImages(_In_ size_t nimages, _In_ size_t pixelSize, _In_ CP_FLAGS flags) noexcept;
     };
 
     //---------------------------------------------------------------------------------
@@ -483,8 +509,8 @@ namespace DirectX
     class DIRECTX_TEX_API Blob
     {
     public:
-        Blob() noexcept : m_buffer(nullptr), m_size(0) {}
-        Blob(Blob&& moveFrom) noexcept : m_buffer(nullptr), m_size(0) { *this = std::move(moveFrom); }
+        Blob() noexcept : m_buffer(nullptr), m_size(0), m_capacity(0), m_allocator(nullptr) {}
+        Blob(Blob&& moveFrom) noexcept : m_buffer(nullptr), m_size(0), m_capacity(0), m_allocator(nullptr) { *this = std::move(moveFrom); }
         ~Blob() { Release(); }
 
         Blob& __cdecl operator= (Blob&& moveFrom) noexcept;
@@ -511,8 +537,56 @@ namespace DirectX
     private:
         uint8_t* m_buffer;
         size_t   m_size;
+        size_t   m_capacity;
+        IMemoryAllocator* m_allocator;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Task scheduling (used by functions that support multithreading)
+    class ITaskExecutor
+    {
+    public:
+        virtual void __cdecl ParallelFor(
+            _In_ size_t count,
+            _In_ const std::function<bool __cdecl(size_t index)>& task) noexcept = 0;
+            // Invokes task for every index in [0, count), possibly concurrently, and returns once all have
+            // completed. Once any invocation returns false, indices not yet started may be skipped.
+
+    protected:
+        ~ITaskExecutor() = default;
     };
 
+    DIRECTX_TEX_API ITaskExecutor* __cdecl GetDefaultTaskExecutor() noexcept;
+        // Process-wide work-stealing thread pool with one worker per hardware thread
+        // The pool is never torn down, so its workers are not joined during static destruction or DLL unload
+
+    //---------------------------------------------------------------------------------
+    // Memory allocation (used by ScratchImage, Blob, and internal scanline buffers)
+    class IMemoryAllocator
+    {
+    public:
+        virtual void* __cdecl Allocate(_In_ size_t size, _In_ size_t alignment) noexcept = 0;
+            // Returns nullptr on failure. alignment is a power of two (ScratchImage and Blob use 16)
+
+        virtual void __cdecl Free(_In_opt_ void* ptr, _In_ size_t size) noexcept = 0;
+            // size is the value passed to the Allocate call that returned ptr
+
+    protected:
+        ~IMemoryAllocator() = default;
+    };
+
+    DIRECTX_TEX_API IMemoryAllocator* __cdecl GetPooledMemoryAllocator() noexcept;
+        // Process-wide size-class pool that keeps freed blocks of 32K or more for reuse
+        // (pooled blocks are 64-byte aligned, larger alignments fail)
+
+    DIRECTX_TEX_API void __cdecl SetPooledMemoryLimit(_In_ size_t maxCachedBytes) noexcept;
+        // Caps the bytes held by the pool while unused (default 256MB); 0 frees all cached blocks
+
+    DIRECTX_TEX_API IMemoryAllocator* __cdecl GetMemoryAllocator() noexcept;
+    DIRECTX_TEX_API void __cdecl SetMemoryAllocator(_In_opt_ IMemoryAllocator* allocator) noexcept;
+        // Allocator used by new ScratchImage and Blob allocations and by internal scanline buffers; nullptr restores _aligned_malloc
+        // Memory is always returned to the allocator it came from, so this can change at any time
+
     //---------------------------------------------------------------------------------
     // Image I/O
 
@@ -521,6 +595,11 @@ namespace DirectX
         _In_reads_bytes_(size) const uint8_t* pSource, _In_ size_t size,
         _In_ DDS_FLAGS flags,
         _Out_opt_ TexMetadata* metadata, _Out_ ScratchImage& image) noexcept;
+    DIRECTX_TEX_API HRESULT __cdecl LoadFromDDSMemory(
+        _Inout_updates_bytes_(size) uint8_t* pSource, _In_ size_t size,
+        _In_ DDS_FLAGS flags,
+        _Out_opt_ TexMetadata* metadata, _Out_ ScratchImage& image) noexcept;
+        // With DDS_FLAGS_NO_COPY the result may reference pSource, and changes to its pixels write to that buffer
     DIRECTX_TEX_API HRESULT __cdecl LoadFromDDSFile(
         _In_z_ const wchar_t* szFile,
         _In_ DDS_FLAGS flags,
@@ -532,6 +611,12 @@ namespace DirectX
         _Out_opt_ TexMetadata* metadata,
         _Out_opt_ DDSMetaData* ddPixelFormat,
         _Out_ ScratchImage& image) noexcept;
+    DIRECTX_TEX_API HRESULT __cdecl LoadFromDDSMemoryEx(
+        _Inout_updates_bytes_(size) uint8_t* pSource, _In_ size_t size,
+        _In_ DDS_FLAGS flags,
+        _Out_opt_ TexMetadata* metadata,
+        _Out_opt_ DDSMetaData* ddPixelFormat,
+        _Out_ ScratchImage& image) noexcept;
     DIRECTX_TEX_API HRESULT __cdecl LoadFromDDSFileEx(
         _In_z_ const wchar_t* szFile,
         _In_ DDS_FLAGS flags,
@@ -694,6 +779,10 @@ namespace DirectX
         TEX_FILTER_FLOAT_X2BIAS = 0x200,
         // Enable *2 - 1 conversion cases for unorm<->float and positive-only float formats
 
+        TEX_FILTER_FUSED_MIPS = 0x400,
+        // Box filter mipmap generation produces every level in a single pass over the base image, keeping
+        // intermediate levels in full float precision (results can differ slightly from level-by-level filtering)
+
         TEX_FILTER_RGB_COPY_RED = 0x1000,
         TEX_FILTER_RGB_COPY_GREEN = 0x2000,
         TEX_FILTER_RGB_COPY_BLUE = 0x4000,
@@ -712,7 +801,11 @@ namespace DirectX
         TEX_FILTER_BOX = 0x400000,
         TEX_FILTER_FANT = 0x400000, // Equiv to Box filtering for mipmap generation
         TEX_FILTER_TRIANGLE = 0x500000,
+        TEX_FILTER_LANCZOS = 0x600000,
+        TEX_FILTER_KAISER = 0x700000,
+        TEX_FILTER_MITCHELL = 0x800000,
         // Filtering mode to use for any required image resizing
+        // (Lanczos-3, Kaiser-windowed sinc, and Mitchell-Netravali always use the non-WIC path, and are not supported for volume mipmaps)
 
         TEX_FILTER_SRGB_IN = 0x1000000,
         TEX_FILTER_SRGB_OUT = 0x2000000,
@@ -721,11 +814,19 @@ namespace DirectX
         // if the input format type is IsSRGB(), then SRGB_IN is on by default
         // if the output format type is IsSRGB(), then SRGB_OUT is on by default
 
+        TEX_FILTER_SRGB_EXACT = 0x8000000,
+        // Always use the exact sRGB curve for RGB -> sRGB (by default a close approximation is used for 8-bit outputs)
+        // NOTE: Without this flag, RGB -> sRGB results for formats of 8 bits or fewer per channel are not bit-exact with
+        //       previous releases; about 0.04% of values near a rounding boundary differ by one step
+
         TEX_FILTER_FORCE_NON_WIC = 0x10000000,
         // Forces use of the non-WIC path when both are an option
 
         TEX_FILTER_FORCE_WIC = 0x20000000,
         // Forces use of the WIC path even when logic would have picked a non-WIC path when both are an option
+
+        TEX_FILTER_PARALLEL = 0x40000000,
+        // Conversion, custom-filter mipmap generation, and triangle/Lanczos/Kaiser/Mitchell resizing are free to use multithreading to improve performance (by default they do not use multithreading)
     };
 
     constexpr uint32_t TEX_FILTER_DITHER_MASK = 0xF0000;
@@ -749,6 +850,8 @@ namespace DirectX
     {
         TEX_FILTER_FLAGS filter;
         float            threshold;
+        ITaskExecutor*   executor;
+            // Used with TEX_FILTER_PARALLEL; nullptr selects GetDefaultTaskExecutor()
     };
 
     DIRECTX_TEX_API HRESULT __cdecl Convert(
@@ -812,6 +915,9 @@ namespace DirectX
         TEX_PMALPHA_SRGB = (TEX_PMALPHA_SRGB_IN | TEX_PMALPHA_SRGB_OUT),
         // if the input format type is IsSRGB(), then SRGB_IN is on by default
         // if the output format type is IsSRGB(), then SRGB_OUT is on by default
+
+        TEX_PMALPHA_SRGB_EXACT = 0x8000000,
+        // Always use the exact sRGB curve for RGB -> sRGB (see TEX_FILTER_SRGB_EXACT)
     };
 
     DIRECTX_TEX_API HRESULT __cdecl PremultiplyAlpha(_In_ const Image& srcImage, _In_ TEX_PMALPHA_FLAGS flags, _Out_ ScratchImage& image) noexcept;
@@ -842,14 +948,33 @@ namespace DirectX
         TEX_COMPRESS_BC7_QUICK = 0x100000,
         // Minimal modes (usually mode 6) for BC7 compression
 
+        TEX_COMPRESS_BC_QUICK = 0x200000,
+        // Fast range fit of the color endpoints for BC1-3 compression, lower quality, intended for previews;
+        // also selects the faster batched BC4/BC5 encoder (output differs from the default BC4/BC5 encoder)
+
+        TEX_COMPRESS_BC_HIGH_QUALITY = 0x400000,
+        // Exhaustive cluster fit of the color endpoints for BC1-3 compression; much slower, highest quality; cannot be combined with TEX_COMPRESS_BC_QUICK
+
+        TEX_COMPRESS_BC7_BALANCED = 0x800000,
+        // Skips BC7 modes and partitions that block statistics show are unlikely to win; close to default quality
+
         TEX_COMPRESS_SRGB_IN = 0x1000000,
         TEX_COMPRESS_SRGB_OUT = 0x2000000,
         TEX_COMPRESS_SRGB = (TEX_COMPRESS_SRGB_IN | TEX_COMPRESS_SRGB_OUT),
         // if the input format type is IsSRGB(), then SRGB_IN is on by default
         // if the output format type is IsSRGB(), then SRGB_OUT is on by default
 
+        TEX_COMPRESS_SRGB_EXACT = 0x8000000,
+        // Always use the exact sRGB curve for RGB -> sRGB (see TEX_FILTER_SRGB_EXACT)
+
         TEX_COMPRESS_PARALLEL = 0x10000000,
         // Compress is free to use multithreading to improve performance (by default it does not use multithreading)
+
+        TEX_COMPRESS_BC_INTEGER = 0x20000000,
+        // Faster integer encoder for BC1/BC3 from 8-bit UNORM sources without dithering; output is not bit-identical to the default encoder
+
+        TEX_COMPRESS_BC7_FAST = 0x40000000,
+        // More aggressive form of TEX_COMPRESS_BC7_BALANCED, between it and TEX_COMPRESS_BC7_QUICK in speed and quality
     };
 
     constexpr float TEX_ALPHA_WEIGHT_DEFAULT = 1.0f;
@@ -860,6 +985,8 @@ namespace DirectX
         TEX_COMPRESS_FLAGS flags;
         float              threshold;
         float              alphaWeight;
+        ITaskExecutor*     executor;
+            // Used with TEX_COMPRESS_PARALLEL; nullptr selects GetDefaultTaskExecutor()
     };
 
     DIRECTX_TEX_API HRESULT __cdecl Compress(
@@ -903,6 +1030,15 @@ namespace DirectX
         _In_reads_(nimages) const Image* cImages, _In_ size_t nimages, _In_ const TexMetadata& metadata,
         _In_ DXGI_FORMAT format, _Out_ ScratchImage& images) noexcept;
 
+    DIRECTX_TEX_API HRESULT __cdecl Decompress(
+        _In_ const Image& cImage, _In_ DXGI_FORMAT format, _In_ TEX_COMPRESS_FLAGS compress,
+        _In_opt_ ITaskExecutor* executor, _Out_ ScratchImage& image) noexcept;
+    DIRECTX_TEX_API HRESULT __cdecl Decompress(
+        _In_reads_(nimages) const Image* cImages, _In_ size_t nimages, _In_ const TexMetadata& metadata,
+        _In_ DXGI_FORMAT format, _In_ TEX_COMPRESS_FLAGS compress, _In_opt_ ITaskExecutor* executor,
+        _Out_ ScratchImage& images) noexcept;
+        // Only TEX_COMPRESS_PARALLEL is used from compress; a nullptr executor selects GetDefaultTaskExecutor()
+
     //---------------------------------------------------------------------------------
     // Normal map operations
 
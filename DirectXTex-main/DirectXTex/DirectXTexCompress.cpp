@@ -11,11 +11,6 @@
 
 #include "DirectXTexP.h"
 
-#ifdef _OPENMP
-#include <omp.h>
-#pragma warning(disable : 4616 6993)
-#endif
-
 #include "BC.h"
 
 using namespace DirectX;
@@ -31,7 +26,13 @@ namespace
         static_assert(static_cast<int>(TEX_COMPRESS_UNIFORM) == static_cast<int>(BC_FLAGS_UNIFORM), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
         static_assert(static_cast<int>(TEX_COMPRESS_BC7_USE_3SUBSETS) == static_cast<int>(BC_FLAGS_USE_3SUBSETS), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
         static_assert(static_cast<int>(TEX_COMPRESS_BC7_QUICK) == static_cast<int>(BC_FLAGS_FORCE_BC7_MODE6), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
-        return (compress & (BC_FLAGS_DITHER_RGB | BC_FLAGS_DITHER_A | BC_FLAGS_UNIFORM | BC_FLAGS_USE_3SUBSETS | BC_FLAGS_FORCE_BC7_MODE6));
+        static_assert(static_cast<int>(TEX_COMPRESS_BC_QUICK) == static_cast<int>(BC_FLAGS_RANGE_FIT), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
+        static_assert(static_cast<int>(TEX_COMPRESS_BC_HIGH_QUALITY) == static_cast<int>(BC_FLAGS_CLUSTER_FIT), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
+        static_assert(static_cast<int>(TEX_COMPRESS_BC7_BALANCED) == static_cast<int>(BC_FLAGS_BC7_PRUNE), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
+        static_assert(static_cast<int>(TEX_COMPRESS_BC7_FAST) == static_cast<int>(BC_FLAGS_BC7_PRUNE_MORE), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
+        static_assert(static_cast<int>(TEX_COMPRESS_BC_INTEGER) == static_cast<int>(BC_FLAGS_INTEGER_FIT), "TEX_COMPRESS_* flags should match BC_FLAGS_*");
+        return (compress & (BC_FLAGS_DITHER_RGB | BC_FLAGS_DITHER_A | BC_FLAGS_UNIFORM | BC_FLAGS_USE_3SUBSETS | BC_FLAGS_FORCE_BC7_MODE6
+            | BC_FLAGS_RANGE_FIT | BC_FLAGS_CLUSTER_FIT | BC_FLAGS_BC7_PRUNE | BC_FLAGS_BC7_PRUNE_MORE | BC_FLAGS_INTEGER_FIT));
     }
 
     constexpr TEX_FILTER_FLAGS GetSRGBFlags(_In_ TEX_COMPRESS_FLAGS compress) noexcept
@@ -40,23 +41,32 @@ namespace
         static_assert(static_cast<int>(TEX_COMPRESS_SRGB_IN) == static_cast<int>(TEX_FILTER_SRGB_IN), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_COMPRESS_SRGB_OUT) == static_cast<int>(TEX_FILTER_SRGB_OUT), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_COMPRESS_SRGB) == static_cast<int>(TEX_FILTER_SRGB), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
+        static_assert(static_cast<int>(TEX_COMPRESS_SRGB_EXACT) == static_cast<int>(TEX_FILTER_SRGB_EXACT), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
+        static_assert((static_cast<uint32_t>(TEX_COMPRESS_BC7_FAST) & TEX_FILTER_SRGB_MASK) == 0, "TEX_COMPRESS_BC7_FAST must not overlap TEX_FILTER_SRGB_MASK");
         return static_cast<TEX_FILTER_FLAGS>(compress & TEX_FILTER_SRGB_MASK);
     }
 
-    inline bool DetermineEncoderSettings(_In_ DXGI_FORMAT format, _Out_ BC_ENCODE& pfEncode, _Out_ size_t& blocksize, _Out_ TEX_FILTER_FLAGS& cflags) noexcept
+    inline bool DetermineEncoderSettings(
+        _In_ DXGI_FORMAT format,
+        _Out_ BC_ENCODE& pfEncode,
+        _Out_ BC_ENCODE_BATCH& pfEncodeBatch,
+        _Out_ size_t& blocksize,
+        _Out_ TEX_FILTER_FLAGS& cflags) noexcept
     {
+        pfEncodeBatch = nullptr;
+
         switch (format)
         {
         case DXGI_FORMAT_BC1_UNORM:
         case DXGI_FORMAT_BC1_UNORM_SRGB:    pfEncode = nullptr;         blocksize = 8;   cflags = TEX_FILTER_DEFAULT; break;
         case DXGI_FORMAT_BC2_UNORM:
-        case DXGI_FORMAT_BC2_UNORM_SRGB:    pfEncode = D3DXEncodeBC2;   blocksize = 16;  cflags = TEX_FILTER_DEFAULT; break;
+        case DXGI_FORMAT_BC2_UNORM_SRGB:    pfEncode = D3DXEncodeBC2;   blocksize = 16;  cflags = TEX_FILTER_DEFAULT; pfEncodeBatch = D3DXEncodeBC2Batch; break;
         case DXGI_FORMAT_BC3_UNORM:
-        case DXGI_FORMAT_BC3_UNORM_SRGB:    pfEncode = D3DXEncodeBC3;   blocksize = 16;  cflags = TEX_FILTER_DEFAULT; break;
-        case DXGI_FORMAT_BC4_UNORM:         pfEncode = D3DXEncodeBC4U;  blocksize = 8;   cflags = TEX_FILTER_RGB_COPY_RED; break;
-        case DXGI_FORMAT_BC4_SNORM:         pfEncode = D3DXEncodeBC4S;  blocksize = 8;   cflags = TEX_FILTER_RGB_COPY_RED; break;
-        case DXGI_FORMAT_BC5_UNORM:         pfEncode = D3DXEncodeBC5U;  blocksize = 16;  cflags = TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN; break;
-        case DXGI_FORMAT_BC5_SNORM:         pfEncode = D3DXEncodeBC5S;  blocksize = 16;  cflags = TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN; break;
+        case DXGI_FORMAT_BC3_UNORM_SRGB:    pfEncode = D3DXEncodeBC3;   blocksize = 16;  cflags = TEX_FILTER_DEFAULT; pfEncodeBatch = D3DXEncodeBC3Batch; break;
+        case DXGI_FORMAT_BC4_UNORM:         pfEncode = D3DXEncodeBC4U;  blocksize = 8;   cflags = TEX_FILTER_RGB_COPY_RED; pfEncodeBatch = D3DXEncodeBC4UBatch; break;
+        case DXGI_FORMAT_BC4_SNORM:         pfEncode = D3DXEncodeBC4S;  blocksize = 8;   cflags = TEX_FILTER_RGB_COPY_RED; pfEncodeBatch = D3DXEncodeBC4SBatch; break;
+        case DXGI_FORMAT_BC5_UNORM:         pfEncode = D3DXEncodeBC5U;  blocksize = 16;  cflags = TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN; pfEncodeBatch = D3DXEncodeBC5UBatch; break;
+        case DXGI_FORMAT_BC5_SNORM:         pfEncode = D3DXEncodeBC5S;  blocksize = 16;  cflags = TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN; pfEncodeBatch = D3DXEncodeBC5SBatch; break;
         case DXGI_FORMAT_BC6H_UF16:         pfEncode = D3DXEncodeBC6HU; blocksize = 16;  cflags = TEX_FILTER_DEFAULT; break;
         case DXGI_FORMAT_BC6H_SF16:         pfEncode = D3DXEncodeBC6HS; blocksize = 16;  cflags = TEX_FILTER_DEFAULT; break;
         case DXGI_FORMAT_BC7_UNORM:
@@ -67,153 +77,246 @@ namespace
         return true;
     }
 
+    // Number of blocks gathered from a block row before handing them to the encoder
+    constexpr size_t BC_MAX_BATCH_BLOCKS = 16;
+
 
     //-------------------------------------------------------------------------------------
-    HRESULT CompressBC(
-        const Image& image,
-        const Image& result,
-        uint32_t bcflags,
-        TEX_FILTER_FLAGS srgb,
-        float threshold,
-        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+    // Loads a run of up to BC_MAX_BATCH_BLOCKS horizontally adjacent 4x4 blocks, reading
+    // each source scanline once for the whole run (replicating pixels for partial blocks)
+    //-------------------------------------------------------------------------------------
+    bool LoadBlockRow(
+        _Out_writes_(NUM_PIXELS_PER_BLOCK * ((pw + 3) / 4)) XMVECTOR* pBlocks,
+        _In_ const uint8_t* pSrc,
+        size_t rowPitch,
+        size_t bytesLeft,
+        size_t pw,
+        size_t ph,
+        DXGI_FORMAT format) noexcept
     {
-        if (!image.pixels || !result.pixels)
-            return E_POINTER;
+        assert(pw > 0 && pw <= 4 * BC_MAX_BATCH_BLOCKS);
+        assert(ph > 0 && ph <= 4);
+        assert(bytesLeft > 0);
 
-        assert(image.width == result.width);
-        assert(image.height == result.height);
-
-        const DXGI_FORMAT format = image.format;
-        size_t sbpp = BitsPerPixel(format);
-        if (!sbpp)
-            return E_FAIL;
+        constexpr size_t SCANLINE_PIXELS = 4 * BC_MAX_BATCH_BLOCKS;
+        XM_ALIGNED_DATA(16) XMVECTOR scanlines[4 * SCANLINE_PIXELS];
 
-        if (sbpp < 8)
+        for (size_t t = 0; t < ph; ++t)
         {
-            // We don't support compressing from monochrome (DXGI_FORMAT_R1_UNORM)
-            return HRESULT_E_NOT_SUPPORTED;
+            const size_t bytesToRead = std::min<size_t>(rowPitch, bytesLeft - rowPitch * t);
+            if (!LoadScanline(&scanlines[t * SCANLINE_PIXELS], pw, pSrc + rowPitch * t, bytesToRead, format))
+                return false;
         }
 
-        // Round to bytes
-        sbpp = (sbpp + 7) / 8;
-
-        uint8_t *pDest = result.pixels;
-
-        // Determine BC format encoder
-        BC_ENCODE pfEncode;
-        size_t blocksize;
-        TEX_FILTER_FLAGS cflags;
-        if (!DetermineEncoderSettings(result.format, pfEncode, blocksize, cflags))
-            return HRESULT_E_NOT_SUPPORTED;
-
-        XM_ALIGNED_DATA(16) XMVECTOR temp[16];
-        const uint8_t *pSrc = image.pixels;
-        const uint8_t *pEnd = image.pixels + image.slicePitch;
-        const size_t rowPitch = image.rowPitch;
-        for (size_t h = 0; h < image.height; h += 4)
+        // Source column/row used for each position of a partial block, indexed by the number
+        // of valid pixels. Matches replicating { 0, 0, 0, 1 } into the missing positions.
+        static const size_t s_replicate[4][4] =
         {
-            if (statusCallback)
+            { 0, 0, 0, 0 },
+            { 0, 1, 0, 1 },
+            { 0, 1, 2, 1 },
+            { 0, 1, 2, 3 },
+        };
+
+        const size_t* rowMap = s_replicate[ph - 1];
+        const size_t nBlocks = (pw + 3) / 4;
+        for (size_t n = 0; n < nBlocks; ++n)
+        {
+            const size_t* colMap = s_replicate[std::min<size_t>(4, pw - n * 4) - 1];
+            XMVECTOR* pBlock = &pBlocks[n * NUM_PIXELS_PER_BLOCK];
+            for (size_t t = 0; t < 4; ++t)
             {
-                if (!statusCallback(h, image.height))
+                const XMVECTOR* pRow = &scanlines[rowMap[t] * SCANLINE_PIXELS + n * 4];
+                for (size_t s = 0; s < 4; ++s)
                 {
-                    return E_ABORT;
+                    pBlock[(t << 2) | s] = pRow[colMap[s]];
                 }
             }
+        }
+
+        return true;
+    }
+
 
-            const uint8_t *sptr = pSrc;
-            uint8_t* dptr = pDest;
-            const size_t ph = std::min<size_t>(4, image.height - h);
-            size_t w = 0;
-            for (size_t count = 0; (count < result.rowPitch) && (w < image.width); count += blocksize, w += 4)
+    //-------------------------------------------------------------------------------------
+    // Encodes 'count' consecutive blocks, using the multi-block encoder when available
+    //-------------------------------------------------------------------------------------
+    void EncodeBlocks(
+        _Out_ uint8_t* pDest,
+        _In_reads_(NUM_PIXELS_PER_BLOCK * count) const XMVECTOR* pBlocks,
+        size_t count,
+        BC_ENCODE pfEncode,
+        BC_ENCODE_BATCH pfEncodeBatch,
+        size_t blocksize,
+        uint32_t bcflags,
+        float threshold) noexcept
+    {
+        if (pfEncodeBatch)
+        {
+            pfEncodeBatch(pDest, pBlocks, count, bcflags);
+        }
+        else if (pfEncode)
+        {
+            for (size_t n = 0; n < count; ++n)
             {
-                const size_t pw = std::min<size_t>(4, image.width - w);
-                assert(pw > 0 && ph > 0);
+                pfEncode(pDest + n * blocksize, pBlocks + n * NUM_PIXELS_PER_BLOCK, bcflags);
+            }
+        }
+        else
+        {
+            D3DXEncodeBC1Batch(pDest, pBlocks, count, threshold, bcflags);
+        }
+    }
 
-                const ptrdiff_t bytesLeft = pEnd - sptr;
-                assert(bytesLeft > 0);
-                size_t bytesToRead = std::min<size_t>(rowPitch, static_cast<size_t>(bytesLeft));
-                if (!LoadScanline(&temp[0], pw, sptr, bytesToRead, format))
-                    return E_FAIL;
 
-                if (ph > 1)
-                {
-                    bytesToRead = std::min<size_t>(rowPitch, static_cast<size_t>(bytesLeft) - rowPitch);
-                    if (!LoadScanline(&temp[4], pw, sptr + rowPitch, bytesToRead, format))
-                        return E_FAIL;
+    //-------------------------------------------------------------------------------------
+    // 8-bit integer encoder for BC1/BC3 from 8-bit UNORM sources
+    //-------------------------------------------------------------------------------------
+    bool UseRGBA8Encoder(
+        _In_ DXGI_FORMAT inFormat,
+        _In_ DXGI_FORMAT outFormat,
+        uint32_t bcflags,
+        TEX_FILTER_FLAGS srgb) noexcept
+    {
+        if (!(bcflags & BC_FLAGS_INTEGER_FIT))
+        {
+            // Opt-in, as the output differs from the float encoder
+            return false;
+        }
 
-                    if (ph > 2)
-                    {
-                        bytesToRead = std::min<size_t>(rowPitch, static_cast<size_t>(bytesLeft) - rowPitch * 2);
-                        if (!LoadScanline(&temp[8], pw, sptr + rowPitch * 2, bytesToRead, format))
-                            return E_FAIL;
-
-                        if (ph > 3)
-                        {
-                            bytesToRead = std::min<size_t>(rowPitch, static_cast<size_t>(bytesLeft) - rowPitch * 3);
-                            if (!LoadScanline(&temp[12], pw, sptr + rowPitch * 3, bytesToRead, format))
-                                return E_FAIL;
-                        }
-                    }
-                }
+        if (bcflags & (BC_FLAGS_DITHER_RGB | BC_FLAGS_DITHER_A | BC_FLAGS_CLUSTER_FIT))
+            return false;
 
-                if (pw != 4 || ph != 4)
-                {
-                    // Replicate pixels for partial block
-                    static const size_t uSrc[] = { 0, 0, 0, 1 };
+        switch (outFormat)
+        {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            break;
 
-                    if (pw < 4)
-                    {
-                        for (size_t t = 0; t < ph && t < 4; ++t)
-                        {
-                            for (size_t s = pw; s < 4; ++s)
-                            {
-                            #pragma prefast(suppress: 26000, "PREFAST false positive")
-                                temp[(t << 2) | s] = temp[(t << 2) | uSrc[s]];
-                            }
-                        }
-                    }
+        default:
+            return false;
+        }
 
-                    if (ph < 4)
-                    {
-                        for (size_t t = ph; t < 4; ++t)
-                        {
-                            for (size_t s = 0; s < 4; ++s)
-                            {
-                            #pragma prefast(suppress: 26000, "PREFAST false positive")
-                                temp[(t << 2) | s] = temp[(uSrc[t] << 2) | s];
-                            }
-                        }
-                    }
+        switch (inFormat)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+            break;
+
+        default:
+            return false;
+        }
+
+        // Only when ConvertScanline would not apply a gamma conversion
+        const bool srgbIn = IsSRGB(inFormat) || (srgb & TEX_FILTER_SRGB_IN);
+        const bool srgbOut = IsSRGB(outFormat) || (srgb & TEX_FILTER_SRGB_OUT);
+        return (srgbIn == srgbOut);
+    }
+
+    // Loads a 4x4 block as R8G8B8A8 (replicating pixels for partial blocks)
+    void LoadBlockRGBA8(
+        _Out_writes_(NUM_PIXELS_PER_BLOCK) uint32_t* pBlock,
+        _In_ const uint8_t* pSrc,
+        size_t rowPitch,
+        size_t pw,
+        size_t ph,
+        DXGI_FORMAT format) noexcept
+    {
+        assert(pw > 0 && pw <= 4 && ph > 0 && ph <= 4);
+
+        for (size_t t = 0; t < ph; ++t)
+        {
+            const uint8_t* sptr = pSrc + rowPitch * t;
+            for (size_t s = 0; s < pw; ++s, sptr += 4)
+            {
+                uint32_t t1;
+                memcpy(&t1, sptr, sizeof(uint32_t));
+
+                switch (format)
+                {
+                case DXGI_FORMAT_B8G8R8A8_UNORM:
+                case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+                    t1 = (t1 & 0xff00ff00) | ((t1 >> 16) & 0xff) | ((t1 & 0xff) << 16);
+                    break;
+
+                case DXGI_FORMAT_B8G8R8X8_UNORM:
+                case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+                    t1 = (t1 & 0x0000ff00) | ((t1 >> 16) & 0xff) | ((t1 & 0xff) << 16) | 0xff000000;
+                    break;
+
+                default:
+                    break;
                 }
 
-                ConvertScanline(temp, 16, result.format, format, cflags | srgb);
+                pBlock[(t << 2) | s] = t1;
+            }
+        }
 
-                if (pfEncode)
-                    pfEncode(dptr, temp, bcflags);
-                else
-                    D3DXEncodeBC1(dptr, temp, threshold, bcflags);
+        if (pw != 4 || ph != 4)
+        {
+            // Replicate pixels for partial block
+            static const size_t uSrc[] = { 0, 0, 0, 1 };
 
-                sptr += sbpp * 4;
-                dptr += blocksize;
+            for (size_t t = 0; t < ph; ++t)
+            {
+                for (size_t s = pw; s < 4; ++s)
+                {
+                    pBlock[(t << 2) | s] = pBlock[(t << 2) | uSrc[s]];
+                }
             }
 
-            pSrc += rowPitch * 4;
-            pDest += result.rowPitch;
+            for (size_t t = ph; t < 4; ++t)
+            {
+                for (size_t s = 0; s < 4; ++s)
+                {
+                    pBlock[(t << 2) | s] = pBlock[(uSrc[t] << 2) | s];
+                }
+            }
         }
+    }
 
-        return S_OK;
+    inline void EncodeBlockRGBA8(
+        _Out_ uint8_t* pDest,
+        _In_reads_(NUM_PIXELS_PER_BLOCK) const uint32_t* pBlock,
+        DXGI_FORMAT format,
+        uint32_t bcflags,
+        float threshold) noexcept
+    {
+        if (format == DXGI_FORMAT_BC3_UNORM || format == DXGI_FORMAT_BC3_UNORM_SRGB)
+            D3DXEncodeBC3RGBA8(pDest, pBlock, bcflags);
+        else
+            D3DXEncodeBC1RGBA8(pDest, pBlock, threshold, bcflags);
     }
 
 
     //-------------------------------------------------------------------------------------
-#ifdef _OPENMP
-    HRESULT CompressBC_Parallel(
+    // Per-image encoder state shared by the serial and parallel compressors
+    //-------------------------------------------------------------------------------------
+    struct BCEncodeContext
+    {
+        BC_ENCODE           pfEncode;
+        BC_ENCODE_BATCH     pfEncodeBatch;
+        size_t              blocksize;
+        size_t              sbpp;
+        ConvertPlan         convert;
+        uint32_t            bcflags;
+        float               threshold;
+        bool                rgba8;
+    };
+
+    HRESULT SetupBCEncode(
         const Image& image,
         const Image& result,
         uint32_t bcflags,
         TEX_FILTER_FLAGS srgb,
         float threshold,
-        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+        BCEncodeContext& ctx) noexcept
     {
         if (!image.pixels || !result.pixels)
             return E_POINTER;
@@ -221,8 +324,7 @@ namespace
         assert(image.width == result.width);
         assert(image.height == result.height);
 
-        const DXGI_FORMAT format = image.format;
-        size_t sbpp = BitsPerPixel(format);
+        size_t sbpp = BitsPerPixel(image.format);
         if (!sbpp)
             return E_FAIL;
 
@@ -233,133 +335,294 @@ namespace
         }
 
         // Round to bytes
-        sbpp = (sbpp + 7) / 8;
-
-        const uint8_t *pEnd = image.pixels + image.slicePitch;
+        ctx.sbpp = (sbpp + 7) / 8;
 
         // Determine BC format encoder
-        BC_ENCODE pfEncode;
-        size_t blocksize;
         TEX_FILTER_FLAGS cflags;
-        if (!DetermineEncoderSettings(result.format, pfEncode, blocksize, cflags))
+        if (!DetermineEncoderSettings(result.format, ctx.pfEncode, ctx.pfEncodeBatch, ctx.blocksize, cflags))
             return HRESULT_E_NOT_SUPPORTED;
 
-        // Refactored version of loop to support parallel independance
-        const size_t nBlocks = std::max<size_t>(1, (image.width + 3) / 4) * std::max<size_t>(1, (image.height + 3) / 4);
+        CreateConvertPlan(ctx.convert, result.format, image.format, cflags | srgb);
+        ctx.bcflags = bcflags;
+        ctx.threshold = threshold;
+        ctx.rgba8 = UseRGBA8Encoder(image.format, result.format, bcflags, srgb);
 
-        bool fail = false;
+        return S_OK;
+    }
 
-        size_t progress = 0;
-        bool abort = false;
+    // Compresses one row of blocks, handing runs of up to BC_MAX_BATCH_BLOCKS to the encoder
+    bool CompressBlockRow(
+        const Image& image,
+        const Image& result,
+        size_t by,
+        const BCEncodeContext& ctx) noexcept
+    {
+        const size_t nbWidth = std::max<size_t>(1, (image.width + 3) / 4);
+        const size_t rowPitch = image.rowPitch;
 
-        const size_t progressTotal = std::max<size_t>(1, (image.height + 3) / 4);
+        const size_t y = by * 4;
+        assert(y < image.height);
+        const size_t ph = std::min<size_t>(4, image.height - y);
 
-#pragma omp parallel for shared(progress)
-        for (int nb = 0; nb < static_cast<int>(nBlocks); ++nb)
+        const uint8_t *pSrc = image.pixels + (y * rowPitch);
+        const uint8_t *pEnd = image.pixels + image.slicePitch;
+        uint8_t *pDest = result.pixels + (by * result.rowPitch);
+
+        XM_ALIGNED_DATA(16) XMVECTOR temp[NUM_PIXELS_PER_BLOCK * BC_MAX_BATCH_BLOCKS];
+
+        for (size_t bx = 0; bx < nbWidth; bx += BC_MAX_BATCH_BLOCKS)
         {
-#pragma omp flush (abort)
-            if (abort)
+            const size_t nBlocks = std::min<size_t>(BC_MAX_BATCH_BLOCKS, nbWidth - bx);
+            const size_t x = bx * 4;
+            assert(x < image.width);
+
+            const uint8_t *sptr = pSrc + (x * ctx.sbpp);
+            uint8_t *dptr = pDest + (bx * ctx.blocksize);
+
+            if (ctx.rgba8)
             {
-                // Short circuit the loop body if an abort is requested.
-                // OpenMP 2.0 does not support cancellation of a 'parallel for' loop.
+                for (size_t n = 0; n < nBlocks; ++n)
+                {
+                    const size_t pw = std::min<size_t>(4, image.width - x - n * 4);
+
+                    uint32_t block[NUM_PIXELS_PER_BLOCK];
+                    LoadBlockRGBA8(block, sptr + n * 4 * ctx.sbpp, rowPitch, pw, ph, image.format);
+                    EncodeBlockRGBA8(dptr + n * ctx.blocksize, block, result.format, ctx.bcflags, ctx.threshold);
+                }
                 continue;
             }
 
-            const int nbWidth = std::max<int>(1, int((image.width + 3) / 4));
-
-            int y = nb / nbWidth;
-            const int x = (nb - (y*nbWidth)) * 4;
-            y *= 4;
+            const size_t pw = std::min<size_t>(nBlocks * 4, image.width - x);
 
-            assert((x >= 0) && (x < int(image.width)));
-            assert((y >= 0) && (y < int(image.height)));
+            const ptrdiff_t bytesLeft = pEnd - sptr;
+            assert(bytesLeft > 0);
+            if (!LoadBlockRow(temp, sptr, rowPitch, static_cast<size_t>(bytesLeft), pw, ph, image.format))
+                return false;
 
-            const size_t rowPitch = image.rowPitch;
-            const uint8_t *pSrc = image.pixels + (size_t(y)*rowPitch) + (size_t(x)*sbpp);
+            ConvertScanline(temp, NUM_PIXELS_PER_BLOCK * nBlocks, ctx.convert);
 
-            uint8_t *pDest = result.pixels + (size_t(nb)*blocksize);
+            EncodeBlocks(dptr, temp, nBlocks, ctx.pfEncode, ctx.pfEncodeBatch, ctx.blocksize, ctx.bcflags, ctx.threshold);
+        }
 
-            const size_t ph = std::min<size_t>(4, image.height - size_t(y));
-            const size_t pw = std::min<size_t>(4, image.width - size_t(x));
-            assert(pw > 0 && ph > 0);
+        return true;
+    }
 
-            const ptrdiff_t bytesLeft = pEnd - pSrc;
-            assert(bytesLeft > 0);
-            size_t bytesToRead = std::min<size_t>(rowPitch, size_t(bytesLeft));
 
-            XM_ALIGNED_DATA(16) XMVECTOR temp[16];
-            if (!LoadScanline(&temp[0], pw, pSrc, bytesToRead, format))
-                fail = true;
+    //-------------------------------------------------------------------------------------
+    HRESULT CompressBC(
+        const Image& image,
+        const Image& result,
+        uint32_t bcflags,
+        TEX_FILTER_FLAGS srgb,
+        float threshold,
+        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+    {
+        BCEncodeContext ctx;
+        HRESULT hr = SetupBCEncode(image, result, bcflags, srgb, threshold, ctx);
+        if (FAILED(hr))
+            return hr;
 
-            if (ph > 1)
+        const size_t nbHeight = std::max<size_t>(1, (image.height + 3) / 4);
+        for (size_t by = 0; by < nbHeight; ++by)
+        {
+            if (statusCallback)
             {
-                bytesToRead = std::min<size_t>(rowPitch, size_t(bytesLeft) - rowPitch);
-                if (!LoadScanline(&temp[4], pw, pSrc + rowPitch, bytesToRead, format))
-                    fail = true;
-
-                if (ph > 2)
+                if (!statusCallback(by * 4, image.height))
                 {
-                    bytesToRead = std::min<size_t>(rowPitch, size_t(bytesLeft) - rowPitch * 2);
-                    if (!LoadScanline(&temp[8], pw, pSrc + rowPitch * 2, bytesToRead, format))
-                        fail = true;
-
-                    if (ph > 3)
-                    {
-                        bytesToRead = std::min<size_t>(rowPitch, size_t(bytesLeft) - rowPitch * 3);
-                        if (!LoadScanline(&temp[12], pw, pSrc + rowPitch * 3, bytesToRead, format))
-                            fail = true;
-                    }
+                    return E_ABORT;
                 }
             }
 
-            if (pw != 4 || ph != 4)
-            {
-                // Replicate pixels for partial block
-                static const size_t uSrc[] = { 0, 0, 0, 1 };
+            if (!CompressBlockRow(image, result, by, ctx))
+                return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    // Picks how many block rows each parallel task owns. A worker then walks its source rows
+    // and destination blocks contiguously instead of interleaving with its neighbours, while
+    // narrow images still produce tasks large enough to amortize scheduling.
+    constexpr size_t BC_MIN_STRIP_BLOCKS = 512;
+    constexpr size_t BC_MIN_DECODE_STRIP_BLOCKS = 8192;
+    constexpr size_t BC_MIN_STRIPS = 64;
+
+    inline size_t BlockRowsPerStrip(size_t nbWidth, size_t nbHeight, size_t minStripBlocks = BC_MIN_STRIP_BLOCKS) noexcept
+    {
+        const size_t rows = (minStripBlocks + nbWidth - 1) / nbWidth;
+        return std::max<size_t>(1, std::min<size_t>(rows, nbHeight / BC_MIN_STRIPS));
+    }
+
+    HRESULT CompressBC_Parallel(
+        const Image& image,
+        const Image& result,
+        uint32_t bcflags,
+        TEX_FILTER_FLAGS srgb,
+        float threshold,
+        ITaskExecutor* executor,
+        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+    {
+        BCEncodeContext ctx;
+        HRESULT hr = SetupBCEncode(image, result, bcflags, srgb, threshold, ctx);
+        if (FAILED(hr))
+            return hr;
+
+        const size_t nbWidth = std::max<size_t>(1, (image.width + 3) / 4);
+        const size_t nbHeight = std::max<size_t>(1, (image.height + 3) / 4);
+        const size_t rowsPerStrip = BlockRowsPerStrip(nbWidth, nbHeight);
+        const size_t nStrips = (nbHeight + rowsPerStrip - 1) / rowsPerStrip;
 
-                if (pw < 4)
+        std::atomic<bool> fail(false);
+
+        size_t progress = 0;
+        std::atomic<bool> abort(false);
+        std::mutex statusLock;
+
+        const size_t progressTotal = std::max<size_t>(1, (image.height + 3) / 4);
+
+        if (!executor)
+            executor = GetDefaultTaskExecutor();
+
+        hr = ParallelFor(executor, nStrips, [&](size_t strip) -> bool
+        {
+            const size_t byEnd = std::min<size_t>(nbHeight, (strip + 1) * rowsPerStrip);
+            for (size_t by = strip * rowsPerStrip; by < byEnd; ++by)
+            {
+                if (abort.load(std::memory_order_relaxed))
                 {
-                    for (size_t t = 0; t < ph && t < 4; ++t)
-                    {
-                        for (size_t s = pw; s < 4; ++s)
-                        {
-                            temp[(t << 2) | s] = temp[(t << 2) | uSrc[s]];
-                        }
-                    }
+                    // Executors are allowed to keep going after a cancellation, so short circuit here too.
+                    return false;
                 }
 
-                if (ph < 4)
+                if (!CompressBlockRow(image, result, by, ctx))
+                    fail.store(true, std::memory_order_relaxed);
+
+                // Report progress as each row completes.
+                if (statusCallback)
                 {
-                    for (size_t t = ph; t < 4; ++t)
+                    // Callers don't expect the callback to be reentrant, and counting under the lock keeps
+                    // the reported progress from going backwards
+                    std::lock_guard<std::mutex> lock(statusLock);
+                    progress += 4;
+                    if (!statusCallback(progress, progressTotal))
                     {
-                        for (size_t s = 0; s < 4; ++s)
-                        {
-                            temp[(t << 2) | s] = temp[(uSrc[t] << 2) | s];
-                        }
+                        abort.store(true, std::memory_order_relaxed);
+                        return false;
                     }
                 }
             }
 
-            ConvertScanline(temp, 16, result.format, format, cflags | srgb);
+            return true;
+        });
+        if (FAILED(hr))
+            return hr;
 
-            if (pfEncode)
-                pfEncode(pDest, temp, bcflags);
-            else
-                D3DXEncodeBC1(pDest, temp, threshold, bcflags);
+        if (abort)
+        {
+            return E_ABORT;
+        }
+        else
+        {
+            return (fail) ? E_FAIL : S_OK;
+        }
+    }
 
-            // Report progress when a new row is reached.
-            if (x == 0 && statusCallback)
+
+    //-------------------------------------------------------------------------------------
+    // Compresses a set of subresources (mips, array slices, cube faces) as one pool of work,
+    // so the strips of small images run alongside those of large ones instead of after them
+    //-------------------------------------------------------------------------------------
+    HRESULT CompressBC_Parallel(
+        const Image* srcImages,
+        const Image* destImages,
+        size_t nimages,
+        uint32_t bcflags,
+        TEX_FILTER_FLAGS srgb,
+        float threshold,
+        ITaskExecutor* executor,
+        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+    {
+        assert(srcImages && destImages && nimages > 0);
+
+        std::unique_ptr<BCEncodeContext[]> contexts(new (std::nothrow) BCEncodeContext[nimages]);
+        std::unique_ptr<size_t[]> firstStrip(new (std::nothrow) size_t[nimages + 1]);
+        std::unique_ptr<size_t[]> stripRows(new (std::nothrow) size_t[nimages]);
+        std::unique_ptr<std::atomic<size_t>[]> stripsLeft(new (std::nothrow) std::atomic<size_t>[nimages]);
+        if (!contexts || !firstStrip || !stripRows || !stripsLeft)
+            return E_OUTOFMEMORY;
+
+        size_t nStrips = 0;
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            const Image& src = srcImages[index];
+
+            HRESULT hr = SetupBCEncode(src, destImages[index], bcflags, srgb, threshold, contexts[index]);
+            if (FAILED(hr))
+                return hr;
+
+            const size_t nbWidth = std::max<size_t>(1, (src.width + 3) / 4);
+            const size_t nbHeight = std::max<size_t>(1, (src.height + 3) / 4);
+            const size_t rowsPerStrip = BlockRowsPerStrip(nbWidth, nbHeight);
+            const size_t count = (nbHeight + rowsPerStrip - 1) / rowsPerStrip;
+
+            firstStrip[index] = nStrips;
+            stripRows[index] = rowsPerStrip;
+            stripsLeft[index] = count;
+            nStrips += count;
+        }
+        firstStrip[nimages] = nStrips;
+
+        std::atomic<bool> fail(false);
+
+        size_t imagesDone = 0;
+        std::atomic<bool> abort(false);
+        std::mutex statusLock;
+
+        if (!executor)
+            executor = GetDefaultTaskExecutor();
+
+        HRESULT hr = ParallelFor(executor, nStrips, [&](size_t strip) -> bool
+        {
+            if (abort.load(std::memory_order_relaxed))
             {
-#pragma omp atomic
-                progress += 4;
+                // Executors are allowed to keep going after a cancellation, so short circuit here too.
+                return false;
+            }
 
-                if (!statusCallback(progress, progressTotal))
+            const size_t index = size_t(std::upper_bound(firstStrip.get(), firstStrip.get() + nimages + 1, strip) - firstStrip.get()) - 1;
+            assert(index < nimages);
+
+            const Image& src = srcImages[index];
+            const size_t nbHeight = std::max<size_t>(1, (src.height + 3) / 4);
+            const size_t rowsPerStrip = stripRows[index];
+            const size_t byStart = (strip - firstStrip[index]) * rowsPerStrip;
+            const size_t byEnd = std::min<size_t>(nbHeight, byStart + rowsPerStrip);
+            for (size_t by = byStart; by < byEnd; ++by)
+            {
+                if (!CompressBlockRow(src, destImages[index], by, contexts[index]))
+                    fail.store(true, std::memory_order_relaxed);
+            }
+
+            // Report progress as each image completes.
+            if (stripsLeft[index].fetch_sub(1, std::memory_order_acq_rel) == 1 && statusCallback)
+            {
+                // Callers don't expect the callback to be reentrant, and counting under the lock keeps
+                // the reported progress from going backwards
+                std::lock_guard<std::mutex> lock(statusLock);
+                ++imagesDone;
+                if (!statusCallback(imagesDone, nimages))
                 {
-                    abort = true;
-#pragma omp flush (abort)
+                    abort.store(true, std::memory_order_relaxed);
+                    return false;
                 }
             }
-        }
+
+            return true;
+        });
+        if (FAILED(hr))
+            return hr;
 
         if (abort)
         {
@@ -370,7 +633,6 @@ namespace
             return (fail) ? E_FAIL : S_OK;
         }
     }
-#endif // _OPENMP
 
 
     //-------------------------------------------------------------------------------------
@@ -422,7 +684,21 @@ namespace
 
 
     //-------------------------------------------------------------------------------------
-    HRESULT DecompressBC(_In_ const Image& cImage, _In_ const Image& result) noexcept
+    //-------------------------------------------------------------------------------------
+    // Per-image decoder state shared by the serial and parallel decompressors
+    //-------------------------------------------------------------------------------------
+    struct BCDecodeContext
+    {
+        BC_DECODE           pfDecode;
+        BC_DECODE_PALETTE   pfDecodePalette;    // nullptr when every pixel must go through ConvertScanline
+        DXGI_FORMAT         cformat;
+        ConvertPlan         convert;
+        size_t              sbpp;
+        size_t              dbpp;
+        size_t              channelOffset;      // byte holding BC_PALETTE_BLOCK::channel within a destination pixel
+    };
+
+    HRESULT SetupBCDecode(_In_ const Image& cImage, _In_ const Image& result, _Out_ BCDecodeContext& ctx) noexcept
     {
         if (!cImage.pixels || !result.pixels)
             return E_POINTER;
@@ -442,97 +718,296 @@ namespace
         }
 
         // Round to bytes
-        dbpp = (dbpp + 7) / 8;
-
-        uint8_t *pDest = result.pixels;
-        if (!pDest)
-            return E_POINTER;
+        ctx.dbpp = (dbpp + 7) / 8;
 
         // Promote "typeless" BC formats
-        DXGI_FORMAT cformat;
         switch (cImage.format)
         {
-        case DXGI_FORMAT_BC1_TYPELESS:  cformat = DXGI_FORMAT_BC1_UNORM; break;
-        case DXGI_FORMAT_BC2_TYPELESS:  cformat = DXGI_FORMAT_BC2_UNORM; break;
-        case DXGI_FORMAT_BC3_TYPELESS:  cformat = DXGI_FORMAT_BC3_UNORM; break;
-        case DXGI_FORMAT_BC4_TYPELESS:  cformat = DXGI_FORMAT_BC4_UNORM; break;
-        case DXGI_FORMAT_BC5_TYPELESS:  cformat = DXGI_FORMAT_BC5_UNORM; break;
-        case DXGI_FORMAT_BC6H_TYPELESS: cformat = DXGI_FORMAT_BC6H_UF16; break;
-        case DXGI_FORMAT_BC7_TYPELESS:  cformat = DXGI_FORMAT_BC7_UNORM; break;
-        default:                        cformat = cImage.format;         break;
+        case DXGI_FORMAT_BC1_TYPELESS:  ctx.cformat = DXGI_FORMAT_BC1_UNORM; break;
+        case DXGI_FORMAT_BC2_TYPELESS:  ctx.cformat = DXGI_FORMAT_BC2_UNORM; break;
+        case DXGI_FORMAT_BC3_TYPELESS:  ctx.cformat = DXGI_FORMAT_BC3_UNORM; break;
+        case DXGI_FORMAT_BC4_TYPELESS:  ctx.cformat = DXGI_FORMAT_BC4_UNORM; break;
+        case DXGI_FORMAT_BC5_TYPELESS:  ctx.cformat = DXGI_FORMAT_BC5_UNORM; break;
+        case DXGI_FORMAT_BC6H_TYPELESS: ctx.cformat = DXGI_FORMAT_BC6H_UF16; break;
+        case DXGI_FORMAT_BC7_TYPELESS:  ctx.cformat = DXGI_FORMAT_BC7_UNORM; break;
+        default:                        ctx.cformat = cImage.format;         break;
         }
 
         // Determine BC format decoder
-        BC_DECODE pfDecode;
-        size_t sbpp;
-        switch (cformat)
+        BC_DECODE_PALETTE pfDecodePalette = nullptr;
+        switch (ctx.cformat)
         {
         case DXGI_FORMAT_BC1_UNORM:
-        case DXGI_FORMAT_BC1_UNORM_SRGB:    pfDecode = D3DXDecodeBC1;   sbpp = 8;   break;
+        case DXGI_FORMAT_BC1_UNORM_SRGB:    ctx.pfDecode = D3DXDecodeBC1;   ctx.sbpp = 8;   pfDecodePalette = D3DXDecodeBC1Palette;  break;
         case DXGI_FORMAT_BC2_UNORM:
-        case DXGI_FORMAT_BC2_UNORM_SRGB:    pfDecode = D3DXDecodeBC2;   sbpp = 16;  break;
+        case DXGI_FORMAT_BC2_UNORM_SRGB:    ctx.pfDecode = D3DXDecodeBC2;   ctx.sbpp = 16;  pfDecodePalette = D3DXDecodeBC2Palette;  break;
         case DXGI_FORMAT_BC3_UNORM:
-        case DXGI_FORMAT_BC3_UNORM_SRGB:    pfDecode = D3DXDecodeBC3;   sbpp = 16;  break;
-        case DXGI_FORMAT_BC4_UNORM:         pfDecode = D3DXDecodeBC4U;  sbpp = 8;   break;
-        case DXGI_FORMAT_BC4_SNORM:         pfDecode = D3DXDecodeBC4S;  sbpp = 8;   break;
-        case DXGI_FORMAT_BC5_UNORM:         pfDecode = D3DXDecodeBC5U;  sbpp = 16;  break;
-        case DXGI_FORMAT_BC5_SNORM:         pfDecode = D3DXDecodeBC5S;  sbpp = 16;  break;
-        case DXGI_FORMAT_BC6H_UF16:         pfDecode = D3DXDecodeBC6HU; sbpp = 16;  break;
-        case DXGI_FORMAT_BC6H_SF16:         pfDecode = D3DXDecodeBC6HS; sbpp = 16;  break;
+        case DXGI_FORMAT_BC3_UNORM_SRGB:    ctx.pfDecode = D3DXDecodeBC3;   ctx.sbpp = 16;  pfDecodePalette = D3DXDecodeBC3Palette;  break;
+        case DXGI_FORMAT_BC4_UNORM:         ctx.pfDecode = D3DXDecodeBC4U;  ctx.sbpp = 8;   pfDecodePalette = D3DXDecodeBC4UPalette; break;
+        case DXGI_FORMAT_BC4_SNORM:         ctx.pfDecode = D3DXDecodeBC4S;  ctx.sbpp = 8;   pfDecodePalette = D3DXDecodeBC4SPalette; break;
+        case DXGI_FORMAT_BC5_UNORM:         ctx.pfDecode = D3DXDecodeBC5U;  ctx.sbpp = 16;  pfDecodePalette = D3DXDecodeBC5UPalette; break;
+        case DXGI_FORMAT_BC5_SNORM:         ctx.pfDecode = D3DXDecodeBC5S;  ctx.sbpp = 16;  pfDecodePalette = D3DXDecodeBC5SPalette; break;
+        case DXGI_FORMAT_BC6H_UF16:         ctx.pfDecode = D3DXDecodeBC6HU; ctx.sbpp = 16;  break;
+        case DXGI_FORMAT_BC6H_SF16:         ctx.pfDecode = D3DXDecodeBC6HS; ctx.sbpp = 16;  break;
         case DXGI_FORMAT_BC7_UNORM:
-        case DXGI_FORMAT_BC7_UNORM_SRGB:    pfDecode = D3DXDecodeBC7;   sbpp = 16;  break;
+        case DXGI_FORMAT_BC7_UNORM_SRGB:    ctx.pfDecode = D3DXDecodeBC7;   ctx.sbpp = 16;  break;
         default:
             return HRESULT_E_NOT_SUPPORTED;
         }
 
+        CreateConvertPlan(ctx.convert, format, ctx.cformat, TEX_FILTER_DEFAULT);
+
+        // Palette decoding converts only the palette entries of each block and then copies whole destination
+        // pixels, so it needs a format that stores each pixel independently. BC2/BC3 (alpha) and BC5 (green)
+        // merge a second palette into one byte, so are limited to formats where no conversion mixes channels.
+        ctx.pfDecodePalette = nullptr;
+        ctx.channelOffset = 0;
+        if (pfDecodePalette && !IsPacked(format) && (BitsPerPixel(format) % 8) == 0)
+        {
+            switch (ctx.cformat)
+            {
+            case DXGI_FORMAT_BC2_UNORM:
+            case DXGI_FORMAT_BC2_UNORM_SRGB:
+            case DXGI_FORMAT_BC3_UNORM:
+            case DXGI_FORMAT_BC3_UNORM_SRGB:
+                switch (format)
+                {
+                case DXGI_FORMAT_R8G8B8A8_UNORM:
+                case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+                case DXGI_FORMAT_B8G8R8A8_UNORM:
+                case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+                    ctx.pfDecodePalette = pfDecodePalette;
+                    ctx.channelOffset = 3;
+                    break;
+
+                default:
+                    break;
+                }
+                break;
+
+            case DXGI_FORMAT_BC5_UNORM:
+            case DXGI_FORMAT_BC5_SNORM:
+                switch (format)
+                {
+                case DXGI_FORMAT_R8G8_UNORM:
+                case DXGI_FORMAT_R8G8_SNORM:
+                case DXGI_FORMAT_R8G8B8A8_UNORM:
+                case DXGI_FORMAT_R8G8B8A8_SNORM:
+                    ctx.pfDecodePalette = pfDecodePalette;
+                    ctx.channelOffset = 1;
+                    break;
+
+                default:
+                    break;
+                }
+                break;
+
+            default:
+                ctx.pfDecodePalette = pfDecodePalette;
+                break;
+            }
+        }
+
+        return S_OK;
+    }
+
+    // Decodes one block through its palette, writing pw x ph destination pixels
+    bool DecodeBlockPalette(
+        _Out_ uint8_t* pDest,
+        size_t rowPitch,
+        _In_ const uint8_t* pSrc,
+        size_t pw,
+        size_t ph,
+        DXGI_FORMAT format,
+        const BCDecodeContext& ctx) noexcept
+    {
+        BC_PALETTE_BLOCK block;
+        ctx.pfDecodePalette(&block, pSrc);
+
         XM_ALIGNED_DATA(16) XMVECTOR temp[16];
-        const uint8_t *pSrc = cImage.pixels;
-        const size_t rowPitch = result.rowPitch;
-        for (size_t h = 0; h < cImage.height; h += 4)
+        size_t count = block.colorCount;
+        for (size_t k = 0; k < count; ++k)
         {
-            const uint8_t *sptr = pSrc;
-            uint8_t* dptr = pDest;
-            const size_t ph = std::min<size_t>(4, cImage.height - h);
-            size_t w = 0;
-            for (size_t count = 0; (count < cImage.rowPitch) && (w < cImage.width); count += sbpp, w += 4)
+            temp[k] = block.color[k];
+        }
+
+        if (block.channelCount > 0)
+        {
+            // Carry the second palette in the spare entries (or alongside the first), one component per entry
+            count = std::max(block.colorCount, block.channelCount);
+            for (size_t k = 0; k < count; ++k)
             {
-                pfDecode(temp, sptr);
-                ConvertScanline(temp, 16, format, cformat, TEX_FILTER_DEFAULT);
+                const XMVECTOR base = block.color[std::min(k, block.colorCount - 1)];
+                const float value = block.channel[std::min(k, block.channelCount - 1)];
+                temp[k] = (ctx.channelOffset == 1) ? XMVectorSetY(base, value) : XMVectorSetW(base, value);
+            }
+        }
 
-                const size_t pw = std::min<size_t>(4, cImage.width - w);
-                assert(pw > 0 && ph > 0);
+        ConvertScanline(temp, count, ctx.convert);
 
-                if (!StoreScanline(dptr, rowPitch, format, &temp[0], pw))
-                    return E_FAIL;
+        uint8_t palette[16 * 16];
+        if (!StoreScanline(palette, count * ctx.dbpp, format, temp, count))
+            return false;
 
-                if (ph > 1)
+        const size_t dbpp = ctx.dbpp;
+        for (size_t t = 0; t < ph; ++t)
+        {
+            uint8_t* dptr = pDest + rowPitch * t;
+            for (size_t s = 0; s < pw; ++s, dptr += dbpp)
+            {
+                const size_t i = (t << 2) | s;
+                if (dbpp == 4)
+                {
+                    memcpy(dptr, &palette[block.colorIndex[i] * 4], 4);
+                }
+                else
                 {
-                    if (!StoreScanline(dptr + rowPitch, rowPitch, format, &temp[4], pw))
-                        return E_FAIL;
+                    memcpy(dptr, &palette[block.colorIndex[i] * dbpp], dbpp);
+                }
 
-                    if (ph > 2)
-                    {
-                        if (!StoreScanline(dptr + rowPitch * 2, rowPitch, format, &temp[8], pw))
-                            return E_FAIL;
-
-                        if (ph > 3)
-                        {
-                            if (!StoreScanline(dptr + rowPitch * 3, rowPitch, format, &temp[12], pw))
-                                return E_FAIL;
-                        }
-                    }
+                if (block.channelCount > 0)
+                {
+                    dptr[ctx.channelOffset] = palette[block.channelIndex[i] * dbpp + ctx.channelOffset];
                 }
+            }
+        }
 
-                sptr += sbpp;
-                dptr += dbpp * 4;
+        return true;
+    }
+
+    // Decompresses one row of blocks
+    bool DecompressBlockRow(
+        const Image& cImage,
+        const Image& result,
+        size_t by,
+        const BCDecodeContext& ctx) noexcept
+    {
+        const DXGI_FORMAT format = result.format;
+        const size_t rowPitch = result.rowPitch;
+
+        const size_t h = by * 4;
+        assert(h < cImage.height);
+        const size_t ph = std::min<size_t>(4, cImage.height - h);
+
+        const uint8_t *sptr = cImage.pixels + by * cImage.rowPitch;
+        uint8_t* dptr = result.pixels + h * rowPitch;
+
+        XM_ALIGNED_DATA(16) XMVECTOR temp[16];
+        size_t w = 0;
+        for (size_t count = 0; (count < cImage.rowPitch) && (w < cImage.width); count += ctx.sbpp, w += 4)
+        {
+            const size_t pw = std::min<size_t>(4, cImage.width - w);
+            assert(pw > 0 && ph > 0);
+
+            if (ctx.pfDecodePalette)
+            {
+                if (!DecodeBlockPalette(dptr, rowPitch, sptr, pw, ph, format, ctx))
+                    return false;
+            }
+            else
+            {
+                ctx.pfDecode(temp, sptr);
+                ConvertScanline(temp, 16, ctx.convert);
+
+                for (size_t t = 0; t < ph; ++t)
+                {
+                    if (!StoreScanline(dptr + rowPitch * t, rowPitch, format, &temp[t * 4], pw))
+                        return false;
+                }
             }
 
-            pSrc += cImage.rowPitch;
-            pDest += rowPitch * 4;
+            sptr += ctx.sbpp;
+            dptr += ctx.dbpp * 4;
+        }
+
+        return true;
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    HRESULT DecompressBC(_In_ const Image& cImage, _In_ const Image& result) noexcept
+    {
+        BCDecodeContext ctx;
+        HRESULT hr = SetupBCDecode(cImage, result, ctx);
+        if (FAILED(hr))
+            return hr;
+
+        for (size_t h = 0; h < cImage.height; h += 4)
+        {
+            if (!DecompressBlockRow(cImage, result, h / 4, ctx))
+                return E_FAIL;
         }
 
         return S_OK;
     }
+
+
+    //-------------------------------------------------------------------------------------
+    // Decompresses a set of subresources as one pool of strips, like CompressBC_Parallel
+    //-------------------------------------------------------------------------------------
+    HRESULT DecompressBC_Parallel(
+        _In_reads_(nimages) const Image* cImages,
+        _In_reads_(nimages) const Image* results,
+        size_t nimages,
+        _In_opt_ ITaskExecutor* executor) noexcept
+    {
+        assert(cImages && results && nimages > 0);
+
+        std::unique_ptr<BCDecodeContext[]> contexts(new (std::nothrow) BCDecodeContext[nimages]);
+        std::unique_ptr<size_t[]> firstStrip(new (std::nothrow) size_t[nimages + 1]);
+        std::unique_ptr<size_t[]> stripRows(new (std::nothrow) size_t[nimages]);
+        if (!contexts || !firstStrip || !stripRows)
+            return E_OUTOFMEMORY;
+
+        size_t nStrips = 0;
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            const Image& src = cImages[index];
+
+            HRESULT hr = SetupBCDecode(src, results[index], contexts[index]);
+            if (FAILED(hr))
+                return hr;
+
+            const size_t nbWidth = std::max<size_t>(1, (src.width + 3) / 4);
+            const size_t nbHeight = (src.height + 3) / 4;
+            const size_t rowsPerStrip = BlockRowsPerStrip(nbWidth, nbHeight, BC_MIN_DECODE_STRIP_BLOCKS);
+
+            firstStrip[index] = nStrips;
+            stripRows[index] = rowsPerStrip;
+            nStrips += (nbHeight + rowsPerStrip - 1) / rowsPerStrip;
+        }
+        firstStrip[nimages] = nStrips;
+
+        std::atomic<bool> fail(false);
+
+        if (!executor)
+            executor = GetDefaultTaskExecutor();
+
+        HRESULT hr = ParallelFor(executor, nStrips, [&](size_t strip) -> bool
+        {
+            const size_t index = size_t(std::upper_bound(firstStrip.get(), firstStrip.get() + nimages + 1, strip) - firstStrip.get()) - 1;
+            assert(index < nimages);
+
+            const Image& src = cImages[index];
+            const size_t nbHeight = (src.height + 3) / 4;
+            const size_t byStart = (strip - firstStrip[index]) * stripRows[index];
+            const size_t byEnd = std::min<size_t>(nbHeight, byStart + stripRows[index]);
+            for (size_t by = byStart; by < byEnd; ++by)
+            {
+                if (!DecompressBlockRow(src, results[index], by, contexts[index]))
+                {
+                    fail.store(true, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            return true;
+        });
+        if (FAILED(hr))
+            return hr;
+
+        return (fail) ? E_FAIL : S_OK;
+    }
 }
 
 //-------------------------------------------------------------------------------------
@@ -671,12 +1146,15 @@ HRESULT DirectX::CompressEx(
     if (IsCompressed(srcImage.format) || !IsCompressed(format))
         return E_INVALIDARG;
 
+    if ((options.flags & TEX_COMPRESS_BC_QUICK) && (options.flags & TEX_COMPRESS_BC_HIGH_QUALITY))
+        return E_INVALIDARG;
+
     if (IsTypeless(format)
         || IsTypeless(srcImage.format) || IsPlanar(srcImage.format) || IsPalettized(srcImage.format))
         return HRESULT_E_NOT_SUPPORTED;
 
     // Create compressed image
-    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1);
+    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -699,11 +1177,7 @@ HRESULT DirectX::CompressEx(
     // Compress single image
     if (options.flags & TEX_COMPRESS_PARALLEL)
     {
-    #ifndef _OPENMP
-        hr = E_NOTIMPL;
-    #else
-        hr = CompressBC_Parallel(srcImage, *img, GetBCFlags(options.flags), GetSRGBFlags(options.flags), options.threshold, statusCallback);
-    #endif // _OPENMP
+        hr = CompressBC_Parallel(srcImage, *img, GetBCFlags(options.flags), GetSRGBFlags(options.flags), options.threshold, options.executor, statusCallback);
     }
     else
     {
@@ -744,12 +1218,13 @@ HRESULT DirectX::CompressEx(
     if (IsCompressed(metadata.format) || !IsCompressed(format))
         return E_INVALIDARG;
 
+    if ((options.flags & TEX_COMPRESS_BC_QUICK) && (options.flags & TEX_COMPRESS_BC_HIGH_QUALITY))
+        return E_INVALIDARG;
+
     if (IsTypeless(format)
         || IsTypeless(metadata.format) || IsPlanar(metadata.format) || IsPalettized(metadata.format))
         return HRESULT_E_NOT_SUPPORTED;
 
-    cImages.Release();
-
     if (statusCallback
         && nimages == 1
         && !metadata.IsVolumemap()
@@ -765,7 +1240,7 @@ HRESULT DirectX::CompressEx(
 
     TexMetadata mdata2 = metadata;
     mdata2.format = format;
-    HRESULT hr = cImages.Initialize(mdata2);
+    HRESULT hr = cImages.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -802,32 +1277,35 @@ HRESULT DirectX::CompressEx(
             cImages.Release();
             return E_FAIL;
         }
+    }
 
-        if (options.flags & TEX_COMPRESS_PARALLEL)
-        {
-        #ifndef _OPENMP
-            hr = E_NOTIMPL;
-        #else
-            hr = CompressBC_Parallel(src, dest[index], GetBCFlags(options.flags), GetSRGBFlags(options.flags), options.threshold, nullptr);
-        #endif // _OPENMP
-        }
-        else
-        {
-            hr = CompressBC(src, dest[index], GetBCFlags(options.flags), GetSRGBFlags(options.flags), options.threshold, nullptr);
-        }
-
+    if (options.flags & TEX_COMPRESS_PARALLEL)
+    {
+        hr = CompressBC_Parallel(srcImages, dest, nimages, GetBCFlags(options.flags), GetSRGBFlags(options.flags), options.threshold, options.executor, statusCallback);
         if (FAILED(hr))
         {
             cImages.Release();
             return hr;
         }
-
-        if (statusCallback)
+    }
+    else
+    {
+        for (size_t index = 0; index < nimages; ++index)
         {
-            if (!statusCallback(index, nimages))
+            hr = CompressBC(srcImages[index], dest[index], GetBCFlags(options.flags), GetSRGBFlags(options.flags), options.threshold, nullptr);
+            if (FAILED(hr))
             {
                 cImages.Release();
-                return E_ABORT;
+                return hr;
+            }
+
+            if (statusCallback)
+            {
+                if (!statusCallback(index, nimages))
+                {
+                    cImages.Release();
+                    return E_ABORT;
+                }
             }
         }
     }
@@ -853,6 +1331,17 @@ HRESULT DirectX::Decompress(
     const Image& cImage,
     DXGI_FORMAT format,
     ScratchImage& image) noexcept
+{
+    return Decompress(cImage, format, TEX_COMPRESS_DEFAULT, nullptr, image);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::Decompress(
+    const Image& cImage,
+    DXGI_FORMAT format,
+    TEX_COMPRESS_FLAGS compress,
+    ITaskExecutor* executor,
+    ScratchImage& image) noexcept
 {
     if (!IsCompressed(cImage.format) || IsCompressed(format))
         return E_INVALIDARG;
@@ -877,7 +1366,7 @@ HRESULT DirectX::Decompress(
     }
 
     // Create decompressed image
-    HRESULT hr = image.Initialize2D(format, cImage.width, cImage.height, 1, 1);
+    HRESULT hr = image.Initialize2D(format, cImage.width, cImage.height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -889,7 +1378,14 @@ HRESULT DirectX::Decompress(
     }
 
     // Decompress single image
-    hr = DecompressBC(cImage, *img);
+    if (compress & TEX_COMPRESS_PARALLEL)
+    {
+        hr = DecompressBC_Parallel(&cImage, img, 1, executor);
+    }
+    else
+    {
+        hr = DecompressBC(cImage, *img);
+    }
     if (FAILED(hr))
         image.Release();
 
@@ -903,6 +1399,19 @@ HRESULT DirectX::Decompress(
     const TexMetadata& metadata,
     DXGI_FORMAT format,
     ScratchImage& images) noexcept
+{
+    return Decompress(cImages, nimages, metadata, format, TEX_COMPRESS_DEFAULT, nullptr, images);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::Decompress(
+    const Image* cImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    DXGI_FORMAT format,
+    TEX_COMPRESS_FLAGS compress,
+    ITaskExecutor* executor,
+    ScratchImage& images) noexcept
 {
     if (!cImages || !nimages)
         return E_INVALIDARG;
@@ -929,11 +1438,9 @@ HRESULT DirectX::Decompress(
             return HRESULT_E_NOT_SUPPORTED;
     }
 
-    images.Release();
-
     TexMetadata mdata2 = metadata;
     mdata2.format = format;
-    HRESULT hr = images.Initialize(mdata2);
+    HRESULT hr = images.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -967,6 +1474,9 @@ HRESULT DirectX::Decompress(
             return E_FAIL;
         }
 
+        if (compress & TEX_COMPRESS_PARALLEL)
+            continue;
+
         hr = DecompressBC(src, dest[index]);
         if (FAILED(hr))
         {
@@ -975,5 +1485,15 @@ HRESULT DirectX::Decompress(
         }
     }
 
+    if (compress & TEX_COMPRESS_PARALLEL)
+    {
+        hr = DecompressBC_Parallel(cImages, dest, nimages, executor);
+        if (FAILED(hr))
+        {
+            images.Release();
+            return hr;
+        }
+    }
+
     return S_OK;
 }
@@ -24,6 +24,8 @@ namespace
         static_assert(static_cast<int>(TEX_COMPRESS_SRGB_IN) == static_cast<int>(TEX_FILTER_SRGB_IN), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_COMPRESS_SRGB_OUT) == static_cast<int>(TEX_FILTER_SRGB_OUT), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_COMPRESS_SRGB) == static_cast<int>(TEX_FILTER_SRGB), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
+        static_assert(static_cast<int>(TEX_COMPRESS_SRGB_EXACT) == static_cast<int>(TEX_FILTER_SRGB_EXACT), "TEX_COMPRESS_SRGB* should match TEX_FILTER_SRGB*");
+        static_assert((static_cast<uint32_t>(TEX_COMPRESS_BC7_FAST) & TEX_FILTER_SRGB_MASK) == 0, "TEX_COMPRESS_BC7_FAST must not overlap TEX_FILTER_SRGB_MASK");
         return static_cast<TEX_FILTER_FLAGS>(compress & TEX_FILTER_SRGB_MASK);
     }
 
@@ -67,6 +69,9 @@ namespace
             return E_OUTOFMEMORY;
         }
 
+        ConvertPlan plan;
+        CreateConvertPlan(plan, format, srcImage.format, filter);
+
         const uint8_t *pSrc = srcImage.pixels;
         for (size_t h = 0; h < srcImage.height; ++h)
         {
@@ -76,7 +81,7 @@ namespace
                 return E_FAIL;
             }
 
-            ConvertScanline(scanline.get(), srcImage.width, format, srcImage.format, filter);
+            ConvertScanline(scanline.get(), srcImage.width, plan);
 
             if (!StoreScanline(pDest, img->rowPitch, format, scanline.get(), srcImage.width))
             {
@@ -121,6 +126,9 @@ namespace
             return E_POINTER;
         }
 
+        ConvertPlan plan;
+        CreateConvertPlan(plan, DXGI_FORMAT_R32G32B32A32_FLOAT, srcImage.format, filter);
+
         const uint8_t *pSrc = srcImage.pixels;
         for (size_t h = 0; h < srcImage.height; ++h)
         {
@@ -130,7 +138,7 @@ namespace
                 return E_FAIL;
             }
 
-            ConvertScanline(reinterpret_cast<XMVECTOR*>(pDest), srcImage.width, DXGI_FORMAT_R32G32B32A32_FLOAT, srcImage.format, filter);
+            ConvertScanline(reinterpret_cast<XMVECTOR*>(pDest), srcImage.width, plan);
 
             pSrc += srcImage.rowPitch;
             pDest += img->rowPitch;
@@ -278,7 +286,7 @@ HRESULT DirectX::CompressEx(
         return hr;
 
     // Create workspace for result
-    hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1);
+    hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -353,7 +361,7 @@ HRESULT DirectX::CompressEx(
     // Create workspace for result
     TexMetadata mdata2 = metadata;
     mdata2.format = format;
-    hr = cImages.Initialize(mdata2);
+    hr = cImages.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -192,9 +192,6 @@ namespace
 #endif
 
     const XMVECTORF32 g_Grayscale = { { { 0.2125f, 0.7154f, 0.0721f, 0.0f } } };
-    const XMVECTORF32 g_HalfMin = { { { -65504.f, -65504.f, -65504.f, -65504.f } } };
-    const XMVECTORF32 g_HalfMax = { { { 65504.f, 65504.f, 65504.f, 65504.f } } };
-    const XMVECTORF32 g_8BitBias = { { { 0.5f / 255.f, 0.5f / 255.f, 0.5f / 255.f, 0.5f / 255.f } } };
 }
 
 //-------------------------------------------------------------------------------------
@@ -816,10 +813,10 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
         LOAD_SCANLINE3(XMINT3, XMLoadSInt3, g_XMIdentityR3)
 
     case DXGI_FORMAT_R16G16B16A16_FLOAT:
-        LOAD_SCANLINE(XMHALF4, XMLoadHalf4)
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R16G16B16A16_FLOAT>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_R16G16B16A16_UNORM:
-        LOAD_SCANLINE(XMUSHORTN4, XMLoadUShortN4)
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R16G16B16A16_UNORM>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_R16G16B16A16_UINT:
         LOAD_SCANLINE(XMUSHORT4, XMLoadUShort4)
@@ -893,7 +890,7 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
         return false;
 
     case DXGI_FORMAT_R10G10B10A2_UNORM:
-        LOAD_SCANLINE(XMUDECN4, XMLoadUDecN4)
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R10G10B10A2_UNORM>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
         LOAD_SCANLINE(XMUDECN4, XMLoadUDecN4_XR)
@@ -906,7 +903,7 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
 
     case DXGI_FORMAT_R8G8B8A8_UNORM:
     case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
-        LOAD_SCANLINE(XMUBYTEN4, XMLoadUByteN4)
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R8G8B8A8_UNORM>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_R8G8B8A8_UINT:
         LOAD_SCANLINE(XMUBYTE4, XMLoadUByte4)
@@ -934,18 +931,7 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
 
     case DXGI_FORMAT_D32_FLOAT:
     case DXGI_FORMAT_R32_FLOAT:
-        if (size >= sizeof(float))
-        {
-            const float* __restrict sPtr = static_cast<const float*>(pSource);
-            for (size_t icount = 0; icount < (size - sizeof(float) + 1); icount += sizeof(float))
-            {
-                const XMVECTOR v = XMLoadFloat(sPtr++);
-                if (dPtr >= ePtr) break;
-                *(dPtr++) = XMVectorSelect(g_XMIdentityR3, v, g_XMSelect1000);
-            }
-            return true;
-        }
-        return false;
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R32_FLOAT>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_R32_UINT:
         if (size >= sizeof(uint32_t))
@@ -1036,17 +1022,7 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
         LOAD_SCANLINE2(XMBYTE2, XMLoadByte2, g_XMIdentityR3)
 
     case DXGI_FORMAT_R16_FLOAT:
-        if (size >= sizeof(HALF))
-        {
-            const HALF * __restrict sPtr = static_cast<const HALF*>(pSource);
-            for (size_t icount = 0; icount < (size - sizeof(HALF) + 1); icount += sizeof(HALF))
-            {
-                if (dPtr >= ePtr) break;
-                *(dPtr++) = XMVectorSet(XMConvertHalfToFloat(*sPtr++), 0.f, 0.f, 1.f);
-            }
-            return true;
-        }
-        return false;
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R16_FLOAT>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_D16_UNORM:
     case DXGI_FORMAT_R16_UNORM:
@@ -1102,17 +1078,7 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
         return false;
 
     case DXGI_FORMAT_R8_UNORM:
-        if (size >= sizeof(uint8_t))
-        {
-            const uint8_t * __restrict sPtr = static_cast<const uint8_t*>(pSource);
-            for (size_t icount = 0; icount < size; icount += sizeof(uint8_t))
-            {
-                if (dPtr >= ePtr) break;
-                *(dPtr++) = XMVectorSet(static_cast<float>(*sPtr++) / 255.f, 0.f, 0.f, 1.f);
-            }
-            return true;
-        }
-        return false;
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_R8_UNORM>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_R8_UINT:
         if (size >= sizeof(uint8_t))
@@ -1257,34 +1223,11 @@ _Use_decl_annotations_ bool DirectX::Internal::LoadScanline(
 
     case DXGI_FORMAT_B8G8R8A8_UNORM:
     case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
-        if (size >= sizeof(XMUBYTEN4))
-        {
-            const XMUBYTEN4 * __restrict sPtr = static_cast<const XMUBYTEN4*>(pSource);
-            for (size_t icount = 0; icount < (size - sizeof(XMUBYTEN4) + 1); icount += sizeof(XMUBYTEN4))
-            {
-                const XMVECTOR v = XMLoadUByteN4(sPtr++);
-                if (dPtr >= ePtr) break;
-                *(dPtr++) = XMVectorSwizzle<2, 1, 0, 3>(v);
-            }
-            return true;
-        }
-        return false;
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_B8G8R8A8_UNORM>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_B8G8R8X8_UNORM:
     case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
-        if (size >= sizeof(XMUBYTEN4))
-        {
-            const XMUBYTEN4 * __restrict sPtr = static_cast<const XMUBYTEN4*>(pSource);
-            for (size_t icount = 0; icount < (size - sizeof(XMUBYTEN4) + 1); icount += sizeof(XMUBYTEN4))
-            {
-                XMVECTOR v = XMLoadUByteN4(sPtr++);
-                v = XMVectorSwizzle<2, 1, 0, 3>(v);
-                if (dPtr >= ePtr) break;
-                *(dPtr++) = XMVectorSelect(g_XMIdentityR3, v, g_XMSelect1110);
-            }
-            return true;
-        }
-        return false;
+        return LoadScanlineT<ScanlineCodec<DXGI_FORMAT_B8G8R8X8_UNORM>>(dPtr, count, pSource, size);
 
     case DXGI_FORMAT_AYUV:
         if (size >= sizeof(XMUBYTEN4))
@@ -1667,7 +1610,7 @@ bool DirectX::Internal::StoreScanline(
     switch (static_cast<int>(format))
     {
     case DXGI_FORMAT_R32G32B32A32_FLOAT:
-        STORE_SCANLINE(XMFLOAT4, XMStoreFloat4)
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R32G32B32A32_FLOAT>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R32G32B32A32_UINT:
         STORE_SCANLINE(XMUINT4, XMStoreUInt4)
@@ -1685,22 +1628,10 @@ bool DirectX::Internal::StoreScanline(
         STORE_SCANLINE(XMINT3, XMStoreSInt3)
 
     case DXGI_FORMAT_R16G16B16A16_FLOAT:
-        if (size >= sizeof(XMHALF4))
-        {
-            XMHALF4* __restrict dPtr = static_cast<XMHALF4*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(XMHALF4) + 1); icount += sizeof(XMHALF4))
-            {
-                if (sPtr >= ePtr) break;
-                XMVECTOR v = *sPtr++;
-                v = XMVectorClamp(v, g_HalfMin, g_HalfMax);
-                XMStoreHalf4(dPtr++, v);
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R16G16B16A16_FLOAT>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R16G16B16A16_UNORM:
-        STORE_SCANLINE(XMUSHORTN4, XMStoreUShortN4)
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R16G16B16A16_UNORM>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R16G16B16A16_UINT:
         STORE_SCANLINE(XMUSHORT4, XMStoreUShort4)
@@ -1743,7 +1674,7 @@ bool DirectX::Internal::StoreScanline(
             return false;
 
     case DXGI_FORMAT_R10G10B10A2_UNORM:
-        STORE_SCANLINE(XMUDECN4, XMStoreUDecN4)
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R10G10B10A2_UNORM>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
         STORE_SCANLINE(XMUDECN4, XMStoreUDecN4_XR)
@@ -1756,18 +1687,7 @@ bool DirectX::Internal::StoreScanline(
 
     case DXGI_FORMAT_R8G8B8A8_UNORM:
     case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
-        if (size >= sizeof(XMUBYTEN4))
-        {
-            XMUBYTEN4 * __restrict dPtr = static_cast<XMUBYTEN4*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(XMUBYTEN4) + 1); icount += sizeof(XMUBYTEN4))
-            {
-                if (sPtr >= ePtr) break;
-                const XMVECTOR v = XMVectorAdd(*sPtr++, g_8BitBias);
-                XMStoreUByteN4(dPtr++, v);
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R8G8B8A8_UNORM>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R8G8B8A8_UINT:
         STORE_SCANLINE(XMUBYTE4, XMStoreUByte4)
@@ -1807,17 +1727,7 @@ bool DirectX::Internal::StoreScanline(
 
     case DXGI_FORMAT_D32_FLOAT:
     case DXGI_FORMAT_R32_FLOAT:
-        if (size >= sizeof(float))
-        {
-            float * __restrict dPtr = static_cast<float*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(float) + 1); icount += sizeof(float))
-            {
-                if (sPtr >= ePtr) break;
-                XMStoreFloat(dPtr++, *(sPtr++));
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R32_FLOAT>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R32_UINT:
         if (size >= sizeof(uint32_t))
@@ -1878,19 +1788,7 @@ bool DirectX::Internal::StoreScanline(
         STORE_SCANLINE(XMBYTE2, XMStoreByte2)
 
     case DXGI_FORMAT_R16_FLOAT:
-        if (size >= sizeof(HALF))
-        {
-            HALF * __restrict dPtr = static_cast<HALF*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(HALF) + 1); icount += sizeof(HALF))
-            {
-                if (sPtr >= ePtr) break;
-                float v = XMVectorGetX(*sPtr++);
-                v = std::max<float>(std::min<float>(v, 65504.f), -65504.f);
-                *(dPtr++) = XMConvertFloatToHalf(v);
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R16_FLOAT>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_D16_UNORM:
     case DXGI_FORMAT_R16_UNORM:
@@ -1954,19 +1852,7 @@ bool DirectX::Internal::StoreScanline(
         return false;
 
     case DXGI_FORMAT_R8_UNORM:
-        if (size >= sizeof(uint8_t))
-        {
-            uint8_t * __restrict dPtr = static_cast<uint8_t*>(pDestination);
-            for (size_t icount = 0; icount < size; icount += sizeof(uint8_t))
-            {
-                if (sPtr >= ePtr) break;
-                float v = XMVectorGetX(*sPtr++);
-                v = std::max<float>(std::min<float>(v, 1.f), 0.f);
-                *(dPtr++) = static_cast<uint8_t>(v * 255.f);
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_R8_UNORM>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_R8_UINT:
         if (size >= sizeof(uint8_t))
@@ -2138,35 +2024,11 @@ bool DirectX::Internal::StoreScanline(
 
     case DXGI_FORMAT_B8G8R8A8_UNORM:
     case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
-        if (size >= sizeof(XMUBYTEN4))
-        {
-            XMUBYTEN4 * __restrict dPtr = static_cast<XMUBYTEN4*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(XMUBYTEN4) + 1); icount += sizeof(XMUBYTEN4))
-            {
-                if (sPtr >= ePtr) break;
-                XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(*sPtr++);
-                v = XMVectorAdd(v, g_8BitBias);
-                XMStoreUByteN4(dPtr++, v);
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_B8G8R8A8_UNORM>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_B8G8R8X8_UNORM:
     case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
-        if (size >= sizeof(XMUBYTEN4))
-        {
-            XMUBYTEN4 * __restrict dPtr = static_cast<XMUBYTEN4*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(XMUBYTEN4) + 1); icount += sizeof(XMUBYTEN4))
-            {
-                if (sPtr >= ePtr) break;
-                XMVECTOR v = XMVectorPermute<2, 1, 0, 7>(*sPtr++, g_XMIdentityR3);
-                v = XMVectorAdd(v, g_8BitBias);
-                XMStoreUByteN4(dPtr++, v);
-            }
-            return true;
-        }
-        return false;
+        return StoreScanlineT<ScanlineCodec<DXGI_FORMAT_B8G8R8X8_UNORM>>(pDestination, size, sPtr, count);
 
     case DXGI_FORMAT_AYUV:
         if (size >= sizeof(XMUBYTEN4))
@@ -2790,6 +2652,125 @@ HRESULT DirectX::Internal::ConvertFromR16G16B16A16(const Image& srcImage, const
 }
 
 
+//-------------------------------------------------------------------------------------
+// sRGB transfer helpers
+//-------------------------------------------------------------------------------------
+namespace
+{
+    // Linear RGB -> sRGB for results stored with 8 bits or less per channel. Above the linear segment
+    // this is a minimax fit of the sRGB curve in x^(1/2), x^(1/4), x^(1/8) and x^(1/16), so it needs only
+    // square roots instead of XMVectorPow. Max error is 3.1e-6 (about 1/1250th of an 8-bit step).
+    XMVECTOR XM_CALLCONV ColorRGBToSRGBFast(FXMVECTOR rgb) noexcept
+    {
+        static const XMVECTORF32 Cutoff = { { { 0.0031308f, 0.0031308f, 0.0031308f, 1.f } } };
+        static const XMVECTORF32 Linear = { { { 12.92f, 12.92f, 12.92f, 1.f } } };
+        static const XMVECTORF32 C0 = { { { -0.342012483f, -0.342012483f, -0.342012483f, 0.f } } };
+        static const XMVECTORF32 C1 = { { { -0.008106388f, -0.008106388f, -0.008106388f, 0.f } } };
+        static const XMVECTORF32 C2 = { { { 0.532348759f, 0.532348759f, 0.532348759f, 0.f } } };
+        static const XMVECTORF32 C4 = { { { 1.292003473f, 1.292003473f, 1.292003473f, 0.f } } };
+        static const XMVECTORF32 C8 = { { { -1.790271895f, -1.790271895f, -1.790271895f, 0.f } } };
+        static const XMVECTORF32 C16 = { { { 1.316035824f, 1.316035824f, 1.316035824f, 0.f } } };
+
+        XMVECTOR V = XMVectorSaturate(rgb);
+        const XMVECTOR V0 = XMVectorMultiply(V, Linear);
+
+        const XMVECTOR S2 = XMVectorSqrt(V);
+        const XMVECTOR S4 = XMVectorSqrt(S2);
+        const XMVECTOR S8 = XMVectorSqrt(S4);
+        const XMVECTOR S16 = XMVectorSqrt(S8);
+
+        XMVECTOR V1 = XMVectorMultiplyAdd(V, C1, C0);
+        V1 = XMVectorMultiplyAdd(S2, C2, V1);
+        V1 = XMVectorMultiplyAdd(S4, C4, V1);
+        V1 = XMVectorMultiplyAdd(S8, C8, V1);
+        V1 = XMVectorMultiplyAdd(S16, C16, V1);
+
+        const XMVECTOR select = XMVectorLess(V, Cutoff);
+        V = XMVectorSelect(V1, V0, select);
+        return XMVectorSelect(rgb, V, g_XMSelect1110);
+    }
+
+    // sRGB -> Linear RGB for each byte value in each lane of XMLoadUByteN4, computed with the exact
+    // curve so the table reproduces LoadScanline followed by XMColorSRGBToRGB. Lane 3 is alpha (no curve).
+    struct SRGB8Table
+    {
+        float lane[4][256];
+
+        SRGB8Table() noexcept
+        {
+            for (size_t i = 0; i < 256; ++i)
+            {
+                const auto b = static_cast<uint8_t>(i);
+                const XMUBYTEN4 packed(b, b, b, b);
+                XMFLOAT4A value;
+                XMStoreFloat4A(&value, XMColorSRGBToRGB(XMLoadUByteN4(&packed)));
+                lane[0][i] = value.x;
+                lane[1][i] = value.y;
+                lane[2][i] = value.z;
+                lane[3][i] = value.w;
+            }
+        }
+    };
+
+    // LoadScanlineLinear for 8-bit 4-channel sRGB data; returns false to fall back to the general path
+    bool LoadScanlineSRGB8(
+        _Out_writes_(count) XMVECTOR* pDestination,
+        size_t count,
+        _In_reads_bytes_(size) const void* pSource,
+        size_t size,
+        DXGI_FORMAT format) noexcept
+    {
+        size_t red, blue;
+        bool opaque = false;
+        switch (static_cast<int>(format))
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+            red = 0;
+            blue = 2;
+            break;
+
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+            opaque = true;
+            red = 2;
+            blue = 0;
+            break;
+
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            red = 2;
+            blue = 0;
+            break;
+
+        default:
+            return false;
+        }
+
+        if (size < sizeof(uint32_t))
+            return false;
+
+        static const SRGB8Table s_table;
+        const auto& lane = s_table.lane;
+
+        const size_t n = std::min<size_t>(count, size / sizeof(uint32_t));
+        const uint8_t * __restrict sPtr = static_cast<const uint8_t*>(pSource);
+        XMVECTOR* __restrict dPtr = pDestination;
+        for (size_t i = 0; i < n; ++i, sPtr += 4)
+        {
+            const XMVECTORF32 v = { { {
+                lane[red][sPtr[red]],
+                lane[1][sPtr[1]],
+                lane[blue][sPtr[blue]],
+                (opaque) ? 1.f : lane[3][sPtr[3]] } } };
+            *(dPtr++) = v;
+        }
+
+        return true;
+    }
+}
+
+
 //-------------------------------------------------------------------------------------
 // Convert from Linear RGB to sRGB
 //
@@ -2858,9 +2839,19 @@ bool DirectX::Internal::StoreScanlineLinear(
         // To avoid the need for another temporary scanline buffer, we allow this function to overwrite the source buffer in-place
         // Given the intended usage in the filtering routines, this is not a problem.
         XMVECTOR* ptr = pSource;
-        for (size_t i = 0; i < count; ++i, ++ptr)
+        if (!(flags & TEX_FILTER_SRGB_EXACT) && BitsPerColor(format) <= 8)
+        {
+            for (size_t i = 0; i < count; ++i, ++ptr)
+            {
+                *ptr = ColorRGBToSRGBFast(*ptr);
+            }
+        }
+        else
         {
-            *ptr = XMColorRGBToSRGB(*ptr);
+            for (size_t i = 0; i < count; ++i, ++ptr)
+            {
+                *ptr = XMColorRGBToSRGB(*ptr);
+            }
         }
     }
 
@@ -2924,6 +2915,9 @@ bool DirectX::Internal::LoadScanlineLinear(
         break;
     }
 
+    if ((flags & TEX_FILTER_SRGB_IN) && LoadScanlineSRGB8(pDestination, count, pSource, size, format))
+        return true;
+
     if (LoadScanline(pDestination, count, pSource, size, format))
     {
         // sRGB input processing (sRGB -> Linear RGB)
@@ -3074,86 +3068,328 @@ uint32_t DirectX::Internal::GetConvertFlags(DXGI_FORMAT format) noexcept
     return (in) ? in->flags : 0;
 }
 
-_Use_decl_annotations_
-void DirectX::Internal::ConvertScanline(
-    XMVECTOR* pBuffer,
-    size_t count,
-    DXGI_FORMAT outFormat,
-    DXGI_FORMAT inFormat,
-    TEX_FILTER_FLAGS flags) noexcept
+//-------------------------------------------------------------------------------------
+// Conversion plan steps (selected once per format pair by CreateConvertPlan)
+//-------------------------------------------------------------------------------------
+namespace
 {
-    assert(pBuffer && count > 0 && ((reinterpret_cast<uintptr_t>(pBuffer) & 0xF) == 0));
-    assert(IsValid(outFormat) && !IsTypeless(outFormat) && !IsPlanar(outFormat) && !IsPalettized(outFormat));
-    assert(IsValid(inFormat) && !IsTypeless(inFormat) && !IsPlanar(inFormat) && !IsPalettized(inFormat));
+    template<XMVECTOR (XM_CALLCONV *Op)(FXMVECTOR)>
+    void ConvertStep(_Inout_updates_all_(count) XMVECTOR* pBuffer, size_t count) noexcept
+    {
+        XMVECTOR* ptr = pBuffer;
+        for (size_t i = 0; i < count; ++i, ++ptr)
+        {
+            *ptr = Op(*ptr);
+        }
+    }
 
-    if (!pBuffer)
-        return;
+    const XMVECTORF32 g_StencilScale = { { { 1.f, 1.f, 1.f, 255.f } } };
+    const XMVECTORF32 g_StencilScaleAll = { { { 255.f, 255.f, 255.f, 255.f } } };
+    const XMVECTORU32 g_Select0100 = { { { XM_SELECT_0, XM_SELECT_1, XM_SELECT_0, XM_SELECT_0 } } };
 
-#ifdef _DEBUG
-    // Ensure conversion table is in ascending order
-    assert(std::size(g_ConvertTable) > 0);
-    DXGI_FORMAT lastvalue = g_ConvertTable[0].format;
-    for (size_t index = 1; index < std::size(g_ConvertTable); ++index)
+    // Depth/stencil -> color
+    XMVECTOR XM_CALLCONV StencilToAlphaUNorm(FXMVECTOR v) noexcept
     {
-        assert(g_ConvertTable[index].format > lastvalue);
-        lastvalue = g_ConvertTable[index].format;
+        XMVECTOR v1 = XMVectorSplatY(v);
+        v1 = XMVectorClamp(v1, g_XMZero, g_StencilScale);
+        v1 = XMVectorDivide(v1, g_StencilScale);
+        return XMVectorSelect(v1, v, g_XMSelect1110);
     }
-#endif
 
-    // Determine conversion details about source and dest formats
-    ConvertData key = { inFormat, 0, 0 };
-    auto in = reinterpret_cast<const ConvertData*>(
-        bsearch(&key, g_ConvertTable, std::size(g_ConvertTable), sizeof(ConvertData), ConvertCompare));
-    key.format = outFormat;
-    auto out = reinterpret_cast<const ConvertData*>(
-        bsearch(&key, g_ConvertTable, std::size(g_ConvertTable), sizeof(ConvertData), ConvertCompare));
-    if (!in || !out)
+    XMVECTOR XM_CALLCONV StencilToAlphaSNorm(FXMVECTOR v) noexcept
     {
-        assert(false);
-        return;
+        XMVECTOR v1 = XMVectorSplatY(v);
+        v1 = XMVectorClamp(v1, g_XMZero, g_StencilScale);
+        v1 = XMVectorDivide(v1, g_StencilScale);
+        v1 = XMVectorMultiplyAdd(v1, g_XMTwo, g_XMNegativeOne);
+        return XMVectorSelect(v1, v, g_XMSelect1110);
     }
 
-    assert(GetConvertFlags(inFormat) == in->flags);
-    assert(GetConvertFlags(outFormat) == out->flags);
+    XMVECTOR XM_CALLCONV StencilToAlpha(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatY(v);
+        return XMVectorSelect(v1, v, g_XMSelect1110);
+    }
 
-    // Handle SRGB filtering modes
-    switch (inFormat)
+    XMVECTOR XM_CALLCONV DepthFloatToUNorm(FXMVECTOR v) noexcept
     {
-    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
-    case DXGI_FORMAT_BC1_UNORM_SRGB:
-    case DXGI_FORMAT_BC2_UNORM_SRGB:
-    case DXGI_FORMAT_BC3_UNORM_SRGB:
-    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
-    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
-    case DXGI_FORMAT_BC7_UNORM_SRGB:
-        flags |= TEX_FILTER_SRGB_IN;
-        break;
+        XMVECTOR v1 = XMVectorSaturate(v);
+        v1 = XMVectorSplatX(v1);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
 
-    case DXGI_FORMAT_A8_UNORM:
-    case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
-        flags &= ~TEX_FILTER_SRGB_IN;
-        break;
+    XMVECTOR XM_CALLCONV DepthUNormToSNorm(FXMVECTOR v) noexcept
+    {
+        XMVECTOR v1 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+        v1 = XMVectorSplatX(v1);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
 
-    default:
-        break;
+    XMVECTOR XM_CALLCONV DepthFloatToSNorm(FXMVECTOR v) noexcept
+    {
+        XMVECTOR v1 = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
+        v1 = XMVectorSplatX(v1);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
     }
 
-    switch (outFormat)
+    // Also R -> RGB
+    XMVECTOR XM_CALLCONV ReplicateRedToRGB(FXMVECTOR v) noexcept
     {
-    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
-    case DXGI_FORMAT_BC1_UNORM_SRGB:
-    case DXGI_FORMAT_BC2_UNORM_SRGB:
-    case DXGI_FORMAT_BC3_UNORM_SRGB:
-    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
-    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
-    case DXGI_FORMAT_BC7_UNORM_SRGB:
-        flags |= TEX_FILTER_SRGB_OUT;
-        break;
+        const XMVECTOR v1 = XMVectorSplatX(v);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
 
-    case DXGI_FORMAT_A8_UNORM:
-    case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
-        flags &= ~TEX_FILTER_SRGB_OUT;
-        break;
+    // Color -> depth (red channel)
+    XMVECTOR XM_CALLCONV GreenToRed(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatY(v);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    XMVECTOR XM_CALLCONV BlueToRed(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatZ(v);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    XMVECTOR XM_CALLCONV AlphaToRed(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatW(v);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    XMVECTOR XM_CALLCONV GrayscaleToRed(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVector3Dot(v, g_Grayscale);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    XMVECTOR XM_CALLCONV RedToRed(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatX(v);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    XMVECTOR XM_CALLCONV RedSNormToUNorm(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    // Also depth FLOAT -> UNORM depth, preserving stencil
+    XMVECTOR XM_CALLCONV RedFloatToUNorm(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSaturate(v);
+        return XMVectorSelect(v, v1, g_XMSelect1000);
+    }
+
+    XMVECTOR XM_CALLCONV AlphaUNormToStencil(FXMVECTOR v) noexcept
+    {
+        XMVECTOR v1 = XMVectorMultiply(v, g_StencilScaleAll);
+        v1 = XMVectorSplatW(v1);
+        return XMVectorSelect(v, v1, g_Select0100);
+    }
+
+    XMVECTOR XM_CALLCONV AlphaSNormToStencil(FXMVECTOR v) noexcept
+    {
+        XMVECTOR v1 = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
+        v1 = XMVectorMultiply(v1, g_StencilScaleAll);
+        v1 = XMVectorSplatW(v1);
+        return XMVectorSelect(v, v1, g_Select0100);
+    }
+
+    XMVECTOR XM_CALLCONV AlphaToStencil(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatW(v);
+        return XMVectorSelect(v, v1, g_Select0100);
+    }
+
+    // Numeric type conversions
+    XMVECTOR XM_CALLCONV SNormToUNorm(FXMVECTOR v) noexcept
+    {
+        return XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
+    }
+
+    XMVECTOR XM_CALLCONV FloatToUNormX2Bias(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
+        return XMVectorMultiplyAdd(v1, g_XMOneHalf, g_XMOneHalf);
+    }
+
+    XMVECTOR XM_CALLCONV FloatToUNorm(FXMVECTOR v) noexcept
+    {
+        return XMVectorSaturate(v);
+    }
+
+    XMVECTOR XM_CALLCONV UNormToSNorm(FXMVECTOR v) noexcept
+    {
+        return XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
+    }
+
+    XMVECTOR XM_CALLCONV FloatX2BiasToSNorm(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSaturate(v);
+        return XMVectorMultiplyAdd(v1, g_XMTwo, g_XMNegativeOne);
+    }
+
+    XMVECTOR XM_CALLCONV FloatToSNorm(FXMVECTOR v) noexcept
+    {
+        return XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
+    }
+
+    // Channel replication
+    XMVECTOR XM_CALLCONV SplatRed(FXMVECTOR v) noexcept
+    {
+        return XMVectorSplatX(v);
+    }
+
+    XMVECTOR XM_CALLCONV SplatGreen(FXMVECTOR v) noexcept
+    {
+        return XMVectorSplatY(v);
+    }
+
+    XMVECTOR XM_CALLCONV SplatBlue(FXMVECTOR v) noexcept
+    {
+        return XMVectorSplatZ(v);
+    }
+
+    XMVECTOR XM_CALLCONV SplatAlpha(FXMVECTOR v) noexcept
+    {
+        return XMVectorSplatW(v);
+    }
+
+    XMVECTOR XM_CALLCONV SplatGrayscale(FXMVECTOR v) noexcept
+    {
+        return XMVector3Dot(v, g_Grayscale);
+    }
+
+    XMVECTOR XM_CALLCONV ReplicateRedToRG(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatX(v);
+        return XMVectorSelect(v, v1, g_XMSelect1100);
+    }
+
+    XMVECTOR XM_CALLCONV GreenToRGB(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatY(v);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
+
+    XMVECTOR XM_CALLCONV BlueToRGB(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatZ(v);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
+
+    XMVECTOR XM_CALLCONV AlphaToRGB(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSplatW(v);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
+
+    XMVECTOR XM_CALLCONV GrayscaleToRGB(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVector3Dot(v, g_Grayscale);
+        return XMVectorSelect(v, v1, g_XMSelect1110);
+    }
+
+    template<uint32_t E0, uint32_t E1>
+    XMVECTOR XM_CALLCONV SwizzleToRG(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSwizzle<E0, E1, E0, E1>(v);
+        return XMVectorSelect(v, v1, g_XMSelect1100);
+    }
+
+    XMVECTOR XM_CALLCONV GreenBlueToRG(FXMVECTOR v) noexcept
+    {
+        const XMVECTOR v1 = XMVectorSwizzle<1, 2, 3, 0>(v);
+        return XMVectorSelect(v, v1, g_XMSelect1100);
+    }
+
+    inline void AddStep(ConvertPlan& plan, ConvertPlan::Step step) noexcept
+    {
+        assert(plan.stepCount < std::size(plan.steps));
+        plan.steps[plan.stepCount++] = step;
+    }
+}
+
+_Use_decl_annotations_
+void DirectX::Internal::CreateConvertPlan(
+    ConvertPlan& plan,
+    DXGI_FORMAT outFormat,
+    DXGI_FORMAT inFormat,
+    TEX_FILTER_FLAGS flags) noexcept
+{
+    assert(IsValid(outFormat) && !IsTypeless(outFormat) && !IsPlanar(outFormat) && !IsPalettized(outFormat));
+    assert(IsValid(inFormat) && !IsTypeless(inFormat) && !IsPlanar(inFormat) && !IsPalettized(inFormat));
+
+    plan.stepCount = 0;
+
+#ifdef _DEBUG
+    // Ensure conversion table is in ascending order
+    assert(std::size(g_ConvertTable) > 0);
+    DXGI_FORMAT lastvalue = g_ConvertTable[0].format;
+    for (size_t index = 1; index < std::size(g_ConvertTable); ++index)
+    {
+        assert(g_ConvertTable[index].format > lastvalue);
+        lastvalue = g_ConvertTable[index].format;
+    }
+#endif
+
+    // Determine conversion details about source and dest formats
+    ConvertData key = { inFormat, 0, 0 };
+    auto in = reinterpret_cast<const ConvertData*>(
+        bsearch(&key, g_ConvertTable, std::size(g_ConvertTable), sizeof(ConvertData), ConvertCompare));
+    key.format = outFormat;
+    auto out = reinterpret_cast<const ConvertData*>(
+        bsearch(&key, g_ConvertTable, std::size(g_ConvertTable), sizeof(ConvertData), ConvertCompare));
+    if (!in || !out)
+    {
+        assert(false);
+        return;
+    }
+
+    assert(GetConvertFlags(inFormat) == in->flags);
+    assert(GetConvertFlags(outFormat) == out->flags);
+
+    // Handle SRGB filtering modes
+    switch (inFormat)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        flags |= TEX_FILTER_SRGB_IN;
+        break;
+
+    case DXGI_FORMAT_A8_UNORM:
+    case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+        flags &= ~TEX_FILTER_SRGB_IN;
+        break;
+
+    default:
+        break;
+    }
+
+    switch (outFormat)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        flags |= TEX_FILTER_SRGB_OUT;
+        break;
+
+    case DXGI_FORMAT_A8_UNORM:
+    case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM:
+        flags &= ~TEX_FILTER_SRGB_OUT;
+        break;
 
     default:
         break;
@@ -3169,11 +3405,7 @@ void DirectX::Internal::ConvertScanline(
     {
         if (!(in->flags & CONVF_DEPTH) && ((in->flags & CONVF_FLOAT) || (in->flags & CONVF_UNORM)))
         {
-            XMVECTOR* ptr = pBuffer;
-            for (size_t i = 0; i < count; ++i, ++ptr)
-            {
-                *ptr = XMColorSRGBToRGB(*ptr);
-            }
+            AddStep(plan, ConvertStep<XMColorSRGBToRGB>);
         }
     }
 
@@ -3190,44 +3422,19 @@ void DirectX::Internal::ConvertScanline(
                 if (in->flags & CONVF_STENCIL)
                 {
                     // Stencil -> Alpha
-                    static const XMVECTORF32 S = { { { 1.f, 1.f, 1.f, 255.f } } };
-
                     if (out->flags & CONVF_UNORM)
                     {
                         // UINT -> UNORM
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            XMVECTOR v1 = XMVectorSplatY(v);
-                            v1 = XMVectorClamp(v1, g_XMZero, S);
-                            v1 = XMVectorDivide(v1, S);
-                            *ptr++ = XMVectorSelect(v1, v, g_XMSelect1110);
-                        }
+                        AddStep(plan, ConvertStep<StencilToAlphaUNorm>);
                     }
                     else if (out->flags & CONVF_SNORM)
                     {
                         // UINT -> SNORM
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            XMVECTOR v1 = XMVectorSplatY(v);
-                            v1 = XMVectorClamp(v1, g_XMZero, S);
-                            v1 = XMVectorDivide(v1, S);
-                            v1 = XMVectorMultiplyAdd(v1, g_XMTwo, g_XMNegativeOne);
-                            *ptr++ = XMVectorSelect(v1, v, g_XMSelect1110);
-                        }
+                        AddStep(plan, ConvertStep<StencilToAlphaSNorm>);
                     }
                     else
                     {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatY(v);
-                            *ptr++ = XMVectorSelect(v1, v, g_XMSelect1110);
-                        }
+                        AddStep(plan, ConvertStep<StencilToAlpha>);
                     }
                 }
 
@@ -3235,51 +3442,24 @@ void DirectX::Internal::ConvertScanline(
                 if ((out->flags & CONVF_UNORM) && (in->flags & CONVF_FLOAT))
                 {
                     // Depth FLOAT -> UNORM
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        XMVECTOR v1 = XMVectorSaturate(v);
-                        v1 = XMVectorSplatX(v1);
-                        *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                    }
+                    AddStep(plan, ConvertStep<DepthFloatToUNorm>);
                 }
                 else if (out->flags & CONVF_SNORM)
                 {
                     if (in->flags & CONVF_UNORM)
                     {
                         // Depth UNORM -> SNORM
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            XMVECTOR v1 = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                            v1 = XMVectorSplatX(v1);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                        }
+                        AddStep(plan, ConvertStep<DepthUNormToSNorm>);
                     }
                     else
                     {
                         // Depth FLOAT -> SNORM
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            XMVECTOR v1 = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                            v1 = XMVectorSplatX(v1);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                        }
+                        AddStep(plan, ConvertStep<DepthFloatToSNorm>);
                     }
                 }
                 else
                 {
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        const XMVECTOR v1 = XMVectorSplatX(v);
-                        *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                    }
+                    AddStep(plan, ConvertStep<ReplicateRedToRGB>);
                 }
             }
             else
@@ -3290,51 +3470,21 @@ void DirectX::Internal::ConvertScanline(
                 switch (flags & (TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN | TEX_FILTER_RGB_COPY_BLUE | TEX_FILTER_RGB_COPY_ALPHA))
                 {
                 case TEX_FILTER_RGB_COPY_GREEN:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatY(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<GreenToRed>);
                     break;
 
                 case TEX_FILTER_RGB_COPY_BLUE:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatZ(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<BlueToRed>);
                     break;
 
                 case TEX_FILTER_RGB_COPY_ALPHA:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatW(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<AlphaToRed>);
                     break;
 
                 default:
                     if ((in->flags & CONVF_UNORM) && ((in->flags & CONVF_RGB_MASK) == (CONVF_R | CONVF_G | CONVF_B)))
                     {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVector3Dot(v, g_Grayscale);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
+                        AddStep(plan, ConvertStep<GrayscaleToRed>);
                         break;
                     }
 
@@ -3347,15 +3497,7 @@ void DirectX::Internal::ConvertScanline(
                 #endif
 
                 case TEX_FILTER_RGB_COPY_RED:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatX(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<RedToRed>);
                     break;
                 }
 
@@ -3365,67 +3507,31 @@ void DirectX::Internal::ConvertScanline(
                     if (in->flags & CONVF_SNORM)
                     {
                         // SNORM -> UNORM
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
+                        AddStep(plan, ConvertStep<RedSNormToUNorm>);
                     }
                     else if (in->flags & CONVF_FLOAT)
                     {
                         // FLOAT -> UNORM
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSaturate(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                        }
+                        AddStep(plan, ConvertStep<RedFloatToUNorm>);
                     }
                 }
 
                 if (out->flags & CONVF_STENCIL)
                 {
                     // Alpha -> Stencil (green channel)
-                    static const XMVECTORU32 select0100 = { { { XM_SELECT_0, XM_SELECT_1, XM_SELECT_0, XM_SELECT_0 } } };
-                    static const XMVECTORF32 S = { { { 255.f, 255.f, 255.f, 255.f } } };
-
                     if (in->flags & CONVF_UNORM)
                     {
                         // UNORM -> UINT
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            XMVECTOR v1 = XMVectorMultiply(v, S);
-                            v1 = XMVectorSplatW(v1);
-                            *ptr++ = XMVectorSelect(v, v1, select0100);
-                        }
+                        AddStep(plan, ConvertStep<AlphaUNormToStencil>);
                     }
                     else if (in->flags & CONVF_SNORM)
                     {
                         // SNORM -> UINT
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            XMVECTOR v1 = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-                            v1 = XMVectorMultiply(v1, S);
-                            v1 = XMVectorSplatW(v1);
-                            *ptr++ = XMVectorSelect(v, v1, select0100);
-                        }
+                        AddStep(plan, ConvertStep<AlphaSNormToStencil>);
                     }
                     else
                     {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatW(v);
-                            *ptr++ = XMVectorSelect(v, v1, select0100);
-                        }
+                        AddStep(plan, ConvertStep<AlphaToStencil>);
                     }
                 }
             }
@@ -3438,13 +3544,7 @@ void DirectX::Internal::ConvertScanline(
                 if (in->flags & CONVF_FLOAT)
                 {
                     // FLOAT -> UNORM depth, preserve stencil
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        const XMVECTOR v1 = XMVectorSaturate(v);
-                        *ptr++ = XMVectorSelect(v, v1, g_XMSelect1000);
-                    }
+                    AddStep(plan, ConvertStep<RedFloatToUNorm>);
                 }
             }
         }
@@ -3454,34 +3554,19 @@ void DirectX::Internal::ConvertScanline(
             if (in->flags & CONVF_SNORM)
             {
                 // SNORM -> UNORM
-                XMVECTOR* ptr = pBuffer;
-                for (size_t i = 0; i < count; ++i)
-                {
-                    const XMVECTOR v = *ptr;
-                    *ptr++ = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-                }
+                AddStep(plan, ConvertStep<SNormToUNorm>);
             }
             else if (in->flags & CONVF_FLOAT)
             {
-                XMVECTOR* ptr = pBuffer;
                 if (!(in->flags & CONVF_POS_ONLY) && (flags & TEX_FILTER_FLOAT_X2BIAS))
                 {
                     // FLOAT -> UNORM (x2 bias)
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        XMVECTOR v = *ptr;
-                        v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                        *ptr++ = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-                    }
+                    AddStep(plan, ConvertStep<FloatToUNormX2Bias>);
                 }
                 else
                 {
                     // FLOAT -> UNORM
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVectorSaturate(v);
-                    }
+                    AddStep(plan, ConvertStep<FloatToUNorm>);
                 }
             }
         }
@@ -3491,34 +3576,19 @@ void DirectX::Internal::ConvertScanline(
             if (in->flags & CONVF_UNORM)
             {
                 // UNORM -> SNORM
-                XMVECTOR* ptr = pBuffer;
-                for (size_t i = 0; i < count; ++i)
-                {
-                    const XMVECTOR v = *ptr;
-                    *ptr++ = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                }
+                AddStep(plan, ConvertStep<UNormToSNorm>);
             }
             else if (in->flags & CONVF_FLOAT)
             {
-                XMVECTOR* ptr = pBuffer;
                 if ((in->flags & CONVF_POS_ONLY) && (flags & TEX_FILTER_FLOAT_X2BIAS))
                 {
                     // FLOAT (positive only, x2 bias) -> SNORM
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        XMVECTOR v = *ptr;
-                        v = XMVectorSaturate(v);
-                        *ptr++ = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                    }
+                    AddStep(plan, ConvertStep<FloatX2BiasToSNorm>);
                 }
                 else
                 {
                     // FLOAT -> SNORM
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                    }
+                    AddStep(plan, ConvertStep<FloatToSNorm>);
                 }
             }
         }
@@ -3531,12 +3601,7 @@ void DirectX::Internal::ConvertScanline(
                 if (!(out->flags & CONVF_POS_ONLY) && (flags & TEX_FILTER_FLOAT_X2BIAS))
                 {
                     // UNORM (x2 bias) -> FLOAT
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                    }
+                    AddStep(plan, ConvertStep<UNormToSNorm>);
                 }
             }
         }
@@ -3549,13 +3614,7 @@ void DirectX::Internal::ConvertScanline(
                     if (out->flags & CONVF_FLOAT)
                     {
                         // FLOAT (positive only, x2 bias) -> FLOAT
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            XMVECTOR v = *ptr;
-                            v = XMVectorSaturate(v);
-                            *ptr++ = XMVectorMultiplyAdd(v, g_XMTwo, g_XMNegativeOne);
-                        }
+                        AddStep(plan, ConvertStep<FloatX2BiasToSNorm>);
                     }
                 }
                 else if (out->flags & CONVF_POS_ONLY)
@@ -3563,23 +3622,12 @@ void DirectX::Internal::ConvertScanline(
                     if (in->flags & CONVF_FLOAT)
                     {
                         // FLOAT -> FLOAT (positive only, x2 bias)
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            XMVECTOR v = *ptr;
-                            v = XMVectorClamp(v, g_XMNegativeOne, g_XMOne);
-                            *ptr++ = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-                        }
+                        AddStep(plan, ConvertStep<FloatToUNormX2Bias>);
                     }
                     else if (in->flags & CONVF_SNORM)
                     {
                         // SNORM -> FLOAT (positive only, x2 bias)
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            *ptr++ = XMVectorMultiplyAdd(v, g_XMOneHalf, g_XMOneHalf);
-                        }
+                        AddStep(plan, ConvertStep<SNormToUNorm>);
                     }
                 }
             }
@@ -3596,36 +3644,17 @@ void DirectX::Internal::ConvertScanline(
             switch (flags & (TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN | TEX_FILTER_RGB_COPY_BLUE))
             {
             case TEX_FILTER_RGB_COPY_GREEN:
-                {
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVectorSplatY(v);
-                    }
-                }
+                AddStep(plan, ConvertStep<SplatGreen>);
                 break;
 
             case TEX_FILTER_RGB_COPY_BLUE:
-                {
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVectorSplatZ(v);
-                    }
-                }
+                AddStep(plan, ConvertStep<SplatBlue>);
                 break;
 
             default:
                 if ((in->flags & CONVF_UNORM) && ((in->flags & CONVF_RGB_MASK) == (CONVF_R | CONVF_G | CONVF_B)))
                 {
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVector3Dot(v, g_Grayscale);
-                    }
+                    AddStep(plan, ConvertStep<SplatGrayscale>);
                     break;
                 }
 
@@ -3638,50 +3667,26 @@ void DirectX::Internal::ConvertScanline(
             #endif
 
             case TEX_FILTER_RGB_COPY_RED:
-                {
-                    XMVECTOR* ptr = pBuffer;
-                    for (size_t i = 0; i < count; ++i)
-                    {
-                        const XMVECTOR v = *ptr;
-                        *ptr++ = XMVectorSplatX(v);
-                    }
-                }
+                AddStep(plan, ConvertStep<SplatRed>);
                 break;
             }
         }
         else if (((in->flags & CONVF_RGBA_MASK) == CONVF_A) && !(out->flags & CONVF_A))
         {
             // A format -> !CONVF_A
-            XMVECTOR* ptr = pBuffer;
-            for (size_t i = 0; i < count; ++i)
-            {
-                const XMVECTOR v = *ptr;
-                *ptr++ = XMVectorSplatW(v);
-            }
+            AddStep(plan, ConvertStep<SplatAlpha>);
         }
         else if ((in->flags & CONVF_RGB_MASK) == CONVF_R)
         {
             if ((out->flags & CONVF_RGB_MASK) == (CONVF_R | CONVF_G | CONVF_B))
             {
                 // R format -> RGB format
-                XMVECTOR* ptr = pBuffer;
-                for (size_t i = 0; i < count; ++i)
-                {
-                    const XMVECTOR v = *ptr;
-                    const XMVECTOR v1 = XMVectorSplatX(v);
-                    *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                }
+                AddStep(plan, ConvertStep<ReplicateRedToRGB>);
             }
             else if ((out->flags & CONVF_RGB_MASK) == (CONVF_R | CONVF_G))
             {
                 // R format -> RG format
-                XMVECTOR* ptr = pBuffer;
-                for (size_t i = 0; i < count; ++i)
-                {
-                    const XMVECTOR v = *ptr;
-                    const XMVECTOR v1 = XMVectorSplatX(v);
-                    *ptr++ = XMVectorSelect(v, v1, g_XMSelect1100);
-                }
+                AddStep(plan, ConvertStep<ReplicateRedToRG>);
             }
         }
         else if ((in->flags & CONVF_RGB_MASK) == (CONVF_R | CONVF_G | CONVF_B))
@@ -3692,51 +3697,21 @@ void DirectX::Internal::ConvertScanline(
                 switch (flags & (TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN | TEX_FILTER_RGB_COPY_BLUE | TEX_FILTER_RGB_COPY_ALPHA))
                 {
                 case TEX_FILTER_RGB_COPY_GREEN:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatY(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<GreenToRGB>);
                     break;
 
                 case TEX_FILTER_RGB_COPY_BLUE:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatZ(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<BlueToRGB>);
                     break;
 
                 case TEX_FILTER_RGB_COPY_ALPHA:
-                    {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVectorSplatW(v);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                        }
-                    }
+                    AddStep(plan, ConvertStep<AlphaToRGB>);
                     break;
 
                 default:
                     if (in->flags & CONVF_UNORM)
                     {
-                        XMVECTOR* ptr = pBuffer;
-                        for (size_t i = 0; i < count; ++i)
-                        {
-                            const XMVECTOR v = *ptr;
-                            const XMVECTOR v1 = XMVector3Dot(v, g_Grayscale);
-                            *ptr++ = XMVectorSelect(v, v1, g_XMSelect1110);
-                        }
+                        AddStep(plan, ConvertStep<GrayscaleToRGB>);
                         break;
                     }
 
@@ -3762,39 +3737,15 @@ void DirectX::Internal::ConvertScanline(
                     {
                     case (static_cast<int>(TEX_FILTER_RGB_COPY_RED) | static_cast<int>(TEX_FILTER_RGB_COPY_ALPHA)):
                     default:
-                        {
-                            XMVECTOR* ptr = pBuffer;
-                            for (size_t i = 0; i < count; ++i)
-                            {
-                                const XMVECTOR v = *ptr;
-                                const XMVECTOR v1 = XMVectorSwizzle<0, 3, 0, 3>(v);
-                                *ptr++ = XMVectorSelect(v, v1, g_XMSelect1100);
-                            }
-                        }
+                        AddStep(plan, ConvertStep<SwizzleToRG<0, 3>>);
                         break;
 
                     case (static_cast<int>(TEX_FILTER_RGB_COPY_GREEN) | static_cast<int>(TEX_FILTER_RGB_COPY_ALPHA)):
-                        {
-                            XMVECTOR* ptr = pBuffer;
-                            for (size_t i = 0; i < count; ++i)
-                            {
-                                const XMVECTOR v = *ptr;
-                                const XMVECTOR v1 = XMVectorSwizzle<1, 3, 1, 3>(v);
-                                *ptr++ = XMVectorSelect(v, v1, g_XMSelect1100);
-                            }
-                        }
+                        AddStep(plan, ConvertStep<SwizzleToRG<1, 3>>);
                         break;
 
                     case (static_cast<int>(TEX_FILTER_RGB_COPY_BLUE) | static_cast<int>(TEX_FILTER_RGB_COPY_ALPHA)):
-                        {
-                            XMVECTOR* ptr = pBuffer;
-                            for (size_t i = 0; i < count; ++i)
-                            {
-                                const XMVECTOR v = *ptr;
-                                const XMVECTOR v1 = XMVectorSwizzle<2, 3, 2, 3>(v);
-                                *ptr++ = XMVectorSelect(v, v1, g_XMSelect1100);
-                            }
-                        }
+                        AddStep(plan, ConvertStep<SwizzleToRG<2, 3>>);
                         break;
                     }
                 }
@@ -3804,27 +3755,11 @@ void DirectX::Internal::ConvertScanline(
                     switch (static_cast<int>(flags & (TEX_FILTER_RGB_COPY_RED | TEX_FILTER_RGB_COPY_GREEN | TEX_FILTER_RGB_COPY_BLUE)))
                     {
                     case (static_cast<int>(TEX_FILTER_RGB_COPY_RED) | static_cast<int>(TEX_FILTER_RGB_COPY_BLUE)):
-                        {
-                            XMVECTOR* ptr = pBuffer;
-                            for (size_t i = 0; i < count; ++i)
-                            {
-                                const XMVECTOR v = *ptr;
-                                const XMVECTOR v1 = XMVectorSwizzle<0, 2, 0, 2>(v);
-                                *ptr++ = XMVectorSelect(v, v1, g_XMSelect1100);
-                            }
-                        }
+                        AddStep(plan, ConvertStep<SwizzleToRG<0, 2>>);
                         break;
 
                     case (static_cast<int>(TEX_FILTER_RGB_COPY_GREEN) | static_cast<int>(TEX_FILTER_RGB_COPY_BLUE)):
-                        {
-                            XMVECTOR* ptr = pBuffer;
-                            for (size_t i = 0; i < count; ++i)
-                            {
-                                const XMVECTOR v = *ptr;
-                                const XMVECTOR v1 = XMVectorSwizzle<1, 2, 3, 0>(v);
-                                *ptr++ = XMVectorSelect(v, v1, g_XMSelect1100);
-                            }
-                        }
+                        AddStep(plan, ConvertStep<GreenBlueToRG>);
                         break;
 
                     case (static_cast<int>(TEX_FILTER_RGB_COPY_RED) | static_cast<int>(TEX_FILTER_RGB_COPY_GREEN)):
@@ -3842,15 +3777,55 @@ void DirectX::Internal::ConvertScanline(
     {
         if (!(out->flags & CONVF_DEPTH) && ((out->flags & CONVF_FLOAT) || (out->flags & CONVF_UNORM)))
         {
-            XMVECTOR* ptr = pBuffer;
-            for (size_t i = 0; i < count; ++i, ++ptr)
+            if (!(flags & TEX_FILTER_SRGB_EXACT) && out->datasize <= 8)
             {
-                *ptr = XMColorRGBToSRGB(*ptr);
+                AddStep(plan, ConvertStep<ColorRGBToSRGBFast>);
+            }
+            else
+            {
+                AddStep(plan, ConvertStep<XMColorRGBToSRGB>);
             }
         }
     }
 }
 
+_Use_decl_annotations_
+void DirectX::Internal::ConvertScanline(
+    XMVECTOR* pBuffer,
+    size_t count,
+    const ConvertPlan& plan) noexcept
+{
+    assert(pBuffer && count > 0 && ((reinterpret_cast<uintptr_t>(pBuffer) & 0xF) == 0));
+
+    if (!pBuffer)
+        return;
+
+    for (size_t index = 0; index < plan.stepCount; ++index)
+    {
+        plan.steps[index](pBuffer, count);
+    }
+}
+
+_Use_decl_annotations_
+void DirectX::Internal::ConvertScanline(
+    XMVECTOR* pBuffer,
+    size_t count,
+    DXGI_FORMAT outFormat,
+    DXGI_FORMAT inFormat,
+    TEX_FILTER_FLAGS flags) noexcept
+{
+    assert(pBuffer && count > 0 && ((reinterpret_cast<uintptr_t>(pBuffer) & 0xF) == 0));
+    assert(IsValid(outFormat) && !IsTypeless(outFormat) && !IsPlanar(outFormat) && !IsPalettized(outFormat));
+    assert(IsValid(inFormat) && !IsTypeless(inFormat) && !IsPlanar(inFormat) && !IsPalettized(inFormat));
+
+    if (!pBuffer)
+        return;
+
+    ConvertPlan plan;
+    CreateConvertPlan(plan, outFormat, inFormat, flags);
+    ConvertScanline(pBuffer, count, plan);
+}
+
 
 //-------------------------------------------------------------------------------------
 // Dithering
@@ -4708,92 +4683,476 @@ namespace
         if (IsSRGB(sformat))
             filter |= TEX_FILTER_SRGB_IN;
 
-        if (IsSRGB(tformat))
-            filter |= TEX_FILTER_SRGB_OUT;
+        if (IsSRGB(tformat))
+            filter |= TEX_FILTER_SRGB_OUT;
+
+        if ((filter & (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT)) == (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT))
+        {
+            filter &= ~(TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT);
+        }
+
+        const auto wicsrgb = CheckWICColorSpace(pfGUID, targetGUID);
+
+        if (wicsrgb != (filter & (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT)))
+        {
+            // WIC will perform a colorspace conversion we didn't request
+            return false;
+        }
+
+        return true;
+    #endif // WIN32
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Convert the source image using WIC
+    //-------------------------------------------------------------------------------------
+    HRESULT ConvertUsingWIC(
+        _In_ const Image& srcImage,
+        _In_ const WICPixelFormatGUID& pfGUID,
+        _In_ const WICPixelFormatGUID& targetGUID,
+        _In_ TEX_FILTER_FLAGS filter,
+        _In_ float threshold,
+        _In_ const Image& destImage)
+    {
+    #ifndef _WIN32
+        UNREFERENCED_PARAMETER(srcImage);
+        UNREFERENCED_PARAMETER(pfGUID);
+        UNREFERENCED_PARAMETER(targetGUID);
+        UNREFERENCED_PARAMETER(filter);
+        UNREFERENCED_PARAMETER(threshold);
+        UNREFERENCED_PARAMETER(destImage);
+        return E_NOTIMPL;
+    #else
+        assert(srcImage.width == destImage.width);
+        assert(srcImage.height == destImage.height);
+
+        bool iswic2 = false;
+        auto pWIC = GetWICFactory(iswic2);
+        if (!pWIC)
+            return E_NOINTERFACE;
+
+        ComPtr<IWICFormatConverter> FC;
+        HRESULT hr = pWIC->CreateFormatConverter(FC.GetAddressOf());
+        if (FAILED(hr))
+            return hr;
+
+        // Note that WIC conversion ignores the TEX_FILTER_SRGB_IN and TEX_FILTER_SRGB_OUT flags,
+        // but also always assumes UNORM <-> FLOAT conversions are changing color spaces sRGB <-> scRGB
+
+        BOOL canConvert = FALSE;
+        hr = FC->CanConvert(pfGUID, targetGUID, &canConvert);
+        if (FAILED(hr) || !canConvert)
+        {
+            // This case is not an issue for the subset of WIC formats that map directly to DXGI
+            return E_UNEXPECTED;
+        }
+
+        if (srcImage.rowPitch > UINT32_MAX || srcImage.slicePitch > UINT32_MAX
+            || destImage.rowPitch > UINT32_MAX || destImage.slicePitch > UINT32_MAX)
+            return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+        ComPtr<IWICBitmap> source;
+        hr = pWIC->CreateBitmapFromMemory(static_cast<UINT>(srcImage.width), static_cast<UINT>(srcImage.height), pfGUID,
+            static_cast<UINT>(srcImage.rowPitch), static_cast<UINT>(srcImage.slicePitch),
+            srcImage.pixels, source.GetAddressOf());
+        if (FAILED(hr))
+            return hr;
+
+        hr = FC->Initialize(source.Get(), targetGUID, GetWICDither(filter), nullptr,
+            static_cast<double>(threshold) * 100.0, WICBitmapPaletteTypeMedianCut);
+        if (FAILED(hr))
+            return hr;
+
+        hr = FC->CopyPixels(nullptr, static_cast<UINT>(destImage.rowPitch), static_cast<UINT>(destImage.slicePitch), destImage.pixels);
+        if (FAILED(hr))
+            return hr;
+
+        return S_OK;
+    #endif // WIN32
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Direct format-to-format conversion kernels
+    //
+    // For sources with one byte per channel every destination channel depends on a single
+    // source byte, so each format pair reduces to a 256-entry table per channel. The tables
+    // are filled by running the generic Load/Convert/StoreScanline path over every byte
+    // value, which keeps results bit-identical to the XMVECTOR scanline for any filter flags.
+    //-------------------------------------------------------------------------------------
+    struct DirectFormat
+    {
+        DXGI_FORMAT format;
+        uint8_t     channelBytes;
+        uint8_t     channels;
+        uint8_t     component[4];   // 0-3 for R, G, B, A in storage order; 4 for unused bits
+    };
+
+    const DirectFormat g_DirectFormats[] =
+    {
+        { DXGI_FORMAT_R32G32B32A32_FLOAT,   4, 4, { 0, 1, 2, 3 } },
+        { DXGI_FORMAT_R16G16B16A16_FLOAT,   2, 4, { 0, 1, 2, 3 } },
+        { DXGI_FORMAT_R16G16B16A16_UNORM,   2, 4, { 0, 1, 2, 3 } },
+        { DXGI_FORMAT_R32G32_FLOAT,         4, 2, { 0, 1, 4, 4 } },
+        { DXGI_FORMAT_R8G8B8A8_UNORM,       1, 4, { 0, 1, 2, 3 } },
+        { DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,  1, 4, { 0, 1, 2, 3 } },
+        { DXGI_FORMAT_R16G16_FLOAT,         2, 2, { 0, 1, 4, 4 } },
+        { DXGI_FORMAT_R16G16_UNORM,         2, 2, { 0, 1, 4, 4 } },
+        { DXGI_FORMAT_R32_FLOAT,            4, 1, { 0, 4, 4, 4 } },
+        { DXGI_FORMAT_R8G8_UNORM,           1, 2, { 0, 1, 4, 4 } },
+        { DXGI_FORMAT_R16_FLOAT,            2, 1, { 0, 4, 4, 4 } },
+        { DXGI_FORMAT_R16_UNORM,            2, 1, { 0, 4, 4, 4 } },
+        { DXGI_FORMAT_R8_UNORM,             1, 1, { 0, 4, 4, 4 } },
+        { DXGI_FORMAT_B8G8R8A8_UNORM,       1, 4, { 2, 1, 0, 3 } },
+        { DXGI_FORMAT_B8G8R8X8_UNORM,       1, 4, { 2, 1, 0, 4 } },
+        { DXGI_FORMAT_B8G8R8A8_UNORM_SRGB,  1, 4, { 2, 1, 0, 3 } },
+        { DXGI_FORMAT_B8G8R8X8_UNORM_SRGB,  1, 4, { 2, 1, 0, 4 } },
+    };
+
+    const DirectFormat* FindDirectFormat(DXGI_FORMAT format) noexcept
+    {
+        for (const auto& entry : g_DirectFormats)
+        {
+            if (entry.format == format)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    inline uint32_t DirectRGBMask(const DirectFormat& fmt) noexcept
+    {
+        uint32_t mask = 0;
+        for (size_t c = 0; c < fmt.channels; ++c)
+        {
+            if (fmt.component[c] < 3)
+                mask |= 1u << fmt.component[c];
+        }
+        return mask;
+    }
+
+    struct DirectConvert
+    {
+        void (*pfnRow)(_Out_ uint8_t* pDest, _In_ const uint8_t* pSrc, size_t count, const DirectConvert& dc);
+        size_t      srcBytes;           // bytes per source pixel
+        size_t      channels;           // destination channels
+        size_t      srcByte[4];         // source byte feeding each destination channel
+        uint32_t    shuffleConst;       // 8-bit shuffle: constant bits of the destination pixel
+        uint32_t    lut[4][256];        // destination channel value for each source byte
+    };
+
+    // 4 bytes -> 4 bytes where every channel is either a plain byte move or a constant
+    void DirectShuffle8(_Out_ uint8_t* pDest, _In_ const uint8_t* pSrc, size_t count, const DirectConvert& dc)
+    {
+        uint32_t shift[4] = {};
+        uint32_t mask[4] = {};
+        for (size_t c = 0; c < 4; ++c)
+        {
+            if (dc.srcByte[c] < 4)
+            {
+                shift[c] = uint32_t(dc.srcByte[c] * 8);
+                mask[c] = 0xFFu << (c * 8);
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t v;
+            memcpy(&v, pSrc + i * 4, sizeof(v));
+
+            const uint32_t r = (((v >> shift[0]) & 0xFF) | (((v >> shift[1]) & 0xFF) << 8)
+                | (((v >> shift[2]) & 0xFF) << 16) | (((v >> shift[3]) & 0xFF) << 24));
+            const uint32_t t = (r & (mask[0] | mask[1] | mask[2] | mask[3])) | dc.shuffleConst;
+            memcpy(pDest + i * 4, &t, sizeof(t));
+        }
+    }
+
+    template<typename T>
+    void DirectLookup(_Out_ uint8_t* pDest, _In_ const uint8_t* pSrc, size_t count, const DirectConvert& dc)
+    {
+        T* dPtr = reinterpret_cast<T*>(pDest);
+        const size_t channels = dc.channels;
+        for (size_t i = 0; i < count; ++i, pSrc += dc.srcBytes)
+        {
+            for (size_t c = 0; c < channels; ++c)
+            {
+                *(dPtr++) = static_cast<T>(dc.lut[c][pSrc[dc.srcByte[c]]]);
+            }
+        }
+    }
+
+    void DirectHalfToFloat(_Out_ uint8_t* pDest, _In_ const uint8_t* pSrc, size_t count, const DirectConvert& dc)
+    {
+        XMConvertHalfToFloatStream(reinterpret_cast<float*>(pDest), sizeof(float),
+            reinterpret_cast<const HALF*>(pSrc), sizeof(HALF), count * dc.channels);
+    }
+
+    // Selects a direct kernel for the format pair, or returns false to use the generic scanline path
+    bool SetupDirectConvert(
+        _In_ DXGI_FORMAT srcFormat,
+        _In_ DXGI_FORMAT destFormat,
+        _In_ TEX_FILTER_FLAGS filter,
+        _In_ float threshold,
+        _Out_ DirectConvert& dc) noexcept
+    {
+        if (filter & (TEX_FILTER_DITHER | TEX_FILTER_DITHER_DIFFUSION))
+            return false;
+
+        const DirectFormat* sfmt = FindDirectFormat(srcFormat);
+        const DirectFormat* dfmt = FindDirectFormat(destFormat);
+        if (!sfmt || !dfmt || srcFormat == destFormat)
+            return false;
+
+        if (DirectRGBMask(*sfmt) != DirectRGBMask(*dfmt))
+            return false;
+
+        dc.srcBytes = size_t(sfmt->channelBytes) * sfmt->channels;
+        dc.channels = dfmt->channels;
+        dc.shuffleConst = 0;
+
+        if (sfmt->channelBytes == 2 && dfmt->channelBytes == 4)
+        {
+            // FP16 -> FP32 of the same layout only changes values when an sRGB conversion is requested
+            if (srcFormat != DXGI_FORMAT_R16G16B16A16_FLOAT
+                && srcFormat != DXGI_FORMAT_R16G16_FLOAT
+                && srcFormat != DXGI_FORMAT_R16_FLOAT)
+                return false;
+
+            if (sfmt->channels != dfmt->channels || dfmt->channelBytes != 4)
+                return false;
+
+            const auto srgb = filter & (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT);
+            if (srgb == TEX_FILTER_SRGB_IN || srgb == TEX_FILTER_SRGB_OUT)
+                return false;
+
+            dc.pfnRow = DirectHalfToFloat;
+            return true;
+        }
+
+        if (sfmt->channelBytes != 1)
+            return false;
+
+        for (size_t c = 0; c < dc.channels; ++c)
+        {
+            // Channels missing from the source (alpha, X bits) come out constant, so any byte will do
+            dc.srcByte[c] = 0;
+            for (size_t j = 0; j < sfmt->channels; ++j)
+            {
+                if (sfmt->component[j] == dfmt->component[c] && sfmt->component[j] < 4)
+                {
+                    dc.srcByte[c] = j;
+                    break;
+                }
+            }
+        }
+
+        // Seed the tables from the generic path with every source byte set to each value in turn
+        const size_t destBytes = size_t(dfmt->channelBytes) * dfmt->channels;
+
+        auto scanline = make_AlignedArrayXMVECTOR(256);
+        std::unique_ptr<uint8_t[]> srcRow(new (std::nothrow) uint8_t[256 * 4]);
+        std::unique_ptr<uint8_t[]> destRow(new (std::nothrow) uint8_t[256 * 16]);
+        if (!scanline || !srcRow || !destRow)
+            return false;
+
+        for (size_t i = 0; i < 256; ++i)
+        {
+            memset(srcRow.get() + i * dc.srcBytes, int(i), dc.srcBytes);
+        }
+
+        if (!LoadScanline(scanline.get(), 256, srcRow.get(), 256 * dc.srcBytes, srcFormat))
+            return false;
+
+        ConvertScanline(scanline.get(), 256, destFormat, srcFormat, filter);
+
+        if (!StoreScanline(destRow.get(), 256 * destBytes, destFormat, scanline.get(), 256, threshold))
+            return false;
+
+        for (size_t c = 0; c < dc.channels; ++c)
+        {
+            const uint8_t* ptr = destRow.get() + c * dfmt->channelBytes;
+            for (size_t i = 0; i < 256; ++i, ptr += destBytes)
+            {
+                switch (dfmt->channelBytes)
+                {
+                case 1: dc.lut[c][i] = *ptr; break;
+                case 2: { uint16_t v; memcpy(&v, ptr, sizeof(v)); dc.lut[c][i] = v; } break;
+                default: memcpy(&dc.lut[c][i], ptr, sizeof(uint32_t)); break;
+                }
+            }
+        }
+
+        switch (dfmt->channelBytes)
+        {
+        case 1:
+            dc.pfnRow = DirectLookup<uint8_t>;
+            if (dc.srcBytes == 4 && dc.channels == 4)
+            {
+                // Plain swizzles (no colorspace change) skip the tables altogether
+                bool shuffle = true;
+                for (size_t c = 0; c < 4 && shuffle; ++c)
+                {
+                    bool identity = true;
+                    bool constant = true;
+                    for (size_t i = 0; i < 256; ++i)
+                    {
+                        identity = identity && (dc.lut[c][i] == i);
+                        constant = constant && (dc.lut[c][i] == dc.lut[c][0]);
+                    }
+
+                    if (constant)
+                    {
+                        dc.srcByte[c] = 4;
+                        dc.shuffleConst |= dc.lut[c][0] << (c * 8);
+                    }
+                    else if (!identity)
+                    {
+                        shuffle = false;
+                    }
+                }
+
+                if (shuffle)
+                    dc.pfnRow = DirectShuffle8;
+            }
+            break;
+
+        case 2:
+            dc.pfnRow = DirectLookup<uint16_t>;
+            break;
+
+        default:
+            dc.pfnRow = DirectLookup<uint32_t>;
+            break;
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Cache of direct kernels so repeated conversions between the same formats don't rebuild the tables
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DIRECT_CACHE_SIZE = 16;
+
+    struct DirectConvertCacheEntry
+    {
+        DXGI_FORMAT                     srcFormat;
+        DXGI_FORMAT                     destFormat;
+        TEX_FILTER_FLAGS                filter;
+        float                           threshold;
+        std::unique_ptr<DirectConvert>  dc;
+    };
+
+    // Returns the kernel for the format pair, or nullptr to use the generic scanline path. Cached kernels are never
+    // modified or evicted once published; if the cache is full the kernel is built into 'local' instead.
+    const DirectConvert* GetDirectConvert(
+        _In_ DXGI_FORMAT srcFormat,
+        _In_ DXGI_FORMAT destFormat,
+        _In_ TEX_FILTER_FLAGS filter,
+        _In_ float threshold,
+        _Inout_ std::unique_ptr<DirectConvert>& local) noexcept
+    {
+        static std::mutex s_cacheLock;
+        static DirectConvertCacheEntry s_cache[DIRECT_CACHE_SIZE];
+        static size_t s_cacheCount = 0;
+
+        auto find = [&]() -> const DirectConvert*
+        {
+            for (size_t j = 0; j < s_cacheCount; ++j)
+            {
+                const auto& entry = s_cache[j];
+                if (entry.srcFormat == srcFormat && entry.destFormat == destFormat
+                    && entry.filter == filter && entry.threshold == threshold)
+                    return entry.dc.get();
+            }
+            return nullptr;
+        };
 
-        if ((filter & (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT)) == (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT))
         {
-            filter &= ~(TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT);
+            std::lock_guard<std::mutex> lock(s_cacheLock);
+            const DirectConvert* dc = find();
+            if (dc)
+                return dc;
         }
 
-        const auto wicsrgb = CheckWICColorSpace(pfGUID, targetGUID);
+        // Built outside the lock since seeding the tables runs the generic conversion
+        std::unique_ptr<DirectConvert> dc(new (std::nothrow) DirectConvert);
+        if (!dc || !SetupDirectConvert(srcFormat, destFormat, filter, threshold, *dc))
+            return nullptr;
 
-        if (wicsrgb != (filter & (TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT)))
         {
-            // WIC will perform a colorspace conversion we didn't request
-            return false;
+            std::lock_guard<std::mutex> lock(s_cacheLock);
+            const DirectConvert* existing = find();
+            if (existing)
+                return existing;
+
+            if (s_cacheCount < DIRECT_CACHE_SIZE)
+            {
+                auto& entry = s_cache[s_cacheCount++];
+                entry.srcFormat = srcFormat;
+                entry.destFormat = destFormat;
+                entry.filter = filter;
+                entry.threshold = threshold;
+                entry.dc = std::move(dc);
+                return entry.dc.get();
+            }
         }
 
-        return true;
-    #endif // WIN32
+        local = std::move(dc);
+        return local.get();
     }
 
     //-------------------------------------------------------------------------------------
-    // Convert the source image using WIC
+    // Converts rows [y0, y1) of the source image (not using WIC or error diffusion)
     //-------------------------------------------------------------------------------------
-    HRESULT ConvertUsingWIC(
+    bool ConvertRows(
         _In_ const Image& srcImage,
-        _In_ const WICPixelFormatGUID& pfGUID,
-        _In_ const WICPixelFormatGUID& targetGUID,
         _In_ TEX_FILTER_FLAGS filter,
+        _In_ const Image& destImage,
         _In_ float threshold,
-        _In_ const Image& destImage)
+        size_t z,
+        size_t y0,
+        size_t y1,
+        _In_opt_ const DirectConvert* direct,
+        _In_ const ConvertPlan& plan,
+        _Inout_updates_all_opt_(srcImage.width) XMVECTOR* scanline) noexcept
     {
-    #ifndef _WIN32
-        UNREFERENCED_PARAMETER(srcImage);
-        UNREFERENCED_PARAMETER(pfGUID);
-        UNREFERENCED_PARAMETER(targetGUID);
-        UNREFERENCED_PARAMETER(filter);
-        UNREFERENCED_PARAMETER(threshold);
-        UNREFERENCED_PARAMETER(destImage);
-        return E_NOTIMPL;
-    #else
-        assert(srcImage.width == destImage.width);
-        assert(srcImage.height == destImage.height);
-
-        bool iswic2 = false;
-        auto pWIC = GetWICFactory(iswic2);
-        if (!pWIC)
-            return E_NOINTERFACE;
-
-        ComPtr<IWICFormatConverter> FC;
-        HRESULT hr = pWIC->CreateFormatConverter(FC.GetAddressOf());
-        if (FAILED(hr))
-            return hr;
+        assert(direct || scanline);
 
-        // Note that WIC conversion ignores the TEX_FILTER_SRGB_IN and TEX_FILTER_SRGB_OUT flags,
-        // but also always assumes UNORM <-> FLOAT conversions are changing color spaces sRGB <-> scRGB
+        const uint8_t *pSrc = srcImage.pixels + y0 * srcImage.rowPitch;
+        uint8_t *pDest = destImage.pixels + y0 * destImage.rowPitch;
+        const size_t width = srcImage.width;
 
-        BOOL canConvert = FALSE;
-        hr = FC->CanConvert(pfGUID, targetGUID, &canConvert);
-        if (FAILED(hr) || !canConvert)
+        for (size_t h = y0; h < y1; ++h)
         {
-            // This case is not an issue for the subset of WIC formats that map directly to DXGI
-            return E_UNEXPECTED;
-        }
-
-        if (srcImage.rowPitch > UINT32_MAX || srcImage.slicePitch > UINT32_MAX
-            || destImage.rowPitch > UINT32_MAX || destImage.slicePitch > UINT32_MAX)
-            return HRESULT_E_ARITHMETIC_OVERFLOW;
+            if (direct)
+            {
+                // Specialized kernel for this format pair
+                direct->pfnRow(pDest, pSrc, width, *direct);
+            }
+            else
+            {
+                if (!LoadScanline(scanline, width, pSrc, srcImage.rowPitch, srcImage.format))
+                    return false;
 
-        ComPtr<IWICBitmap> source;
-        hr = pWIC->CreateBitmapFromMemory(static_cast<UINT>(srcImage.width), static_cast<UINT>(srcImage.height), pfGUID,
-            static_cast<UINT>(srcImage.rowPitch), static_cast<UINT>(srcImage.slicePitch),
-            srcImage.pixels, source.GetAddressOf());
-        if (FAILED(hr))
-            return hr;
+                ConvertScanline(scanline, width, plan);
 
-        hr = FC->Initialize(source.Get(), targetGUID, GetWICDither(filter), nullptr,
-            static_cast<double>(threshold) * 100.0, WICBitmapPaletteTypeMedianCut);
-        if (FAILED(hr))
-            return hr;
+                if (filter & TEX_FILTER_DITHER)
+                {
+                    // Ordered dithering
+                    if (!StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, scanline, width, threshold, h, z, nullptr))
+                        return false;
+                }
+                else
+                {
+                    // No dithering
+                    if (!StoreScanline(pDest, destImage.rowPitch, destImage.format, scanline, width, threshold))
+                        return false;
+                }
+            }
 
-        hr = FC->CopyPixels(nullptr, static_cast<UINT>(destImage.rowPitch), static_cast<UINT>(destImage.slicePitch), destImage.pixels);
-        if (FAILED(hr))
-            return hr;
+            pSrc += srcImage.rowPitch;
+            pDest += destImage.rowPitch;
+        }
 
-        return S_OK;
-    #endif // WIN32
+        return true;
     }
 
     //-------------------------------------------------------------------------------------
@@ -4817,7 +5176,13 @@ namespace
 
         size_t width = srcImage.width;
 
-        if (filter & TEX_FILTER_DITHER_DIFFUSION)
+        std::unique_ptr<DirectConvert> localDirect;
+        const DirectConvert* direct = GetDirectConvert(srcImage.format, destImage.format, filter, threshold, localDirect);
+
+        ConvertPlan plan;
+        CreateConvertPlan(plan, destImage.format, srcImage.format, filter);
+
+        if (!direct && (filter & TEX_FILTER_DITHER_DIFFUSION))
         {
             // Error diffusion dithering (aka Floyd-Steinberg dithering)
             auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 2 + 2);
@@ -4840,7 +5205,7 @@ namespace
                 if (!LoadScanline(scanline.get(), width, pSrc, srcImage.rowPitch, srcImage.format))
                     return E_FAIL;
 
-                ConvertScanline(scanline.get(), width, destImage.format, srcImage.format, filter);
+                ConvertScanline(scanline.get(), width, plan);
 
                 if (!StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, scanline.get(), width, threshold, h, z, pDiffusionErrors))
                     return E_FAIL;
@@ -4851,65 +5216,315 @@ namespace
         }
         else
         {
-            auto scanline = make_AlignedArrayXMVECTOR(width);
-            if (!scanline)
-                return E_OUTOFMEMORY;
+            ScopedAlignedArrayXMVECTOR scanline;
+            if (!direct)
+            {
+                scanline = make_AlignedArrayXMVECTOR(width);
+                if (!scanline)
+                    return E_OUTOFMEMORY;
+            }
 
-            if (filter & TEX_FILTER_DITHER)
+            for (size_t h = 0; h < srcImage.height; ++h)
             {
-                // Ordered dithering
-                for (size_t h = 0; h < srcImage.height; ++h)
+                if (statusCallback)
                 {
-                    if (statusCallback)
+                    if (!statusCallback(h, srcImage.height))
                     {
-                        if (!statusCallback(h, srcImage.height))
-                        {
-                            return E_ABORT;
-                        }
+                        return E_ABORT;
                     }
+                }
 
-                    if (!LoadScanline(scanline.get(), width, pSrc, srcImage.rowPitch, srcImage.format))
-                        return E_FAIL;
+                if (!ConvertRows(srcImage, filter, destImage, threshold, z, h, h + 1, direct, plan, scanline.get()))
+                    return E_FAIL;
+            }
+        }
 
-                    ConvertScanline(scanline.get(), width, destImage.format, srcImage.format, filter);
+        return S_OK;
+    }
 
-                    if (!StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, scanline.get(), width, threshold, h, z, nullptr))
-                        return E_FAIL;
+    //-------------------------------------------------------------------------------------
+    // Convert a set of images (not using WIC) as one pool of row bands
+    //-------------------------------------------------------------------------------------
+    constexpr size_t CONVERT_MIN_BAND_PIXELS = 16384;
+    constexpr size_t CONVERT_MIN_BANDS = 64;
 
-                    pSrc += srcImage.rowPitch;
-                    pDest += destImage.rowPitch;
-                }
-            }
-            else
+    inline size_t RowsPerBand(size_t width, size_t height) noexcept
+    {
+        const size_t rows = (CONVERT_MIN_BAND_PIXELS + width - 1) / width;
+        return std::max<size_t>(1, std::min<size_t>(rows, height / CONVERT_MIN_BANDS));
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Error diffusion of one image with row loading done in parallel
+    //
+    // The serpentine scan makes every pixel depend on the one before it (each row starts
+    // where the previous one ended), so the diffusion itself must stay serial to match
+    // ConvertCustom. The rows are loaded and converted in parallel one chunk ahead of it.
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DIFFUSION_CHUNK_PIXELS = 262144;
+
+    HRESULT ConvertDiffusion_Parallel(
+        _In_ const Image& srcImage,
+        _In_ const Image& destImage,
+        _In_ float threshold,
+        size_t z,
+        _In_ const ConvertPlan& plan,
+        _In_ ITaskExecutor* executor,
+        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+    {
+        assert(srcImage.width == destImage.width && srcImage.height == destImage.height);
+        assert(executor != nullptr);
+
+        if (!srcImage.pixels || !destImage.pixels)
+            return E_POINTER;
+
+        const size_t width = srcImage.width;
+        const size_t height = srcImage.height;
+        if (!width || !height)
+            return S_OK;
+
+        const size_t chunkRows = std::max<size_t>(1, std::min<size_t>(height, DIFFUSION_CHUNK_PIXELS / width));
+        const size_t bandRows = std::min<size_t>(chunkRows, (CONVERT_MIN_BAND_PIXELS + width - 1) / width);
+        const size_t nChunks = (height + chunkRows - 1) / chunkRows;
+
+        // Two chunks of scanlines (one being loaded, one being diffused) followed by the error row
+        auto scanlines = make_AlignedArrayXMVECTOR(uint64_t(width) * chunkRows * 2 + width + 2);
+        if (!scanlines)
+            return E_OUTOFMEMORY;
+
+        XMVECTOR* chunks[2] = { scanlines.get(), scanlines.get() + width * chunkRows };
+
+        XMVECTOR* pDiffusionErrors = scanlines.get() + width * chunkRows * 2;
+        memset(pDiffusionErrors, 0, sizeof(XMVECTOR) * (width + 2));
+
+        std::atomic<bool> fail(false);
+
+        // Step k diffuses chunk k - 1 while chunk k is being loaded
+        for (size_t k = 0; k <= nChunks; ++k)
+        {
+            const size_t loadY0 = k * chunkRows;
+            const size_t loadY1 = (k < nChunks) ? std::min<size_t>(height, loadY0 + chunkRows) : loadY0;
+            const size_t nBands = (loadY1 - loadY0 + bandRows - 1) / bandRows;
+
+            HRESULT hr = ParallelFor(executor, nBands + 1, [&](size_t index) -> bool
             {
-                // No dithering
-                for (size_t h = 0; h < srcImage.height; ++h)
+                if (!index)
                 {
-                    if (statusCallback)
+                    if (!k)
+                        return true;
+
+                    XMVECTOR* pChunk = chunks[(k - 1) & 1];
+                    const size_t y0 = (k - 1) * chunkRows;
+                    const size_t y1 = std::min<size_t>(height, y0 + chunkRows);
+
+                    uint8_t* pDest = destImage.pixels + destImage.rowPitch * y0;
+                    for (size_t h = y0; h < y1; ++h)
                     {
-                        if (!statusCallback(h, srcImage.height))
+                        if (!StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, pChunk, width, threshold, h, z, pDiffusionErrors))
                         {
-                            return E_ABORT;
+                            fail.store(true, std::memory_order_relaxed);
+                            return false;
                         }
+
+                        pChunk += width;
+                        pDest += destImage.rowPitch;
                     }
+                    return true;
+                }
 
-                    if (!LoadScanline(scanline.get(), width, pSrc, srcImage.rowPitch, srcImage.format))
-                        return E_FAIL;
+                const size_t y0 = loadY0 + (index - 1) * bandRows;
+                const size_t y1 = std::min<size_t>(loadY1, y0 + bandRows);
 
-                    ConvertScanline(scanline.get(), width, destImage.format, srcImage.format, filter);
+                XMVECTOR* pChunk = chunks[k & 1] + width * (y0 - loadY0);
+                const uint8_t* pSrc = srcImage.pixels + srcImage.rowPitch * y0;
+                for (size_t h = y0; h < y1; ++h)
+                {
+                    if (!LoadScanline(pChunk, width, pSrc, srcImage.rowPitch, srcImage.format))
+                    {
+                        fail.store(true, std::memory_order_relaxed);
+                        return false;
+                    }
 
-                    if (!StoreScanline(pDest, destImage.rowPitch, destImage.format, scanline.get(), width, threshold))
-                        return E_FAIL;
+                    ConvertScanline(pChunk, width, plan);
 
+                    pChunk += width;
                     pSrc += srcImage.rowPitch;
-                    pDest += destImage.rowPitch;
                 }
+                return true;
+            });
+            if (FAILED(hr))
+                return hr;
+
+            if (fail)
+                return E_FAIL;
+
+            // Chunk k - 1 has now been diffused and stored
+            if (statusCallback && k > 0)
+            {
+                if (!statusCallback(std::min<size_t>(height, k * chunkRows), height))
+                    return E_ABORT;
             }
         }
 
         return S_OK;
     }
 
+    HRESULT ConvertCustom_Parallel(
+        _In_reads_(nimages) const Image* srcImages,
+        _In_reads_(nimages) const Image* destImages,
+        _In_reads_(nimages) const size_t* slices,
+        size_t nimages,
+        _In_ TEX_FILTER_FLAGS filter,
+        _In_ float threshold,
+        _In_opt_ ITaskExecutor* executor,
+        const std::function<bool __cdecl(size_t, size_t)>& statusCallback) noexcept
+    {
+        assert(srcImages && destImages && slices && nimages > 0);
+
+        std::unique_ptr<size_t[]> firstBand(new (std::nothrow) size_t[nimages + 1]);
+        std::unique_ptr<size_t[]> bandRows(new (std::nothrow) size_t[nimages]);
+        std::unique_ptr<std::atomic<size_t>[]> bandsLeft(new (std::nothrow) std::atomic<size_t>[nimages]);
+        if (!firstBand || !bandRows || !bandsLeft)
+            return E_OUTOFMEMORY;
+
+        // All images share the same format pair
+        std::unique_ptr<DirectConvert> localDirect;
+        const DirectConvert* direct = GetDirectConvert(srcImages[0].format, destImages[0].format, filter, threshold, localDirect);
+
+        ConvertPlan plan;
+        CreateConvertPlan(plan, destImages[0].format, srcImages[0].format, filter);
+
+        if (!executor)
+            executor = GetDefaultTaskExecutor();
+
+        // Error diffusion carries state from row to row, so each such image is one band
+        const bool diffusion = !direct && (filter & TEX_FILTER_DITHER_DIFFUSION);
+
+        if (diffusion && nimages == 1)
+        {
+            // With nothing else to run alongside it, overlap the image's own row loads instead
+            return ConvertDiffusion_Parallel(srcImages[0], destImages[0], threshold, slices[0], plan, executor, statusCallback);
+        }
+
+        size_t nBands = 0;
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            const Image& src = srcImages[index];
+            const Image& dst = destImages[index];
+
+            assert(src.width == dst.width && src.height == dst.height);
+            if (!src.pixels || !dst.pixels)
+                return E_POINTER;
+
+            const size_t height = std::max<size_t>(1, src.height);
+            const size_t rows = (diffusion) ? height : RowsPerBand(std::max<size_t>(1, src.width), height);
+            const size_t count = (height + rows - 1) / rows;
+
+            firstBand[index] = nBands;
+            bandRows[index] = rows;
+            bandsLeft[index] = count;
+            nBands += count;
+        }
+        firstBand[nimages] = nBands;
+
+        // A single image reports progress by rows, otherwise by completed images
+        const bool reportRows = (nimages == 1);
+
+        std::atomic<bool> fail(false);
+        std::atomic<bool> outOfMemory(false);
+
+        size_t progress = 0;
+        std::atomic<bool> abort(false);
+        std::mutex statusLock;
+
+        HRESULT hr = ParallelFor(executor, nBands, [&](size_t band) -> bool
+        {
+            if (abort.load(std::memory_order_relaxed))
+            {
+                // Executors are allowed to keep going after a cancellation, so short circuit here too.
+                return false;
+            }
+
+            const size_t index = size_t(std::upper_bound(firstBand.get(), firstBand.get() + nimages + 1, band) - firstBand.get()) - 1;
+            assert(index < nimages);
+
+            const Image& src = srcImages[index];
+            const size_t y0 = (band - firstBand[index]) * bandRows[index];
+            const size_t y1 = std::min<size_t>(src.height, y0 + bandRows[index]);
+
+            if (diffusion)
+            {
+                const HRESULT hr = ConvertCustom(src, filter, destImages[index], threshold, slices[index], nullptr);
+                if (hr == E_OUTOFMEMORY)
+                    outOfMemory.store(true, std::memory_order_relaxed);
+                else if (FAILED(hr))
+                    fail.store(true, std::memory_order_relaxed);
+            }
+            else
+            {
+                ScopedAlignedArrayXMVECTOR scanline;
+                if (!direct)
+                {
+                    scanline = make_AlignedArrayXMVECTOR(src.width);
+                    if (!scanline)
+                    {
+                        outOfMemory.store(true, std::memory_order_relaxed);
+                        return false;
+                    }
+                }
+
+                if (!ConvertRows(src, filter, destImages[index], threshold, slices[index], y0, y1, direct, plan, scanline.get()))
+                    fail.store(true, std::memory_order_relaxed);
+            }
+
+            if (statusCallback)
+            {
+                size_t done = 0;
+                size_t total = 0;
+                if (reportRows)
+                {
+                    done = y1 - y0;
+                    total = src.height;
+                }
+                else if (bandsLeft[index].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    done = 1;
+                    total = nimages;
+                }
+
+                if (total > 0)
+                {
+                    // Callers don't expect the callback to be reentrant, and counting under the lock keeps
+                    // the reported progress from going backwards
+                    std::lock_guard<std::mutex> lock(statusLock);
+                    progress += done;
+                    if (!statusCallback(progress, total))
+                    {
+                        abort.store(true, std::memory_order_relaxed);
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        });
+        if (FAILED(hr))
+            return hr;
+
+        if (abort)
+        {
+            return E_ABORT;
+        }
+        else if (outOfMemory)
+        {
+            return E_OUTOFMEMORY;
+        }
+        else
+        {
+            return (fail) ? E_FAIL : S_OK;
+        }
+    }
+
     //-------------------------------------------------------------------------------------
     DXGI_FORMAT PlanarToSingle(_In_ DXGI_FORMAT format) noexcept
     {
@@ -5123,7 +5738,7 @@ HRESULT DirectX::ConvertEx(
     if ((srcImage.width > UINT32_MAX) || (srcImage.height > UINT32_MAX))
         return E_INVALIDARG;
 
-    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1);
+    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -5148,6 +5763,11 @@ HRESULT DirectX::ConvertEx(
     {
         hr = ConvertUsingWIC(srcImage, pfGUID, targetGUID, options.filter, options.threshold, *rimage);
     }
+    else if (options.filter & TEX_FILTER_PARALLEL)
+    {
+        const size_t slice = 0;
+        hr = ConvertCustom_Parallel(&srcImage, rimage, &slice, 1, options.filter, options.threshold, options.executor, statusCallback);
+    }
     else
     {
         hr = ConvertCustom(srcImage, options.filter, *rimage, options.threshold, 0, statusCallback);
@@ -5229,7 +5849,7 @@ HRESULT DirectX::ConvertEx(
 
     TexMetadata mdata2 = metadata;
     mdata2.format = format;
-    HRESULT hr = result.Initialize(mdata2);
+    HRESULT hr = result.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -5258,6 +5878,21 @@ HRESULT DirectX::ConvertEx(
     WICPixelFormatGUID pfGUID, targetGUID;
     const bool usewic = !metadata.IsPMAlpha() && UseWICConversion(options.filter, metadata.format, format, pfGUID, targetGUID);
 
+    // With TEX_FILTER_PARALLEL the loops below only validate, then all images are converted as one pool
+    std::unique_ptr<size_t[]> slices;
+    if (!usewic && (options.filter & TEX_FILTER_PARALLEL))
+    {
+        slices.reset(new (std::nothrow) size_t[nimages]());
+        if (!slices)
+        {
+            result.Release();
+            return E_OUTOFMEMORY;
+        }
+    }
+
+    // A volume's mip chain may cover fewer than nimages images
+    size_t nconvert = nimages;
+
     switch (metadata.dimension)
     {
     case TEX_DIMENSION_TEXTURE1D:
@@ -5286,6 +5921,12 @@ HRESULT DirectX::ConvertEx(
                 return E_FAIL;
             }
 
+            if (slices)
+            {
+                slices[index] = 0;
+                continue;
+            }
+
             if (usewic)
             {
                 hr = ConvertUsingWIC(src, pfGUID, targetGUID, options.filter, options.threshold, dst);
@@ -5348,6 +5989,12 @@ HRESULT DirectX::ConvertEx(
                         return E_FAIL;
                     }
 
+                    if (slices)
+                    {
+                        slices[index] = slice;
+                        continue;
+                    }
+
                     if (usewic)
                     {
                         hr = ConvertUsingWIC(src, pfGUID, targetGUID, options.filter, options.threshold, dst);
@@ -5376,6 +6023,8 @@ HRESULT DirectX::ConvertEx(
                 if (d > 1)
                     d >>= 1;
             }
+
+            nconvert = index;
         }
         break;
 
@@ -5384,6 +6033,16 @@ HRESULT DirectX::ConvertEx(
         return E_FAIL;
     }
 
+    if (slices && nconvert > 0)
+    {
+        hr = ConvertCustom_Parallel(srcImages, dest, slices.get(), nconvert, options.filter, options.threshold, options.executor, statusCallback);
+        if (FAILED(hr))
+        {
+            result.Release();
+            return hr;
+        }
+    }
+
     if (statusCallback)
     {
         if (!statusCallback(nimages, nimages))
@@ -5416,7 +6075,7 @@ HRESULT DirectX::ConvertToSinglePlane(const Image& srcImage, ScratchImage& image
     if ((srcImage.width > UINT32_MAX) || (srcImage.height > UINT32_MAX))
         return E_INVALIDARG;
 
-    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1);
+    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -5466,7 +6125,7 @@ HRESULT DirectX::ConvertToSinglePlane(
 
     TexMetadata mdata2 = metadata;
     mdata2.format = format;
-    HRESULT hr = result.Initialize(mdata2);
+    HRESULT hr = result.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -1959,6 +1959,125 @@ HRESULT DirectX::GetMetadataFromDDSFileEx(
 //-------------------------------------------------------------------------------------
 // Load a DDS file in memory
 //-------------------------------------------------------------------------------------
+namespace
+{
+    // pWritable is either nullptr or pSource itself; DDS_FLAGS_NO_COPY only references the buffer when it is writable
+    HRESULT LoadDDSFromMemory(
+        _In_reads_bytes_(size) const uint8_t* pSource,
+        _In_opt_ uint8_t* pWritable,
+        size_t size,
+        DDS_FLAGS flags,
+        _Out_opt_ TexMetadata* metadata,
+        _Out_opt_ DDSMetaData* ddPixelFormat,
+        ScratchImage& image) noexcept
+    {
+        assert(!pWritable || pWritable == pSource);
+        if (!pSource || size == 0)
+            return E_INVALIDARG;
+
+        image.Release();
+
+        uint32_t convFlags = 0;
+        TexMetadata mdata;
+        HRESULT hr = DecodeDDSHeader(pSource, size, flags, mdata, ddPixelFormat, convFlags);
+        if (FAILED(hr))
+            return hr;
+
+        size_t offset = DDS_MIN_HEADER_SIZE;
+        if (convFlags & CONV_FLAGS_DX10)
+            offset += sizeof(DDS_HEADER_DXT10);
+
+        assert(offset <= size);
+
+        const uint32_t *pal8 = nullptr;
+        if (convFlags & CONV_FLAGS_PAL8)
+        {
+            pal8 = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(pSource) + offset);
+            assert(pal8);
+            offset += (256 * sizeof(uint32_t));
+            if (size < offset)
+                return E_FAIL;
+        }
+
+        size_t remaining = size - offset;
+        if (remaining == 0)
+            return E_FAIL;
+
+        if ((flags & DDS_FLAGS_NO_COPY)
+            && pWritable
+            && !(flags & (DDS_FLAGS_LEGACY_DWORD | DDS_FLAGS_BAD_DXTN_TAILS))
+            && !(convFlags & (CONV_FLAGS_EXPAND | CONV_FLAGS_NOALPHA | CONV_FLAGS_SWIZZLE)))
+        {
+            // Pixel data is already in the final layout, so reference it in place
+            uint8_t* pPixels = pWritable + offset;
+            if (SUCCEEDED(image.InitializeFromMemory(mdata, pPixels, remaining)))
+            {
+                if (metadata)
+                    memcpy(metadata, &mdata, sizeof(TexMetadata));
+
+                return S_OK;
+            }
+
+            // Otherwise fall back to the copy below, which handles PERMISSIVE fixups and reports errors
+        }
+
+        hr = image.Initialize(mdata);
+        if (FAILED(hr))
+            return hr;
+
+        if (flags & DDS_FLAGS_PERMISSIVE)
+        {
+            // For cubemaps, DDS_HEADER_DXT10.arraySize is supposed to be 'number of cubes'.
+            // This handles cases where the value is incorrectly written as the original 6*numCubes value.
+            if ((mdata.miscFlags & TEX_MISC_TEXTURECUBE)
+                && (convFlags & CONV_FLAGS_DX10)
+                && (image.GetPixelsSize() > remaining)
+                && ((mdata.arraySize % 6) == 0))
+            {
+                mdata.arraySize = mdata.arraySize / 6;
+                hr = image.Initialize(mdata);
+                if (FAILED(hr))
+                    return hr;
+
+                if (image.GetPixelsSize() > remaining)
+                {
+                    image.Release();
+                    return HRESULT_E_HANDLE_EOF;
+                }
+            }
+        }
+
+        CP_FLAGS cflags = CP_FLAGS_NONE;
+        if (flags & DDS_FLAGS_LEGACY_DWORD)
+        {
+            cflags |= CP_FLAGS_LEGACY_DWORD;
+        }
+        if (flags & DDS_FLAGS_BAD_DXTN_TAILS)
+        {
+            cflags |= CP_FLAGS_BAD_DXTN_TAILS;
+        }
+
+        const void* pPixels = static_cast<const uint8_t*>(pSource) + offset;
+        assert(pPixels);
+        hr = CopyImage(pPixels,
+            size - offset,
+            mdata,
+            cflags,
+            convFlags,
+            pal8,
+            image);
+        if (FAILED(hr))
+        {
+            image.Release();
+            return hr;
+        }
+        if (metadata)
+            memcpy(metadata, &mdata, sizeof(TexMetadata));
+
+        return S_OK;
+    }
+}
+
 _Use_decl_annotations_
 HRESULT DirectX::LoadFromDDSMemory(
     const uint8_t* pSource,
@@ -1967,7 +2086,18 @@ HRESULT DirectX::LoadFromDDSMemory(
     TexMetadata* metadata,
     ScratchImage& image) noexcept
 {
-    return LoadFromDDSMemoryEx(pSource, size, flags, metadata, nullptr, image);
+    return LoadDDSFromMemory(pSource, nullptr, size, flags, metadata, nullptr, image);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::LoadFromDDSMemory(
+    uint8_t* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadDDSFromMemory(pSource, pSource, size, flags, metadata, nullptr, image);
 }
 
 _Use_decl_annotations_
@@ -1979,91 +2109,19 @@ HRESULT DirectX::LoadFromDDSMemoryEx(
     DDSMetaData* ddPixelFormat,
     ScratchImage& image) noexcept
 {
-    if (!pSource || size == 0)
-        return E_INVALIDARG;
-
-    image.Release();
-
-    uint32_t convFlags = 0;
-    TexMetadata mdata;
-    HRESULT hr = DecodeDDSHeader(pSource, size, flags, mdata, ddPixelFormat, convFlags);
-    if (FAILED(hr))
-        return hr;
-
-    size_t offset = DDS_MIN_HEADER_SIZE;
-    if (convFlags & CONV_FLAGS_DX10)
-        offset += sizeof(DDS_HEADER_DXT10);
-
-    assert(offset <= size);
-
-    const uint32_t *pal8 = nullptr;
-    if (convFlags & CONV_FLAGS_PAL8)
-    {
-        pal8 = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(pSource) + offset);
-        assert(pal8);
-        offset += (256 * sizeof(uint32_t));
-        if (size < offset)
-            return E_FAIL;
-    }
-
-    size_t remaining = size - offset;
-    if (remaining == 0)
-        return E_FAIL;
-
-    hr = image.Initialize(mdata);
-    if (FAILED(hr))
-        return hr;
-
-    if (flags & DDS_FLAGS_PERMISSIVE)
-    {
-        // For cubemaps, DDS_HEADER_DXT10.arraySize is supposed to be 'number of cubes'.
-        // This handles cases where the value is incorrectly written as the original 6*numCubes value.
-        if ((mdata.miscFlags & TEX_MISC_TEXTURECUBE)
-            && (convFlags & CONV_FLAGS_DX10)
-            && (image.GetPixelsSize() > remaining)
-            && ((mdata.arraySize % 6) == 0))
-        {
-            mdata.arraySize = mdata.arraySize / 6;
-            hr = image.Initialize(mdata);
-            if (FAILED(hr))
-                return hr;
-
-            if (image.GetPixelsSize() > remaining)
-            {
-                image.Release();
-                return HRESULT_E_HANDLE_EOF;
-            }
-        }
-    }
-
-    CP_FLAGS cflags = CP_FLAGS_NONE;
-    if (flags & DDS_FLAGS_LEGACY_DWORD)
-    {
-        cflags |= CP_FLAGS_LEGACY_DWORD;
-    }
-    if (flags & DDS_FLAGS_BAD_DXTN_TAILS)
-    {
-        cflags |= CP_FLAGS_BAD_DXTN_TAILS;
-    }
-
-    const void* pPixels = static_cast<const uint8_t*>(pSource) + offset;
-    assert(pPixels);
-    hr = CopyImage(pPixels,
-        size - offset,
-        mdata,
-        cflags,
-        convFlags,
-        pal8,
-        image);
-    if (FAILED(hr))
-    {
-        image.Release();
-        return hr;
-    }
-    if (metadata)
-        memcpy(metadata, &mdata, sizeof(TexMetadata));
+    return LoadDDSFromMemory(pSource, nullptr, size, flags, metadata, ddPixelFormat, image);
+}
 
-    return S_OK;
+_Use_decl_annotations_
+HRESULT DirectX::LoadFromDDSMemoryEx(
+    uint8_t* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    TexMetadata* metadata,
+    DDSMetaData* ddPixelFormat,
+    ScratchImage& image) noexcept
+{
+    return LoadDDSFromMemory(pSource, pSource, size, flags, metadata, ddPixelFormat, image);
 }
 
 
@@ -14,19 +14,6 @@
 using namespace DirectX;
 using namespace DirectX::Internal;
 
-#ifndef _WIN32
-namespace
-{
-    inline void * _aligned_malloc(size_t size, size_t alignment)
-    {
-        size = (size + alignment - 1) & ~(alignment - 1);
-        return std::aligned_alloc(alignment, size);
-    }
-
-#define _aligned_free free
-}
-#endif
-
 //-------------------------------------------------------------------------------------
 // Determines number of image array entries and pixel size
 //-------------------------------------------------------------------------------------
@@ -268,6 +255,61 @@ bool DirectX::Internal::SetupImageArray(
 }
 
 
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Validates metadata for a ScratchImage, computing the full mip count if needed
+    //---------------------------------------------------------------------------------
+    HRESULT ValidateMetadata(const TexMetadata& mdata, size_t& mipLevels) noexcept
+    {
+        if (!IsValid(mdata.format))
+            return E_INVALIDARG;
+
+        if (IsPalettized(mdata.format))
+            return HRESULT_E_NOT_SUPPORTED;
+
+        mipLevels = mdata.mipLevels;
+
+        switch (mdata.dimension)
+        {
+        case TEX_DIMENSION_TEXTURE1D:
+            if (!mdata.width || mdata.height != 1 || mdata.depth != 1 || !mdata.arraySize)
+                return E_INVALIDARG;
+
+            if (!CalculateMipLevels(mdata.width, 1, mipLevels))
+                return E_INVALIDARG;
+            break;
+
+        case TEX_DIMENSION_TEXTURE2D:
+            if (!mdata.width || !mdata.height || mdata.depth != 1 || !mdata.arraySize)
+                return E_INVALIDARG;
+
+            if (mdata.IsCubemap())
+            {
+                if ((mdata.arraySize % 6) != 0)
+                    return E_INVALIDARG;
+            }
+
+            if (!CalculateMipLevels(mdata.width, mdata.height, mipLevels))
+                return E_INVALIDARG;
+            break;
+
+        case TEX_DIMENSION_TEXTURE3D:
+            if (!mdata.width || !mdata.height || !mdata.depth || mdata.arraySize != 1)
+                return E_INVALIDARG;
+
+            if (!CalculateMipLevels3D(mdata.width, mdata.height, mdata.depth, mipLevels))
+                return E_INVALIDARG;
+            break;
+
+        default:
+            return HRESULT_E_NOT_SUPPORTED;
+        }
+
+        return S_OK;
+    }
+}
+
 //=====================================================================================
 // ScratchImage - Bitmap image container
 //=====================================================================================
@@ -280,14 +322,18 @@ ScratchImage& ScratchImage::operator= (ScratchImage&& moveFrom) noexcept
 
         m_nimages = moveFrom.m_nimages;
         m_size = moveFrom.m_size;
+        m_capacity = moveFrom.m_capacity;
         m_metadata = moveFrom.m_metadata;
         m_image = moveFrom.m_image;
         m_memory = moveFrom.m_memory;
+        m_allocator = moveFrom.m_allocator;
 
         moveFrom.m_nimages = 0;
         moveFrom.m_size = 0;
+        moveFrom.m_capacity = 0;
         moveFrom.m_image = nullptr;
         moveFrom.m_memory = nullptr;
+        moveFrom.m_allocator = nullptr;
     }
     return *this;
 }
@@ -299,51 +345,12 @@ ScratchImage& ScratchImage::operator= (ScratchImage&& moveFrom) noexcept
 _Use_decl_annotations_
 HRESULT ScratchImage::Initialize(const TexMetadata& mdata, CP_FLAGS flags) noexcept
 {
-    if (!IsValid(mdata.format))
-        return E_INVALIDARG;
-
-    if (IsPalettized(mdata.format))
-        return HRESULT_E_NOT_SUPPORTED;
-
-    size_t mipLevels = mdata.mipLevels;
-
-    switch (mdata.dimension)
-    {
-    case TEX_DIMENSION_TEXTURE1D:
-        if (!mdata.width || mdata.height != 1 || mdata.depth != 1 || !mdata.arraySize)
-            return E_INVALIDARG;
-
-        if (!CalculateMipLevels(mdata.width, 1, mipLevels))
-            return E_INVALIDARG;
-        break;
-
-    case TEX_DIMENSION_TEXTURE2D:
-        if (!mdata.width || !mdata.height || mdata.depth != 1 || !mdata.arraySize)
-            return E_INVALIDARG;
-
-        if (mdata.IsCubemap())
-        {
-            if ((mdata.arraySize % 6) != 0)
-                return E_INVALIDARG;
-        }
-
-        if (!CalculateMipLevels(mdata.width, mdata.height, mipLevels))
-            return E_INVALIDARG;
-        break;
-
-    case TEX_DIMENSION_TEXTURE3D:
-        if (!mdata.width || !mdata.height || !mdata.depth || mdata.arraySize != 1)
-            return E_INVALIDARG;
-
-        if (!CalculateMipLevels3D(mdata.width, mdata.height, mdata.depth, mipLevels))
-            return E_INVALIDARG;
-        break;
-
-    default:
-        return HRESULT_E_NOT_SUPPORTED;
-    }
+    size_t mipLevels = 0;
+    HRESULT hr = ValidateMetadata(mdata, mipLevels);
+    if (FAILED(hr))
+        return hr;
 
-    Release();
+    ReleaseForInitialize(flags);
 
     m_metadata.width = mdata.width;
     m_metadata.height = mdata.height;
@@ -356,33 +363,14 @@ HRESULT ScratchImage::Initialize(const TexMetadata& mdata, CP_FLAGS flags) noexc
     m_metadata.dimension = mdata.dimension;
 
     size_t pixelSize, nimages;
-    HRESULT hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
+    hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
     if (FAILED(hr))
-        return hr;
-
-    m_image = new (std::nothrow) Image[nimages];
-    if (!m_image)
-        return E_OUTOFMEMORY;
-
-    m_nimages = nimages;
-    memset(m_image, 0, sizeof(Image) * nimages);
-
-    m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, 16));
-    if (!m_memory)
     {
         Release();
-        return E_OUTOFMEMORY;
-    }
-    memset(m_memory, 0, pixelSize);
-    m_size = pixelSize;
-
-    if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
-    {
-        Release();
-        return E_FAIL;
+        return hr;
     }
 
-    return S_OK;
+    return AllocateImages(nimages, pixelSize, flags);
 }
 
 _Use_decl_annotations_
@@ -413,7 +401,7 @@ HRESULT ScratchImage::Initialize2D(DXGI_FORMAT fmt, size_t width, size_t height,
     if (!CalculateMipLevels(width, height, mipLevels))
         return E_INVALIDARG;
 
-    Release();
+    ReleaseForInitialize(flags);
 
     m_metadata.width = width;
     m_metadata.height = height;
@@ -428,31 +416,12 @@ HRESULT ScratchImage::Initialize2D(DXGI_FORMAT fmt, size_t width, size_t height,
     size_t pixelSize, nimages;
     HRESULT hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
     if (FAILED(hr))
-        return hr;
-
-    m_image = new (std::nothrow) Image[nimages];
-    if (!m_image)
-        return E_OUTOFMEMORY;
-
-    m_nimages = nimages;
-    memset(m_image, 0, sizeof(Image) * nimages);
-
-    m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, 16));
-    if (!m_memory)
     {
         Release();
-        return E_OUTOFMEMORY;
-    }
-    memset(m_memory, 0, pixelSize);
-    m_size = pixelSize;
-
-    if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
-    {
-        Release();
-        return E_FAIL;
+        return hr;
     }
 
-    return S_OK;
+    return AllocateImages(nimages, pixelSize, flags);
 }
 
 _Use_decl_annotations_
@@ -470,7 +439,7 @@ HRESULT ScratchImage::Initialize3D(DXGI_FORMAT fmt, size_t width, size_t height,
     if (!CalculateMipLevels3D(width, height, depth, mipLevels))
         return E_INVALIDARG;
 
-    Release();
+    ReleaseForInitialize(flags);
 
     m_metadata.width = width;
     m_metadata.height = height;
@@ -485,33 +454,12 @@ HRESULT ScratchImage::Initialize3D(DXGI_FORMAT fmt, size_t width, size_t height,
     size_t pixelSize, nimages;
     HRESULT hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
     if (FAILED(hr))
-        return hr;
-
-    m_image = new (std::nothrow) Image[nimages];
-    if (!m_image)
-    {
-        Release();
-        return E_OUTOFMEMORY;
-    }
-    m_nimages = nimages;
-    memset(m_image, 0, sizeof(Image) * nimages);
-
-    m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, 16));
-    if (!m_memory)
-    {
-        Release();
-        return E_OUTOFMEMORY;
-    }
-    memset(m_memory, 0, pixelSize);
-    m_size = pixelSize;
-
-    if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
     {
         Release();
-        return E_FAIL;
+        return hr;
     }
 
-    return S_OK;
+    return AllocateImages(nimages, pixelSize, flags);
 }
 
 _Use_decl_annotations_
@@ -706,8 +654,60 @@ HRESULT ScratchImage::Initialize3DFromImages(const Image* images, size_t depth,
     return S_OK;
 }
 
-void ScratchImage::Release() noexcept
+_Use_decl_annotations_
+HRESULT ScratchImage::InitializeFromMemory(const TexMetadata& mdata, uint8_t* pixels, size_t size, IMemoryAllocator* owner, CP_FLAGS flags) noexcept
 {
+    if (!pixels || !size)
+        return E_INVALIDARG;
+
+    size_t mipLevels = 0;
+    HRESULT hr = ValidateMetadata(mdata, mipLevels);
+    if (FAILED(hr))
+        return hr;
+
+    TexMetadata metadata = mdata;
+    metadata.mipLevels = mipLevels;
+
+    size_t pixelSize, nimages;
+    hr = DetermineImageArray(metadata, flags, nimages, pixelSize);
+    if (FAILED(hr))
+        return hr;
+
+    if (pixelSize > size)
+        return E_NOT_SUFFICIENT_BUFFER;
+
+    std::unique_ptr<Image[]> images(new (std::nothrow) Image[nimages]);
+    if (!images)
+        return E_OUTOFMEMORY;
+
+    memset(images.get(), 0, sizeof(Image) * nimages);
+
+    if (!SetupImageArray(pixels, pixelSize, metadata, flags, images.get(), nimages))
+        return E_FAIL;
+
+    Release();
+
+    m_nimages = nimages;
+    m_size = pixelSize;
+    m_capacity = size;
+    m_metadata = metadata;
+    m_image = images.release();
+    m_memory = pixels;
+    m_allocator = owner;
+
+    return S_OK;
+}
+
+// Release() that keeps the pixel allocation for reuse with CP_FLAGS_REUSE_MEMORY
+_Use_decl_annotations_
+void ScratchImage::ReleaseForInitialize(CP_FLAGS flags) noexcept
+{
+    if (!(flags & CP_FLAGS_REUSE_MEMORY) || !m_memory || !m_allocator)
+    {
+        Release();
+        return;
+    }
+
     m_nimages = 0;
     m_size = 0;
 
@@ -717,12 +717,82 @@ void ScratchImage::Release() noexcept
         m_image = nullptr;
     }
 
+    memset(&m_metadata, 0, sizeof(m_metadata));
+}
+
+// Creates the image array and pixel memory for the metadata set up by Initialize*
+_Use_decl_annotations_
+HRESULT ScratchImage::AllocateImages(size_t nimages, size_t pixelSize, CP_FLAGS flags) noexcept
+{
+    m_image = new (std::nothrow) Image[nimages];
+    if (!m_image)
+    {
+        Release();
+        return E_OUTOFMEMORY;
+    }
+
+    m_nimages = nimages;
+    memset(m_image, 0, sizeof(Image) * nimages);
+
+    // A kept block is only reused while the new layout needs at least half of it, so one large result
+    // doesn't pin its allocation under a long run of much smaller ones
+    if (m_memory && (m_capacity < pixelSize || pixelSize < m_capacity / 2))
+    {
+        m_allocator->Free(m_memory, m_capacity);
+        m_memory = nullptr;
+        m_capacity = 0;
+    }
+
+    if (!m_memory)
+    {
+        m_allocator = GetMemoryAllocator();
+        m_memory = static_cast<uint8_t*>(m_allocator->Allocate(pixelSize, 16));
+        if (!m_memory)
+        {
+            Release();
+            return E_OUTOFMEMORY;
+        }
+        m_capacity = pixelSize;
+    }
+
+    if (!(flags & CP_FLAGS_NO_ZERO_FILL))
+    {
+        memset(m_memory, 0, pixelSize);
+    }
+    m_size = pixelSize;
+
+    if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
+    {
+        Release();
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+void ScratchImage::Release() noexcept
+{
+    m_nimages = 0;
+
+    if (m_image)
+    {
+        delete[] m_image;
+        m_image = nullptr;
+    }
+
     if (m_memory)
     {
-        _aligned_free(m_memory);
+        if (m_allocator)
+        {
+            m_allocator->Free(m_memory, m_capacity);
+        }
         m_memory = nullptr;
     }
 
+    m_size = 0;
+    m_capacity = 0;
+    m_allocator = nullptr;
+
     memset(&m_metadata, 0, sizeof(m_metadata));
 }
 
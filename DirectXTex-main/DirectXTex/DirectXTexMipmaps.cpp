@@ -635,6 +635,13 @@ namespace
             return true;
         }
 
+        if ((filter & TEX_FILTER_FUSED_MIPS)
+            && ((filter & TEX_FILTER_MODE_MASK) == 0 || (filter & TEX_FILTER_MODE_MASK) == TEX_FILTER_BOX))
+        {
+            // Fused box pyramid is only implemented by the non-WIC code paths
+            return false;
+        }
+
         if (IsSRGB(format) || (filter & TEX_FILTER_SRGB))
         {
             // Use non-WIC code paths for sRGB correct filtering
@@ -683,7 +690,10 @@ namespace
             break;
 
         case TEX_FILTER_TRIANGLE:
-            // WIC does not implement this filter
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_KAISER:
+        case TEX_FILTER_MITCHELL:
+            // WIC does not implement these filters
             return false;
 
         default:
@@ -864,7 +874,7 @@ namespace
         assert(mdata.height == baseImages[0].height);
         assert(mdata.format == baseImages[0].format);
 
-        HRESULT hr = mipChain.Initialize(mdata);
+        HRESULT hr = mipChain.Initialize(mdata, CP_FLAGS_REUSE_MEMORY);
         if (FAILED(hr))
             return hr;
 
@@ -903,95 +913,155 @@ namespace
         return S_OK;
     }
 
-    //--- 2D Point Filter ---
-    HRESULT Generate2DMipsPointFilter(size_t levels, const ScratchImage& mipChain, size_t item) noexcept
+    //-------------------------------------------------------------------------------------
+    // Runs taskFn(index) for every index in [0, count), concurrently when given an executor.
+    // Returns the first failure.
+    //-------------------------------------------------------------------------------------
+    template<class TaskFn>
+    HRESULT RunMipTasks(size_t count, _In_opt_ ITaskExecutor* executor, TaskFn&& taskFn) noexcept
     {
-        if (!mipChain.GetImages())
-            return E_INVALIDARG;
+        if (!executor || count == 1)
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                const HRESULT hr = taskFn(index);
+                if (FAILED(hr))
+                    return hr;
+            }
 
-        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+            return S_OK;
+        }
 
-        assert(levels > 1);
+        std::atomic<HRESULT> result(S_OK);
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+        HRESULT hr = ParallelFor(executor, count, [&](size_t index) -> bool
+        {
+            if (FAILED(result.load(std::memory_order_relaxed)))
+                return false;
 
-        // Allocate temporary space (2 scanlines)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 2);
-        if (!scanline)
-            return E_OUTOFMEMORY;
+            const HRESULT hr = taskFn(index);
+            if (FAILED(hr))
+            {
+                HRESULT expected = S_OK;
+                result.compare_exchange_strong(expected, hr);
+                return false;
+            }
 
-        XMVECTOR* target = scanline.get();
+            return true;
+        });
+        if (FAILED(hr))
+            return hr;
 
-        XMVECTOR* row = target + width;
+        return result.load();
+    }
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
+    //-------------------------------------------------------------------------------------
+    // Runs rowFn(index, y0, y1) over every image of a mip level (array items, or destination
+    // slices for volumes). With an executor, each image is also split into bands of rows which
+    // run concurrently; the rows of every band are computed exactly as the serial path does.
+    //-------------------------------------------------------------------------------------
+    constexpr size_t MIPS_MIN_BAND_PIXELS = 16384;
+
+    template<class RowFn>
+    HRESULT ProcessMipLevel(
+        size_t nimages,
+        size_t nwidth,
+        size_t nheight,
+        _In_opt_ ITaskExecutor* executor,
+        RowFn&& rowFn) noexcept
+    {
+        assert(nimages > 0 && nwidth > 0 && nheight > 0);
+
+        if (!executor || (nimages == 1 && (uint64_t(nwidth) * uint64_t(nheight)) <= MIPS_MIN_BAND_PIXELS))
         {
-        #ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-        #endif
+            return RunMipTasks(nimages, nullptr, [&](size_t index) noexcept { return rowFn(index, size_t(0), nheight); });
+        }
 
-            // 2D point filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+        const size_t rows = std::min<size_t>(nheight, (MIPS_MIN_BAND_PIXELS + nwidth - 1) / nwidth);
+        const size_t nBands = (nheight + rows - 1) / rows;
 
-            if (!src || !dest)
-                return E_POINTER;
+        return RunMipTasks(nimages * nBands, executor, [&](size_t band) noexcept
+        {
+            const size_t y0 = (band % nBands) * rows;
+            return rowFn(band / nBands, y0, std::min<size_t>(nheight, y0 + rows));
+        });
+    }
 
-            const uint8_t* pSrc = src->pixels;
-            uint8_t* pDest = dest->pixels;
+    inline ITaskExecutor* GetMipsExecutor(TEX_FILTER_FLAGS filter) noexcept
+    {
+        return (filter & TEX_FILTER_PARALLEL) ? GetDefaultTaskExecutor() : nullptr;
+    }
 
-            const size_t rowPitch = src->rowPitch;
+    inline Filters::FILTER_KERNEL_TYPE GetFilterKernelType(uint32_t filter_select) noexcept
+    {
+        switch (filter_select)
+        {
+        case TEX_FILTER_LANCZOS:    return Filters::FILTER_KERNEL_LANCZOS;
+        case TEX_FILTER_KAISER:     return Filters::FILTER_KERNEL_KAISER;
+        case TEX_FILTER_MITCHELL:   return Filters::FILTER_KERNEL_MITCHELL;
+        default:                    return Filters::FILTER_KERNEL_TRIANGLE;
+        }
+    }
 
-            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            const size_t nheight = (height > 1) ? (height >> 1) : 1;
 
-            const size_t xinc = (width << 16) / nwidth;
-            const size_t yinc = (height << 16) / nheight;
+    //--- 2D Point Filter ---
+    HRESULT PointFilterRows(
+        const Image& src,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        _Out_writes_(src.width * 2) XMVECTOR* scanline) noexcept
+    {
+        const size_t width = src.width;
+        const size_t nwidth = dest.width;
 
-            size_t lasty = size_t(-1);
+        XMVECTOR* target = scanline;
 
-            size_t sy = 0;
-            for (size_t y = 0; y < nheight; ++y)
-            {
-                if ((lasty ^ sy) >> 16)
-                {
-                    if (!LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
-                        return E_FAIL;
-                    lasty = sy;
-                }
+        XMVECTOR* row = target + width;
 
-                size_t sx = 0;
-                for (size_t x = 0; x < nwidth; ++x)
-                {
-                    target[x] = row[sx >> 16];
-                    sx += xinc;
-                }
+    #ifdef _DEBUG
+        memset(row, 0xCD, sizeof(XMVECTOR)*width);
+    #endif
 
-                if (!StoreScanline(pDest, dest->rowPitch, dest->format, target, nwidth))
+        const uint8_t* pSrc = src.pixels;
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
+
+        const size_t rowPitch = src.rowPitch;
+
+        const size_t xinc = (width << 16) / nwidth;
+        const size_t yinc = (src.height << 16) / dest.height;
+
+        size_t lasty = size_t(-1);
+
+        size_t sy = yinc * y0;
+        for (size_t y = y0; y < y1; ++y)
+        {
+            if ((lasty ^ sy) >> 16)
+            {
+                if (!LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src.format))
                     return E_FAIL;
-                pDest += dest->rowPitch;
+                lasty = sy;
+            }
 
-                sy += yinc;
+            size_t sx = 0;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                target[x] = row[sx >> 16];
+                sx += xinc;
             }
 
-            if (height > 1)
-                height >>= 1;
+            if (!StoreScanline(pDest, dest.rowPitch, dest.format, target, nwidth))
+                return E_FAIL;
+            pDest += dest.rowPitch;
 
-            if (width > 1)
-                width >>= 1;
+            sy += yinc;
         }
 
         return S_OK;
     }
 
-
-    //--- 2D Box Filter ---
-    HRESULT Generate2DMipsBoxFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    HRESULT Generate2DMipsPointFilter(size_t levels, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
     {
-        using namespace DirectX::Filters;
-
         if (!mipChain.GetImages())
             return E_INVALIDARG;
 
@@ -999,397 +1069,695 @@ namespace
 
         assert(levels > 1);
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+        const size_t nitems = mipChain.GetMetadata().arraySize;
 
-        if (!ispow2(width) || !ispow2(height))
-            return E_FAIL;
+        // Resize base image to each target mip level
+        for (size_t level = 1; level < levels; ++level)
+        {
+            const Image* first = mipChain.GetImage(level, 0, 0);
+            if (!first)
+                return E_POINTER;
 
-        // Allocate temporary space (3 scanlines)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 3);
-        if (!scanline)
-            return E_OUTOFMEMORY;
+            // 2D point filter
+            HRESULT hr = ProcessMipLevel(nitems, first->width, first->height, executor,
+                [&](size_t item, size_t y0, size_t y1) noexcept -> HRESULT
+                {
+                    const Image* src = mipChain.GetImage(level - 1, item, 0);
+                    const Image* dest = mipChain.GetImage(level, item, 0);
 
-        XMVECTOR* target = scanline.get();
+                    if (!src || !dest)
+                        return E_POINTER;
 
-        XMVECTOR* urow0 = target + width;
-        XMVECTOR* urow1 = target + width * 2;
+                    // Allocate temporary space (2 scanlines)
+                    auto scanline = make_AlignedArrayXMVECTOR(uint64_t(src->width) * 2);
+                    if (!scanline)
+                        return E_OUTOFMEMORY;
 
-        const XMVECTOR* urow2 = urow0 + 1;
-        const XMVECTOR* urow3 = urow1 + 1;
+                    return PointFilterRows(*src, *dest, y0, y1, scanline.get());
+                });
+            if (FAILED(hr))
+                return hr;
+        }
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
-        {
-            if (height <= 1)
-            {
-                urow1 = urow0;
-            }
+        return S_OK;
+    }
 
-            if (width <= 1)
-            {
-                urow2 = urow0;
-                urow3 = urow1;
-            }
 
-            // 2D box filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+    //--- Native box filter kernels ---
+    // For formats whose float conversion is linear, the 2x2 (or 2x2x2) average is computed directly in the
+    // storage format. UNORM channels are summed as integers and rounded to nearest; float channels are added
+    // in the same order as AVERAGE4 / AVERAGE8 so they match the XMVECTOR path.
+    struct BoxUNorm8
+    {
+        using type = uint8_t;
+        using sum_type = uint32_t;
+        static sum_type Load(type v) noexcept { return v; }
+        template<unsigned Shift> static type Store(sum_type sum) noexcept
+        {
+            return static_cast<type>((sum + (1u << (Shift - 1))) >> Shift);
+        }
+    };
 
-            if (!src || !dest)
-                return E_POINTER;
+    struct BoxUNorm16
+    {
+        using type = uint16_t;
+        using sum_type = uint32_t;
+        static sum_type Load(type v) noexcept { return v; }
+        template<unsigned Shift> static type Store(sum_type sum) noexcept
+        {
+            return static_cast<type>((sum + (1u << (Shift - 1))) >> Shift);
+        }
+    };
 
-            const uint8_t* pSrc = src->pixels;
-            uint8_t* pDest = dest->pixels;
+    struct BoxFloat16
+    {
+        using type = PackedVector::HALF;
+        using sum_type = float;
+        static sum_type Load(type v) noexcept { return PackedVector::XMConvertHalfToFloat(v); }
+        template<unsigned Shift> static type Store(sum_type sum) noexcept
+        {
+            const float f = sum * (1.f / float(1u << Shift));
+            return PackedVector::XMConvertFloatToHalf(std::max<float>(std::min<float>(f, 65504.f), -65504.f));
+        }
+    };
 
-            const size_t rowPitch = src->rowPitch;
+    struct BoxFloat32
+    {
+        using type = float;
+        using sum_type = float;
+        static sum_type Load(type v) noexcept { return v; }
+        template<unsigned Shift> static type Store(sum_type sum) noexcept
+        {
+            return sum * (1.f / float(1u << Shift));
+        }
+    };
 
-            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            const size_t nheight = (height > 1) ? (height >> 1) : 1;
+    template<class Traits, size_t Channels>
+    struct BoxNative
+    {
+        using type = typename Traits::type;
+        using sum_type = typename Traits::sum_type;
+
+        static void Rows(const Image& src, const Image& dest, size_t y0, size_t y1) noexcept
+        {
+            const size_t nwidth = dest.width;
+            const size_t xoff = (src.width > 1) ? Channels : 0;
+            const bool vfilter = (src.height > 1);
 
-            for (size_t y = 0; y < nheight; ++y)
+            for (size_t y = y0; y < y1; ++y)
             {
-                if (!LoadScanlineLinear(urow0, width, pSrc, rowPitch, src->format, filter))
-                    return E_FAIL;
-                pSrc += rowPitch;
+                auto pRow0 = reinterpret_cast<const type*>(src.pixels + (src.rowPitch * (vfilter ? (y * 2) : y)));
+                auto pRow1 = vfilter ? reinterpret_cast<const type*>(reinterpret_cast<const uint8_t*>(pRow0) + src.rowPitch) : pRow0;
+                auto pDest = reinterpret_cast<type*>(dest.pixels + (dest.rowPitch * y));
 
-                if (urow0 != urow1)
+                for (size_t x = 0; x < nwidth; ++x)
                 {
-                    if (!LoadScanlineLinear(urow1, width, pSrc, rowPitch, src->format, filter))
-                        return E_FAIL;
-                    pSrc += rowPitch;
+                    const size_t i0 = x * 2 * Channels;
+                    const size_t i1 = i0 + xoff;
+
+                    for (size_t c = 0; c < Channels; ++c)
+                    {
+                        sum_type sum = Traits::Load(pRow0[i0 + c]);
+                        sum += Traits::Load(pRow1[i0 + c]);
+                        sum += Traits::Load(pRow0[i1 + c]);
+                        sum += Traits::Load(pRow1[i1 + c]);
+
+                        pDest[x * Channels + c] = Traits::template Store<2>(sum);
+                    }
                 }
+            }
+        }
+
+        static void Rows3D(const Image& srca, const Image& srcb, const Image& dest, size_t y0, size_t y1) noexcept
+        {
+            const size_t nwidth = dest.width;
+            const size_t xoff = (srca.width > 1) ? Channels : 0;
+            const bool vfilter = (srca.height > 1);
+
+            for (size_t y = y0; y < y1; ++y)
+            {
+                const size_t sy = vfilter ? (y * 2) : y;
+
+                auto pURow0 = reinterpret_cast<const type*>(srca.pixels + (srca.rowPitch * sy));
+                auto pURow1 = vfilter ? reinterpret_cast<const type*>(reinterpret_cast<const uint8_t*>(pURow0) + srca.rowPitch) : pURow0;
+                auto pVRow0 = reinterpret_cast<const type*>(srcb.pixels + (srcb.rowPitch * sy));
+                auto pVRow1 = vfilter ? reinterpret_cast<const type*>(reinterpret_cast<const uint8_t*>(pVRow0) + srcb.rowPitch) : pVRow0;
+                auto pDest = reinterpret_cast<type*>(dest.pixels + (dest.rowPitch * y));
 
                 for (size_t x = 0; x < nwidth; ++x)
                 {
-                    const size_t x2 = x << 1;
+                    const size_t i0 = x * 2 * Channels;
+                    const size_t i1 = i0 + xoff;
 
-                    AVERAGE4(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2])
+                    for (size_t c = 0; c < Channels; ++c)
+                    {
+                        sum_type sum = Traits::Load(pURow0[i0 + c]);
+                        sum += Traits::Load(pURow1[i0 + c]);
+                        sum += Traits::Load(pURow0[i1 + c]);
+                        sum += Traits::Load(pURow1[i1 + c]);
+                        sum += Traits::Load(pVRow0[i0 + c]);
+                        sum += Traits::Load(pVRow1[i0 + c]);
+                        sum += Traits::Load(pVRow0[i1 + c]);
+                        sum += Traits::Load(pVRow1[i1 + c]);
+
+                        pDest[x * Channels + c] = Traits::template Store<3>(sum);
+                    }
                 }
-
-                if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                    return E_FAIL;
-                pDest += dest->rowPitch;
             }
-
-            if (height > 1)
-                height >>= 1;
-
-            if (width > 1)
-                width >>= 1;
         }
+    };
 
-        return S_OK;
-    }
+    struct BoxNativeKernel
+    {
+        void (*rows)(const Image& src, const Image& dest, size_t y0, size_t y1);
+        void (*rows3D)(const Image& srca, const Image& srcb, const Image& dest, size_t y0, size_t y1);
+    };
 
+    template<class Traits, size_t Channels>
+    BoxNativeKernel MakeBoxNativeKernel() noexcept
+    {
+        return { BoxNative<Traits, Channels>::Rows, BoxNative<Traits, Channels>::Rows3D };
+    }
 
-    //--- 2D Linear Filter ---
-    HRESULT Generate2DMipsLinearFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    bool GetBoxNativeKernel(DXGI_FORMAT format, TEX_FILTER_FLAGS filter, BoxNativeKernel& kernel) noexcept
     {
-        using namespace DirectX::Filters;
+        if (filter & TEX_FILTER_SRGB)
+        {
+            // sRGB conversion requires the XMVECTOR path
+            return false;
+        }
 
-        if (!mipChain.GetImages())
-            return E_INVALIDARG;
+        switch (format)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+            kernel = MakeBoxNativeKernel<BoxUNorm8, 4>();
+            return true;
 
-        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+        case DXGI_FORMAT_R8G8_UNORM:
+            kernel = MakeBoxNativeKernel<BoxUNorm8, 2>();
+            return true;
 
-        assert(levels > 1);
+        case DXGI_FORMAT_R8_UNORM:
+            kernel = MakeBoxNativeKernel<BoxUNorm8, 1>();
+            return true;
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+            kernel = MakeBoxNativeKernel<BoxUNorm16, 4>();
+            return true;
 
-        // Allocate temporary space (3 scanlines, plus X and Y filters)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 3);
-        if (!scanline)
-            return E_OUTOFMEMORY;
+        case DXGI_FORMAT_R16G16_UNORM:
+            kernel = MakeBoxNativeKernel<BoxUNorm16, 2>();
+            return true;
 
-        std::unique_ptr<LinearFilter[]> lf(new (std::nothrow) LinearFilter[width + height]);
-        if (!lf)
-            return E_OUTOFMEMORY;
+        case DXGI_FORMAT_R16_UNORM:
+            kernel = MakeBoxNativeKernel<BoxUNorm16, 1>();
+            return true;
 
-        LinearFilter* lfX = lf.get();
-        LinearFilter* lfY = lf.get() + width;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            kernel = MakeBoxNativeKernel<BoxFloat16, 4>();
+            return true;
 
-        XMVECTOR* target = scanline.get();
+        case DXGI_FORMAT_R16G16_FLOAT:
+            kernel = MakeBoxNativeKernel<BoxFloat16, 2>();
+            return true;
 
-        XMVECTOR* row0 = target + width;
-        XMVECTOR* row1 = target + width * 2;
+        case DXGI_FORMAT_R16_FLOAT:
+            kernel = MakeBoxNativeKernel<BoxFloat16, 1>();
+            return true;
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
-        {
-            // 2D linear filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            kernel = MakeBoxNativeKernel<BoxFloat32, 4>();
+            return true;
 
-            if (!src || !dest)
-                return E_POINTER;
+        case DXGI_FORMAT_R32G32_FLOAT:
+            kernel = MakeBoxNativeKernel<BoxFloat32, 2>();
+            return true;
 
-            const uint8_t* pSrc = src->pixels;
-            uint8_t* pDest = dest->pixels;
+        case DXGI_FORMAT_R32_FLOAT:
+            kernel = MakeBoxNativeKernel<BoxFloat32, 1>();
+            return true;
 
-            const size_t rowPitch = src->rowPitch;
+        default:
+            return false;
+        }
+    }
 
-            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            CreateLinearFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, lfX);
 
-            const size_t nheight = (height > 1) ? (height >> 1) : 1;
-            CreateLinearFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, lfY);
+    //--- 2D Box Filter ---
+    HRESULT BoxFilterRows(
+        const Image& src,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        _Out_writes_(src.width * 3) XMVECTOR* scanline) noexcept
+    {
+        using namespace DirectX::Filters;
 
-        #ifdef _DEBUG
-            memset(row0, 0xCD, sizeof(XMVECTOR)*width);
-            memset(row1, 0xDD, sizeof(XMVECTOR)*width);
-        #endif
+        BoxNativeKernel kernel;
+        if (src.format == dest.format && GetBoxNativeKernel(src.format, filter, kernel))
+        {
+            kernel.rows(src, dest, y0, y1);
+            return S_OK;
+        }
 
-            size_t u0 = size_t(-1);
-            size_t u1 = size_t(-1);
+        const size_t width = src.width;
+        const size_t nwidth = dest.width;
 
-            for (size_t y = 0; y < nheight; ++y)
-            {
-                const auto& toY = lfY[y];
+        XMVECTOR* target = scanline;
 
-                if (toY.u0 != u0)
-                {
-                    if (toY.u0 != u1)
-                    {
-                        u0 = toY.u0;
+        XMVECTOR* urow0 = target + width;
+        XMVECTOR* urow1 = target + width * 2;
 
-                        if (!LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-                    else
-                    {
-                        u0 = u1;
-                        u1 = size_t(-1);
+        if (src.height <= 1)
+        {
+            urow1 = urow0;
+        }
 
-                        std::swap(row0, row1);
-                    }
-                }
+        const XMVECTOR* urow2 = urow0 + 1;
+        const XMVECTOR* urow3 = urow1 + 1;
 
-                if (toY.u1 != u1)
-                {
-                    u1 = toY.u1;
+        if (width <= 1)
+        {
+            urow2 = urow0;
+            urow3 = urow1;
+        }
 
-                    if (!LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
-                        return E_FAIL;
-                }
+        const size_t rowPitch = src.rowPitch;
 
-                for (size_t x = 0; x < nwidth; ++x)
-                {
-                    const auto& toX = lfX[x];
+        const uint8_t* pSrc = src.pixels + (rowPitch * ((urow0 != urow1) ? (y0 * 2) : y0));
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
 
-                    BILINEAR_INTERPOLATE(target[x], toX, toY, row0, row1)
-                }
+        for (size_t y = y0; y < y1; ++y)
+        {
+            if (!LoadScanlineLinear(urow0, width, pSrc, rowPitch, src.format, filter))
+                return E_FAIL;
+            pSrc += rowPitch;
 
-                if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
+            if (urow0 != urow1)
+            {
+                if (!LoadScanlineLinear(urow1, width, pSrc, rowPitch, src.format, filter))
                     return E_FAIL;
-                pDest += dest->rowPitch;
+                pSrc += rowPitch;
             }
 
-            if (height > 1)
-                height >>= 1;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                const size_t x2 = x << 1;
 
-            if (width > 1)
-                width >>= 1;
+                AVERAGE4(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2])
+            }
+
+            if (!StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
         }
 
         return S_OK;
     }
 
-    //--- 2D Cubic Filter ---
-#ifdef __clang__
-#pragma clang diagnostic ignored "-Wextra-semi-stmt"
-#endif
-
-    HRESULT Generate2DMipsCubicFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    //-------------------------------------------------------------------------------------
+    // Fused box filter pyramid
+    //
+    // Rows of level 'first' are pushed through a cascade of 2x2 box filters which produces
+    // levels (first, last] in a single pass. Each level filters straight into the input rows
+    // of the next one, so no level is read back from the mipChain or requantized before the
+    // next one is filtered.
+    //-------------------------------------------------------------------------------------
+    class BoxPyramid
     {
-        using namespace DirectX::Filters;
+    public:
+        BoxPyramid() noexcept :
+            m_count(0),
+            m_out(nullptr),
+            m_temp(nullptr),
+            m_lastRows(nullptr),
+            m_lastIndex(0),
+            m_filter(TEX_FILTER_DEFAULT) {}
+
+        BoxPyramid(const BoxPyramid&) = delete;
+        BoxPyramid& operator=(const BoxPyramid&) = delete;
+
+        // y0 is the index of the first row to be pushed, and must be a multiple of 2^(last - first)
+        HRESULT Initialize(
+            const ScratchImage& mipChain,
+            size_t item,
+            size_t first,
+            size_t last,
+            size_t y0,
+            TEX_FILTER_FLAGS filter,
+            _In_opt_ XMVECTOR* lastRows) noexcept
+        {
+            assert(first < last);
 
-        if (!mipChain.GetImages())
-            return E_INVALIDARG;
+            m_count = last - first;
+            m_levels.reset(new (std::nothrow) Level[m_count]);
+            if (!m_levels)
+                return E_OUTOFMEMORY;
 
-        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+            uint64_t total = 0;
+            for (size_t k = 0; k < m_count; ++k)
+            {
+                Level& lv = m_levels[k];
 
-        assert(levels > 1);
+                const Image* src = mipChain.GetImage(first + k, item, 0);
+                lv.dest = mipChain.GetImage(first + k + 1, item, 0);
+                if (!src || !lv.dest)
+                    return E_POINTER;
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+                lv.srcWidth = src->width;
+                lv.srcHeight = src->height;
+                lv.y = (src->height > 1) ? (y0 >> (k + 1)) : 0;
+                lv.rows[0] = lv.rows[1] = nullptr;
+                lv.pending = 0;
 
-        // Allocate temporary space (5 scanlines, plus X and Y filters)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 5);
-        if (!scanline)
-            return E_OUTOFMEMORY;
+                total += uint64_t(lv.srcWidth) * 2;
+            }
 
-        std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[width + height]);
-        if (!cf)
-            return E_OUTOFMEMORY;
+            // Two input rows per level, plus the last level's output row and one row for storing
+            const size_t lastWidth = m_levels[m_count - 1].dest->width;
+            m_scanline = make_AlignedArrayXMVECTOR(total + uint64_t(lastWidth) + uint64_t(m_levels[0].dest->width));
+            if (!m_scanline)
+                return E_OUTOFMEMORY;
 
-        CubicFilter* cfX = cf.get();
-        CubicFilter* cfY = cf.get() + width;
+            XMVECTOR* ptr = m_scanline.get();
+            for (size_t k = 0; k < m_count; ++k)
+            {
+                Level& lv = m_levels[k];
+                lv.rows[0] = ptr;   ptr += lv.srcWidth;
+                lv.rows[1] = ptr;   ptr += lv.srcWidth;
+            }
+            m_out = ptr;    ptr += lastWidth;
+            m_temp = ptr;
 
-        XMVECTOR* target = scanline.get();
+            m_lastRows = lastRows;
+            m_lastIndex = 0;
+            m_filter = filter;
 
-        XMVECTOR* row0 = target + width;
-        XMVECTOR* row1 = target + width * 2;
-        XMVECTOR* row2 = target + width * 3;
-        XMVECTOR* row3 = target + width * 4;
+            return S_OK;
+        }
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
+        // Scanline to fill with the next row of level 'first' before calling Push
+        XMVECTOR* GetInputRow() const noexcept
         {
-            // 2D cubic filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+            const Level& lv = m_levels[0];
+            return lv.rows[lv.pending];
+        }
+
+        HRESULT Push() noexcept
+        {
+            using namespace DirectX::Filters;
+
+            for (size_t k = 0; k < m_count; ++k)
+            {
+                Level& lv = m_levels[k];
+
+                const XMVECTOR* row0 = lv.rows[0];
+                const XMVECTOR* row1 = row0;
+                if (lv.srcHeight > 1)
+                {
+                    if (!lv.pending)
+                    {
+                        lv.pending = 1;
+                        return S_OK;
+                    }
+
+                    lv.pending = 0;
+                    row1 = lv.rows[1];
+                }
+
+                XMVECTOR* out = m_out;
+                if (k + 1 < m_count)
+                {
+                    const Level& next = m_levels[k + 1];
+                    out = next.rows[next.pending];
+                }
+
+                // Same operand order as BoxFilterRows
+                const size_t nwidth = lv.dest->width;
+                const size_t xoff = (lv.srcWidth > 1) ? 1 : 0;
+                for (size_t x = 0; x < nwidth; ++x)
+                {
+                    const size_t x2 = x << 1;
+
+                    AVERAGE4(out[x], row0[x2], row1[x2], row0[x2 + xoff], row1[x2 + xoff])
+                }
+
+                if (lv.y >= lv.dest->height)
+                    return E_UNEXPECTED;
+
+                // Storing converts in place, so keep the float row intact for the next level
+                memcpy(m_temp, out, sizeof(XMVECTOR) * nwidth);
+
+                uint8_t* pDest = lv.dest->pixels + (lv.dest->rowPitch * lv.y);
+                if (!StoreScanlineLinear(pDest, lv.dest->rowPitch, lv.dest->format, m_temp, nwidth, m_filter))
+                    return E_FAIL;
+                ++lv.y;
+
+                if (out == m_out && m_lastRows)
+                {
+                    memcpy(m_lastRows + (nwidth * m_lastIndex), out, sizeof(XMVECTOR) * nwidth);
+                    ++m_lastIndex;
+                }
+            }
 
-            if (!src || !dest)
+            return S_OK;
+        }
+
+    private:
+        struct Level
+        {
+            const Image*    dest;
+            size_t          srcWidth;
+            size_t          srcHeight;
+            size_t          y;
+            XMVECTOR*       rows[2];
+            size_t          pending;
+        };
+
+        size_t                      m_count;
+        std::unique_ptr<Level[]>    m_levels;
+        ScopedAlignedArrayXMVECTOR  m_scanline;
+        XMVECTOR*                   m_out;
+        XMVECTOR*                   m_temp;
+        XMVECTOR*                   m_lastRows;
+        size_t                      m_lastIndex;
+        TEX_FILTER_FLAGS            m_filter;
+    };
+
+    // Source rows per band for the parallel fused pyramid (each band produces one row of level log2 of this)
+    constexpr size_t MIPS_FUSED_BAND_SHIFT = 5;
+
+    HRESULT Generate2DMipsBoxFused(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
+    {
+        const size_t width = mipChain.GetMetadata().width;
+        const size_t height = mipChain.GetMetadata().height;
+        const size_t nitems = mipChain.GetMetadata().arraySize;
+
+        // Pushes rows [y0, y1) of the base image through levels (0, last]
+        auto runBase = [&](size_t item, size_t last, size_t y0, size_t y1, XMVECTOR* lastRows) noexcept -> HRESULT
+        {
+            const Image* src = mipChain.GetImage(0, item, 0);
+            if (!src)
                 return E_POINTER;
 
-            const uint8_t* pSrc = src->pixels;
-            uint8_t* pDest = dest->pixels;
+            BoxPyramid pyramid;
+            HRESULT hr = pyramid.Initialize(mipChain, item, 0, last, y0, filter, lastRows);
+            if (FAILED(hr))
+                return hr;
 
-            const size_t rowPitch = src->rowPitch;
+            for (size_t y = y0; y < y1; ++y)
+            {
+                if (!LoadScanlineLinear(pyramid.GetInputRow(), width, src->pixels + (src->rowPitch * y), src->rowPitch, src->format, filter))
+                    return E_FAIL;
 
-            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            CreateCubicFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, cfX);
+                hr = pyramid.Push();
+                if (FAILED(hr))
+                    return hr;
+            }
 
-            const size_t nheight = (height > 1) ? (height >> 1) : 1;
-            CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
+            return S_OK;
+        };
+
+        const size_t shift = std::min<size_t>(MIPS_FUSED_BAND_SHIFT, levels - 1);
+        if (!executor || height < (size_t(2) << shift))
+        {
+            return RunMipTasks(nitems, executor, [&](size_t item) noexcept
+            {
+                return runBase(item, levels - 1, 0, height, nullptr);
+            });
+        }
 
-        #ifdef _DEBUG
-            memset(row0, 0xCD, sizeof(XMVECTOR)*width);
-            memset(row1, 0xDD, sizeof(XMVECTOR)*width);
-            memset(row2, 0xED, sizeof(XMVECTOR)*width);
-            memset(row3, 0xFD, sizeof(XMVECTOR)*width);
-        #endif
+        // Bands of 2^shift source rows produce the first 'shift' levels independently, collecting the
+        // float rows of level 'shift' so the remaining levels continue from them without requantizing.
+        const size_t bandRows = size_t(1) << shift;
+        const size_t nBands = height >> shift;
+        const size_t lwidth = std::max<size_t>(1, width >> shift);
 
-            size_t u0 = size_t(-1);
-            size_t u1 = size_t(-1);
-            size_t u2 = size_t(-1);
-            size_t u3 = size_t(-1);
+        auto lastRows = make_AlignedArrayXMVECTOR(uint64_t(lwidth) * uint64_t(nBands) * uint64_t(nitems));
+        if (!lastRows)
+            return E_OUTOFMEMORY;
 
-            for (size_t y = 0; y < nheight; ++y)
+        HRESULT hr = RunMipTasks(nitems * nBands, executor, [&](size_t band) noexcept
+        {
+            const size_t item = band / nBands;
+            const size_t y0 = (band % nBands) << shift;
+            return runBase(item, shift, y0, y0 + bandRows, lastRows.get() + (lwidth * band));
+        });
+        if (FAILED(hr) || (shift + 1) >= levels)
+            return hr;
+
+        return RunMipTasks(nitems, executor, [&](size_t item) noexcept -> HRESULT
+        {
+            BoxPyramid pyramid;
+            HRESULT thr = pyramid.Initialize(mipChain, item, shift, levels - 1, 0, filter, nullptr);
+            if (FAILED(thr))
+                return thr;
+
+            const XMVECTOR* rows = lastRows.get() + (lwidth * nBands * item);
+            for (size_t y = 0; y < nBands; ++y, rows += lwidth)
             {
-                const auto& toY = cfY[y];
+                memcpy(pyramid.GetInputRow(), rows, sizeof(XMVECTOR) * lwidth);
 
-                // Scanline 1
-                if (toY.u0 != u0)
-                {
-                    if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
-                    {
-                        u0 = toY.u0;
+                thr = pyramid.Push();
+                if (FAILED(thr))
+                    return thr;
+            }
 
-                        if (!LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-                    else if (toY.u0 == u1)
-                    {
-                        u0 = u1;
-                        u1 = size_t(-1);
+            return S_OK;
+        });
+    }
 
-                        std::swap(row0, row1);
-                    }
-                    else if (toY.u0 == u2)
-                    {
-                        u0 = u2;
-                        u2 = size_t(-1);
+    HRESULT Generate2DMipsBoxFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
+    {
+        if (!mipChain.GetImages())
+            return E_INVALIDARG;
 
-                        std::swap(row0, row2);
-                    }
-                    else if (toY.u0 == u3)
-                    {
-                        u0 = u3;
-                        u3 = size_t(-1);
+        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
 
-                        std::swap(row0, row3);
-                    }
-                }
+        assert(levels > 1);
 
-                // Scanline 2
-                if (toY.u1 != u1)
-                {
-                    if (toY.u1 != u2 && toY.u1 != u3)
-                    {
-                        u1 = toY.u1;
+        if (!ispow2(mipChain.GetMetadata().width) || !ispow2(mipChain.GetMetadata().height))
+            return E_FAIL;
 
-                        if (!LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-                    else if (toY.u1 == u2)
-                    {
-                        u1 = u2;
-                        u2 = size_t(-1);
+        if (filter & TEX_FILTER_FUSED_MIPS)
+            return Generate2DMipsBoxFused(levels, filter, mipChain, executor);
 
-                        std::swap(row1, row2);
-                    }
-                    else if (toY.u1 == u3)
-                    {
-                        u1 = u3;
-                        u3 = size_t(-1);
+        const size_t nitems = mipChain.GetMetadata().arraySize;
 
-                        std::swap(row1, row3);
-                    }
-                }
+        // Resize base image to each target mip level
+        for (size_t level = 1; level < levels; ++level)
+        {
+            const Image* first = mipChain.GetImage(level, 0, 0);
+            if (!first)
+                return E_POINTER;
 
-                // Scanline 3
-                if (toY.u2 != u2)
+            // 2D box filter
+            HRESULT hr = ProcessMipLevel(nitems, first->width, first->height, executor,
+                [&](size_t item, size_t y0, size_t y1) noexcept -> HRESULT
                 {
-                    if (toY.u2 != u3)
-                    {
-                        u2 = toY.u2;
+                    const Image* src = mipChain.GetImage(level - 1, item, 0);
+                    const Image* dest = mipChain.GetImage(level, item, 0);
 
-                        if (!LoadScanlineLinear(row2, width, pSrc + (rowPitch * u2), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-                    else
-                    {
-                        u2 = u3;
-                        u3 = size_t(-1);
+                    if (!src || !dest)
+                        return E_POINTER;
 
-                        std::swap(row2, row3);
-                    }
-                }
+                    // Allocate temporary space (3 scanlines)
+                    auto scanline = make_AlignedArrayXMVECTOR(uint64_t(src->width) * 3);
+                    if (!scanline)
+                        return E_OUTOFMEMORY;
+
+                    return BoxFilterRows(*src, *dest, y0, y1, filter, scanline.get());
+                });
+            if (FAILED(hr))
+                return hr;
+        }
+
+        return S_OK;
+    }
+
+
+    //--- 2D Linear Filter ---
+    HRESULT LinearFilterRows(
+        const Image& src,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        _In_reads_(dest.width) const Filters::LinearFilter* lfX,
+        _In_reads_(dest.height) const Filters::LinearFilter* lfY,
+        _Out_writes_(src.width * 3) XMVECTOR* scanline) noexcept
+    {
+        using namespace DirectX::Filters;
+
+        const size_t width = src.width;
+        const size_t nwidth = dest.width;
+
+        XMVECTOR* target = scanline;
+
+        XMVECTOR* row0 = target + width;
+        XMVECTOR* row1 = target + width * 2;
+
+    #ifdef _DEBUG
+        memset(row0, 0xCD, sizeof(XMVECTOR)*width);
+        memset(row1, 0xDD, sizeof(XMVECTOR)*width);
+    #endif
+
+        const uint8_t* pSrc = src.pixels;
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
+
+        const size_t rowPitch = src.rowPitch;
 
-                // Scanline 4
-                if (toY.u3 != u3)
+        size_t u0 = size_t(-1);
+        size_t u1 = size_t(-1);
+
+        for (size_t y = y0; y < y1; ++y)
+        {
+            const auto& toY = lfY[y];
+
+            if (toY.u0 != u0)
+            {
+                if (toY.u0 != u1)
                 {
-                    u3 = toY.u3;
+                    u0 = toY.u0;
 
-                    if (!LoadScanlineLinear(row3, width, pSrc + (rowPitch * u3), rowPitch, src->format, filter))
+                    if (!LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src.format, filter))
                         return E_FAIL;
                 }
-
-                for (size_t x = 0; x < nwidth; ++x)
+                else
                 {
-                    const auto& toX = cfX[x];
+                    u0 = u1;
+                    u1 = size_t(-1);
 
-                    XMVECTOR C0, C1, C2, C3;
-
-                    CUBIC_INTERPOLATE(C0, toX.x, row0[toX.u0], row0[toX.u1], row0[toX.u2], row0[toX.u3]);
-                    CUBIC_INTERPOLATE(C1, toX.x, row1[toX.u0], row1[toX.u1], row1[toX.u2], row1[toX.u3]);
-                    CUBIC_INTERPOLATE(C2, toX.x, row2[toX.u0], row2[toX.u1], row2[toX.u2], row2[toX.u3]);
-                    CUBIC_INTERPOLATE(C3, toX.x, row3[toX.u0], row3[toX.u1], row3[toX.u2], row3[toX.u3]);
-
-                    CUBIC_INTERPOLATE(target[x], toY.x, C0, C1, C2, C3);
+                    std::swap(row0, row1);
                 }
+            }
 
-                if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
+            if (toY.u1 != u1)
+            {
+                u1 = toY.u1;
+
+                if (!LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src.format, filter))
                     return E_FAIL;
-                pDest += dest->rowPitch;
             }
 
-            if (height > 1)
-                height >>= 1;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                const auto& toX = lfX[x];
 
-            if (width > 1)
-                width >>= 1;
+                BILINEAR_INTERPOLATE(target[x], toX, toY, row0, row1)
+            }
+
+            if (!StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
         }
 
         return S_OK;
     }
 
-
-    //--- 2D Triangle Filter ---
-    HRESULT Generate2DMipsTriangleFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    HRESULT Generate2DMipsLinearFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
     {
         using namespace DirectX::Filters;
 
@@ -1402,200 +1770,261 @@ namespace
 
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
+        const size_t nitems = mipChain.GetMetadata().arraySize;
 
-        // Allocate initial temporary space (1 scanline, accumulation rows, plus X and Y filters)
-        auto scanline = make_AlignedArrayXMVECTOR(width);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
-        std::unique_ptr<TriangleRow[]> rowActive(new (std::nothrow) TriangleRow[height]);
-        if (!rowActive)
+        // Allocate X and Y filters (shared by all items of a level)
+        std::unique_ptr<LinearFilter[]> lf(new (std::nothrow) LinearFilter[width + height]);
+        if (!lf)
             return E_OUTOFMEMORY;
 
-        TriangleRow * rowFree = nullptr;
-
-        std::unique_ptr<Filter> tfX, tfY;
-
-        XMVECTOR* row = scanline.get();
+        LinearFilter* lfX = lf.get();
+        LinearFilter* lfY = lf.get() + width;
 
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
-            // 2D triangle filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
+            CreateLinearFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, lfX);
 
-            if (!src || !dest)
-                return E_POINTER;
+            const size_t nheight = (height > 1) ? (height >> 1) : 1;
+            CreateLinearFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, lfY);
 
-            const uint8_t* pSrc = src->pixels;
-            const size_t rowPitch = src->rowPitch;
-            const uint8_t* pEndSrc = pSrc + rowPitch * height;
+            // 2D linear filter
+            HRESULT hr = ProcessMipLevel(nitems, nwidth, nheight, executor,
+                [&](size_t item, size_t y0, size_t y1) noexcept -> HRESULT
+                {
+                    const Image* src = mipChain.GetImage(level - 1, item, 0);
+                    const Image* dest = mipChain.GetImage(level, item, 0);
 
-            uint8_t* pDest = dest->pixels;
+                    if (!src || !dest)
+                        return E_POINTER;
 
-            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            HRESULT hr = CreateTriangleFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, tfX);
-            if (FAILED(hr))
-                return hr;
+                    assert(src->width == width && dest->width == nwidth && dest->height == nheight);
 
-            const size_t nheight = (height > 1) ? (height >> 1) : 1;
-            hr = CreateTriangleFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, tfY);
+                    // Allocate temporary space (3 scanlines)
+                    auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 3);
+                    if (!scanline)
+                        return E_OUTOFMEMORY;
+
+                    return LinearFilterRows(*src, *dest, y0, y1, filter, lfX, lfY, scanline.get());
+                });
             if (FAILED(hr))
                 return hr;
 
-        #ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-        #endif
+            height = nheight;
+            width = nwidth;
+        }
+
+        return S_OK;
+    }
+
+    //--- 2D Cubic Filter ---
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wextra-semi-stmt"
+#endif
+
+    HRESULT CubicFilterRows(
+        const Image& src,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        _In_reads_(dest.width) const Filters::CubicFilter* cfX,
+        _In_reads_(dest.height) const Filters::CubicFilter* cfY,
+        _Out_writes_(src.width + dest.width) XMVECTOR* scanline) noexcept
+    {
+        using namespace DirectX::Filters;
+
+        const size_t width = src.width;
+        const size_t nwidth = dest.width;
+
+        FilterRowCache rows;
+        HRESULT hr = rows.Initialize(4, nwidth);
+        if (FAILED(hr))
+            return hr;
 
-            auto xFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfX.get()) + tfX->sizeInBytes);
-            auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY.get()) + tfY->sizeInBytes);
+        XMVECTOR* target = scanline;
+        XMVECTOR* row = target + nwidth;
+
+    #ifdef _DEBUG
+        memset(row, 0xCD, sizeof(XMVECTOR)*width);
+    #endif
 
-            // Count times rows get written (and clear out any leftover accumulation rows from last miplevel)
-            for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+        const uint8_t* pSrc = src.pixels;
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
+
+        const size_t rowPitch = src.rowPitch;
+
+        // Each source row is filtered horizontally once, however many destination rows use it
+        auto getRow = [&](size_t v) noexcept -> const XMVECTOR*
+        {
+            bool load;
+            XMVECTOR* hrow = rows.Get(v, load);
+            if (load)
             {
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    const size_t v = yFrom->to[j].u;
-                    assert(v < nheight);
-                    TriangleRow* rowAcc = &rowActive[v];
+                if (!LoadScanlineLinear(row, width, pSrc + (rowPitch * v), rowPitch, src.format, filter))
+                    return nullptr;
 
-                    ++rowAcc->remaining;
+                for (size_t x = 0; x < nwidth; ++x)
+                {
+                    const auto& toX = cfX[x];
 
-                    if (rowAcc->scanline)
-                    {
-                        memset(rowAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth);
-                    }
+                    CUBIC_INTERPOLATE(hrow[x], toX.x, row[toX.u0], row[toX.u1], row[toX.u2], row[toX.u3]);
                 }
-
-                yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
             }
+            return hrow;
+        };
+
+        for (size_t y = y0; y < y1; ++y)
+        {
+            const auto& toY = cfY[y];
+
+            const XMVECTOR* row0 = getRow(toY.u0);
+            const XMVECTOR* row1 = getRow(toY.u1);
+            const XMVECTOR* row2 = getRow(toY.u2);
+            const XMVECTOR* row3 = getRow(toY.u3);
+            if (!row0 || !row1 || !row2 || !row3)
+                return E_FAIL;
 
-            // Filter image
-            for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+            for (size_t x = 0; x < nwidth; ++x)
             {
-                // Create accumulation rows as needed
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    const size_t v = yFrom->to[j].u;
-                    assert(v < nheight);
-                    TriangleRow* rowAcc = &rowActive[v];
+                CUBIC_INTERPOLATE(target[x], toY.x, row0[x], row1[x], row2[x], row3[x]);
+            }
 
-                    if (!rowAcc->scanline)
-                    {
-                        if (rowFree)
-                        {
-                            // Steal and reuse scanline from 'free row' list
-                            // (it will always be at least as wide as nwidth due to loop decending order)
-                            assert(rowFree->scanline != nullptr);
-                            rowAcc->scanline.reset(rowFree->scanline.release());
-                            rowFree = rowFree->next;
-                        }
-                        else
-                        {
-                            auto nscanline = make_AlignedArrayXMVECTOR(nwidth);
-                            if (!nscanline)
-                                return E_OUTOFMEMORY;
-                            rowAcc->scanline.swap(nscanline);
-                        }
+            if (!StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
+        }
 
-                        memset(rowAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth);
-                    }
-                }
+        return S_OK;
+    }
 
-                // Load source scanline
-                if ((pSrc + rowPitch) > pEndSrc)
-                    return E_FAIL;
+    HRESULT Generate2DMipsCubicFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
+    {
+        using namespace DirectX::Filters;
 
-                if (!LoadScanlineLinear(row, width, pSrc, rowPitch, src->format, filter))
-                    return E_FAIL;
+        if (!mipChain.GetImages())
+            return E_INVALIDARG;
 
-                pSrc += rowPitch;
+        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
 
-                // Process row
-                size_t x = 0;
-                for (FilterFrom* xFrom = tfX->from; xFrom < xFromEnd; ++x)
-                {
-                    for (size_t j = 0; j < yFrom->count; ++j)
-                    {
-                        const size_t v = yFrom->to[j].u;
-                        assert(v < nheight);
-                        const float yweight = yFrom->to[j].weight;
+        assert(levels > 1);
 
-                        XMVECTOR* accPtr = rowActive[v].scanline.get();
-                        if (!accPtr)
-                            return E_POINTER;
+        size_t width = mipChain.GetMetadata().width;
+        size_t height = mipChain.GetMetadata().height;
+        const size_t nitems = mipChain.GetMetadata().arraySize;
 
-                        for (size_t k = 0; k < xFrom->count; ++k)
-                        {
-                            size_t u = xFrom->to[k].u;
-                            assert(u < nwidth);
+        // Allocate X and Y filters (shared by all items of a level)
+        std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[width + height]);
+        if (!cf)
+            return E_OUTOFMEMORY;
 
-                            const XMVECTOR weight = XMVectorReplicate(yweight * xFrom->to[k].weight);
+        CubicFilter* cfX = cf.get();
+        CubicFilter* cfY = cf.get() + width;
 
-                            assert(x < width);
-                            accPtr[u] = XMVectorMultiplyAdd(row[x], weight, accPtr[u]);
-                        }
-                    }
+        // Resize base image to each target mip level
+        for (size_t level = 1; level < levels; ++level)
+        {
+            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
+            CreateCubicFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, cfX);
 
-                    xFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(xFrom) + xFrom->sizeInBytes);
-                }
+            const size_t nheight = (height > 1) ? (height >> 1) : 1;
+            CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
 
-                // Write completed accumulation rows
-                for (size_t j = 0; j < yFrom->count; ++j)
+            // 2D cubic filter
+            HRESULT hr = ProcessMipLevel(nitems, nwidth, nheight, executor,
+                [&](size_t item, size_t y0, size_t y1) noexcept -> HRESULT
                 {
-                    size_t v = yFrom->to[j].u;
-                    assert(v < nheight);
-                    TriangleRow* rowAcc = &rowActive[v];
+                    const Image* src = mipChain.GetImage(level - 1, item, 0);
+                    const Image* dest = mipChain.GetImage(level, item, 0);
 
-                    assert(rowAcc->remaining > 0);
-                    --rowAcc->remaining;
+                    if (!src || !dest)
+                        return E_POINTER;
 
-                    if (!rowAcc->remaining)
-                    {
-                        XMVECTOR* pAccSrc = rowAcc->scanline.get();
-                        if (!pAccSrc)
-                            return E_POINTER;
+                    assert(src->width == width && dest->width == nwidth && dest->height == nheight);
 
-                        switch (dest->format)
-                        {
-                        case DXGI_FORMAT_R10G10B10A2_UNORM:
-                        case DXGI_FORMAT_R10G10B10A2_UINT:
-                            {
-                                // Need to slightly bias results for floating-point error accumulation which can
-                                // be visible with harshly quantized values
-                                static const XMVECTORF32 Bias = { { { 0.f, 0.f, 0.f, 0.1f } } };
+                    // Allocate temporary space (1 source scanline and 1 target scanline, horizontally filtered rows are cached)
+                    auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) + nwidth);
+                    if (!scanline)
+                        return E_OUTOFMEMORY;
 
-                                XMVECTOR* ptr = pAccSrc;
-                                for (size_t i = 0; i < dest->width; ++i, ++ptr)
-                                {
-                                    *ptr = XMVectorAdd(*ptr, Bias);
-                                }
-                            }
-                            break;
+                    return CubicFilterRows(*src, *dest, y0, y1, filter, cfX, cfY, scanline.get());
+                });
+            if (FAILED(hr))
+                return hr;
 
-                        default:
-                            break;
-                        }
+            height = nheight;
+            width = nwidth;
+        }
 
-                        // This performs any required clamping
-                        if (!StoreScanlineLinear(pDest + (dest->rowPitch * v), dest->rowPitch, dest->format, pAccSrc, dest->width, filter))
-                            return E_FAIL;
+        return S_OK;
+    }
 
-                        // Put row on freelist to reuse it's allocated scanline
-                        rowAcc->next = rowFree;
-                        rowFree = rowAcc;
-                    }
-                }
 
-                yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
-            }
+    //--- 2D Separable Kernel Filter (Triangle, Lanczos, Kaiser, Mitchell) ---
+    HRESULT Generate2DMipsKernelFilter(
+        size_t levels,
+        Filters::FILTER_KERNEL_TYPE type,
+        TEX_FILTER_FLAGS filter,
+        const ScratchImage& mipChain,
+        _In_opt_ ITaskExecutor* executor) noexcept
+    {
+        using namespace DirectX::Filters;
 
-            if (height > 1)
-                height >>= 1;
+        if (!mipChain.GetImages())
+            return E_INVALIDARG;
 
-            if (width > 1)
-                width >>= 1;
+        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+
+        assert(levels > 1);
+
+        size_t width = mipChain.GetMetadata().width;
+        size_t height = mipChain.GetMetadata().height;
+        const size_t nitems = mipChain.GetMetadata().arraySize;
+
+        // Resize base image to each target mip level
+        for (size_t level = 1; level < levels; ++level)
+        {
+            FilterKernel localX, localY;
+
+            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
+            const FilterKernel* kernelX = nullptr;
+            HRESULT hr = GetFilterKernel(type, width, nwidth,
+                (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, localX, &kernelX);
+            if (FAILED(hr))
+                return hr;
+
+            const size_t nheight = (height > 1) ? (height >> 1) : 1;
+            const FilterKernel* kernelY = nullptr;
+            hr = GetFilterKernel(type, height, nheight,
+                (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, localY, &kernelY);
+            if (FAILED(hr))
+                return hr;
+
+            // 2D separable kernel filter
+            hr = ProcessMipLevel(nitems, nwidth, nheight, executor,
+                [&](size_t item, size_t y0, size_t y1) noexcept -> HRESULT
+                {
+                    const Image* src = mipChain.GetImage(level - 1, item, 0);
+                    const Image* dest = mipChain.GetImage(level, item, 0);
+
+                    if (!src || !dest)
+                        return E_POINTER;
+
+                    assert(src->width == width && dest->width == nwidth && dest->height == nheight);
+
+                    // Allocate temporary space (1 source scanline and 1 target scanline, horizontally filtered rows are cached)
+                    auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) + nwidth);
+                    if (!scanline)
+                        return E_OUTOFMEMORY;
+
+                    return FilterKernelRows(*src, filter, *dest, *kernelX, *kernelY, y0, y1, FILTER_MAX_ROW_CACHE_BYTES, scanline.get());
+                });
+            if (FAILED(hr))
+                return hr;
+
+            height = nheight;
+            width = nwidth;
         }
 
         return S_OK;
@@ -1622,7 +2051,7 @@ namespace
         const size_t width = baseImages[0].width;
         const size_t height = baseImages[0].height;
 
-        HRESULT hr = mipChain.Initialize3D(baseImages[0].format, width, height, depth, levels);
+        HRESULT hr = mipChain.Initialize3D(baseImages[0].format, width, height, depth, levels, CP_FLAGS_REUSE_MEMORY);
         if (FAILED(hr))
             return hr;
 
@@ -1663,7 +2092,7 @@ namespace
 
 
     //--- 3D Point Filter ---
-    HRESULT Generate3DMipsPointFilter(size_t depth, size_t levels, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsPointFilter(size_t depth, size_t levels, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
     {
         if (!depth || !mipChain.GetImages())
             return E_INVALIDARG;
@@ -1675,147 +2104,142 @@ namespace
 
         assert(levels > 1);
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
-
-        // Allocate temporary space (2 scanlines)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 2);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
-        XMVECTOR* target = scanline.get();
-
-        XMVECTOR* row = target + width;
-
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
-        #ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-        #endif
-
-            if (depth > 1)
-            {
-                // 3D point filter
-                const size_t ndepth = depth >> 1;
+            const Image* first = mipChain.GetImage(level, 0, 0);
+            if (!first)
+                return E_POINTER;
 
-                const size_t zinc = (depth << 16) / ndepth;
+            // 3D point filter (or 2D once the depth reaches 1)
+            const size_t ndepth = (depth > 1) ? (depth >> 1) : 1;
+            const size_t zinc = (depth << 16) / ndepth;
 
-                size_t sz = 0;
-                for (size_t slice = 0; slice < ndepth; ++slice)
+            HRESULT hr = ProcessMipLevel(ndepth, first->width, first->height, executor,
+                [&](size_t slice, size_t y0, size_t y1) noexcept -> HRESULT
                 {
-                    const Image* src = mipChain.GetImage(level - 1, 0, (sz >> 16));
+                    const Image* src = mipChain.GetImage(level - 1, 0, (depth > 1) ? ((slice * zinc) >> 16) : 0);
                     const Image* dest = mipChain.GetImage(level, 0, slice);
 
                     if (!src || !dest)
                         return E_POINTER;
 
-                    const uint8_t* pSrc = src->pixels;
-                    uint8_t* pDest = dest->pixels;
+                    // Allocate temporary space (2 scanlines)
+                    auto scanline = make_AlignedArrayXMVECTOR(uint64_t(src->width) * 2);
+                    if (!scanline)
+                        return E_OUTOFMEMORY;
 
-                    const size_t rowPitch = src->rowPitch;
+                    return PointFilterRows(*src, *dest, y0, y1, scanline.get());
+                });
+            if (FAILED(hr))
+                return hr;
 
-                    const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                    const size_t nheight = (height > 1) ? (height >> 1) : 1;
+            depth = ndepth;
+        }
 
-                    const size_t xinc = (width << 16) / nwidth;
-                    const size_t yinc = (height << 16) / nheight;
+        return S_OK;
+    }
 
-                    size_t lasty = size_t(-1);
 
-                    size_t sy = 0;
-                    for (size_t y = 0; y < nheight; ++y)
-                    {
-                        if ((lasty ^ sy) >> 16)
-                        {
-                            if (!LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
-                                return E_FAIL;
-                            lasty = sy;
-                        }
+    //--- 3D Box Filter ---
+    HRESULT BoxFilterRows3D(
+        const Image& srca,
+        const Image& srcb,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        _Out_writes_(srca.width * 5) XMVECTOR* scanline) noexcept
+    {
+        using namespace DirectX::Filters;
 
-                        size_t sx = 0;
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            target[x] = row[sx >> 16];
-                            sx += xinc;
-                        }
+        BoxNativeKernel kernel;
+        if (srca.format == dest.format && srcb.format == dest.format && GetBoxNativeKernel(dest.format, filter, kernel))
+        {
+            kernel.rows3D(srca, srcb, dest, y0, y1);
+            return S_OK;
+        }
 
-                        if (!StoreScanline(pDest, dest->rowPitch, dest->format, target, nwidth))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
+        const size_t width = srca.width;
+        const size_t nwidth = dest.width;
 
-                        sy += yinc;
-                    }
+        XMVECTOR* target = scanline;
 
-                    sz += zinc;
-                }
-            }
-            else
-            {
-                // 2D point filter
-                const Image* src = mipChain.GetImage(level - 1, 0, 0);
-                const Image* dest = mipChain.GetImage(level, 0, 0);
+        XMVECTOR* urow0 = target + width;
+        XMVECTOR* urow1 = target + width * 2;
+        XMVECTOR* vrow0 = target + width * 3;
+        XMVECTOR* vrow1 = target + width * 4;
 
-                if (!src || !dest)
-                    return E_POINTER;
+        if (srca.height <= 1)
+        {
+            urow1 = urow0;
+            vrow1 = vrow0;
+        }
 
-                const uint8_t* pSrc = src->pixels;
-                uint8_t* pDest = dest->pixels;
+        const XMVECTOR* urow2 = urow0 + 1;
+        const XMVECTOR* urow3 = urow1 + 1;
+        const XMVECTOR* vrow2 = vrow0 + 1;
+        const XMVECTOR* vrow3 = vrow1 + 1;
 
-                const size_t rowPitch = src->rowPitch;
+        if (width <= 1)
+        {
+            urow2 = urow0;
+            urow3 = urow1;
+            vrow2 = vrow0;
+            vrow3 = vrow1;
+        }
 
-                const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                const size_t nheight = (height > 1) ? (height >> 1) : 1;
+        const size_t aRowPitch = srca.rowPitch;
+        const size_t bRowPitch = srcb.rowPitch;
 
-                const size_t xinc = (width << 16) / nwidth;
-                const size_t yinc = (height << 16) / nheight;
+        const size_t sy = (urow0 != urow1) ? (y0 * 2) : y0;
 
-                size_t lasty = size_t(-1);
+        const uint8_t* pSrc1 = srca.pixels + (aRowPitch * sy);
+        const uint8_t* pSrc2 = srcb.pixels + (bRowPitch * sy);
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
 
-                size_t sy = 0;
-                for (size_t y = 0; y < nheight; ++y)
-                {
-                    if ((lasty ^ sy) >> 16)
-                    {
-                        if (!LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
-                            return E_FAIL;
-                        lasty = sy;
-                    }
+        for (size_t y = y0; y < y1; ++y)
+        {
+            if (!LoadScanlineLinear(urow0, width, pSrc1, aRowPitch, srca.format, filter))
+                return E_FAIL;
+            pSrc1 += aRowPitch;
 
-                    size_t sx = 0;
-                    for (size_t x = 0; x < nwidth; ++x)
-                    {
-                        target[x] = row[sx >> 16];
-                        sx += xinc;
-                    }
+            if (urow0 != urow1)
+            {
+                if (!LoadScanlineLinear(urow1, width, pSrc1, aRowPitch, srca.format, filter))
+                    return E_FAIL;
+                pSrc1 += aRowPitch;
+            }
 
-                    if (!StoreScanline(pDest, dest->rowPitch, dest->format, target, nwidth))
-                        return E_FAIL;
-                    pDest += dest->rowPitch;
+            if (!LoadScanlineLinear(vrow0, width, pSrc2, bRowPitch, srcb.format, filter))
+                return E_FAIL;
+            pSrc2 += bRowPitch;
 
-                    sy += yinc;
-                }
+            if (vrow0 != vrow1)
+            {
+                if (!LoadScanlineLinear(vrow1, width, pSrc2, bRowPitch, srcb.format, filter))
+                    return E_FAIL;
+                pSrc2 += bRowPitch;
             }
 
-            if (height > 1)
-                height >>= 1;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                const size_t x2 = x << 1;
 
-            if (width > 1)
-                width >>= 1;
+                AVERAGE8(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2],
+                    vrow0[x2], vrow1[x2], vrow2[x2], vrow3[x2])
+            }
 
-            if (depth > 1)
-                depth >>= 1;
+            if (!StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
         }
 
         return S_OK;
     }
 
-
-    //--- 3D Box Filter ---
-    HRESULT Generate3DMipsBoxFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsBoxFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
     {
-        using namespace DirectX::Filters;
-
         if (!depth || !mipChain.GetImages())
             return E_INVALIDARG;
 
@@ -1826,170 +2250,159 @@ namespace
 
         assert(levels > 1);
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
-
-        if (!ispow2(width) || !ispow2(height) || !ispow2(depth))
+        if (!ispow2(mipChain.GetMetadata().width) || !ispow2(mipChain.GetMetadata().height) || !ispow2(depth))
             return E_FAIL;
 
-        // Allocate temporary space (5 scanlines)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 5);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
-        XMVECTOR* target = scanline.get();
-
-        XMVECTOR* urow0 = target + width;
-        XMVECTOR* urow1 = target + width * 2;
-        XMVECTOR* vrow0 = target + width * 3;
-        XMVECTOR* vrow1 = target + width * 4;
-
-        const XMVECTOR* urow2 = urow0 + 1;
-        const XMVECTOR* urow3 = urow1 + 1;
-        const XMVECTOR* vrow2 = vrow0 + 1;
-        const XMVECTOR* vrow3 = vrow1 + 1;
-
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
-            if (height <= 1)
-            {
-                urow1 = urow0;
-                vrow1 = vrow0;
-            }
-
-            if (width <= 1)
-            {
-                urow2 = urow0;
-                urow3 = urow1;
-                vrow2 = vrow0;
-                vrow3 = vrow1;
-            }
+            const Image* first = mipChain.GetImage(level, 0, 0);
+            if (!first)
+                return E_POINTER;
 
+            HRESULT hr;
             if (depth > 1)
             {
                 // 3D box filter
                 const size_t ndepth = depth >> 1;
 
-                for (size_t slice = 0; slice < ndepth; ++slice)
-                {
-                    const size_t slicea = std::min<size_t>(slice * 2, depth - 1);
-                    const size_t sliceb = std::min<size_t>(slicea + 1, depth - 1);
-
-                    const Image* srca = mipChain.GetImage(level - 1, 0, slicea);
-                    const Image* srcb = mipChain.GetImage(level - 1, 0, sliceb);
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
+                hr = ProcessMipLevel(ndepth, first->width, first->height, executor,
+                    [&](size_t slice, size_t y0, size_t y1) noexcept -> HRESULT
+                    {
+                        const size_t slicea = std::min<size_t>(slice * 2, depth - 1);
+                        const size_t sliceb = std::min<size_t>(slicea + 1, depth - 1);
 
-                    if (!srca || !srcb || !dest)
-                        return E_POINTER;
+                        const Image* srca = mipChain.GetImage(level - 1, 0, slicea);
+                        const Image* srcb = mipChain.GetImage(level - 1, 0, sliceb);
+                        const Image* dest = mipChain.GetImage(level, 0, slice);
 
-                    const uint8_t* pSrc1 = srca->pixels;
-                    const uint8_t* pSrc2 = srcb->pixels;
-                    uint8_t* pDest = dest->pixels;
+                        if (!srca || !srcb || !dest)
+                            return E_POINTER;
 
-                    const size_t aRowPitch = srca->rowPitch;
-                    const size_t bRowPitch = srcb->rowPitch;
+                        // Allocate temporary space (5 scanlines)
+                        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(srca->width) * 5);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
 
-                    const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                    const size_t nheight = (height > 1) ? (height >> 1) : 1;
+                        return BoxFilterRows3D(*srca, *srcb, *dest, y0, y1, filter, scanline.get());
+                    });
 
-                    for (size_t y = 0; y < nheight; ++y)
+                depth = ndepth;
+            }
+            else
+            {
+                // 2D box filter
+                hr = ProcessMipLevel(1, first->width, first->height, executor,
+                    [&](size_t, size_t y0, size_t y1) noexcept -> HRESULT
                     {
-                        if (!LoadScanlineLinear(urow0, width, pSrc1, aRowPitch, srca->format, filter))
-                            return E_FAIL;
-                        pSrc1 += aRowPitch;
+                        const Image* src = mipChain.GetImage(level - 1, 0, 0);
+                        const Image* dest = mipChain.GetImage(level, 0, 0);
 
-                        if (urow0 != urow1)
-                        {
-                            if (!LoadScanlineLinear(urow1, width, pSrc1, aRowPitch, srca->format, filter))
-                                return E_FAIL;
-                            pSrc1 += aRowPitch;
-                        }
+                        if (!src || !dest)
+                            return E_POINTER;
 
-                        if (!LoadScanlineLinear(vrow0, width, pSrc2, bRowPitch, srcb->format, filter))
-                            return E_FAIL;
-                        pSrc2 += bRowPitch;
+                        // Allocate temporary space (3 scanlines)
+                        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(src->width) * 3);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
 
-                        if (vrow0 != vrow1)
-                        {
-                            if (!LoadScanlineLinear(vrow1, width, pSrc2, bRowPitch, srcb->format, filter))
-                                return E_FAIL;
-                            pSrc2 += bRowPitch;
-                        }
+                        return BoxFilterRows(*src, *dest, y0, y1, filter, scanline.get());
+                    });
+            }
+            if (FAILED(hr))
+                return hr;
+        }
 
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            const size_t x2 = x << 1;
+        return S_OK;
+    }
 
-                            AVERAGE8(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2],
-                                vrow0[x2], vrow1[x2], vrow2[x2], vrow3[x2])
-                        }
 
-                        if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
-                    }
-                }
-            }
-            else
-            {
-                // 2D box filter
-                const Image* src = mipChain.GetImage(level - 1, 0, 0);
-                const Image* dest = mipChain.GetImage(level, 0, 0);
+    //--- 3D Linear Filter ---
+    HRESULT LinearFilterRows3D(
+        const Image& srca,
+        const Image& srcb,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        _In_reads_(dest.width) const Filters::LinearFilter* lfX,
+        _In_reads_(dest.height) const Filters::LinearFilter* lfY,
+        const Filters::LinearFilter& toZ,
+        _Out_writes_(srca.width * 5) XMVECTOR* scanline) noexcept
+    {
+        using namespace DirectX::Filters;
+
+        const size_t width = srca.width;
+        const size_t nwidth = dest.width;
+
+        XMVECTOR* target = scanline;
+
+        XMVECTOR* urow0 = target + width;
+        XMVECTOR* urow1 = target + width * 2;
+        XMVECTOR* vrow0 = target + width * 3;
+        XMVECTOR* vrow1 = target + width * 4;
 
-                if (!src || !dest)
-                    return E_POINTER;
+    #ifdef _DEBUG
+        memset(urow0, 0xCD, sizeof(XMVECTOR)*width);
+        memset(urow1, 0xDD, sizeof(XMVECTOR)*width);
+        memset(vrow0, 0xED, sizeof(XMVECTOR)*width);
+        memset(vrow1, 0xFD, sizeof(XMVECTOR)*width);
+    #endif
 
-                const uint8_t* pSrc = src->pixels;
-                uint8_t* pDest = dest->pixels;
+        size_t u0 = size_t(-1);
+        size_t u1 = size_t(-1);
 
-                const size_t rowPitch = src->rowPitch;
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
 
-                const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                const size_t nheight = (height > 1) ? (height >> 1) : 1;
+        for (size_t y = y0; y < y1; ++y)
+        {
+            const auto& toY = lfY[y];
 
-                for (size_t y = 0; y < nheight; ++y)
+            if (toY.u0 != u0)
+            {
+                if (toY.u0 != u1)
                 {
-                    if (!LoadScanlineLinear(urow0, width, pSrc, rowPitch, src->format, filter))
-                        return E_FAIL;
-                    pSrc += rowPitch;
+                    u0 = toY.u0;
 
-                    if (urow0 != urow1)
-                    {
-                        if (!LoadScanlineLinear(urow1, width, pSrc, rowPitch, src->format, filter))
-                            return E_FAIL;
-                        pSrc += rowPitch;
-                    }
+                    if (!LoadScanlineLinear(urow0, width, srca.pixels + (srca.rowPitch * u0), srca.rowPitch, srca.format, filter)
+                        || !LoadScanlineLinear(vrow0, width, srcb.pixels + (srcb.rowPitch * u0), srcb.rowPitch, srcb.format, filter))
+                        return E_FAIL;
+                }
+                else
+                {
+                    u0 = u1;
+                    u1 = size_t(-1);
 
-                    for (size_t x = 0; x < nwidth; ++x)
-                    {
-                        const size_t x2 = x << 1;
+                    std::swap(urow0, urow1);
+                    std::swap(vrow0, vrow1);
+                }
+            }
 
-                        AVERAGE4(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2])
-                    }
+            if (toY.u1 != u1)
+            {
+                u1 = toY.u1;
 
-                    if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                        return E_FAIL;
-                    pDest += dest->rowPitch;
-                }
+                if (!LoadScanlineLinear(urow1, width, srca.pixels + (srca.rowPitch * u1), srca.rowPitch, srca.format, filter)
+                    || !LoadScanlineLinear(vrow1, width, srcb.pixels + (srcb.rowPitch * u1), srcb.rowPitch, srcb.format, filter))
+                    return E_FAIL;
             }
 
-            if (height > 1)
-                height >>= 1;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                const auto& toX = lfX[x];
 
-            if (width > 1)
-                width >>= 1;
+                TRILINEAR_INTERPOLATE(target[x], toX, toY, toZ, urow0, urow1, vrow0, vrow1)
+            }
 
-            if (depth > 1)
-                depth >>= 1;
+            if (!StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
         }
 
         return S_OK;
     }
 
-
-    //--- 3D Linear Filter ---
-    HRESULT Generate3DMipsLinearFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsLinearFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
     {
         using namespace DirectX::Filters;
 
@@ -2006,11 +2419,7 @@ namespace
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
 
-        // Allocate temporary space (5 scanlines, plus X/Y/Z filters)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 5);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
+        // Allocate X/Y/Z filters (shared by all slices of a level)
         std::unique_ptr<LinearFilter[]> lf(new (std::nothrow) LinearFilter[width + height + depth]);
         if (!lf)
             return E_OUTOFMEMORY;
@@ -2019,13 +2428,6 @@ namespace
         LinearFilter* lfY = lf.get() + width;
         LinearFilter* lfZ = lf.get() + width + height;
 
-        XMVECTOR* target = scanline.get();
-
-        XMVECTOR* urow0 = target + width;
-        XMVECTOR* urow1 = target + width * 2;
-        XMVECTOR* vrow0 = target + width * 3;
-        XMVECTOR* vrow1 = target + width * 4;
-
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
@@ -2035,151 +2437,60 @@ namespace
             const size_t nheight = (height > 1) ? (height >> 1) : 1;
             CreateLinearFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, lfY);
 
-        #ifdef _DEBUG
-            memset(urow0, 0xCD, sizeof(XMVECTOR)*width);
-            memset(urow1, 0xDD, sizeof(XMVECTOR)*width);
-            memset(vrow0, 0xED, sizeof(XMVECTOR)*width);
-            memset(vrow1, 0xFD, sizeof(XMVECTOR)*width);
-        #endif
-
+            HRESULT hr;
             if (depth > 1)
             {
                 // 3D linear filter
                 const size_t ndepth = depth >> 1;
                 CreateLinearFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, lfZ);
 
-                for (size_t slice = 0; slice < ndepth; ++slice)
-                {
-                    const auto& toZ = lfZ[slice];
-
-                    const Image* srca = mipChain.GetImage(level - 1, 0, toZ.u0);
-                    const Image* srcb = mipChain.GetImage(level - 1, 0, toZ.u1);
-                    if (!srca || !srcb)
-                        return E_POINTER;
-
-                    size_t u0 = size_t(-1);
-                    size_t u1 = size_t(-1);
-
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
-                    if (!dest)
-                        return E_POINTER;
-
-                    uint8_t* pDest = dest->pixels;
-
-                    for (size_t y = 0; y < nheight; ++y)
+                hr = ProcessMipLevel(ndepth, nwidth, nheight, executor,
+                    [&](size_t slice, size_t y0, size_t y1) noexcept -> HRESULT
                     {
-                        const auto& toY = lfY[y];
-
-                        if (toY.u0 != u0)
-                        {
-                            if (toY.u0 != u1)
-                            {
-                                u0 = toY.u0;
-
-                                if (!LoadScanlineLinear(urow0, width, srca->pixels + (srca->rowPitch * u0), srca->rowPitch, srca->format, filter)
-                                    || !LoadScanlineLinear(vrow0, width, srcb->pixels + (srcb->rowPitch * u0), srcb->rowPitch, srcb->format, filter))
-                                    return E_FAIL;
-                            }
-                            else
-                            {
-                                u0 = u1;
-                                u1 = size_t(-1);
+                        const auto& toZ = lfZ[slice];
 
-                                std::swap(urow0, urow1);
-                                std::swap(vrow0, vrow1);
-                            }
-                        }
-
-                        if (toY.u1 != u1)
-                        {
-                            u1 = toY.u1;
+                        const Image* srca = mipChain.GetImage(level - 1, 0, toZ.u0);
+                        const Image* srcb = mipChain.GetImage(level - 1, 0, toZ.u1);
+                        const Image* dest = mipChain.GetImage(level, 0, slice);
 
-                            if (!LoadScanlineLinear(urow1, width, srca->pixels + (srca->rowPitch * u1), srca->rowPitch, srca->format, filter)
-                                || !LoadScanlineLinear(vrow1, width, srcb->pixels + (srcb->rowPitch * u1), srcb->rowPitch, srcb->format, filter))
-                                return E_FAIL;
-                        }
+                        if (!srca || !srcb || !dest)
+                            return E_POINTER;
 
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            const auto& toX = lfX[x];
+                        // Allocate temporary space (5 scanlines)
+                        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 5);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
 
-                            TRILINEAR_INTERPOLATE(target[x], toX, toY, toZ, urow0, urow1, vrow0, vrow1)
-                        }
+                        return LinearFilterRows3D(*srca, *srcb, *dest, y0, y1, filter, lfX, lfY, toZ, scanline.get());
+                    });
 
-                        if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
-                    }
-                }
+                depth = ndepth;
             }
             else
             {
                 // 2D linear filter
-                const Image* src = mipChain.GetImage(level - 1, 0, 0);
-                const Image* dest = mipChain.GetImage(level, 0, 0);
-
-                if (!src || !dest)
-                    return E_POINTER;
-
-                const uint8_t* pSrc = src->pixels;
-                uint8_t* pDest = dest->pixels;
-
-                const size_t rowPitch = src->rowPitch;
-
-                size_t u0 = size_t(-1);
-                size_t u1 = size_t(-1);
-
-                for (size_t y = 0; y < nheight; ++y)
-                {
-                    const auto& toY = lfY[y];
-
-                    if (toY.u0 != u0)
-                    {
-                        if (toY.u0 != u1)
-                        {
-                            u0 = toY.u0;
-
-                            if (!LoadScanlineLinear(urow0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
-                                return E_FAIL;
-                        }
-                        else
-                        {
-                            u0 = u1;
-                            u1 = size_t(-1);
-
-                            std::swap(urow0, urow1);
-                        }
-                    }
-
-                    if (toY.u1 != u1)
+                hr = ProcessMipLevel(1, nwidth, nheight, executor,
+                    [&](size_t, size_t y0, size_t y1) noexcept -> HRESULT
                     {
-                        u1 = toY.u1;
+                        const Image* src = mipChain.GetImage(level - 1, 0, 0);
+                        const Image* dest = mipChain.GetImage(level, 0, 0);
 
-                        if (!LoadScanlineLinear(urow1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-
-                    for (size_t x = 0; x < nwidth; ++x)
-                    {
-                        const auto& toX = lfX[x];
+                        if (!src || !dest)
+                            return E_POINTER;
 
-                        BILINEAR_INTERPOLATE(target[x], toX, toY, urow0, urow1)
-                    }
+                        // Allocate temporary space (3 scanlines)
+                        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 3);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
 
-                    if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                        return E_FAIL;
-                    pDest += dest->rowPitch;
-                }
+                        return LinearFilterRows(*src, *dest, y0, y1, filter, lfX, lfY, scanline.get());
+                    });
             }
+            if (FAILED(hr))
+                return hr;
 
-            if (height > 1)
-                height >>= 1;
-
-            if (width > 1)
-                width >>= 1;
-
-            if (depth > 1)
-                depth >>= 1;
+            height = nheight;
+            width = nwidth;
         }
 
         return S_OK;
@@ -2187,44 +2498,30 @@ namespace
 
 
     //--- 3D Cubic Filter ---
-    HRESULT Generate3DMipsCubicFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT CubicFilterRows3D(
+        _In_reads_(4) const Image* const* srcs,
+        const Image& dest,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        _In_reads_(dest.width) const Filters::CubicFilter* cfX,
+        _In_reads_(dest.height) const Filters::CubicFilter* cfY,
+        const Filters::CubicFilter& toZ,
+        _Out_writes_(srcs[0]->width * 17) XMVECTOR* scanline) noexcept
     {
         using namespace DirectX::Filters;
 
-        if (!depth || !mipChain.GetImages())
-            return E_INVALIDARG;
-
-        if (depth > INT16_MAX)
-            return E_INVALIDARG;
-
-        // This assumes that the base images are already placed into the mipChain at the top level... (see _Setup3DMips)
-
-        assert(levels > 1);
-
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
-
-        // Allocate temporary space (17 scanlines, plus X/Y/Z filters)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 17);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
-        std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[width + height + depth]);
-        if (!cf)
-            return E_OUTOFMEMORY;
-
-        CubicFilter* cfX = cf.get();
-        CubicFilter* cfY = cf.get() + width;
-        CubicFilter* cfZ = cf.get() + width + height;
+        const size_t width = srcs[0]->width;
+        const size_t nwidth = dest.width;
 
-        XMVECTOR* target = scanline.get();
+        XMVECTOR* target = scanline;
 
         XMVECTOR* urow[4];
         XMVECTOR* vrow[4];
         XMVECTOR* srow[4];
         XMVECTOR* trow[4];
 
-        XMVECTOR *ptr = scanline.get() + width;
+        XMVECTOR *ptr = scanline + width;
         for (size_t j = 0; j < 4; ++j)
         {
             urow[j] = ptr;  ptr += width;
@@ -2233,345 +2530,163 @@ namespace
             trow[j] = ptr;  ptr += width;
         }
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
+    #ifdef _DEBUG
+        for (size_t j = 0; j < 4; ++j)
         {
-            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            CreateCubicFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, cfX);
-
-            const size_t nheight = (height > 1) ? (height >> 1) : 1;
-            CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
+            memset(urow[j], 0xCD, sizeof(XMVECTOR)*width);
+            memset(vrow[j], 0xDD, sizeof(XMVECTOR)*width);
+            memset(srow[j], 0xED, sizeof(XMVECTOR)*width);
+            memset(trow[j], 0xFD, sizeof(XMVECTOR)*width);
+        }
+    #endif
 
-        #ifdef _DEBUG
+        // Loads source row v of all four slices
+        auto loadRows = [&](XMVECTOR* const* rows, size_t v) noexcept -> bool
+        {
             for (size_t j = 0; j < 4; ++j)
             {
-                memset(urow[j], 0xCD, sizeof(XMVECTOR)*width);
-                memset(vrow[j], 0xDD, sizeof(XMVECTOR)*width);
-                memset(srow[j], 0xED, sizeof(XMVECTOR)*width);
-                memset(trow[j], 0xFD, sizeof(XMVECTOR)*width);
+                const Image& src = *srcs[j];
+                if (!LoadScanlineLinear(rows[j], width, src.pixels + (src.rowPitch * v), src.rowPitch, src.format, filter))
+                    return false;
             }
-        #endif
+            return true;
+        };
 
-            if (depth > 1)
+        auto swapRows = [](XMVECTOR** a, XMVECTOR** b) noexcept
+        {
+            for (size_t j = 0; j < 4; ++j)
             {
-                // 3D cubic filter
-                const size_t ndepth = depth >> 1;
-                CreateCubicFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, (filter & TEX_FILTER_MIRROR_W) != 0, cfZ);
-
-                for (size_t slice = 0; slice < ndepth; ++slice)
-                {
-                    const auto& toZ = cfZ[slice];
-
-                    const Image* srca = mipChain.GetImage(level - 1, 0, toZ.u0);
-                    const Image* srcb = mipChain.GetImage(level - 1, 0, toZ.u1);
-                    const Image* srcc = mipChain.GetImage(level - 1, 0, toZ.u2);
-                    const Image* srcd = mipChain.GetImage(level - 1, 0, toZ.u3);
-                    if (!srca || !srcb || !srcc || !srcd)
-                        return E_POINTER;
-
-                    size_t u0 = size_t(-1);
-                    size_t u1 = size_t(-1);
-                    size_t u2 = size_t(-1);
-                    size_t u3 = size_t(-1);
-
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
-                    if (!dest)
-                        return E_POINTER;
-
-                    uint8_t* pDest = dest->pixels;
-
-                    for (size_t y = 0; y < nheight; ++y)
-                    {
-                        const auto& toY = cfY[y];
-
-                        // Scanline 1
-                        if (toY.u0 != u0)
-                        {
-                            if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
-                            {
-                                u0 = toY.u0;
-
-                                if (!LoadScanlineLinear(urow[0], width, srca->pixels + (srca->rowPitch * u0), srca->rowPitch, srca->format, filter)
-                                    || !LoadScanlineLinear(urow[1], width, srcb->pixels + (srcb->rowPitch * u0), srcb->rowPitch, srcb->format, filter)
-                                    || !LoadScanlineLinear(urow[2], width, srcc->pixels + (srcc->rowPitch * u0), srcc->rowPitch, srcc->format, filter)
-                                    || !LoadScanlineLinear(urow[3], width, srcd->pixels + (srcd->rowPitch * u0), srcd->rowPitch, srcd->format, filter))
-                                    return E_FAIL;
-                            }
-                            else if (toY.u0 == u1)
-                            {
-                                u0 = u1;
-                                u1 = size_t(-1);
-
-                                std::swap(urow[0], vrow[0]);
-                                std::swap(urow[1], vrow[1]);
-                                std::swap(urow[2], vrow[2]);
-                                std::swap(urow[3], vrow[3]);
-                            }
-                            else if (toY.u0 == u2)
-                            {
-                                u0 = u2;
-                                u2 = size_t(-1);
-
-                                std::swap(urow[0], srow[0]);
-                                std::swap(urow[1], srow[1]);
-                                std::swap(urow[2], srow[2]);
-                                std::swap(urow[3], srow[3]);
-                            }
-                            else if (toY.u0 == u3)
-                            {
-                                u0 = u3;
-                                u3 = size_t(-1);
-
-                                std::swap(urow[0], trow[0]);
-                                std::swap(urow[1], trow[1]);
-                                std::swap(urow[2], trow[2]);
-                                std::swap(urow[3], trow[3]);
-                            }
-                        }
-
-                        // Scanline 2
-                        if (toY.u1 != u1)
-                        {
-                            if (toY.u1 != u2 && toY.u1 != u3)
-                            {
-                                u1 = toY.u1;
-
-                                if (!LoadScanlineLinear(vrow[0], width, srca->pixels + (srca->rowPitch * u1), srca->rowPitch, srca->format, filter)
-                                    || !LoadScanlineLinear(vrow[1], width, srcb->pixels + (srcb->rowPitch * u1), srcb->rowPitch, srcb->format, filter)
-                                    || !LoadScanlineLinear(vrow[2], width, srcc->pixels + (srcc->rowPitch * u1), srcc->rowPitch, srcc->format, filter)
-                                    || !LoadScanlineLinear(vrow[3], width, srcd->pixels + (srcd->rowPitch * u1), srcd->rowPitch, srcd->format, filter))
-                                    return E_FAIL;
-                            }
-                            else if (toY.u1 == u2)
-                            {
-                                u1 = u2;
-                                u2 = size_t(-1);
-
-                                std::swap(vrow[0], srow[0]);
-                                std::swap(vrow[1], srow[1]);
-                                std::swap(vrow[2], srow[2]);
-                                std::swap(vrow[3], srow[3]);
-                            }
-                            else if (toY.u1 == u3)
-                            {
-                                u1 = u3;
-                                u3 = size_t(-1);
-
-                                std::swap(vrow[0], trow[0]);
-                                std::swap(vrow[1], trow[1]);
-                                std::swap(vrow[2], trow[2]);
-                                std::swap(vrow[3], trow[3]);
-                            }
-                        }
-
-                        // Scanline 3
-                        if (toY.u2 != u2)
-                        {
-                            if (toY.u2 != u3)
-                            {
-                                u2 = toY.u2;
-
-                                if (!LoadScanlineLinear(srow[0], width, srca->pixels + (srca->rowPitch * u2), srca->rowPitch, srca->format, filter)
-                                    || !LoadScanlineLinear(srow[1], width, srcb->pixels + (srcb->rowPitch * u2), srcb->rowPitch, srcb->format, filter)
-                                    || !LoadScanlineLinear(srow[2], width, srcc->pixels + (srcc->rowPitch * u2), srcc->rowPitch, srcc->format, filter)
-                                    || !LoadScanlineLinear(srow[3], width, srcd->pixels + (srcd->rowPitch * u2), srcd->rowPitch, srcd->format, filter))
-                                    return E_FAIL;
-                            }
-                            else
-                            {
-                                u2 = u3;
-                                u3 = size_t(-1);
-
-                                std::swap(srow[0], trow[0]);
-                                std::swap(srow[1], trow[1]);
-                                std::swap(srow[2], trow[2]);
-                                std::swap(srow[3], trow[3]);
-                            }
-                        }
-
-                        // Scanline 4
-                        if (toY.u3 != u3)
-                        {
-                            u3 = toY.u3;
-
-                            if (!LoadScanlineLinear(trow[0], width, srca->pixels + (srca->rowPitch * u3), srca->rowPitch, srca->format, filter)
-                                || !LoadScanlineLinear(trow[1], width, srcb->pixels + (srcb->rowPitch * u3), srcb->rowPitch, srcb->format, filter)
-                                || !LoadScanlineLinear(trow[2], width, srcc->pixels + (srcc->rowPitch * u3), srcc->rowPitch, srcc->format, filter)
-                                || !LoadScanlineLinear(trow[3], width, srcd->pixels + (srcd->rowPitch * u3), srcd->rowPitch, srcd->format, filter))
-                                return E_FAIL;
-                        }
-
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            const auto& toX = cfX[x];
-
-                            XMVECTOR D[4];
-
-                            for (size_t j = 0; j < 4; ++j)
-                            {
-                                XMVECTOR C0, C1, C2, C3;
-                                CUBIC_INTERPOLATE(C0, toX.x, urow[j][toX.u0], urow[j][toX.u1], urow[j][toX.u2], urow[j][toX.u3]);
-                                CUBIC_INTERPOLATE(C1, toX.x, vrow[j][toX.u0], vrow[j][toX.u1], vrow[j][toX.u2], vrow[j][toX.u3]);
-                                CUBIC_INTERPOLATE(C2, toX.x, srow[j][toX.u0], srow[j][toX.u1], srow[j][toX.u2], srow[j][toX.u3]);
-                                CUBIC_INTERPOLATE(C3, toX.x, trow[j][toX.u0], trow[j][toX.u1], trow[j][toX.u2], trow[j][toX.u3]);
-
-                                CUBIC_INTERPOLATE(D[j], toY.x, C0, C1, C2, C3);
-                            }
-
-                            CUBIC_INTERPOLATE(target[x], toZ.x, D[0], D[1], D[2], D[3]);
-                        }
-
-                        if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
-                    }
-                }
+                std::swap(a[j], b[j]);
             }
-            else
-            {
-                // 2D cubic filter
-                const Image* src = mipChain.GetImage(level - 1, 0, 0);
-                const Image* dest = mipChain.GetImage(level, 0, 0);
-
-                if (!src || !dest)
-                    return E_POINTER;
+        };
 
-                const uint8_t* pSrc = src->pixels;
-                uint8_t* pDest = dest->pixels;
+        size_t u0 = size_t(-1);
+        size_t u1 = size_t(-1);
+        size_t u2 = size_t(-1);
+        size_t u3 = size_t(-1);
 
-                const size_t rowPitch = src->rowPitch;
+        uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
 
-                size_t u0 = size_t(-1);
-                size_t u1 = size_t(-1);
-                size_t u2 = size_t(-1);
-                size_t u3 = size_t(-1);
+        for (size_t y = y0; y < y1; ++y)
+        {
+            const auto& toY = cfY[y];
 
-                for (size_t y = 0; y < nheight; ++y)
+            // Scanline 1
+            if (toY.u0 != u0)
+            {
+                if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
                 {
-                    const auto& toY = cfY[y];
-
-                    // Scanline 1
-                    if (toY.u0 != u0)
-                    {
-                        if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
-                        {
-                            u0 = toY.u0;
-
-                            if (!LoadScanlineLinear(urow[0], width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
-                                return E_FAIL;
-                        }
-                        else if (toY.u0 == u1)
-                        {
-                            u0 = u1;
-                            u1 = size_t(-1);
-
-                            std::swap(urow[0], vrow[0]);
-                        }
-                        else if (toY.u0 == u2)
-                        {
-                            u0 = u2;
-                            u2 = size_t(-1);
-
-                            std::swap(urow[0], srow[0]);
-                        }
-                        else if (toY.u0 == u3)
-                        {
-                            u0 = u3;
-                            u3 = size_t(-1);
-
-                            std::swap(urow[0], trow[0]);
-                        }
-                    }
-
-                    // Scanline 2
-                    if (toY.u1 != u1)
-                    {
-                        if (toY.u1 != u2 && toY.u1 != u3)
-                        {
-                            u1 = toY.u1;
-
-                            if (!LoadScanlineLinear(vrow[0], width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
-                                return E_FAIL;
-                        }
-                        else if (toY.u1 == u2)
-                        {
-                            u1 = u2;
-                            u2 = size_t(-1);
+                    u0 = toY.u0;
 
-                            std::swap(vrow[0], srow[0]);
-                        }
-                        else if (toY.u1 == u3)
-                        {
-                            u1 = u3;
-                            u3 = size_t(-1);
-
-                            std::swap(vrow[0], trow[0]);
-                        }
-                    }
+                    if (!loadRows(urow, u0))
+                        return E_FAIL;
+                }
+                else if (toY.u0 == u1)
+                {
+                    u0 = u1;
+                    u1 = size_t(-1);
 
-                    // Scanline 3
-                    if (toY.u2 != u2)
-                    {
-                        if (toY.u2 != u3)
-                        {
-                            u2 = toY.u2;
+                    swapRows(urow, vrow);
+                }
+                else if (toY.u0 == u2)
+                {
+                    u0 = u2;
+                    u2 = size_t(-1);
 
-                            if (!LoadScanlineLinear(srow[0], width, pSrc + (rowPitch * u2), rowPitch, src->format, filter))
-                                return E_FAIL;
-                        }
-                        else
-                        {
-                            u2 = u3;
-                            u3 = size_t(-1);
+                    swapRows(urow, srow);
+                }
+                else if (toY.u0 == u3)
+                {
+                    u0 = u3;
+                    u3 = size_t(-1);
 
-                            std::swap(srow[0], trow[0]);
-                        }
-                    }
+                    swapRows(urow, trow);
+                }
+            }
 
-                    // Scanline 4
-                    if (toY.u3 != u3)
-                    {
-                        u3 = toY.u3;
+            // Scanline 2
+            if (toY.u1 != u1)
+            {
+                if (toY.u1 != u2 && toY.u1 != u3)
+                {
+                    u1 = toY.u1;
 
-                        if (!LoadScanlineLinear(trow[0], width, pSrc + (rowPitch * u3), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
+                    if (!loadRows(vrow, u1))
+                        return E_FAIL;
+                }
+                else if (toY.u1 == u2)
+                {
+                    u1 = u2;
+                    u2 = size_t(-1);
 
-                    for (size_t x = 0; x < nwidth; ++x)
-                    {
-                        const auto& toX = cfX[x];
+                    swapRows(vrow, srow);
+                }
+                else if (toY.u1 == u3)
+                {
+                    u1 = u3;
+                    u3 = size_t(-1);
 
-                        XMVECTOR C0, C1, C2, C3;
-                        CUBIC_INTERPOLATE(C0, toX.x, urow[0][toX.u0], urow[0][toX.u1], urow[0][toX.u2], urow[0][toX.u3]);
-                        CUBIC_INTERPOLATE(C1, toX.x, vrow[0][toX.u0], vrow[0][toX.u1], vrow[0][toX.u2], vrow[0][toX.u3]);
-                        CUBIC_INTERPOLATE(C2, toX.x, srow[0][toX.u0], srow[0][toX.u1], srow[0][toX.u2], srow[0][toX.u3]);
-                        CUBIC_INTERPOLATE(C3, toX.x, trow[0][toX.u0], trow[0][toX.u1], trow[0][toX.u2], trow[0][toX.u3]);
+                    swapRows(vrow, trow);
+                }
+            }
 
-                        CUBIC_INTERPOLATE(target[x], toY.x, C0, C1, C2, C3);
-                    }
+            // Scanline 3
+            if (toY.u2 != u2)
+            {
+                if (toY.u2 != u3)
+                {
+                    u2 = toY.u2;
 
-                    if (!StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
+                    if (!loadRows(srow, u2))
                         return E_FAIL;
-                    pDest += dest->rowPitch;
+                }
+                else
+                {
+                    u2 = u3;
+                    u3 = size_t(-1);
+
+                    swapRows(srow, trow);
                 }
             }
 
-            if (height > 1)
-                height >>= 1;
+            // Scanline 4
+            if (toY.u3 != u3)
+            {
+                u3 = toY.u3;
 
-            if (width > 1)
-                width >>= 1;
+                if (!loadRows(trow, u3))
+                    return E_FAIL;
+            }
 
-            if (depth > 1)
-                depth >>= 1;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                const auto& toX = cfX[x];
+
+                XMVECTOR D[4];
+
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    XMVECTOR C0, C1, C2, C3;
+                    CUBIC_INTERPOLATE(C0, toX.x, urow[j][toX.u0], urow[j][toX.u1], urow[j][toX.u2], urow[j][toX.u3]);
+                    CUBIC_INTERPOLATE(C1, toX.x, vrow[j][toX.u0], vrow[j][toX.u1], vrow[j][toX.u2], vrow[j][toX.u3]);
+                    CUBIC_INTERPOLATE(C2, toX.x, srow[j][toX.u0], srow[j][toX.u1], srow[j][toX.u2], srow[j][toX.u3]);
+                    CUBIC_INTERPOLATE(C3, toX.x, trow[j][toX.u0], trow[j][toX.u1], trow[j][toX.u2], trow[j][toX.u3]);
+
+                    CUBIC_INTERPOLATE(D[j], toY.x, C0, C1, C2, C3);
+                }
+
+                CUBIC_INTERPOLATE(target[x], toZ.x, D[0], D[1], D[2], D[3]);
+            }
+
+            if (!StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
         }
 
         return S_OK;
     }
 
-
-    //--- 3D Triangle Filter ---
-    HRESULT Generate3DMipsTriangleFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsCubicFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
     {
         using namespace DirectX::Filters;
 
@@ -2588,101 +2703,187 @@ namespace
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
 
-        // Allocate initial temporary space (1 scanline, accumulation rows, plus X/Y/Z filters)
-        auto scanline = make_AlignedArrayXMVECTOR(width);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
-        std::unique_ptr<TriangleRow[]> sliceActive(new (std::nothrow) TriangleRow[depth]);
-        if (!sliceActive)
+        // Allocate X/Y/Z filters (shared by all slices of a level)
+        std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[width + height + depth]);
+        if (!cf)
             return E_OUTOFMEMORY;
 
-        TriangleRow * sliceFree = nullptr;
-
-        std::unique_ptr<Filter> tfX, tfY, tfZ;
-
-        XMVECTOR* row = scanline.get();
+        CubicFilter* cfX = cf.get();
+        CubicFilter* cfY = cf.get() + width;
+        CubicFilter* cfZ = cf.get() + width + height;
 
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
             const size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            HRESULT hr = CreateTriangleFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, tfX);
-            if (FAILED(hr))
-                return hr;
+            CreateCubicFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, cfX);
 
             const size_t nheight = (height > 1) ? (height >> 1) : 1;
-            hr = CreateTriangleFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, tfY);
-            if (FAILED(hr))
-                return hr;
+            CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
 
-            const size_t ndepth = (depth > 1) ? (depth >> 1) : 1;
-            hr = CreateTriangleFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, tfZ);
-            if (FAILED(hr))
-                return hr;
+            HRESULT hr;
+            if (depth > 1)
+            {
+                // 3D cubic filter
+                const size_t ndepth = depth >> 1;
+                CreateCubicFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, (filter & TEX_FILTER_MIRROR_W) != 0, cfZ);
 
-        #ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-        #endif
+                hr = ProcessMipLevel(ndepth, nwidth, nheight, executor,
+                    [&](size_t slice, size_t y0, size_t y1) noexcept -> HRESULT
+                    {
+                        const auto& toZ = cfZ[slice];
 
-            auto xFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfX.get()) + tfX->sizeInBytes);
-            auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY.get()) + tfY->sizeInBytes);
-            auto zFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfZ.get()) + tfZ->sizeInBytes);
+                        const Image* srcs[4] =
+                        {
+                            mipChain.GetImage(level - 1, 0, toZ.u0),
+                            mipChain.GetImage(level - 1, 0, toZ.u1),
+                            mipChain.GetImage(level - 1, 0, toZ.u2),
+                            mipChain.GetImage(level - 1, 0, toZ.u3),
+                        };
+                        const Image* dest = mipChain.GetImage(level, 0, slice);
+
+                        if (!srcs[0] || !srcs[1] || !srcs[2] || !srcs[3] || !dest)
+                            return E_POINTER;
 
-            // Count times slices get written (and clear out any leftover accumulation slices from last miplevel)
-            for (FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; )
-            {
-                for (size_t j = 0; j < zFrom->count; ++j)
-                {
-                    const size_t w = zFrom->to[j].u;
-                    assert(w < ndepth);
-                    TriangleRow* sliceAcc = &sliceActive[w];
+                        // Allocate temporary space (17 scanlines)
+                        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 17);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
 
-                    ++sliceAcc->remaining;
+                        return CubicFilterRows3D(srcs, *dest, y0, y1, filter, cfX, cfY, toZ, scanline.get());
+                    });
 
-                    if (sliceAcc->scanline)
+                depth = ndepth;
+            }
+            else
+            {
+                // 2D cubic filter
+                hr = ProcessMipLevel(1, nwidth, nheight, executor,
+                    [&](size_t, size_t y0, size_t y1) noexcept -> HRESULT
                     {
-                        memset(sliceAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth * nheight);
-                    }
-                }
+                        const Image* src = mipChain.GetImage(level - 1, 0, 0);
+                        const Image* dest = mipChain.GetImage(level, 0, 0);
+
+                        if (!src || !dest)
+                            return E_POINTER;
+
+                        // Allocate temporary space (5 scanlines)
+                        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 5);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
 
-                zFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(zFrom) + zFrom->sizeInBytes);
+                        return CubicFilterRows(*src, *dest, y0, y1, filter, cfX, cfY, scanline.get());
+                    });
             }
+            if (FAILED(hr))
+                return hr;
+
+            height = nheight;
+            width = nwidth;
+        }
+
+        return S_OK;
+    }
+
+
+    //--- 3D Triangle Filter ---
+    HRESULT TriangleFilterSlices3D(
+        const ScratchImage& mipChain,
+        size_t level,
+        size_t z0,
+        size_t z1,
+        size_t y0,
+        size_t y1,
+        TEX_FILTER_FLAGS filter,
+        const Filters::Filter* tfX,
+        const Filters::Filter* tfY,
+        const Filters::Filter* tfZ,
+        _Out_writes_(mipChain.GetImage(level - 1, 0, 0)->width) XMVECTOR* row) noexcept
+    {
+        using namespace DirectX::Filters;
+
+        // Only destination slices in [z0, z1) and rows in [y0, y1) are accumulated and written. Each
+        // of those still gathers its source pixels in the same order as a full pass, so the results
+        // are identical.
+        const Image* first = mipChain.GetImage(level - 1, 0, 0);
+        const Image* nfirst = mipChain.GetImage(level, 0, 0);
+        if (!first || !nfirst)
+            return E_POINTER;
+
+        const size_t width = first->width;
+        const size_t height = first->height;
+        const size_t nwidth = nfirst->width;
+        const size_t nheight = nfirst->height;
+        const size_t nrows = y1 - y0;
+
+        std::unique_ptr<TriangleRow[]> sliceActive(new (std::nothrow) TriangleRow[z1 - z0]);
+        if (!sliceActive)
+            return E_OUTOFMEMORY;
 
-            // Filter image
-            size_t z = 0;
-            for (FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; ++z)
+        TriangleRow * sliceFree = nullptr;
+
+    #ifdef _DEBUG
+        memset(row, 0xCD, sizeof(XMVECTOR)*width);
+    #endif
+
+        auto xFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfX) + tfX->sizeInBytes);
+        auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY) + tfY->sizeInBytes);
+        auto zFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfZ) + tfZ->sizeInBytes);
+
+        // Count times slices get written
+        for (const FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; )
+        {
+            for (size_t j = 0; j < zFrom->count; ++j)
             {
-                // Create accumulation slices as needed
-                for (size_t j = 0; j < zFrom->count; ++j)
+                const size_t w = zFrom->to[j].u;
+                if (w >= z0 && w < z1)
                 {
-                    const size_t w = zFrom->to[j].u;
-                    assert(w < ndepth);
-                    TriangleRow* sliceAcc = &sliceActive[w];
+                    ++sliceActive[w - z0].remaining;
+                }
+            }
 
-                    if (!sliceAcc->scanline)
-                    {
-                        if (sliceFree)
-                        {
-                            // Steal and reuse scanline from 'free slice' list
-                            // (it will always be at least as large as nwidth*nheight due to loop decending order)
-                            assert(sliceFree->scanline != nullptr);
-                            sliceAcc->scanline.reset(sliceFree->scanline.release());
-                            sliceFree = sliceFree->next;
-                        }
-                        else
-                        {
-                            auto nscanline = make_AlignedArrayXMVECTOR(uint64_t(nwidth) * uint64_t(nheight));
-                            if (!nscanline)
-                                return E_OUTOFMEMORY;
-                            sliceAcc->scanline.swap(nscanline);
-                        }
+            zFrom = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(zFrom) + zFrom->sizeInBytes);
+        }
 
-                        memset(sliceAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth * nheight);
+        // Filter image
+        size_t z = 0;
+        for (const FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; ++z)
+        {
+            // Create accumulation slices as needed
+            bool used = false;
+            for (size_t j = 0; j < zFrom->count; ++j)
+            {
+                const size_t w = zFrom->to[j].u;
+                if (w < z0 || w >= z1)
+                    continue;
+
+                used = true;
+
+                TriangleRow* sliceAcc = &sliceActive[w - z0];
+
+                if (!sliceAcc->scanline)
+                {
+                    if (sliceFree)
+                    {
+                        // Steal and reuse scanline from 'free slice' list
+                        assert(sliceFree->scanline != nullptr);
+                        sliceAcc->scanline = std::move(sliceFree->scanline);
+                        sliceFree = sliceFree->next;
+                    }
+                    else
+                    {
+                        auto nscanline = make_AlignedArrayXMVECTOR(uint64_t(nwidth) * uint64_t(nrows));
+                        if (!nscanline)
+                            return E_OUTOFMEMORY;
+                        sliceAcc->scanline.swap(nscanline);
                     }
+
+                    memset(sliceAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth * nrows);
                 }
+            }
 
-                assert(z < depth);
+            if (used)
+            {
                 const Image* src = mipChain.GetImage(level - 1, 0, z);
                 if (!src)
                     return E_POINTER;
@@ -2691,64 +2892,85 @@ namespace
                 const size_t rowPitch = src->rowPitch;
                 const uint8_t* pEndSrc = pSrc + rowPitch * height;
 
-                for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+                for (const FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
                 {
-                    // Load source scanline
-                    if ((pSrc + rowPitch) > pEndSrc)
-                        return E_FAIL;
-
-                    if (!LoadScanlineLinear(row, width, pSrc, rowPitch, src->format, filter))
-                        return E_FAIL;
-
-                    pSrc += rowPitch;
-
-                    // Process row
-                    size_t x = 0;
-                    for (FilterFrom* xFrom = tfX->from; xFrom < xFromEnd; ++x)
+                    bool rowUsed = false;
+                    for (size_t k = 0; k < yFrom->count; ++k)
                     {
-                        for (size_t j = 0; j < zFrom->count; ++j)
+                        const size_t v = yFrom->to[k].u;
+                        if (v >= y0 && v < y1)
                         {
-                            const size_t w = zFrom->to[j].u;
-                            assert(w < ndepth);
-                            const float zweight = zFrom->to[j].weight;
+                            rowUsed = true;
+                            break;
+                        }
+                    }
+
+                    if (rowUsed)
+                    {
+                        // Load source scanline
+                        if ((pSrc + rowPitch) > pEndSrc)
+                            return E_FAIL;
 
-                            XMVECTOR* accSlice = sliceActive[w].scanline.get();
-                            if (!accSlice)
-                                return E_POINTER;
+                        if (!LoadScanlineLinear(row, width, pSrc, rowPitch, src->format, filter))
+                            return E_FAIL;
 
-                            for (size_t k = 0; k < yFrom->count; ++k)
+                        // Process row
+                        size_t x = 0;
+                        for (const FilterFrom* xFrom = tfX->from; xFrom < xFromEnd; ++x)
+                        {
+                            for (size_t j = 0; j < zFrom->count; ++j)
                             {
-                                size_t v = yFrom->to[k].u;
-                                assert(v < nheight);
-                                const float yweight = yFrom->to[k].weight;
+                                const size_t w = zFrom->to[j].u;
+                                if (w < z0 || w >= z1)
+                                    continue;
+
+                                const float zweight = zFrom->to[j].weight;
 
-                                XMVECTOR * accPtr = accSlice + v * nwidth;
+                                XMVECTOR* accSlice = sliceActive[w - z0].scanline.get();
+                                if (!accSlice)
+                                    return E_POINTER;
 
-                                for (size_t l = 0; l < xFrom->count; ++l)
+                                for (size_t k = 0; k < yFrom->count; ++k)
                                 {
-                                    size_t u = xFrom->to[l].u;
-                                    assert(u < nwidth);
+                                    size_t v = yFrom->to[k].u;
+                                    assert(v < nheight);
+                                    if (v < y0 || v >= y1)
+                                        continue;
+
+                                    const float yweight = yFrom->to[k].weight;
+
+                                    XMVECTOR * accPtr = accSlice + (v - y0) * nwidth;
+
+                                    for (size_t l = 0; l < xFrom->count; ++l)
+                                    {
+                                        size_t u = xFrom->to[l].u;
+                                        assert(u < nwidth);
 
-                                    const XMVECTOR weight = XMVectorReplicate(zweight * yweight * xFrom->to[l].weight);
+                                        const XMVECTOR weight = XMVectorReplicate(zweight * yweight * xFrom->to[l].weight);
 
-                                    assert(x < width);
-                                    accPtr[u] = XMVectorMultiplyAdd(row[x], weight, accPtr[u]);
+                                        assert(x < width);
+                                        accPtr[u] = XMVectorMultiplyAdd(row[x], weight, accPtr[u]);
+                                    }
                                 }
                             }
-                        }
 
-                        xFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(xFrom) + xFrom->sizeInBytes);
+                            xFrom = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(xFrom) + xFrom->sizeInBytes);
+                        }
                     }
 
-                    yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
+                    pSrc += rowPitch;
+
+                    yFrom = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(yFrom) + yFrom->sizeInBytes);
                 }
 
                 // Write completed accumulation slices
                 for (size_t j = 0; j < zFrom->count; ++j)
                 {
                     const size_t w = zFrom->to[j].u;
-                    assert(w < ndepth);
-                    TriangleRow* sliceAcc = &sliceActive[w];
+                    if (w < z0 || w >= z1)
+                        continue;
+
+                    TriangleRow* sliceAcc = &sliceActive[w - z0];
 
                     assert(sliceAcc->remaining > 0);
                     --sliceAcc->remaining;
@@ -2760,9 +2982,9 @@ namespace
                         if (!dest || !pAccSrc)
                             return E_POINTER;
 
-                        uint8_t* pDest = dest->pixels;
+                        uint8_t* pDest = dest->pixels + (dest->rowPitch * y0);
 
-                        for (size_t h = 0; h < nheight; ++h)
+                        for (size_t h = y0; h < y1; ++h)
                         {
                             switch (dest->format)
                             {
@@ -2798,18 +3020,79 @@ namespace
                         sliceFree = sliceAcc;
                     }
                 }
-
-                zFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(zFrom) + zFrom->sizeInBytes);
             }
 
-            if (height > 1)
-                height >>= 1;
+            zFrom = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(zFrom) + zFrom->sizeInBytes);
+        }
 
-            if (width > 1)
-                width >>= 1;
+        return S_OK;
+    }
 
-            if (depth > 1)
-                depth >>= 1;
+    HRESULT Generate3DMipsTriangleFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, _In_opt_ ITaskExecutor* executor) noexcept
+    {
+        using namespace DirectX::Filters;
+
+        if (!depth || !mipChain.GetImages())
+            return E_INVALIDARG;
+
+        if (depth > INT16_MAX)
+            return E_INVALIDARG;
+
+        // This assumes that the base images are already placed into the mipChain at the top level... (see _Setup3DMips)
+
+        assert(levels > 1);
+
+        size_t width = mipChain.GetMetadata().width;
+        size_t height = mipChain.GetMetadata().height;
+
+        std::unique_ptr<Filter> tfX, tfY, tfZ;
+
+        // Resize base image to each target mip level
+        for (size_t level = 1; level < levels; ++level)
+        {
+            const size_t nwidth = (width > 1) ? (width >> 1) : 1;
+            HRESULT hr = CreateTriangleFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, tfX);
+            if (FAILED(hr))
+                return hr;
+
+            const size_t nheight = (height > 1) ? (height >> 1) : 1;
+            hr = CreateTriangleFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, tfY);
+            if (FAILED(hr))
+                return hr;
+
+            const size_t ndepth = (depth > 1) ? (depth >> 1) : 1;
+            hr = CreateTriangleFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, tfZ);
+            if (FAILED(hr))
+                return hr;
+
+            if (!executor)
+            {
+                // A single pass over all slices reads each source row only once
+                auto scanline = make_AlignedArrayXMVECTOR(width);
+                if (!scanline)
+                    return E_OUTOFMEMORY;
+
+                hr = TriangleFilterSlices3D(mipChain, level, 0, ndepth, 0, nheight, filter, tfX.get(), tfY.get(), tfZ.get(), scanline.get());
+            }
+            else
+            {
+                hr = ProcessMipLevel(ndepth, nwidth, nheight, executor,
+                    [&](size_t slice, size_t y0, size_t y1) noexcept -> HRESULT
+                    {
+                        // Allocate temporary space (1 scanline, accumulation slices are allocated as needed)
+                        auto scanline = make_AlignedArrayXMVECTOR(width);
+                        if (!scanline)
+                            return E_OUTOFMEMORY;
+
+                        return TriangleFilterSlices3D(mipChain, level, slice, slice + 1, y0, y1, filter, tfX.get(), tfY.get(), tfZ.get(), scanline.get());
+                    });
+            }
+            if (FAILED(hr))
+                return hr;
+
+            height = nheight;
+            width = nwidth;
+            depth = ndepth;
         }
 
         return S_OK;
@@ -2890,8 +3173,8 @@ HRESULT DirectX::GenerateMipMaps(
                 {
                     // Case 1: Base image format is supported by Windows Imaging Component
                     hr = (baseImage.height > 1 || !allow1D)
-                        ? mipChain.Initialize2D(baseImage.format, baseImage.width, baseImage.height, 1, levels)
-                        : mipChain.Initialize1D(baseImage.format, baseImage.width, 1, levels);
+                        ? mipChain.Initialize2D(baseImage.format, baseImage.width, baseImage.height, 1, levels, CP_FLAGS_REUSE_MEMORY)
+                        : mipChain.Initialize1D(baseImage.format, baseImage.width, 1, levels, CP_FLAGS_REUSE_MEMORY);
                     if (FAILED(hr))
                         return hr;
 
@@ -2965,7 +3248,7 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            hr = Generate2DMipsBoxFilter(levels, filter, mipChain, 0);
+            hr = Generate2DMipsBoxFilter(levels, filter, mipChain, GetMipsExecutor(filter));
             if (FAILED(hr))
                 mipChain.Release();
             return hr;
@@ -2975,7 +3258,7 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            hr = Generate2DMipsPointFilter(levels, mipChain, 0);
+            hr = Generate2DMipsPointFilter(levels, mipChain, GetMipsExecutor(filter));
             if (FAILED(hr))
                 mipChain.Release();
             return hr;
@@ -2985,7 +3268,7 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            hr = Generate2DMipsLinearFilter(levels, filter, mipChain, 0);
+            hr = Generate2DMipsLinearFilter(levels, filter, mipChain, GetMipsExecutor(filter));
             if (FAILED(hr))
                 mipChain.Release();
             return hr;
@@ -2995,17 +3278,20 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            hr = Generate2DMipsCubicFilter(levels, filter, mipChain, 0);
+            hr = Generate2DMipsCubicFilter(levels, filter, mipChain, GetMipsExecutor(filter));
             if (FAILED(hr))
                 mipChain.Release();
             return hr;
 
         case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_KAISER:
+        case TEX_FILTER_MITCHELL:
             hr = Setup2DMips(&baseImage, 1, mdata, mipChain);
             if (FAILED(hr))
                 return hr;
 
-            hr = Generate2DMipsTriangleFilter(levels, filter, mipChain, 0);
+            hr = Generate2DMipsKernelFilter(levels, GetFilterKernelType(filter_select), filter, mipChain, GetMipsExecutor(filter));
             if (FAILED(hr))
                 mipChain.Release();
             return hr;
@@ -3106,7 +3392,7 @@ HRESULT DirectX::GenerateMipMaps(
                     // Case 1: Base image format is supported by Windows Imaging Component
                     TexMetadata mdata2 = metadata;
                     mdata2.mipLevels = levels;
-                    hr = mipChain.Initialize(mdata2);
+                    hr = mipChain.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
                     if (FAILED(hr))
                         return hr;
 
@@ -3180,12 +3466,9 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsBoxFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+            hr = Generate2DMipsBoxFilter(levels, filter, mipChain, GetMipsExecutor(filter));
+            if (FAILED(hr))
+                mipChain.Release();
             return hr;
 
         case TEX_FILTER_POINT:
@@ -3193,12 +3476,9 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsPointFilter(levels, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+            hr = Generate2DMipsPointFilter(levels, mipChain, GetMipsExecutor(filter));
+            if (FAILED(hr))
+                mipChain.Release();
             return hr;
 
         case TEX_FILTER_LINEAR:
@@ -3206,12 +3486,9 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsLinearFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+            hr = Generate2DMipsLinearFilter(levels, filter, mipChain, GetMipsExecutor(filter));
+            if (FAILED(hr))
+                mipChain.Release();
             return hr;
 
         case TEX_FILTER_CUBIC:
@@ -3219,25 +3496,22 @@ HRESULT DirectX::GenerateMipMaps(
             if (FAILED(hr))
                 return hr;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsCubicFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+            hr = Generate2DMipsCubicFilter(levels, filter, mipChain, GetMipsExecutor(filter));
+            if (FAILED(hr))
+                mipChain.Release();
             return hr;
 
         case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_KAISER:
+        case TEX_FILTER_MITCHELL:
             hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
             if (FAILED(hr))
                 return hr;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsTriangleFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+            hr = Generate2DMipsKernelFilter(levels, GetFilterKernelType(filter_select), filter, mipChain, GetMipsExecutor(filter));
+            if (FAILED(hr))
+                mipChain.Release();
             return hr;
 
         default:
@@ -3310,7 +3584,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsBoxFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsBoxFilter(depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3320,7 +3594,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsPointFilter(depth, levels, mipChain);
+        hr = Generate3DMipsPointFilter(depth, levels, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3330,7 +3604,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsLinearFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsLinearFilter(depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3340,7 +3614,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsCubicFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsCubicFilter(depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3350,7 +3624,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsTriangleFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsTriangleFilter(depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3429,7 +3703,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsBoxFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsBoxFilter(metadata.depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3439,7 +3713,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsPointFilter(metadata.depth, levels, mipChain);
+        hr = Generate3DMipsPointFilter(metadata.depth, levels, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3449,7 +3723,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsLinearFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsLinearFilter(metadata.depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3459,7 +3733,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsCubicFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsCubicFilter(metadata.depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3469,7 +3743,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsTriangleFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsTriangleFilter(metadata.depth, levels, filter, mipChain, GetMipsExecutor(filter));
         if (FAILED(hr))
             mipChain.Release();
         return hr;
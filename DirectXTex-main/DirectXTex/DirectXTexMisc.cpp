@@ -23,6 +23,91 @@ namespace
 {
     const XMVECTORF32 g_Gamma22 = { { { 2.2f, 2.2f, 2.2f, 1.f } } };
 
+    //-------------------------------------------------------------------------------------
+    // Adds one pixel pair's (I1 - I2)^2 term to the MSE accumulator
+    inline XMVECTOR XM_CALLCONV AccumulateMSE(
+        FXMVECTOR pixel1,
+        FXMVECTOR pixel2,
+        FXMVECTOR acc,
+        CMSE_FLAGS flags) noexcept
+    {
+        static const XMVECTORF32 two = { { { 2.0f, 2.0f, 2.0f, 2.0f } } };
+
+        XMVECTOR v1 = pixel1;
+        if (flags & CMSE_IMAGE1_SRGB)
+        {
+            v1 = XMVectorPow(v1, g_Gamma22);
+        }
+        if (flags & CMSE_IMAGE1_X2_BIAS)
+        {
+            v1 = XMVectorMultiplyAdd(v1, two, g_XMNegativeOne);
+        }
+
+        XMVECTOR v2 = pixel2;
+        if (flags & CMSE_IMAGE2_SRGB)
+        {
+            v2 = XMVectorPow(v2, g_Gamma22);
+        }
+        if (flags & CMSE_IMAGE2_X2_BIAS)
+        {
+            v2 = XMVectorMultiplyAdd(v2, two, g_XMNegativeOne);
+        }
+
+        XMVECTOR v = XMVectorSubtract(v1, v2);
+        if (flags & CMSE_IGNORE_RED)
+        {
+            v = XMVectorSelect(v, g_XMZero, g_XMMaskX);
+        }
+        if (flags & CMSE_IGNORE_GREEN)
+        {
+            v = XMVectorSelect(v, g_XMZero, g_XMMaskY);
+        }
+        if (flags & CMSE_IGNORE_BLUE)
+        {
+            v = XMVectorSelect(v, g_XMZero, g_XMMaskZ);
+        }
+        if (flags & CMSE_IGNORE_ALPHA)
+        {
+            v = XMVectorSelect(v, g_XMZero, g_XMMaskW);
+        }
+
+        return XMVectorMultiplyAdd(v, v, acc);
+    }
+
+    //-------------------------------------------------------------------------------------
+    // sum[ (I1 - I2)^2 ] decoding both images directly with a compile-time scanline codec
+    template<class Codec>
+    XMVECTOR ComputeMSESum(
+        const Image& image1,
+        const Image& image2,
+        CMSE_FLAGS flags) noexcept
+    {
+        using type = typename Codec::type;
+
+        const size_t width = std::min<size_t>(image1.width,
+            std::min<size_t>(image1.rowPitch, image2.rowPitch) / sizeof(type));
+
+        const uint8_t *pSrc1 = image1.pixels;
+        const uint8_t *pSrc2 = image2.pixels;
+
+        XMVECTOR acc = g_XMZero;
+        for (size_t h = 0; h < image1.height; ++h)
+        {
+            auto sPtr1 = reinterpret_cast<const type*>(pSrc1);
+            auto sPtr2 = reinterpret_cast<const type*>(pSrc2);
+
+            for (size_t i = 0; i < width; ++i)
+            {
+                acc = AccumulateMSE(Codec::Load(sPtr1 + i), Codec::Load(sPtr2 + i), acc, flags);
+            }
+
+            pSrc1 += image1.rowPitch;
+            pSrc2 += image2.rowPitch;
+        }
+
+        return acc;
+    }
+
     //-------------------------------------------------------------------------------------
     HRESULT ComputeMSE_(
         const Image& image1,
@@ -39,10 +124,6 @@ namespace
 
         const size_t width = image1.width;
 
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 2);
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
         // Flags implied from image formats
         switch (image1.format)
         {
@@ -97,64 +178,37 @@ namespace
         const size_t rowPitch2 = image2.rowPitch;
 
         XMVECTOR acc = g_XMZero;
-        static XMVECTORF32 two = { { { 2.0f, 2.0f, 2.0f, 2.0f } } };
 
-        for (size_t h = 0; h < image1.height; ++h)
-        {
-            XMVECTOR* ptr1 = scanline.get();
-            if (!LoadScanline(ptr1, width, pSrc1, rowPitch1, image1.format))
-                return E_FAIL;
+        const bool fused = (image1.format == image2.format)
+            && VisitScanlineCodec(image1.format, [&](auto codec) noexcept
+                {
+                    acc = ComputeMSESum<decltype(codec)>(image1, image2, flags);
+                });
 
-            XMVECTOR* ptr2 = scanline.get() + width;
-            if (!LoadScanline(ptr2, width, pSrc2, rowPitch2, image2.format))
-                return E_FAIL;
+        if (!fused)
+        {
+            auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 2);
+            if (!scanline)
+                return E_OUTOFMEMORY;
 
-            for (size_t i = 0; i < width; ++i)
+            for (size_t h = 0; h < image1.height; ++h)
             {
-                XMVECTOR v1 = *(ptr1++);
-                if (flags & CMSE_IMAGE1_SRGB)
-                {
-                    v1 = XMVectorPow(v1, g_Gamma22);
-                }
-                if (flags & CMSE_IMAGE1_X2_BIAS)
-                {
-                    v1 = XMVectorMultiplyAdd(v1, two, g_XMNegativeOne);
-                }
+                XMVECTOR* ptr1 = scanline.get();
+                if (!LoadScanline(ptr1, width, pSrc1, rowPitch1, image1.format))
+                    return E_FAIL;
 
-                XMVECTOR v2 = *(ptr2++);
-                if (flags & CMSE_IMAGE2_SRGB)
-                {
-                    v2 = XMVectorPow(v2, g_Gamma22);
-                }
-                if (flags & CMSE_IMAGE2_X2_BIAS)
-                {
-                    v2 = XMVectorMultiplyAdd(v2, two, g_XMNegativeOne);
-                }
+                XMVECTOR* ptr2 = scanline.get() + width;
+                if (!LoadScanline(ptr2, width, pSrc2, rowPitch2, image2.format))
+                    return E_FAIL;
 
-                // sum[ (I1 - I2)^2 ]
-                XMVECTOR v = XMVectorSubtract(v1, v2);
-                if (flags & CMSE_IGNORE_RED)
-                {
-                    v = XMVectorSelect(v, g_XMZero, g_XMMaskX);
-                }
-                if (flags & CMSE_IGNORE_GREEN)
-                {
-                    v = XMVectorSelect(v, g_XMZero, g_XMMaskY);
-                }
-                if (flags & CMSE_IGNORE_BLUE)
+                for (size_t i = 0; i < width; ++i)
                 {
-                    v = XMVectorSelect(v, g_XMZero, g_XMMaskZ);
-                }
-                if (flags & CMSE_IGNORE_ALPHA)
-                {
-                    v = XMVectorSelect(v, g_XMZero, g_XMMaskW);
+                    acc = AccumulateMSE(ptr1[i], ptr2[i], acc, flags);
                 }
 
-                acc = XMVectorMultiplyAdd(v, v, acc);
+                pSrc1 += rowPitch1;
+                pSrc2 += rowPitch2;
             }
-
-            pSrc1 += rowPitch1;
-            pSrc2 += rowPitch2;
         }
 
         // MSE = sum[ (I1 - I2)^2 ] / w*h
@@ -360,6 +414,9 @@ HRESULT DirectX::CopyRectangle(
     const size_t copyS = srcRect.w * sbpp;
     const size_t copyD = srcRect.w * dbpp;
 
+    ConvertPlan plan;
+    CreateConvertPlan(plan, dstImage.format, srcImage.format, filter);
+
     for (size_t h = 0; h < srcRect.h; ++h)
     {
         if (((pSrc + copyS) > pEndSrc) || ((pDest + copyD) > pEndDest))
@@ -368,7 +425,7 @@ HRESULT DirectX::CopyRectangle(
         if (!LoadScanline(scanline.get(), srcRect.w, pSrc, copyS, srcImage.format))
             return E_FAIL;
 
-        ConvertScanline(scanline.get(), srcRect.w, dstImage.format, srcImage.format, filter);
+        ConvertScanline(scanline.get(), srcRect.w, plan);
 
         if (!StoreScanline(pDest, copyD, dstImage.format, scanline.get(), srcRect.w))
             return E_FAIL;
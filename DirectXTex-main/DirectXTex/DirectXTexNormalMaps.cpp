@@ -74,6 +74,61 @@ namespace
         }
     }
 
+    // Loads source row y and evaluates it into pDest (width + 2 entries)
+    using EvaluateSourceRowFunc = bool(*)(
+        const Image& srcImage, size_t y, XMVECTOR* pScanline, float* pDest, CNMAP_FLAGS flags) noexcept;
+
+    bool EvaluateSourceRow(
+        const Image& srcImage,
+        size_t y,
+        _Out_writes_(srcImage.width) XMVECTOR* pScanline,
+        _Out_writes_(srcImage.width + 2) float* pDest,
+        CNMAP_FLAGS flags) noexcept
+    {
+        if (!LoadScanline(pScanline, srcImage.width, srcImage.pixels + (srcImage.rowPitch * y), srcImage.rowPitch, srcImage.format))
+            return false;
+
+        EvaluateRow(pScanline, pDest, srcImage.width, flags);
+        return true;
+    }
+
+    // Same as EvaluateSourceRow, decoding pixels directly with a compile-time scanline codec
+    template<class Codec>
+    bool EvaluateSourceRowT(
+        const Image& srcImage,
+        size_t y,
+        XMVECTOR*,
+        _Out_writes_(srcImage.width + 2) float* pDest,
+        CNMAP_FLAGS flags) noexcept
+    {
+        using type = typename Codec::type;
+
+        const size_t width = srcImage.width;
+        if (srcImage.rowPitch < width * sizeof(type))
+            return false;
+
+        auto sPtr = reinterpret_cast<const type*>(srcImage.pixels + (srcImage.rowPitch * y));
+
+        for (size_t x = 0; x < width; ++x)
+        {
+            pDest[x + 1] = EvaluateColor(Codec::Load(sPtr + x), flags);
+        }
+
+        if (flags & CNMAP_MIRROR_U)
+        {
+            // Mirror in U
+            pDest[0] = pDest[1];
+            pDest[width + 1] = pDest[width];
+        }
+        else
+        {
+            // Wrap in U
+            pDest[0] = pDest[width];
+            pDest[width + 1] = pDest[1];
+        }
+        return true;
+    }
+
     HRESULT ComputeNMap(_In_ const Image& srcImage, _In_ CNMAP_FLAGS flags, _In_ float amplitude,
         _In_ DXGI_FORMAT format, _In_ const Image& normalMap) noexcept
     {
@@ -92,8 +147,8 @@ namespace
         if (width != normalMap.width || height != normalMap.height)
             return E_FAIL;
 
-        // Allocate temporary space (4 scanlines and 3 evaluated rows)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 4);
+        // Allocate temporary space (2 scanlines and 3 evaluated rows)
+        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(width) * 2);
         if (!scanline)
             return E_OUTOFMEMORY;
 
@@ -105,67 +160,39 @@ namespace
         if (!pDest)
             return E_POINTER;
 
-        XMVECTOR* row0 = scanline.get();
-        XMVECTOR* row1 = row0 + width;
-        XMVECTOR* row2 = row1 + width;
-        XMVECTOR* target = row2 + width;
+        XMVECTOR* row = scanline.get();
+        XMVECTOR* target = row + width;
 
         float* val0 = buffer.get();
         float* val1 = val0 + width + 2;
         float* val2 = val1 + width + 2;
 
-        const size_t rowPitch = srcImage.rowPitch;
-        const uint8_t* pSrc = srcImage.pixels;
+        EvaluateSourceRowFunc evaluateSourceRow = EvaluateSourceRow;
+        VisitScanlineCodec(srcImage.format, [&](auto codec) noexcept
+            {
+                evaluateSourceRow = EvaluateSourceRowT<decltype(codec)>;
+            });
 
-        // Read first scanline row into 'row1'
-        if (!LoadScanline(row1, width, pSrc, rowPitch, srcImage.format))
+        // Evaluate the initial rows: first row into 'val1', and either the first row
+        // again (Mirror V) or the last row (Wrap V) into 'val0'
+        if (!evaluateSourceRow(srcImage, 0, row, val1, flags))
             return E_FAIL;
 
-        // Setup 'row0'
-        if (flags & CNMAP_MIRROR_V)
-        {
-            // Mirror first row
-            memcpy(row0, row1, rowPitch);
-        }
-        else
-        {
-            // Read last row (Wrap V)
-            if (!LoadScanline(row0, width, pSrc + (rowPitch * (height - 1)), rowPitch, srcImage.format))
-                return E_FAIL;
-        }
-
-        // Evaluate the initial rows
-        EvaluateRow(row0, val0, width, flags);
-        EvaluateRow(row1, val1, width, flags);
-
-        pSrc += rowPitch;
+        if (!evaluateSourceRow(srcImage, (flags & CNMAP_MIRROR_V) ? 0 : (height - 1), row, val0, flags))
+            return E_FAIL;
 
         for (size_t y = 0; y < height; ++y)
         {
-            // Load next scanline of source image
-            if (y < (height - 1))
+            // Evaluate next scanline of source image
+            size_t next = y + 1;
+            if (next >= height)
             {
-                if (!LoadScanline(row2, width, pSrc, rowPitch, srcImage.format))
-                    return E_FAIL;
-            }
-            else
-            {
-                if (flags & CNMAP_MIRROR_V)
-                {
-                    // Use last row of source image
-                    if (!LoadScanline(row2, width, srcImage.pixels + (rowPitch * (height - 1)), rowPitch, srcImage.format))
-                        return E_FAIL;
-                }
-                else
-                {
-                    // Use first row of source image (Wrap V)
-                    if (!LoadScanline(row2, width, srcImage.pixels, rowPitch, srcImage.format))
-                        return E_FAIL;
-                }
+                // Use last row (Mirror V) or first row (Wrap V) of source image
+                next = (flags & CNMAP_MIRROR_V) ? (height - 1) : 0;
             }
 
-            // Evaluate row
-            EvaluateRow(row2, val2, width, flags);
+            if (!evaluateSourceRow(srcImage, next, row, val2, flags))
+                return E_FAIL;
 
             // Generate target scanline
             XMVECTOR *dptr = target;
@@ -237,7 +264,6 @@ namespace
             val1 = val2;
             val2 = temp;
 
-            pSrc += rowPitch;
             pDest += normalMap.rowPitch;
         }
 
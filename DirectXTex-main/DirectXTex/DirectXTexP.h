@@ -141,20 +141,24 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
+#include <condition_variable>
 #include <cstdlib>
 #include <ctime>
 #include <cstring>
+#include <deque>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <new>
+#include <thread>
 #include <tuple>
 
 #ifndef _WIN32
 #include <fstream>
 #include <filesystem>
-#include <thread>
 #endif
 
 #define _XM_NO_XMVECTOR_OVERLOADS_
@@ -421,6 +425,189 @@ namespace DirectX
             _In_ float threshold, size_t y, size_t z,
             _Inout_updates_all_opt_(count + 2) XMVECTOR* pDiffusionErrors) noexcept;
 
+        //---------------------------------------------------------------------------------
+        // Compile-time scanline codecs for the most common formats
+        //
+        // Load/Store match LoadScanline/StoreScanline exactly for the format, so hot loops
+        // can instantiate on the codec to inline the pixel conversion into their own work.
+        const XMVECTORF32 g_HalfMin = { { { -65504.f, -65504.f, -65504.f, -65504.f } } };
+        const XMVECTORF32 g_HalfMax = { { { 65504.f, 65504.f, 65504.f, 65504.f } } };
+        const XMVECTORF32 g_8BitBias = { { { 0.5f / 255.f, 0.5f / 255.f, 0.5f / 255.f, 0.5f / 255.f } } };
+
+        template<DXGI_FORMAT Format> struct ScanlineCodec;
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R32G32B32A32_FLOAT>
+        {
+            using type = XMFLOAT4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept { return XMLoadFloat4(p); }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept { XMStoreFloat4(p, v); }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R16G16B16A16_FLOAT>
+        {
+            using type = PackedVector::XMHALF4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept { return PackedVector::XMLoadHalf4(p); }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept
+            {
+                PackedVector::XMStoreHalf4(p, XMVectorClamp(v, g_HalfMin, g_HalfMax));
+            }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R16G16B16A16_UNORM>
+        {
+            using type = PackedVector::XMUSHORTN4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept { return PackedVector::XMLoadUShortN4(p); }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept { PackedVector::XMStoreUShortN4(p, v); }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R10G10B10A2_UNORM>
+        {
+            using type = PackedVector::XMUDECN4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept { return PackedVector::XMLoadUDecN4(p); }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept { PackedVector::XMStoreUDecN4(p, v); }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R8G8B8A8_UNORM>
+        {
+            using type = PackedVector::XMUBYTEN4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept { return PackedVector::XMLoadUByteN4(p); }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept
+            {
+                PackedVector::XMStoreUByteN4(p, XMVectorAdd(v, g_8BitBias));
+            }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_B8G8R8A8_UNORM>
+        {
+            using type = PackedVector::XMUBYTEN4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept
+            {
+                return XMVectorSwizzle<2, 1, 0, 3>(PackedVector::XMLoadUByteN4(p));
+            }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept
+            {
+                PackedVector::XMStoreUByteN4(p, XMVectorAdd(XMVectorSwizzle<2, 1, 0, 3>(v), g_8BitBias));
+            }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_B8G8R8X8_UNORM>
+        {
+            using type = PackedVector::XMUBYTEN4;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept
+            {
+                const XMVECTOR v = XMVectorSwizzle<2, 1, 0, 3>(PackedVector::XMLoadUByteN4(p));
+                return XMVectorSelect(g_XMIdentityR3, v, g_XMSelect1110);
+            }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept
+            {
+                PackedVector::XMStoreUByteN4(p, XMVectorAdd(XMVectorPermute<2, 1, 0, 7>(v, g_XMIdentityR3), g_8BitBias));
+            }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R32_FLOAT>
+        {
+            using type = float;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept
+            {
+                return XMVectorSelect(g_XMIdentityR3, XMLoadFloat(p), g_XMSelect1000);
+            }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept { XMStoreFloat(p, v); }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R16_FLOAT>
+        {
+            using type = PackedVector::HALF;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept
+            {
+                return XMVectorSet(PackedVector::XMConvertHalfToFloat(*p), 0.f, 0.f, 1.f);
+            }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept
+            {
+                const float f = std::max<float>(std::min<float>(XMVectorGetX(v), 65504.f), -65504.f);
+                *p = PackedVector::XMConvertFloatToHalf(f);
+            }
+        };
+
+        template<> struct ScanlineCodec<DXGI_FORMAT_R8_UNORM>
+        {
+            using type = uint8_t;
+            static XMVECTOR XM_CALLCONV Load(_In_ const type* p) noexcept
+            {
+                return XMVectorSet(static_cast<float>(*p) / 255.f, 0.f, 0.f, 1.f);
+            }
+            static void XM_CALLCONV Store(_Out_ type* p, FXMVECTOR v) noexcept
+            {
+                const float f = std::max<float>(std::min<float>(XMVectorGetX(v), 1.f), 0.f);
+                *p = static_cast<uint8_t>(f * 255.f);
+            }
+        };
+
+        // sRGB variants share the bit layout; LoadScanline/StoreScanline do not apply the transfer curve
+        template<> struct ScanlineCodec<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB> : ScanlineCodec<DXGI_FORMAT_R8G8B8A8_UNORM> {};
+        template<> struct ScanlineCodec<DXGI_FORMAT_B8G8R8A8_UNORM_SRGB> : ScanlineCodec<DXGI_FORMAT_B8G8R8A8_UNORM> {};
+        template<> struct ScanlineCodec<DXGI_FORMAT_B8G8R8X8_UNORM_SRGB> : ScanlineCodec<DXGI_FORMAT_B8G8R8X8_UNORM> {};
+
+        template<class Codec>
+        _Success_(return) bool LoadScanlineT(
+            _Out_writes_(count) XMVECTOR* pDestination, _In_ size_t count,
+            _In_reads_bytes_(size) const void* pSource, _In_ size_t size) noexcept
+        {
+            using type = typename Codec::type;
+            if (size < sizeof(type))
+                return false;
+
+            const size_t n = std::min<size_t>(count, size / sizeof(type));
+            const type* __restrict sPtr = static_cast<const type*>(pSource);
+            XMVECTOR* __restrict dPtr = pDestination;
+            for (size_t i = 0; i < n; ++i)
+            {
+                dPtr[i] = Codec::Load(sPtr + i);
+            }
+            return true;
+        }
+
+        template<class Codec>
+        _Success_(return) bool StoreScanlineT(
+            _Out_writes_bytes_(size) void* pDestination, _In_ size_t size,
+            _In_reads_(count) const XMVECTOR* pSource, _In_ size_t count) noexcept
+        {
+            using type = typename Codec::type;
+            if (size < sizeof(type))
+                return false;
+
+            const size_t n = std::min<size_t>(count, size / sizeof(type));
+            type* __restrict dPtr = static_cast<type*>(pDestination);
+            const XMVECTOR* __restrict sPtr = pSource;
+            for (size_t i = 0; i < n; ++i)
+            {
+                Codec::Store(dPtr + i, sPtr[i]);
+            }
+            return true;
+        }
+
+        // Calls fn(ScanlineCodec<format>()) and returns true if the format has a codec, otherwise returns false
+        template<class Fn>
+        bool VisitScanlineCodec(_In_ DXGI_FORMAT format, Fn&& fn)
+        {
+            switch (format)
+            {
+            case DXGI_FORMAT_R32G32B32A32_FLOAT:    fn(ScanlineCodec<DXGI_FORMAT_R32G32B32A32_FLOAT>()); return true;
+            case DXGI_FORMAT_R16G16B16A16_FLOAT:    fn(ScanlineCodec<DXGI_FORMAT_R16G16B16A16_FLOAT>()); return true;
+            case DXGI_FORMAT_R16G16B16A16_UNORM:    fn(ScanlineCodec<DXGI_FORMAT_R16G16B16A16_UNORM>()); return true;
+            case DXGI_FORMAT_R10G10B10A2_UNORM:     fn(ScanlineCodec<DXGI_FORMAT_R10G10B10A2_UNORM>()); return true;
+            case DXGI_FORMAT_R8G8B8A8_UNORM:
+            case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:   fn(ScanlineCodec<DXGI_FORMAT_R8G8B8A8_UNORM>()); return true;
+            case DXGI_FORMAT_B8G8R8A8_UNORM:
+            case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:   fn(ScanlineCodec<DXGI_FORMAT_B8G8R8A8_UNORM>()); return true;
+            case DXGI_FORMAT_B8G8R8X8_UNORM:
+            case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:   fn(ScanlineCodec<DXGI_FORMAT_B8G8R8X8_UNORM>()); return true;
+            case DXGI_FORMAT_R32_FLOAT:             fn(ScanlineCodec<DXGI_FORMAT_R32_FLOAT>()); return true;
+            case DXGI_FORMAT_R16_FLOAT:             fn(ScanlineCodec<DXGI_FORMAT_R16_FLOAT>()); return true;
+            case DXGI_FORMAT_R8_UNORM:              fn(ScanlineCodec<DXGI_FORMAT_R8_UNORM>()); return true;
+            default:                                return false;
+            }
+        }
+
         HRESULT __cdecl ConvertToR32G32B32A32(_In_ const Image& srcImage, _Inout_ ScratchImage& image) noexcept;
 
         HRESULT __cdecl ConvertFromR32G32B32A32(_In_ const Image& srcImage, _In_ const Image& destImage) noexcept;
@@ -438,6 +625,44 @@ namespace DirectX
             _Inout_updates_all_(count) XMVECTOR* pBuffer, _In_ size_t count,
             _In_ DXGI_FORMAT outFormat, _In_ DXGI_FORMAT inFormat, _In_ TEX_FILTER_FLAGS flags) noexcept;
 
+        // Precomputed ConvertScanline for a fixed outFormat/inFormat/flags combination
+        struct ConvertPlan
+        {
+            using Step = void(*)(XMVECTOR* pBuffer, size_t count) noexcept;
+
+            Step steps[8];
+            size_t stepCount;
+        };
+
+        void __cdecl CreateConvertPlan(
+            _Out_ ConvertPlan& plan,
+            _In_ DXGI_FORMAT outFormat, _In_ DXGI_FORMAT inFormat, _In_ TEX_FILTER_FLAGS flags) noexcept;
+
+        void __cdecl ConvertScanline(
+            _Inout_updates_all_(count) XMVECTOR* pBuffer, _In_ size_t count,
+            _In_ const ConvertPlan& plan) noexcept;
+
+        //---------------------------------------------------------------------------------
+        // Multithreading helper functions
+
+        // Wrapping the task in std::function can allocate, which must not escape a noexcept caller
+        template<typename Task>
+        inline HRESULT ParallelFor(_In_ ITaskExecutor* executor, _In_ size_t count, Task&& task) noexcept
+        {
+            std::function<bool __cdecl(size_t)> func;
+            try
+            {
+                func = std::forward<Task>(task);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return E_OUTOFMEMORY;
+            }
+
+            executor->ParallelFor(count, func);
+            return S_OK;
+        }
+
         //---------------------------------------------------------------------------------
         // Misc helper functions
         bool __cdecl IsAlphaAllOpaqueBC(_In_ const Image& cImage) noexcept;
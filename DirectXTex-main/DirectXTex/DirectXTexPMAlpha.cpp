@@ -22,6 +22,7 @@ namespace
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB_IN) == static_cast<int>(TEX_FILTER_SRGB_IN), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB_OUT) == static_cast<int>(TEX_FILTER_SRGB_OUT), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB) == static_cast<int>(TEX_FILTER_SRGB), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
+        static_assert(static_cast<int>(TEX_PMALPHA_SRGB_EXACT) == static_cast<int>(TEX_FILTER_SRGB_EXACT), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
         return static_cast<TEX_FILTER_FLAGS>(compress & TEX_FILTER_SRGB_MASK);
     }
 
@@ -73,7 +74,7 @@ namespace
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB_IN) == static_cast<int>(TEX_FILTER_SRGB_IN), "TEX_PMALHPA_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB_OUT) == static_cast<int>(TEX_FILTER_SRGB_OUT), "TEX_PMALHPA_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB) == static_cast<int>(TEX_FILTER_SRGB), "TEX_PMALHPA_SRGB* should match TEX_FILTER_SRGB*");
-        flags &= TEX_PMALPHA_SRGB;
+        flags &= (TEX_PMALPHA_SRGB | TEX_PMALPHA_SRGB_EXACT);
 
         auto scanline = make_AlignedArrayXMVECTOR(srcImage.width);
         if (!scanline)
@@ -161,7 +162,7 @@ namespace
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB_IN) == static_cast<int>(TEX_FILTER_SRGB_IN), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB_OUT) == static_cast<int>(TEX_FILTER_SRGB_OUT), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
         static_assert(static_cast<int>(TEX_PMALPHA_SRGB) == static_cast<int>(TEX_FILTER_SRGB), "TEX_PMALPHA_SRGB* should match TEX_FILTER_SRGB*");
-        flags &= TEX_PMALPHA_SRGB;
+        flags &= (TEX_PMALPHA_SRGB | TEX_PMALPHA_SRGB_EXACT);
 
         auto scanline = make_AlignedArrayXMVECTOR(srcImage.width);
         if (!scanline)
@@ -229,7 +230,7 @@ HRESULT DirectX::PremultiplyAlpha(
     if ((srcImage.width > UINT32_MAX) || (srcImage.height > UINT32_MAX))
         return E_INVALIDARG;
 
-    HRESULT hr = image.Initialize2D(srcImage.format, srcImage.width, srcImage.height, 1, 1);
+    HRESULT hr = image.Initialize2D(srcImage.format, srcImage.width, srcImage.height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -287,7 +288,7 @@ HRESULT DirectX::PremultiplyAlpha(
 
     TexMetadata mdata2 = metadata;
     mdata2.SetAlphaMode((flags & TEX_PMALPHA_REVERSE) ? TEX_ALPHA_MODE_STRAIGHT : TEX_ALPHA_MODE_PREMULTIPLIED);
-    HRESULT hr = result.Initialize(mdata2);
+    HRESULT hr = result.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
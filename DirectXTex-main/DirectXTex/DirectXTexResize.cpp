@@ -231,7 +231,10 @@ namespace
             break;
 
         case TEX_FILTER_TRIANGLE:
-            // WIC does not implement this filter
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_KAISER:
+        case TEX_FILTER_MITCHELL:
+            // WIC does not implement these filters
             return false;
 
         default:
@@ -470,11 +473,16 @@ namespace
         assert(srcImage.pixels && destImage.pixels);
         assert(srcImage.format == destImage.format);
 
-        // Allocate temporary space (5 scanlines, plus X and Y filters)
-        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(srcImage.width) * 4 + destImage.width);
+        // Allocate temporary space (1 source scanline and 1 target scanline, horizontally filtered rows are cached)
+        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(srcImage.width) + destImage.width);
         if (!scanline)
             return E_OUTOFMEMORY;
 
+        FilterRowCache rows;
+        HRESULT hr = rows.Initialize(4, destImage.width);
+        if (FAILED(hr))
+            return hr;
+
         std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[destImage.width + destImage.height]);
         if (!cf)
             return E_OUTOFMEMORY;
@@ -486,17 +494,10 @@ namespace
         CreateCubicFilter(srcImage.height, destImage.height, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
 
         XMVECTOR* target = scanline.get();
-
-        XMVECTOR* row0 = target + destImage.width;
-        XMVECTOR* row1 = row0 + srcImage.width;
-        XMVECTOR* row2 = row0 + srcImage.width * 2;
-        XMVECTOR* row3 = row0 + srcImage.width * 3;
+        XMVECTOR* row = target + destImage.width;
 
     #ifdef _DEBUG
-        memset(row0, 0xCD, sizeof(XMVECTOR)*srcImage.width);
-        memset(row1, 0xDD, sizeof(XMVECTOR)*srcImage.width);
-        memset(row2, 0xED, sizeof(XMVECTOR)*srcImage.width);
-        memset(row3, 0xFD, sizeof(XMVECTOR)*srcImage.width);
+        memset(row, 0xCD, sizeof(XMVECTOR)*srcImage.width);
     #endif
 
         const uint8_t* pSrc = srcImage.pixels;
@@ -504,114 +505,40 @@ namespace
 
         const size_t rowPitch = srcImage.rowPitch;
 
-        size_t u0 = size_t(-1);
-        size_t u1 = size_t(-1);
-        size_t u2 = size_t(-1);
-        size_t u3 = size_t(-1);
-
-        for (size_t y = 0; y < destImage.height; ++y)
+        // Each source row is filtered horizontally once, however many destination rows use it
+        auto getRow = [&](size_t v) noexcept -> const XMVECTOR*
         {
-            const auto& toY = cfY[y];
-
-            // Scanline 1
-            if (toY.u0 != u0)
+            bool load;
+            XMVECTOR* hrow = rows.Get(v, load);
+            if (load)
             {
-                if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
-                {
-                    u0 = toY.u0;
+                if (!LoadScanlineLinear(row, srcImage.width, pSrc + (rowPitch * v), rowPitch, srcImage.format, filter))
+                    return nullptr;
 
-                    if (!LoadScanlineLinear(row0, srcImage.width, pSrc + (rowPitch * u0), rowPitch, srcImage.format, filter))
-                        return E_FAIL;
-                }
-                else if (toY.u0 == u1)
+                for (size_t x = 0; x < destImage.width; ++x)
                 {
-                    u0 = u1;
-                    u1 = size_t(-1);
+                    const auto& toX = cfX[x];
 
-                    std::swap(row0, row1);
-                }
-                else if (toY.u0 == u2)
-                {
-                    u0 = u2;
-                    u2 = size_t(-1);
-
-                    std::swap(row0, row2);
-                }
-                else if (toY.u0 == u3)
-                {
-                    u0 = u3;
-                    u3 = size_t(-1);
-
-                    std::swap(row0, row3);
+                    CUBIC_INTERPOLATE(hrow[x], toX.x, row[toX.u0], row[toX.u1], row[toX.u2], row[toX.u3]);
                 }
             }
+            return hrow;
+        };
 
-            // Scanline 2
-            if (toY.u1 != u1)
-            {
-                if (toY.u1 != u2 && toY.u1 != u3)
-                {
-                    u1 = toY.u1;
-
-                    if (!LoadScanlineLinear(row1, srcImage.width, pSrc + (rowPitch * u1), rowPitch, srcImage.format, filter))
-                        return E_FAIL;
-                }
-                else if (toY.u1 == u2)
-                {
-                    u1 = u2;
-                    u2 = size_t(-1);
-
-                    std::swap(row1, row2);
-                }
-                else if (toY.u1 == u3)
-                {
-                    u1 = u3;
-                    u3 = size_t(-1);
-
-                    std::swap(row1, row3);
-                }
-            }
-
-            // Scanline 3
-            if (toY.u2 != u2)
-            {
-                if (toY.u2 != u3)
-                {
-                    u2 = toY.u2;
-
-                    if (!LoadScanlineLinear(row2, srcImage.width, pSrc + (rowPitch * u2), rowPitch, srcImage.format, filter))
-                        return E_FAIL;
-                }
-                else
-                {
-                    u2 = u3;
-                    u3 = size_t(-1);
-
-                    std::swap(row2, row3);
-                }
-            }
-
-            // Scanline 4
-            if (toY.u3 != u3)
-            {
-                u3 = toY.u3;
+        for (size_t y = 0; y < destImage.height; ++y)
+        {
+            const auto& toY = cfY[y];
 
-                if (!LoadScanlineLinear(row3, srcImage.width, pSrc + (rowPitch * u3), rowPitch, srcImage.format, filter))
-                    return E_FAIL;
-            }
+            const XMVECTOR* row0 = getRow(toY.u0);
+            const XMVECTOR* row1 = getRow(toY.u1);
+            const XMVECTOR* row2 = getRow(toY.u2);
+            const XMVECTOR* row3 = getRow(toY.u3);
+            if (!row0 || !row1 || !row2 || !row3)
+                return E_FAIL;
 
             for (size_t x = 0; x < destImage.width; ++x)
             {
-                const auto& toX = cfX[x];
-
-                XMVECTOR C0, C1, C2, C3;
-
-                CUBIC_INTERPOLATE(C0, toX.x, row0[toX.u0], row0[toX.u1], row0[toX.u2], row0[toX.u3]);
-                CUBIC_INTERPOLATE(C1, toX.x, row1[toX.u0], row1[toX.u1], row1[toX.u2], row1[toX.u3]);
-                CUBIC_INTERPOLATE(C2, toX.x, row2[toX.u0], row2[toX.u1], row2[toX.u2], row2[toX.u3]);
-                CUBIC_INTERPOLATE(C3, toX.x, row3[toX.u0], row3[toX.u1], row3[toX.u2], row3[toX.u3]);
-
-                CUBIC_INTERPOLATE(target[x], toY.x, C0, C1, C2, C3);
+                CUBIC_INTERPOLATE(target[x], toY.x, row0[x], row1[x], row2[x], row3[x]);
             }
 
             if (!StoreScanlineLinear(pDest, destImage.rowPitch, destImage.format, target, destImage.width, filter))
@@ -623,183 +550,86 @@ namespace
     }
 
 
-    //--- Triangle Filter ---
-    HRESULT ResizeTriangleFilter(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage) noexcept
-    {
-        using namespace DirectX::Filters;
-
-        assert(srcImage.pixels && destImage.pixels);
-        assert(srcImage.format == destImage.format);
+    //--- Separable kernel filters (Triangle, Lanczos, Kaiser, Mitchell) ---
+    constexpr size_t RESIZE_MIN_BAND_PIXELS = 16384;
+    constexpr size_t RESIZE_BAND_TAP_MULTIPLE = 8;
 
-        // Allocate initial temporary space (1 scanline, accumulation rows, plus X and Y filters)
-        auto scanline = make_AlignedArrayXMVECTOR(srcImage.width);
+    HRESULT ResizeKernelRows(
+        const Image& srcImage,
+        TEX_FILTER_FLAGS filter,
+        const Image& destImage,
+        const Filters::FilterKernel& kernelX,
+        const Filters::FilterKernel& kernelY,
+        size_t y0,
+        size_t y1) noexcept
+    {
+        // Allocate temporary space (1 source scanline and 1 target scanline, horizontally filtered rows are cached)
+        auto scanline = make_AlignedArrayXMVECTOR(uint64_t(srcImage.width) + destImage.width);
         if (!scanline)
             return E_OUTOFMEMORY;
 
-        std::unique_ptr<TriangleRow[]> rowActive(new (std::nothrow) TriangleRow[destImage.height]);
-        if (!rowActive)
-            return E_OUTOFMEMORY;
+        return Filters::FilterKernelRows(srcImage, filter, destImage, kernelX, kernelY, y0, y1,
+            Filters::FILTER_MAX_ROW_CACHE_BYTES, scanline.get());
+    }
+
+    HRESULT ResizeKernelFilter(
+        const Image& srcImage,
+        TEX_FILTER_FLAGS filter,
+        const Image& destImage,
+        Filters::FILTER_KERNEL_TYPE type) noexcept
+    {
+        using namespace DirectX::Filters;
 
-        TriangleRow * rowFree = nullptr;
+        assert(srcImage.pixels && destImage.pixels);
+        assert(srcImage.format == destImage.format);
 
-        std::unique_ptr<Filter> tfX;
-        HRESULT hr = CreateTriangleFilter(srcImage.width, destImage.width, (filter & TEX_FILTER_WRAP_U) != 0, tfX);
+        FilterKernel localX, localY;
+        const FilterKernel* kernelX = nullptr;
+        HRESULT hr = GetFilterKernel(type, srcImage.width, destImage.width,
+            (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, localX, &kernelX);
         if (FAILED(hr))
             return hr;
 
-        std::unique_ptr<Filter> tfY;
-        hr = CreateTriangleFilter(srcImage.height, destImage.height, (filter & TEX_FILTER_WRAP_V) != 0, tfY);
+        const FilterKernel* kernelY = nullptr;
+        hr = GetFilterKernel(type, srcImage.height, destImage.height,
+            (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, localY, &kernelY);
         if (FAILED(hr))
             return hr;
 
-        XMVECTOR* row = scanline.get();
-
-    #ifdef _DEBUG
-        memset(row, 0xCD, sizeof(XMVECTOR)*srcImage.width);
-    #endif
-
-        auto xFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfX.get()) + tfX->sizeInBytes);
-        auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY.get()) + tfY->sizeInBytes);
-
-        // Count times rows get written
-        for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+        const size_t height = destImage.height;
+        if (!(filter & TEX_FILTER_PARALLEL) || (uint64_t(destImage.width) * uint64_t(height)) <= RESIZE_MIN_BAND_PIXELS)
         {
-            for (size_t j = 0; j < yFrom->count; ++j)
-            {
-                const size_t v = yFrom->to[j].u;
-                assert(v < destImage.height);
-                ++rowActive[v].remaining;
-            }
-
-            yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
+            return ResizeKernelRows(srcImage, filter, destImage, *kernelX, *kernelY, 0, height);
         }
 
-        // Filter image
-        const uint8_t* pSrc = srcImage.pixels;
-        const size_t rowPitch = srcImage.rowPitch;
-        const uint8_t* pEndSrc = pSrc + rowPitch * srcImage.height;
+        // Bands of destination rows are independent; source rows shared by the kernels of adjacent bands are
+        // filtered by both, so bands are kept tall relative to the kernel to limit the duplicated work
+        const size_t rows = std::min<size_t>(height,
+            std::max<size_t>((RESIZE_MIN_BAND_PIXELS + destImage.width - 1) / destImage.width, kernelY->maxTaps * RESIZE_BAND_TAP_MULTIPLE));
+        const size_t nBands = (height + rows - 1) / rows;
 
-        uint8_t* pDest = destImage.pixels;
+        std::atomic<HRESULT> result(S_OK);
 
-        for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+        hr = ParallelFor(GetDefaultTaskExecutor(), nBands, [&](size_t band) -> bool
         {
-            // Create accumulation rows as needed
-            for (size_t j = 0; j < yFrom->count; ++j)
-            {
-                const size_t v = yFrom->to[j].u;
-                assert(v < destImage.height);
-                TriangleRow* rowAcc = &rowActive[v];
-
-                if (!rowAcc->scanline)
-                {
-                    if (rowFree)
-                    {
-                        // Steal and reuse scanline from 'free row' list
-                        assert(rowFree->scanline != nullptr);
-                        rowAcc->scanline.reset(rowFree->scanline.release());
-                        rowFree = rowFree->next;
-                    }
-                    else
-                    {
-                        auto nscanline = make_AlignedArrayXMVECTOR(destImage.width);
-                        if (!nscanline)
-                            return E_OUTOFMEMORY;
-                        rowAcc->scanline.swap(nscanline);
-                    }
-
-                    memset(rowAcc->scanline.get(), 0, sizeof(XMVECTOR) * destImage.width);
-                }
-            }
-
-            // Load source scanline
-            if ((pSrc + rowPitch) > pEndSrc)
-                return E_FAIL;
-
-            if (!LoadScanlineLinear(row, srcImage.width, pSrc, rowPitch, srcImage.format, filter))
-                return E_FAIL;
-
-            pSrc += rowPitch;
-
-            // Process row
-            size_t x = 0;
-            for (FilterFrom* xFrom = tfX->from; xFrom < xFromEnd; ++x)
-            {
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    const size_t v = yFrom->to[j].u;
-                    assert(v < destImage.height);
-                    const float yweight = yFrom->to[j].weight;
-
-                    XMVECTOR* accPtr = rowActive[v].scanline.get();
-                    if (!accPtr)
-                        return E_POINTER;
-
-                    for (size_t k = 0; k < xFrom->count; ++k)
-                    {
-                        size_t u = xFrom->to[k].u;
-                        assert(u < destImage.width);
-
-                        const XMVECTOR weight = XMVectorReplicate(yweight * xFrom->to[k].weight);
-
-                        assert(x < srcImage.width);
-                        accPtr[u] = XMVectorMultiplyAdd(row[x], weight, accPtr[u]);
-                    }
-                }
-
-                xFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(xFrom) + xFrom->sizeInBytes);
-            }
+            if (FAILED(result.load(std::memory_order_relaxed)))
+                return false;
 
-            // Write completed accumulation rows
-            for (size_t j = 0; j < yFrom->count; ++j)
+            const size_t y0 = band * rows;
+            const HRESULT bhr = ResizeKernelRows(srcImage, filter, destImage, *kernelX, *kernelY, y0, std::min<size_t>(height, y0 + rows));
+            if (FAILED(bhr))
             {
-                size_t v = yFrom->to[j].u;
-                assert(v < destImage.height);
-                TriangleRow* rowAcc = &rowActive[v];
-
-                assert(rowAcc->remaining > 0);
-                --rowAcc->remaining;
-
-                if (!rowAcc->remaining)
-                {
-                    XMVECTOR* pAccSrc = rowAcc->scanline.get();
-                    if (!pAccSrc)
-                        return E_POINTER;
-
-                    switch (destImage.format)
-                    {
-                    case DXGI_FORMAT_R10G10B10A2_UNORM:
-                    case DXGI_FORMAT_R10G10B10A2_UINT:
-                        {
-                            // Need to slightly bias results for floating-point error accumulation which can
-                            // be visible with harshly quantized values
-                            static const XMVECTORF32 Bias = { { { 0.f, 0.f, 0.f, 0.1f } } };
-
-                            XMVECTOR* ptr = pAccSrc;
-                            for (size_t i = 0; i < destImage.width; ++i, ++ptr)
-                            {
-                                *ptr = XMVectorAdd(*ptr, Bias);
-                            }
-                        }
-                        break;
-
-                    default:
-                        break;
-                    }
-
-                    // This performs any required clamping
-                    if (!StoreScanlineLinear(pDest + (destImage.rowPitch * v), destImage.rowPitch, destImage.format, pAccSrc, destImage.width, filter))
-                        return E_FAIL;
-
-                    // Put row on freelist to reuse it's allocated scanline
-                    rowAcc->next = rowFree;
-                    rowFree = rowAcc;
-                }
+                HRESULT expected = S_OK;
+                result.compare_exchange_strong(expected, bhr);
+                return false;
             }
 
-            yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
-        }
+            return true;
+        });
+        if (FAILED(hr))
+            return hr;
 
-        return S_OK;
+        return result.load();
     }
 
 
@@ -834,7 +664,16 @@ namespace
             return ResizeCubicFilter(srcImage, filter, destImage);
 
         case TEX_FILTER_TRIANGLE:
-            return ResizeTriangleFilter(srcImage, filter, destImage);
+            return ResizeKernelFilter(srcImage, filter, destImage, Filters::FILTER_KERNEL_TRIANGLE);
+
+        case TEX_FILTER_LANCZOS:
+            return ResizeKernelFilter(srcImage, filter, destImage, Filters::FILTER_KERNEL_LANCZOS);
+
+        case TEX_FILTER_KAISER:
+            return ResizeKernelFilter(srcImage, filter, destImage, Filters::FILTER_KERNEL_KAISER);
+
+        case TEX_FILTER_MITCHELL:
+            return ResizeKernelFilter(srcImage, filter, destImage, Filters::FILTER_KERNEL_MITCHELL);
 
         default:
             return HRESULT_E_NOT_SUPPORTED;
@@ -897,7 +736,7 @@ HRESULT DirectX::Resize(
     }
 #endif // WIN32
 
-    HRESULT hr = image.Initialize2D(srcImage.format, width, height, 1, 1);
+    HRESULT hr = image.Initialize2D(srcImage.format, width, height, 1, 1, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -959,7 +798,7 @@ HRESULT DirectX::Resize(
     mdata2.width = width;
     mdata2.height = height;
     mdata2.mipLevels = 1;
-    HRESULT hr = result.Initialize(mdata2);
+    HRESULT hr = result.Initialize(mdata2, CP_FLAGS_REUSE_MEMORY);
     if (FAILED(hr))
         return hr;
 
@@ -1639,6 +1639,211 @@ uint32_t TexMetadata::CalculateSubresource(size_t mip, size_t item, size_t plane
 }
 
 
+//=====================================================================================
+// Memory allocators
+//=====================================================================================
+
+namespace
+{
+    class AlignedAllocator final : public IMemoryAllocator
+    {
+    public:
+        void* __cdecl Allocate(size_t size, size_t alignment) noexcept override
+        {
+            return _aligned_malloc(size, alignment);
+        }
+
+        void __cdecl Free(void* ptr, size_t) noexcept override
+        {
+            if (ptr)
+            {
+                _aligned_free(ptr);
+            }
+        }
+    };
+
+    AlignedAllocator g_AlignedAllocator;
+
+    std::atomic<IMemoryAllocator*> g_MemoryAllocator(&g_AlignedAllocator);
+
+    //---------------------------------------------------------------------------------
+    // Size-class pool: blocks of 32K or more are rounded up to one of four classes per
+    // power of two (at most 25% slack) and kept on a per-class free list when released.
+    //---------------------------------------------------------------------------------
+    constexpr size_t POOL_MIN_SHIFT = 15;
+    constexpr size_t POOL_CLASSES = (sizeof(size_t) * 8 - POOL_MIN_SHIFT) * 4;
+    constexpr size_t POOL_ALIGNMENT = 64;
+    constexpr size_t POOL_DEFAULT_LIMIT = 256 * 1024 * 1024;
+
+    class MemoryPool final : public IMemoryAllocator
+    {
+    public:
+        MemoryPool() noexcept : m_cached(0), m_limit(POOL_DEFAULT_LIMIT), m_freeLists{} {}
+
+        MemoryPool(const MemoryPool&) = delete;
+        MemoryPool& operator=(const MemoryPool&) = delete;
+
+        void* __cdecl Allocate(size_t size, size_t alignment) noexcept override
+        {
+            if (size <= (size_t(1) << POOL_MIN_SHIFT))
+                return _aligned_malloc(size, alignment);
+
+            if (alignment > POOL_ALIGNMENT)
+                return nullptr;
+
+            size_t index;
+            const size_t classSize = SizeClass(size, index);
+            if (!classSize)
+                return nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                FreeBlock* block = m_freeLists[index];
+                if (block)
+                {
+                    m_freeLists[index] = block->next;
+                    m_cached -= classSize;
+                    return block;
+                }
+            }
+
+            return _aligned_malloc(classSize, POOL_ALIGNMENT);
+        }
+
+        void __cdecl Free(void* ptr, size_t size) noexcept override
+        {
+            if (!ptr)
+                return;
+
+            if (size <= (size_t(1) << POOL_MIN_SHIFT))
+            {
+                _aligned_free(ptr);
+                return;
+            }
+
+            size_t index;
+            const size_t classSize = SizeClass(size, index);
+
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (m_cached + classSize <= m_limit)
+                {
+                    auto block = static_cast<FreeBlock*>(ptr);
+                    block->next = m_freeLists[index];
+                    m_freeLists[index] = block;
+                    m_cached += classSize;
+                    return;
+                }
+            }
+
+            _aligned_free(ptr);
+        }
+
+        void SetLimit(size_t limit) noexcept
+        {
+            FreeBlock* release = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_limit = limit;
+
+                // Drop the largest classes first, they are the most likely to be stranded
+                for (size_t index = POOL_CLASSES; index-- > 0 && m_cached > m_limit; )
+                {
+                    const size_t classSize = ClassSize(index);
+                    while (m_freeLists[index] && m_cached > m_limit)
+                    {
+                        FreeBlock* block = m_freeLists[index];
+                        m_freeLists[index] = block->next;
+                        m_cached -= classSize;
+
+                        block->next = release;
+                        release = block;
+                    }
+                }
+            }
+
+            while (release)
+            {
+                FreeBlock* next = release->next;
+                _aligned_free(release);
+                release = next;
+            }
+        }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        std::mutex  m_lock;
+        size_t      m_cached;
+        size_t      m_limit;
+        FreeBlock*  m_freeLists[POOL_CLASSES];
+
+        // Returns the class size (0 if too large) and its free-list index for size > 32K
+        static size_t SizeClass(size_t size, size_t& index) noexcept
+        {
+            assert(size > (size_t(1) << POOL_MIN_SHIFT));
+
+            size_t msb = 0;
+            for (size_t s = size - 1; s > 1; s >>= 1)
+                ++msb;
+
+            const size_t step = size_t(1) << (msb - 2);
+            const size_t steps = (size - 1) / step + 1;
+            index = (msb - POOL_MIN_SHIFT) * 4 + (steps - 5);
+
+            if (msb + 1 >= sizeof(size_t) * 8)
+                return 0;
+
+            return steps * step;
+        }
+
+        static size_t ClassSize(size_t index) noexcept
+        {
+            const size_t msb = index / 4 + POOL_MIN_SHIFT;
+            return (index % 4 + 5) << (msb - 2);
+        }
+    };
+
+    MemoryPool* GetMemoryPool() noexcept
+    {
+        // Never destroyed: images released during static destruction may still return blocks to it
+        static MemoryPool* s_pool = new (std::nothrow) MemoryPool;
+        return s_pool;
+    }
+}
+
+IMemoryAllocator* DirectX::GetPooledMemoryAllocator() noexcept
+{
+    MemoryPool* pool = GetMemoryPool();
+    return (pool) ? static_cast<IMemoryAllocator*>(pool) : &g_AlignedAllocator;
+}
+
+_Use_decl_annotations_
+void DirectX::SetPooledMemoryLimit(size_t maxCachedBytes) noexcept
+{
+    MemoryPool* pool = GetMemoryPool();
+    if (pool)
+    {
+        pool->SetLimit(maxCachedBytes);
+    }
+}
+
+IMemoryAllocator* DirectX::GetMemoryAllocator() noexcept
+{
+    return g_MemoryAllocator.load(std::memory_order_acquire);
+}
+
+_Use_decl_annotations_
+void DirectX::SetMemoryAllocator(IMemoryAllocator* allocator) noexcept
+{
+    g_MemoryAllocator.store((allocator) ? allocator : &g_AlignedAllocator, std::memory_order_release);
+}
+
+
 //=====================================================================================
 // Blob - Bitmap image container
 //=====================================================================================
@@ -1651,9 +1856,13 @@ Blob& Blob::operator= (Blob&& moveFrom) noexcept
 
         m_buffer = moveFrom.m_buffer;
         m_size = moveFrom.m_size;
+        m_capacity = moveFrom.m_capacity;
+        m_allocator = moveFrom.m_allocator;
 
         moveFrom.m_buffer = nullptr;
         moveFrom.m_size = 0;
+        moveFrom.m_capacity = 0;
+        moveFrom.m_allocator = nullptr;
     }
     return *this;
 }
@@ -1662,11 +1871,13 @@ void Blob::Release() noexcept
 {
     if (m_buffer)
     {
-        _aligned_free(m_buffer);
+        m_allocator->Free(m_buffer, m_capacity);
         m_buffer = nullptr;
     }
 
     m_size = 0;
+    m_capacity = 0;
+    m_allocator = nullptr;
 }
 
 _Use_decl_annotations_
@@ -1677,14 +1888,15 @@ HRESULT Blob::Initialize(size_t size) noexcept
 
     Release();
 
-    m_buffer = reinterpret_cast<uint8_t*>(_aligned_malloc(size, 16));
+    m_allocator = GetMemoryAllocator();
+    m_buffer = static_cast<uint8_t*>(m_allocator->Allocate(size, 16));
     if (!m_buffer)
     {
         Release();
         return E_OUTOFMEMORY;
     }
 
-    m_size = size;
+    m_size = m_capacity = size;
 
     return S_OK;
 }
@@ -1713,7 +1925,8 @@ HRESULT Blob::Resize(size_t size) noexcept
     if (!m_buffer || !m_size)
         return E_UNEXPECTED;
 
-    auto tbuffer = reinterpret_cast<uint8_t*>(_aligned_malloc(size, 16));
+    IMemoryAllocator* allocator = GetMemoryAllocator();
+    auto tbuffer = static_cast<uint8_t*>(allocator->Allocate(size, 16));
     if (!tbuffer)
         return E_OUTOFMEMORY;
 
@@ -1722,7 +1935,275 @@ HRESULT Blob::Resize(size_t size) noexcept
     Release();
 
     m_buffer = tbuffer;
-    m_size = size;
+    m_size = m_capacity = size;
+    m_allocator = allocator;
 
     return S_OK;
 }
+
+
+//=====================================================================================
+// Default task executor - work-stealing thread pool
+//=====================================================================================
+
+namespace
+{
+    class TaskPool final : public ITaskExecutor
+    {
+    public:
+        TaskPool() noexcept :
+            m_queueCount(0),
+            m_nextQueue(0),
+            m_available(0),
+            m_shutdown(false)
+        {
+            // The thread calling ParallelFor also runs ranges, so one fewer worker than hardware threads
+            const unsigned int hwthreads = std::thread::hardware_concurrency();
+            if (hwthreads <= 1)
+                return;
+
+            const size_t nworkers = hwthreads - 1;
+            m_queues.reset(new (std::nothrow) TaskQueue[nworkers]);
+            if (!m_queues)
+                return;
+
+            m_queueCount = nworkers;
+
+            try
+            {
+                m_workers.reserve(nworkers);
+                for (size_t j = 0; j < nworkers; ++j)
+                {
+                    m_workers.emplace_back(&TaskPool::WorkerLoop, this, j);
+                }
+            }
+            catch (...)
+            {
+                // Run with however many workers were started; queues without an owner are drained by stealing
+            }
+        }
+
+        TaskPool(TaskPool&&) = delete;
+        TaskPool& operator= (TaskPool&&) = delete;
+
+        TaskPool(TaskPool const&) = delete;
+        TaskPool& operator= (TaskPool const&) = delete;
+
+        ~TaskPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_wakeLock);
+                m_shutdown = true;
+            }
+            m_wake.notify_all();
+
+            for (auto& it : m_workers)
+            {
+                if (it.joinable())
+                    it.join();
+            }
+        }
+
+        void __cdecl ParallelFor(size_t count, const std::function<bool __cdecl(size_t)>& task) noexcept override
+        {
+            if (!count)
+                return;
+
+            if (m_workers.empty() || count == 1)
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    if (!task(index))
+                        break;
+                }
+                return;
+            }
+
+            // Over-split so that idle threads have something to steal when per-index costs vary
+            const size_t nranges = std::min<size_t>(count, (m_workers.size() + 1) * 4);
+            const size_t rangeSize = (count + nranges - 1) / nranges;
+
+            TaskJob job;
+            job.task = &task;
+            job.pending = (count + rangeSize - 1) / rangeSize;
+            job.cancelled = false;
+
+            size_t queued = 0;
+            size_t q = m_nextQueue.fetch_add(1, std::memory_order_relaxed);
+            for (size_t begin = 0; begin < count; begin += rangeSize, ++q)
+            {
+                const TaskRange range = { &job, begin, std::min(begin + rangeSize, count) };
+
+                bool pushed = false;
+                try
+                {
+                    TaskQueue& queue = m_queues[q % m_queueCount];
+                    std::lock_guard<std::mutex> lock(queue.lock);
+                    queue.ranges.push_back(range);
+                    m_available.fetch_add(1, std::memory_order_release);
+                    pushed = true;
+                }
+                catch (...)
+                {
+                }
+
+                if (pushed)
+                {
+                    ++queued;
+                }
+                else
+                {
+                    Run(range);
+                }
+            }
+
+            if (queued > 0)
+            {
+                {
+                    // Pairs with the predicate check in WorkerLoop so a worker about to sleep can't miss the wakeup
+                    std::lock_guard<std::mutex> lock(m_wakeLock);
+                }
+                m_wake.notify_all();
+
+                // Help out until nothing is left to take, then wait for whatever other threads are still running
+                TaskRange range;
+                while (job.pending.load(std::memory_order_acquire) > 0 && Pop(0, range))
+                {
+                    Run(range);
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(job.lock);
+            job.done.wait(lock, [&job] { return job.pending.load(std::memory_order_acquire) == 0; });
+        }
+
+    private:
+        struct TaskJob
+        {
+            const std::function<bool __cdecl(size_t)>*  task;
+            std::atomic<size_t>                         pending;
+            std::atomic<bool>                           cancelled;
+            std::mutex                                  lock;
+            std::condition_variable                     done;
+        };
+
+        struct TaskRange
+        {
+            TaskJob*    job;
+            size_t      begin;
+            size_t      end;
+        };
+
+        struct TaskQueue
+        {
+            std::mutex              lock;
+            std::deque<TaskRange>   ranges;
+        };
+
+        std::unique_ptr<TaskQueue[]>    m_queues;
+        size_t                          m_queueCount;
+        std::vector<std::thread>        m_workers;
+        std::atomic<size_t>             m_nextQueue;
+        std::atomic<size_t>             m_available;
+        std::mutex                      m_wakeLock;
+        std::condition_variable         m_wake;
+        bool                            m_shutdown;
+
+        // Takes the most recently queued range from the home queue, otherwise steals the oldest range from another
+        bool Pop(size_t home, TaskRange& range) noexcept
+        {
+            for (size_t j = 0; j < m_queueCount; ++j)
+            {
+                TaskQueue& queue = m_queues[(home + j) % m_queueCount];
+                std::lock_guard<std::mutex> lock(queue.lock);
+                if (queue.ranges.empty())
+                    continue;
+
+                if (!j)
+                {
+                    range = queue.ranges.back();
+                    queue.ranges.pop_back();
+                }
+                else
+                {
+                    range = queue.ranges.front();
+                    queue.ranges.pop_front();
+                }
+
+                m_available.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            return false;
+        }
+
+        static void Run(const TaskRange& range) noexcept
+        {
+            TaskJob* job = range.job;
+            for (size_t index = range.begin; index < range.end; ++index)
+            {
+                if (job->cancelled.load(std::memory_order_relaxed))
+                    break;
+
+                if (!(*job->task)(index))
+                {
+                    job->cancelled.store(true, std::memory_order_relaxed);
+                    break;
+                }
+            }
+
+            // The owner may destroy the job as soon as pending reaches zero, so this must be the last access
+            std::lock_guard<std::mutex> lock(job->lock);
+            if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                job->done.notify_all();
+            }
+        }
+
+        void WorkerLoop(size_t home) noexcept
+        {
+            for (;;)
+            {
+                TaskRange range;
+                if (Pop(home, range))
+                {
+                    Run(range);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_wakeLock);
+                m_wake.wait(lock, [this] { return m_shutdown || m_available.load(std::memory_order_acquire) > 0; });
+                if (m_shutdown)
+                    return;
+            }
+        }
+    };
+
+    // Fallback when the pool itself cannot be allocated
+    class SerialExecutor final : public ITaskExecutor
+    {
+    public:
+        void __cdecl ParallelFor(size_t count, const std::function<bool __cdecl(size_t)>& task) noexcept override
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                if (!task(index))
+                    break;
+            }
+        }
+    };
+}
+
+ITaskExecutor* DirectX::GetDefaultTaskExecutor() noexcept
+{
+    // Intentionally never destroyed: joining the workers from a static destructor can deadlock under the loader lock
+    // during DLL unload, and the OS reclaims the threads at process exit anyway
+    static TaskPool* s_pool = new (std::nothrow) TaskPool;
+    if (!s_pool)
+    {
+        static SerialExecutor s_serial;
+        return &s_serial;
+    }
+
+    return s_pool;
+}
@@ -13,6 +13,7 @@
 #include <DirectXPackedVector.h>
 
 #include <memory>
+#include <mutex>
 
 #include "scoped.h"
 
@@ -418,5 +419,592 @@ namespace DirectX
             return S_OK;
         }
 
+        //-------------------------------------------------------------------------------------
+        // Separable filter kernels
+        //
+        // Gather form of a 1D filter: a contiguous run of source indices and weights for each
+        // destination texel. A 2D filter is applied as a horizontal pass over each source row
+        // followed by a vertical pass over the horizontally filtered rows.
+        //-------------------------------------------------------------------------------------
+
+        struct FilterKernel
+        {
+            size_t                          source;
+            size_t                          dest;
+            size_t                          maxTaps;
+            std::unique_ptr<size_t[]>       first;  // dest + 1 entries, taps of texel u are [first[u], first[u + 1])
+            std::unique_ptr<FilterTo[]>     taps;
+
+            FilterKernel() noexcept : source(0), dest(0), maxTaps(0) {}
+        };
+
+        enum FILTER_KERNEL_TYPE : uint32_t
+        {
+            FILTER_KERNEL_TRIANGLE = 0,
+            FILTER_KERNEL_LANCZOS,
+            FILTER_KERNEL_KAISER,
+            FILTER_KERNEL_MITCHELL,
+        };
+
+        // Builds the gather form of CreateTriangleFilter, keeping taps in ascending source order
+        inline HRESULT CreateTriangleKernel(_In_ size_t source, _In_ size_t dest, _In_ bool wrap, _Inout_ FilterKernel& kernel) noexcept
+        {
+            std::unique_ptr<Filter> tf;
+            HRESULT hr = CreateTriangleFilter(source, dest, wrap, tf);
+            if (FAILED(hr))
+                return hr;
+
+            std::unique_ptr<size_t[]> first(new (std::nothrow) size_t[dest + 1]);
+            std::unique_ptr<size_t[]> next(new (std::nothrow) size_t[dest]);
+            if (!first || !next)
+                return E_OUTOFMEMORY;
+
+            memset(first.get(), 0, sizeof(size_t) * (dest + 1));
+
+            auto fromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tf.get()) + tf->sizeInBytes);
+
+            for (const FilterFrom* from = tf->from; from < fromEnd; )
+            {
+                for (size_t j = 0; j < from->count; ++j)
+                {
+                    const size_t u = from->to[j].u;
+                    if (u >= dest)
+                        return E_FAIL;
+
+                    ++first[u + 1];
+                }
+
+                from = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(from) + from->sizeInBytes);
+            }
+
+            size_t maxTaps = 0;
+            for (size_t u = 0; u < dest; ++u)
+            {
+                maxTaps = std::max<size_t>(maxTaps, first[u + 1]);
+                first[u + 1] += first[u];
+                next[u] = first[u];
+            }
+
+            std::unique_ptr<FilterTo[]> taps(new (std::nothrow) FilterTo[std::max<size_t>(first[dest], 1)]);
+            if (!taps)
+                return E_OUTOFMEMORY;
+
+            size_t u = 0;
+            for (const FilterFrom* from = tf->from; from < fromEnd; ++u)
+            {
+                for (size_t j = 0; j < from->count; ++j)
+                {
+                    FilterTo& tap = taps[next[from->to[j].u]++];
+                    tap.u = u;
+                    tap.weight = from->to[j].weight;
+                }
+
+                from = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(from) + from->sizeInBytes);
+            }
+
+            kernel.source = source;
+            kernel.dest = dest;
+            kernel.maxTaps = maxTaps;
+            kernel.first = std::move(first);
+            kernel.taps = std::move(taps);
+
+            return S_OK;
+        }
+
+        //-------------------------------------------------------------------------------------
+        // Windowed-sinc (Lanczos-3, Kaiser) and Mitchell-Netravali kernels
+        //-------------------------------------------------------------------------------------
+
+        constexpr double FK_PI = 3.14159265358979323846;
+        constexpr double FK_KAISER_ALPHA = 4.0;
+        constexpr double FK_MITCHELL_B = 1.0 / 3.0;
+        constexpr double FK_MITCHELL_C = 1.0 / 3.0;
+
+        inline double FilterSinc(double x) noexcept
+        {
+            if (std::abs(x) < 1e-8)
+                return 1.0;
+
+            x *= FK_PI;
+            return std::sin(x) / x;
+        }
+
+        // Modified Bessel function of the first kind, order zero
+        inline double FilterBesselI0(double x) noexcept
+        {
+            const double q = x * x * 0.25;
+
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 64; ++k)
+            {
+                term *= q / double(k * k);
+                sum += term;
+                if (term < sum * 1e-12)
+                    break;
+            }
+
+            return sum;
+        }
+
+        inline double GetFilterKernelRadius(FILTER_KERNEL_TYPE type) noexcept
+        {
+            switch (type)
+            {
+            case FILTER_KERNEL_LANCZOS:
+            case FILTER_KERNEL_KAISER:
+                return 3.0;
+
+            case FILTER_KERNEL_MITCHELL:
+                return 2.0;
+
+            default:
+                return 1.0;
+            }
+        }
+
+        inline double EvaluateFilterKernel(FILTER_KERNEL_TYPE type, double x) noexcept
+        {
+            x = std::abs(x);
+
+            switch (type)
+            {
+            case FILTER_KERNEL_LANCZOS:
+                return (x < 3.0) ? FilterSinc(x) * FilterSinc(x / 3.0) : 0.0;
+
+            case FILTER_KERNEL_KAISER:
+                if (x < 3.0)
+                {
+                    const double t = x / 3.0;
+                    return FilterSinc(x) * FilterBesselI0(FK_KAISER_ALPHA * std::sqrt(1.0 - t * t)) / FilterBesselI0(FK_KAISER_ALPHA);
+                }
+                return 0.0;
+
+            case FILTER_KERNEL_MITCHELL:
+                {
+                    constexpr double B = FK_MITCHELL_B;
+                    constexpr double C = FK_MITCHELL_C;
+
+                    if (x < 1.0)
+                    {
+                        return ((12.0 - 9.0 * B - 6.0 * C) * x * x * x
+                            + (-18.0 + 12.0 * B + 6.0 * C) * x * x
+                            + (6.0 - 2.0 * B)) / 6.0;
+                    }
+                    else if (x < 2.0)
+                    {
+                        return ((-B - 6.0 * C) * x * x * x
+                            + (6.0 * B + 30.0 * C) * x * x
+                            + (-12.0 * B - 48.0 * C) * x
+                            + (8.0 * B + 24.0 * C)) / 6.0;
+                    }
+                }
+                return 0.0;
+
+            default:
+                return 0.0;
+            }
+        }
+
+        // Maps a tap position outside of [0, source) according to the addressing mode
+        inline size_t AddressFilterTap(ptrdiff_t i, size_t source, bool wrap, bool mirror) noexcept
+        {
+            const auto n = static_cast<ptrdiff_t>(source);
+
+            if (wrap)
+            {
+                i %= n;
+                if (i < 0)
+                    i += n;
+            }
+            else if (mirror)
+            {
+                const ptrdiff_t period = n * 2;
+                i %= period;
+                if (i < 0)
+                    i += period;
+                if (i >= n)
+                    i = period - 1 - i;
+            }
+            else
+            {
+                i = std::min<ptrdiff_t>(std::max<ptrdiff_t>(i, 0), n - 1);
+            }
+
+            return size_t(i);
+        }
+
+        // Kernels are stretched by the scale factor when minifying so they also act as the low-pass filter
+        inline HRESULT CreateWindowedKernel(
+            _In_ FILTER_KERNEL_TYPE type, _In_ size_t source, _In_ size_t dest, _In_ bool wrap, _In_ bool mirror,
+            _Inout_ FilterKernel& kernel) noexcept
+        {
+            assert(source > 0);
+            assert(dest > 0);
+
+            const double scale = double(source) / double(dest);
+            const double support = std::max(1.0, scale);
+            const double radius = GetFilterKernelRadius(type) * support;
+
+            const size_t maxSpan = size_t(radius * 2.0) + 2;
+            const uint64_t totalTaps = uint64_t(maxSpan) * uint64_t(dest);
+            if (totalTaps > UINT32_MAX)
+                return HRESULT_E_ARITHMETIC_OVERFLOW;
+
+            std::unique_ptr<size_t[]> first(new (std::nothrow) size_t[dest + 1]);
+            std::unique_ptr<FilterTo[]> taps(new (std::nothrow) FilterTo[size_t(totalTaps)]);
+            if (!first || !taps)
+                return E_OUTOFMEMORY;
+
+            size_t count = 0;
+            size_t maxTaps = 0;
+            for (size_t u = 0; u < dest; ++u)
+            {
+                first[u] = count;
+
+                const double center = (double(u) + 0.5) * scale - 0.5;
+                const auto i0 = static_cast<ptrdiff_t>(std::ceil(center - radius));
+                const auto i1 = static_cast<ptrdiff_t>(std::floor(center + radius));
+
+                double total = 0.0;
+                for (ptrdiff_t i = i0; i <= i1; ++i)
+                {
+                    total += EvaluateFilterKernel(type, (double(i) - center) / support);
+                }
+
+                if (std::abs(total) < 1e-8)
+                {
+                    // Degenerate footprint, use the nearest texel
+                    FilterTo& tap = taps[count++];
+                    tap.u = AddressFilterTap(static_cast<ptrdiff_t>(std::floor(center + 0.5)), source, wrap, mirror);
+                    tap.weight = 1.f;
+                }
+                else
+                {
+                    for (ptrdiff_t i = i0; i <= i1; ++i)
+                    {
+                        const double w = EvaluateFilterKernel(type, (double(i) - center) / support);
+                        if (w == 0.0)
+                            continue;
+
+                        const size_t su = AddressFilterTap(i, source, wrap, mirror);
+                        if (count > first[u] && taps[count - 1].u == su)
+                        {
+                            // Clamping repeats the edge texel
+                            taps[count - 1].weight += float(w / total);
+                            continue;
+                        }
+
+                        assert(count < totalTaps);
+                        FilterTo& tap = taps[count++];
+                        tap.u = su;
+                        tap.weight = float(w / total);
+                    }
+                }
+
+                maxTaps = std::max<size_t>(maxTaps, count - first[u]);
+            }
+            first[dest] = count;
+
+            kernel.source = source;
+            kernel.dest = dest;
+            kernel.maxTaps = maxTaps;
+            kernel.first = std::move(first);
+            kernel.taps = std::move(taps);
+
+            return S_OK;
+        }
+
+        inline HRESULT CreateFilterKernel(
+            _In_ FILTER_KERNEL_TYPE type, _In_ size_t source, _In_ size_t dest, _In_ bool wrap, _In_ bool mirror,
+            _Inout_ FilterKernel& kernel) noexcept
+        {
+            switch (type)
+            {
+            case FILTER_KERNEL_TRIANGLE:
+                return CreateTriangleKernel(source, dest, wrap, kernel);
+
+            case FILTER_KERNEL_LANCZOS:
+            case FILTER_KERNEL_KAISER:
+            case FILTER_KERNEL_MITCHELL:
+                return CreateWindowedKernel(type, source, dest, wrap, mirror, kernel);
+
+            default:
+                return E_INVALIDARG;
+            }
+        }
+
+        constexpr size_t FK_CACHE_ENTRIES = 32;
+        constexpr size_t FK_CACHE_MAX_TAPS = 4 * 1024 * 1024;
+
+        // Returns a kernel from a process-wide cache keyed by (type, source, dest, wrap, mirror). Cached kernels
+        // are immutable and live until exit. Once the cache is full, the kernel is built into 'local' instead.
+        inline HRESULT GetFilterKernel(
+            _In_ FILTER_KERNEL_TYPE type, _In_ size_t source, _In_ size_t dest, _In_ bool wrap, _In_ bool mirror,
+            _Inout_ FilterKernel& local, _Outptr_ const FilterKernel** kernel) noexcept
+        {
+            struct Entry
+            {
+                FILTER_KERNEL_TYPE              type;
+                size_t                          source;
+                size_t                          dest;
+                bool                            wrap;
+                bool                            mirror;
+                std::unique_ptr<FilterKernel>   kernel;
+            };
+
+            static std::mutex s_mutex;
+            static Entry s_entries[FK_CACHE_ENTRIES];
+            static size_t s_count = 0;
+            static size_t s_taps = 0;
+
+            assert(kernel != nullptr);
+            *kernel = nullptr;
+
+            if (type == FILTER_KERNEL_TRIANGLE || wrap)
+            {
+                // Mirror only matters for the windowed kernels, and wrap takes precedence
+                mirror = false;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+
+                for (size_t j = 0; j < s_count; ++j)
+                {
+                    const Entry& entry = s_entries[j];
+                    if (entry.type == type && entry.source == source && entry.dest == dest && entry.wrap == wrap && entry.mirror == mirror)
+                    {
+                        *kernel = entry.kernel.get();
+                        return S_OK;
+                    }
+                }
+            }
+
+            std::unique_ptr<FilterKernel> created(new (std::nothrow) FilterKernel);
+            if (!created)
+                return E_OUTOFMEMORY;
+
+            HRESULT hr = CreateFilterKernel(type, source, dest, wrap, mirror, *created);
+            if (FAILED(hr))
+                return hr;
+
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            for (size_t j = 0; j < s_count; ++j)
+            {
+                const Entry& entry = s_entries[j];
+                if (entry.type == type && entry.source == source && entry.dest == dest && entry.wrap == wrap && entry.mirror == mirror)
+                {
+                    // Another thread built the same kernel
+                    *kernel = entry.kernel.get();
+                    return S_OK;
+                }
+            }
+
+            const size_t ntaps = created->first[dest];
+            if (s_count >= FK_CACHE_ENTRIES || (s_taps + ntaps) > FK_CACHE_MAX_TAPS)
+            {
+                local = std::move(*created);
+                *kernel = &local;
+                return S_OK;
+            }
+
+            Entry& entry = s_entries[s_count++];
+            entry.type = type;
+            entry.source = source;
+            entry.dest = dest;
+            entry.wrap = wrap;
+            entry.mirror = mirror;
+            entry.kernel = std::move(created);
+            s_taps += ntaps;
+
+            *kernel = entry.kernel.get();
+            return S_OK;
+        }
+
+        // Horizontal pass of a separable filter
+        inline void FilterKernelScanline(
+            _Out_writes_(kernel.dest) XMVECTOR* pDestination,
+            _In_reads_(kernel.source) const XMVECTOR* pSource,
+            const FilterKernel& kernel) noexcept
+        {
+            const FilterTo* tap = kernel.taps.get();
+            for (size_t u = 0; u < kernel.dest; ++u)
+            {
+                XMVECTOR acc = XMVectorZero();
+                for (const FilterTo* end = kernel.taps.get() + kernel.first[u + 1]; tap < end; ++tap)
+                {
+                    acc = XMVectorMultiplyAdd(pSource[tap->u], XMVectorReplicate(tap->weight), acc);
+                }
+                pDestination[u] = acc;
+            }
+        }
+
+        // Horizontally filtered source rows, keyed by source row, for the vertical pass of a separable filter
+        class FilterRowCache
+        {
+        public:
+            FilterRowCache() noexcept : m_count(0), m_width(0), m_clock(0) {}
+
+            FilterRowCache(const FilterRowCache&) = delete;
+            FilterRowCache& operator=(const FilterRowCache&) = delete;
+
+            HRESULT Initialize(size_t count, size_t width) noexcept
+            {
+                assert(count > 0 && width > 0);
+
+                m_scanlines = make_AlignedArrayXMVECTOR(uint64_t(count) * uint64_t(width));
+                m_slots.reset(new (std::nothrow) Slot[count]);
+                if (!m_scanlines || !m_slots)
+                    return E_OUTOFMEMORY;
+
+                for (size_t j = 0; j < count; ++j)
+                {
+                    m_slots[j].row = size_t(-1);
+                    m_slots[j].lastUse = 0;
+                }
+
+                m_count = count;
+                m_width = width;
+                m_clock = 0;
+                return S_OK;
+            }
+
+            // Returns the scanline for the source row; 'load' is set when it must be (re)filled
+            XMVECTOR* Get(size_t row, bool& load) noexcept
+            {
+                ++m_clock;
+
+                size_t lru = 0;
+                for (size_t j = 0; j < m_count; ++j)
+                {
+                    if (m_slots[j].row == row)
+                    {
+                        m_slots[j].lastUse = m_clock;
+                        load = false;
+                        return m_scanlines.get() + m_width * j;
+                    }
+
+                    if (m_slots[j].lastUse < m_slots[lru].lastUse)
+                        lru = j;
+                }
+
+                m_slots[lru].row = row;
+                m_slots[lru].lastUse = m_clock;
+                load = true;
+                return m_scanlines.get() + m_width * lru;
+            }
+
+        private:
+            struct Slot
+            {
+                size_t  row;
+                size_t  lastUse;
+            };
+
+            size_t                      m_count;
+            size_t                      m_width;
+            size_t                      m_clock;
+            std::unique_ptr<Slot[]>     m_slots;
+            ScopedAlignedArrayXMVECTOR  m_scanlines;
+        };
+
+        // Row-cache budget for FilterKernelRows; strong minification can need more rows than are worth keeping,
+        // in which case some get filtered twice
+        constexpr size_t FILTER_MAX_ROW_CACHE_BYTES = 64 * 1024 * 1024;
+
+        // Filters destination rows [y0, y1) of a separable kernel resize of src into dest
+        inline HRESULT FilterKernelRows(
+            const Image& src,
+            TEX_FILTER_FLAGS filter,
+            const Image& dest,
+            const FilterKernel& kernelX,
+            const FilterKernel& kernelY,
+            size_t y0,
+            size_t y1,
+            size_t maxCacheBytes,
+            _Out_writes_(src.width + dest.width) XMVECTOR* scanline) noexcept
+        {
+            assert(y0 < y1 && y1 <= dest.height);
+
+            const size_t width = src.width;
+            const size_t nwidth = dest.width;
+
+            const size_t maxRows = std::max<size_t>(4, maxCacheBytes / (sizeof(XMVECTOR) * nwidth));
+
+            FilterRowCache rows;
+            HRESULT hr = rows.Initialize(std::min<size_t>(std::max<size_t>(kernelY.maxTaps, 1), maxRows), nwidth);
+            if (FAILED(hr))
+                return hr;
+
+            XMVECTOR* target = scanline;
+            XMVECTOR* row = target + nwidth;
+
+        #ifdef _DEBUG
+            memset(row, 0xCD, sizeof(XMVECTOR)*width);
+        #endif
+
+            const uint8_t* pSrc = src.pixels;
+            const size_t rowPitch = src.rowPitch;
+
+            uint8_t* pDest = dest.pixels + (dest.rowPitch * y0);
+
+            for (size_t y = y0; y < y1; ++y)
+            {
+                memset(target, 0, sizeof(XMVECTOR) * nwidth);
+
+                for (size_t t = kernelY.first[y]; t < kernelY.first[y + 1]; ++t)
+                {
+                    const FilterTo& toY = kernelY.taps[t];
+                    assert(toY.u < src.height);
+
+                    bool load;
+                    XMVECTOR* hrow = rows.Get(toY.u, load);
+                    if (load)
+                    {
+                        if (!Internal::LoadScanlineLinear(row, width, pSrc + (rowPitch * toY.u), rowPitch, src.format, filter))
+                            return E_FAIL;
+
+                        FilterKernelScanline(hrow, row, kernelX);
+                    }
+
+                    const XMVECTOR weight = XMVectorReplicate(toY.weight);
+                    for (size_t x = 0; x < nwidth; ++x)
+                    {
+                        target[x] = XMVectorMultiplyAdd(hrow[x], weight, target[x]);
+                    }
+                }
+
+                switch (dest.format)
+                {
+                case DXGI_FORMAT_R10G10B10A2_UNORM:
+                case DXGI_FORMAT_R10G10B10A2_UINT:
+                    {
+                        // Need to slightly bias results for floating-point error accumulation which can
+                        // be visible with harshly quantized values
+                        static const XMVECTORF32 Bias = { { { 0.f, 0.f, 0.f, 0.1f } } };
+
+                        XMVECTOR* ptr = target;
+                        for (size_t i = 0; i < nwidth; ++i, ++ptr)
+                        {
+                            *ptr = XMVectorAdd(*ptr, Bias);
+                        }
+                    }
+                    break;
+
+                default:
+                    break;
+                }
+
+                // This performs any required clamping
+                if (!Internal::StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                    return E_FAIL;
+                pDest += dest.rowPitch;
+            }
+
+            return S_OK;
+        }
+
     } // namespace Filters
 } // namespace DirectX
@@ -15,63 +15,44 @@
 #include <memory>
 #include <tuple>
 
-#ifndef _WIN32
-#include <cstdlib>
-
-struct aligned_deleter { void operator()(void* p) noexcept { free(p); } };
-
-using ScopedAlignedArrayFloat = std::unique_ptr<float[], aligned_deleter>;
-
-inline ScopedAlignedArrayFloat make_AlignedArrayFloat(uint64_t count)
+//---------------------------------------------------------------------------------
+// Aligned scratch arrays come from DirectX::GetMemoryAllocator() so they follow SetMemoryAllocator
+struct aligned_deleter
 {
-    uint64_t size = sizeof(float) * count;
-    size = (size + 15u) & ~0xF;
-    if (size > static_cast<uint64_t>(UINT32_MAX))
-        return nullptr;
+    DirectX::IMemoryAllocator* allocator;
+    size_t size;
 
-    auto ptr = aligned_alloc(16, static_cast<size_t>(size));
-    return ScopedAlignedArrayFloat(static_cast<float*>(ptr));
-}
-
-using ScopedAlignedArrayXMVECTOR = std::unique_ptr<DirectX::XMVECTOR[], aligned_deleter>;
+    void operator()(void* p) noexcept { if (p) allocator->Free(p, size); }
+};
 
-inline ScopedAlignedArrayXMVECTOR make_AlignedArrayXMVECTOR(uint64_t count)
+template<typename T>
+inline std::unique_ptr<T[], aligned_deleter> make_AlignedArray(uint64_t count) noexcept
 {
-    uint64_t size = sizeof(DirectX::XMVECTOR) * count;
+    uint64_t size = sizeof(T) * count;
+    size = (size + 15u) & ~uint64_t(0xF);
     if (size > static_cast<uint64_t>(UINT32_MAX))
         return nullptr;
-    auto ptr = aligned_alloc(16, static_cast<size_t>(size));
-    return ScopedAlignedArrayXMVECTOR(static_cast<DirectX::XMVECTOR*>(ptr));
-}
 
-#else // WIN32
-//---------------------------------------------------------------------------------
-#include <malloc.h>
-
-struct aligned_deleter { void operator()(void* p) noexcept { _aligned_free(p); } };
+    DirectX::IMemoryAllocator* allocator = DirectX::GetMemoryAllocator();
+    auto ptr = allocator->Allocate(static_cast<size_t>(size), 16);
+    return std::unique_ptr<T[], aligned_deleter>(static_cast<T*>(ptr), aligned_deleter{ allocator, static_cast<size_t>(size) });
+}
 
 using ScopedAlignedArrayFloat = std::unique_ptr<float[], aligned_deleter>;
 
-inline ScopedAlignedArrayFloat make_AlignedArrayFloat(uint64_t count)
+inline ScopedAlignedArrayFloat make_AlignedArrayFloat(uint64_t count) noexcept
 {
-    const uint64_t size = sizeof(float) * count;
-    if (size > static_cast<uint64_t>(UINT32_MAX))
-        return nullptr;
-    auto ptr = _aligned_malloc(static_cast<size_t>(size), 16);
-    return ScopedAlignedArrayFloat(static_cast<float*>(ptr));
+    return make_AlignedArray<float>(count);
 }
 
 using ScopedAlignedArrayXMVECTOR = std::unique_ptr<DirectX::XMVECTOR[], aligned_deleter>;
 
-inline ScopedAlignedArrayXMVECTOR make_AlignedArrayXMVECTOR(uint64_t count)
+inline ScopedAlignedArrayXMVECTOR make_AlignedArrayXMVECTOR(uint64_t count) noexcept
 {
-    const uint64_t size = sizeof(DirectX::XMVECTOR) * count;
-    if (size > static_cast<uint64_t>(UINT32_MAX))
-        return nullptr;
-    auto ptr = _aligned_malloc(static_cast<size_t>(size), 16);
-    return ScopedAlignedArrayXMVECTOR(static_cast<DirectX::XMVECTOR*>(ptr));
+    return make_AlignedArray<DirectX::XMVECTOR>(count);
 }
 
+#ifdef _WIN32
 //---------------------------------------------------------------------------------
 struct handle_closer { void operator()(HANDLE h) noexcept { assert(h != INVALID_HANDLE_VALUE); if (h) CloseHandle(h); } };
 
@@ -840,9 +840,7 @@ namespace
             L"   -nologo             suppress copyright message\n"
             L"   --timing            display elapsed processing time\n"
             L"\n"
-        #ifdef _OPENMP
-            L"   --single-proc       Do not use multi-threaded compression\n"
-        #endif
+            L"   --single-proc       Do not use multi-threaded processing\n"
             L"   -gpu <adapter>      Select GPU for DirectCompute-based codecs (0 is default)\n"
             L"   -nogpu              Do not use DirectCompute-based codecs\n"
             L"\n"
@@ -1976,6 +1974,11 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
         mipLevels = 1;
     }
 
+    if (!(dwOptions & (UINT64_C(1) << OPT_FORCE_SINGLEPROC)))
+    {
+        dwConvert |= TEX_FILTER_PARALLEL;
+    }
+
     LARGE_INTEGER qpcFreq = {};
     std::ignore = QueryPerformanceFrequency(&qpcFreq);
 
@@ -2344,7 +2347,10 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 return 1;
             }
 
-            hr = Decompress(img, nimg, info, DXGI_FORMAT_UNKNOWN /* picks good default */, *timage);
+            const TEX_COMPRESS_FLAGS dflags = (dwOptions & (UINT64_C(1) << OPT_FORCE_SINGLEPROC))
+                ? TEX_COMPRESS_DEFAULT : TEX_COMPRESS_PARALLEL;
+
+            hr = Decompress(img, nimg, info, DXGI_FORMAT_UNKNOWN /* picks good default */, dflags, nullptr, *timage);
             if (FAILED(hr))
             {
                 wprintf(L" FAILED [decompress] (%08X%ls)\n", static_cast<unsigned int>(hr), GetErrorDesc(hr));
@@ -3587,12 +3593,10 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                     }
 
                     TEX_COMPRESS_FLAGS cflags = dwCompress;
-                #ifdef _OPENMP
                     if (!(dwOptions & (UINT64_C(1) << OPT_FORCE_SINGLEPROC)))
                     {
                         cflags |= TEX_COMPRESS_PARALLEL;
                     }
-                #endif
 
                     if ((img->width % 4) != 0 || (img->height % 4) != 0)
                     {